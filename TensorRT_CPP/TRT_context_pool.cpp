@@ -0,0 +1,93 @@
+#include "TRT_context_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+void ContextLease::release()
+{
+    if (this->pool_)
+    {
+        this->pool_->give_back(this->index_);
+        this->pool_ = nullptr;
+        this->index_ = -1;
+    }
+}
+
+ContextPool::ContextPool(int num_contexts)
+    : size_(std::max(num_contexts, 1))
+{
+    for (int i = 0; i < this->size_; i++)
+    {
+        this->free_.push_back(i);
+    }
+    this->free_count_ = this->size_;
+    this->stats_.leases_per_context.resize(this->size_, 0);
+}
+
+ContextLease ContextPool::lease()
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(this->mutex_);
+
+    // Ticket lock: each waiter is served in the order it arrived.
+    const uint64_t ticket = this->next_ticket_++;
+    const bool contended = ticket != this->now_serving_ || this->free_count_ == 0;
+    this->freed_.wait(lock, [&] { return ticket == this->now_serving_ && this->free_count_ > 0; });
+    this->now_serving_++;
+
+    const double wait_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    ContextLease lease = this->take_locked(wait_ms, contended);
+
+    // The next waiter in line may already be able to proceed.
+    lock.unlock();
+    this->freed_.notify_all();
+    return lease;
+}
+
+ContextLease ContextPool::try_lease()
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    if (this->free_count_ == 0 || this->next_ticket_ != this->now_serving_)
+    {
+        this->stats_.failed_try_leases++;
+        return ContextLease();
+    }
+    return this->take_locked(0.0, false);
+}
+
+int ContextPool::available() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->free_count_;
+}
+
+ContextPoolStats ContextPool::get_stats() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->stats_;
+}
+
+void ContextPool::give_back(int index)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->free_[(this->free_head_ + this->free_count_) % this->size_] = index;
+        this->free_count_++;
+    }
+    this->freed_.notify_all();
+}
+
+ContextLease ContextPool::take_locked(double wait_ms, bool contended)
+{
+    const int index = this->free_[this->free_head_];
+    this->free_head_ = (this->free_head_ + 1) % this->size_;
+    this->free_count_--;
+
+    this->stats_.leases++;
+    this->stats_.contended_leases += contended;
+    this->stats_.total_wait_ms += wait_ms;
+    this->stats_.max_wait_ms = std::max(this->stats_.max_wait_ms, wait_ms);
+    this->stats_.leases_per_context[index]++;
+    return ContextLease(this, index);
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class ContextPool;
+
+/// @brief Counters of a ContextPool.
+struct ContextPoolStats
+{
+    uint64_t leases = 0;             // Successful leases
+    uint64_t contended_leases = 0;   // Leases that had to wait for a context
+    uint64_t failed_try_leases = 0;  // try_lease() calls that found nothing free
+    double total_wait_ms = 0.0;
+    double max_wait_ms = 0.0;
+    std::vector<uint64_t> leases_per_context;
+};
+
+/// @brief Exclusive use of one execution context of a ContextPool.
+/// The context returns to the pool when the lease is destroyed or release() is called.
+/// Move-only.
+class ContextLease
+{
+public:
+    ContextLease() = default;
+    ~ContextLease() { this->release(); }
+
+    ContextLease(ContextLease&& other) noexcept
+        : pool_(other.pool_), index_(other.index_)
+    {
+        other.pool_ = nullptr;
+        other.index_ = -1;
+    }
+
+    ContextLease& operator=(ContextLease&& other) noexcept
+    {
+        if (this != &other)
+        {
+            this->release();
+            this->pool_ = other.pool_;
+            this->index_ = other.index_;
+            other.pool_ = nullptr;
+            other.index_ = -1;
+        }
+        return *this;
+    }
+
+    ContextLease(const ContextLease&) = delete;
+    ContextLease& operator=(const ContextLease&) = delete;
+
+    /// @brief Get the index of the leased context, or -1 if this lease is empty.
+    int index() const noexcept { return this->index_; }
+
+    /// @brief TRUE if this lease holds a context.
+    explicit operator bool() const noexcept { return this->pool_ != nullptr; }
+
+    /// @brief Returns the context to its pool early. Safe to call on an empty lease.
+    void release();
+
+private:
+    friend class ContextPool;
+
+    ContextLease(ContextPool* pool, int index) : pool_(pool), index_(index) {}
+
+    ContextPool* pool_ = nullptr;
+    int index_ = -1;
+};
+
+/// @brief Fixed set of execution contexts (identified by index) shared between threads.
+/// lease() blocks until a context is free and serves waiting threads strictly in arrival order,
+/// so no caller is starved. Free contexts are handed out round-robin.
+/// Thread-safe; the pool must outlive every lease.
+class ContextPool
+{
+public:
+    explicit ContextPool(int num_contexts);
+
+    ContextPool(const ContextPool&) = delete;
+    ContextPool& operator=(const ContextPool&) = delete;
+
+    /// @brief Get the number of contexts
+    int size() const noexcept { return this->size_; }
+
+    /// @brief Waits (in FIFO order with other waiters) for a free context.
+    ContextLease lease();
+
+    /// @brief Leases a free context without waiting. Never jumps ahead of waiting threads.
+    /// @return The lease, or an empty lease if nothing is free.
+    ContextLease try_lease();
+
+    /// @brief Get the number of contexts not currently leased
+    int available() const;
+
+    /// @brief TRUE if lease holds a context of this pool (not of another pool, and not empty).
+    bool owns(const ContextLease& lease) const noexcept { return lease.pool_ == this; }
+
+    /// @brief Get a snapshot of the pool counters
+    ContextPoolStats get_stats() const;
+
+private:
+    friend class ContextLease;
+
+    /// @brief Called by ContextLease::release().
+    void give_back(int index);
+
+    /// @brief Pops a free context and updates the counters. Caller holds mutex_.
+    ContextLease take_locked(double wait_ms, bool contended);
+
+    const int size_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable freed_;
+    std::vector<int> free_;     // Ring of free contexts, in the order they were returned (never reallocates)
+    int free_head_ = 0;         // Position of the oldest free context in free_
+    int free_count_ = 0;
+    uint64_t next_ticket_ = 0;  // Ticket of the next thread to start waiting
+    uint64_t now_serving_ = 0;  // Ticket of the thread whose turn it is
+    ContextPoolStats stats_;
+};
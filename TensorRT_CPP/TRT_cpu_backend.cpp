@@ -0,0 +1,577 @@
+#include "TRT_cpu_backend.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    /// @brief Small xorshift generator, so outputs are identical across standard libraries.
+    struct XorShift32
+    {
+        uint32_t state;
+
+        explicit XorShift32(uint32_t seed) : state(seed ? seed : 0x9E3779B9u) {}
+
+        uint32_t next() noexcept
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        /// @brief Uniform float in [0, 1).
+        float next_float() noexcept { return (next() >> 8) * (1.0f / 16777216.0f); }
+    };
+
+    /// @brief Parses "1x3x640x640" into {1, 3, 640, 640}.
+    std::vector<int> parse_shape(const std::string& text)
+    {
+        std::vector<int> shape;
+        std::stringstream ss(text);
+        std::string dim;
+        while (std::getline(ss, dim, 'x'))
+        {
+            shape.push_back(std::stoi(dim));
+        }
+        return shape;
+    }
+}
+
+CpuInferenceBackend::CpuInferenceBackend(const std::string& descriptor_path)
+    : CpuInferenceBackend(load_descriptor(descriptor_path))
+{
+    std::cout << "[CPU_BACKEND] Loaded CPU stand-in model from path: " << descriptor_path << std::endl;
+}
+
+CpuInferenceBackend::CpuInferenceBackend(const CpuBackendConfig& config)
+    : InferenceBackend(config.contexts), config_(config)
+{
+    this->calculate_model_parameters();
+}
+
+bool CpuInferenceBackend::execute_on_context(int context, const std::vector<void*> &input_buf,
+    const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf,
+    const std::vector<size_t> &size_out_param, const std::vector<TensorShape> *input_shapes,
+    std::vector<TensorShape> *output_shapes)
+{
+    const auto& image = input_shapes ? (*input_shapes)[0] : this->input_shapes_[0];
+    const auto deadline = this->reserve_device_time(image.size() == 4 ? image[0] : 1);
+
+    std::vector<size_t>& shaped_bytes = this->slots_[context].shaped_input_bytes;
+    if (input_shapes)
+    {
+        // Only the part of each buffer covered by its shape is input data.
+        for (int i = 0; i < this->num_inputs_; i++)
+        {
+            shaped_bytes[i] = tensor_size_bytes(this->input_descs_[i], (*input_shapes)[i]);
+        }
+        this->calculate_output_shapes(*input_shapes, *output_shapes);
+    }
+    const auto& used_bytes = input_shapes ? shaped_bytes : size_in_param;
+
+    const auto& shapes = output_shapes ? *output_shapes : this->output_shapes_;
+    if (this->has_counted_outputs() && !input_shapes)
+    {
+        // Stand-in for device memory: generate into the context's staging area,
+        // then transfer only the valid rows.
+        ContextSlot& slot = this->slots_[context];
+        size_t total = 0;
+        for (int i = 0; i < this->num_outputs_; i++)
+        {
+            total += size_out_param[i];
+        }
+        this->fill_outputs(slot.output_ptrs, input_buf, used_bytes, shapes, image);
+        this->record_valid_rows(this->copy_valid_rows(slot.output_ptrs, output_buf, size_out_param), total);
+    }
+    else
+    {
+        this->fill_outputs(output_buf, input_buf, used_bytes, shapes, image);
+    }
+
+    // Simulated device time - generating the outputs counts towards it.
+    std::this_thread::sleep_until(deadline);
+    return true;
+}
+
+bool CpuInferenceBackend::enqueue_on_context(int context, const std::vector<void*> &input_buf,
+    const std::vector<size_t> &size_in_param)
+{
+    // The inputs are only read at retrieval, as the device may read them any time before completion,
+    // so a caller that refills them early gets wrong results here too.
+    ContextSlot& slot = this->slots_[context];
+    const TensorShape& image = this->input_shapes_[0];
+    std::copy(input_buf.begin(), input_buf.end(), slot.inputs.begin());
+    std::copy(size_in_param.begin(), size_in_param.end(), slot.input_sizes.begin());
+    slot.ready_at = this->reserve_device_time(image.size() == 4 ? image[0] : 1);
+    return true;
+}
+
+AsyncInferStatus CpuInferenceBackend::collect_from_context(int context, const std::vector<void*> &output_buf,
+    const std::vector<size_t> &size_out_param, bool wait)
+{
+    ContextSlot& slot = this->slots_[context];
+    if (std::chrono::steady_clock::now() < slot.ready_at)
+    {
+        if (!wait)
+        {
+            return AsyncInferStatus::kPending;
+        }
+        std::this_thread::sleep_until(slot.ready_at);
+    }
+
+    this->fill_outputs(slot.output_ptrs, slot.inputs, slot.input_sizes, this->output_shapes_, this->input_shapes_[0]);
+    this->copy_valid_rows(slot.output_ptrs, output_buf, size_out_param);
+    return AsyncInferStatus::kReady;
+}
+
+CpuBackendConfig CpuInferenceBackend::load_descriptor(const std::string& descriptor_path)
+{
+    std::ifstream file(descriptor_path);
+    if (!file)
+    {
+        throw std::runtime_error("[CPU_BACKEND] Cannot open descriptor: " + descriptor_path);
+    }
+    return parse_descriptor(file);
+}
+
+CpuBackendConfig CpuInferenceBackend::parse_descriptor(std::istream& in)
+{
+    CpuBackendConfig config;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line))
+    {
+        line_number++;
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos)
+        {
+            line.erase(comment);
+        }
+
+        std::stringstream ss(line);
+        std::string key;
+        if (!(ss >> key))
+        {
+            continue; // Blank line
+        }
+
+        try
+        {
+            if (key == "input" || key == "output")
+            {
+                CpuBindingDesc binding;
+                std::string shape, dtype;
+                if (!(ss >> binding.name >> shape))
+                {
+                    throw std::invalid_argument("expected '<name> <shape> [dtype]'");
+                }
+                if (ss >> dtype && !parse_data_type(dtype, binding.dtype))
+                {
+                    throw std::invalid_argument("unknown data type '" + dtype + "'");
+                }
+                binding.is_input = (key == "input");
+                binding.shape = parse_shape(shape);
+                config.bindings.push_back(binding);
+            }
+            else if (key == "service_time_us")
+            {
+                long long us = 0;
+                ss >> us;
+                config.service_time = std::chrono::microseconds(us);
+            }
+            else if (key == "frame_time_us")
+            {
+                long long us = 0;
+                ss >> us;
+                config.frame_time = std::chrono::microseconds(us);
+            }
+            else if (key == "detections")
+            {
+                ss >> config.synthetic_detections;
+            }
+            else if (key == "classes")
+            {
+                ss >> config.synthetic_classes;
+            }
+            else if (key == "seed")
+            {
+                ss >> config.seed;
+            }
+            else if (key == "contexts")
+            {
+                ss >> config.contexts;
+            }
+            else if (key == "device_lanes")
+            {
+                ss >> config.device_lanes;
+            }
+            else if (key == "profile")
+            {
+                int index = -1;
+                std::string name, min, opt, max;
+                if (!(ss >> index >> name >> min >> opt >> max) || index < 0)
+                {
+                    throw std::invalid_argument("expected '<index> <input> <min> <opt> <max>'");
+                }
+
+                // Shape ranges are kept in input order, like a TensorRT profile.
+                int input = -1;
+                int inputs_seen = 0;
+                for (const auto& binding : config.bindings)
+                {
+                    if (!binding.is_input) continue;
+                    if (binding.name == name) input = inputs_seen;
+                    inputs_seen++;
+                }
+                if (input < 0)
+                {
+                    throw std::invalid_argument("profile for undeclared input '" + name + "'");
+                }
+                if (config.profiles.size() <= static_cast<size_t>(index))
+                {
+                    config.profiles.resize(index + 1);
+                }
+                OptimizationProfile& profile = config.profiles[index];
+                profile.index = index;
+                if (profile.inputs.size() <= static_cast<size_t>(input))
+                {
+                    profile.inputs.resize(input + 1);
+                }
+                profile.inputs[input] = {parse_shape(min), parse_shape(opt), parse_shape(max)};
+            }
+            else if (key == "batch")
+            {
+                ss >> config.batch_size;
+            }
+            else
+            {
+                throw std::invalid_argument("unknown key '" + key + "'");
+            }
+        }
+        catch (const std::exception& e)
+        {
+            throw std::runtime_error("[CPU_BACKEND] Descriptor line " + std::to_string(line_number)
+                + ": " + e.what());
+        }
+    }
+    return config;
+}
+
+CpuBackendConfig CpuInferenceBackend::yolo_nms_config()
+{
+    CpuBackendConfig config;
+    config.bindings = {
+        {"images", true, {1, 3, 640, 640}},
+        {"num_dets", false, {1, 1}, TensorDataType::kINT32},
+        {"bboxes", false, {1, 100, 4}},
+        {"scores", false, {1, 100}},
+        {"labels", false, {1, 100}, TensorDataType::kINT32},
+    };
+    return config;
+}
+
+
+/// --- The functions below this line are internal use only ---
+
+
+void CpuInferenceBackend::calculate_model_parameters()
+{
+    this->input_names_.clear();
+    this->output_names_.clear();
+    this->input_shapes_.clear();
+    this->output_shapes_.clear();
+    this->declared_output_shapes_.clear();
+    this->trt_input_element_counts_.clear();
+    this->trt_output_element_counts_.clear();
+    this->input_descs_.clear();
+    this->output_descs_.clear();
+
+    std::vector<TensorShape> declared_input_shapes;
+    std::vector<TensorDataType> input_dtypes;
+    std::vector<TensorDataType> output_dtypes;
+    for (const auto& binding : this->config_.bindings)
+    {
+        if (binding.shape.empty())
+        {
+            throw std::runtime_error("[CPU_BACKEND] No dimensions for binding " + binding.name);
+        }
+        for (int dim : binding.shape)
+        {
+            if (dim == 0 || dim < DYNAMIC_DIM)
+            {
+                throw std::runtime_error("[CPU_BACKEND] Invalid dimension in binding " + binding.name);
+            }
+        }
+
+        if (binding.is_input)
+        {
+            this->input_names_.push_back(binding.name);
+            declared_input_shapes.push_back(binding.shape);
+            input_dtypes.push_back(binding.dtype);
+        }
+        else
+        {
+            this->output_names_.push_back(binding.name);
+            this->declared_output_shapes_.push_back(binding.shape);
+            output_dtypes.push_back(binding.dtype);
+        }
+    }
+
+    this->num_inputs_ = static_cast<int>(this->input_names_.size());
+    this->num_outputs_ = static_cast<int>(this->output_names_.size());
+    if (this->num_inputs_ < 1 || this->num_outputs_ < 1)
+    {
+        throw std::runtime_error("[CPU_BACKEND] Descriptor must declare at least one input and one output");
+    }
+
+    // Buffers are sized for the max shapes of the selected profile.
+    this->select_input_profile(declared_input_shapes);
+    this->calculate_output_shapes(this->input_shapes_, this->output_shapes_);
+    for (int i = 0; i < this->num_inputs_; i++)
+    {
+        this->trt_input_element_counts_.push_back(shape_volume(this->input_shapes_[i]));
+        this->input_descs_.push_back(make_tensor_desc(this->input_names_[i], true, input_dtypes[i],
+            this->input_shapes_[i]));
+    }
+    for (int i = 0; i < this->num_outputs_; i++)
+    {
+        const size_t elements = shape_volume(this->output_shapes_[i]);
+        if (elements == 0)
+        {
+            throw std::runtime_error("[CPU_BACKEND] Cannot resolve the shape of output " + this->output_names_[i]
+                + " (" + shape_to_string(this->declared_output_shapes_[i]) + ") from the first input");
+        }
+        this->trt_output_element_counts_.push_back(elements);
+        this->output_descs_.push_back(make_tensor_desc(this->output_names_[i], false, output_dtypes[i],
+            this->output_shapes_[i]));
+    }
+    this->cache_binding_sizes();
+
+    // Every context stages a full set of outputs for async retrieval.
+    this->slots_.resize(this->get_num_contexts());
+    for (auto& slot : this->slots_)
+    {
+        slot.inputs.resize(this->num_inputs_);
+        slot.input_sizes.resize(this->num_inputs_);
+        slot.shaped_input_bytes.resize(this->num_inputs_);
+        slot.outputs.resize(this->num_outputs_);
+        slot.output_ptrs.resize(this->num_outputs_);
+        for (int i = 0; i < this->num_outputs_; i++)
+        {
+            slot.outputs[i].resize(this->output_descs_[i].size_bytes);
+            slot.output_ptrs[i] = slot.outputs[i].data();
+        }
+    }
+
+    const int lanes = this->config_.device_lanes > 0 ? this->config_.device_lanes : this->get_num_contexts();
+    this->lane_free_at_.assign(lanes, std::chrono::steady_clock::time_point());
+}
+
+void CpuInferenceBackend::select_input_profile(const std::vector<TensorShape>& declared_input_shapes)
+{
+    this->input_profile_.clear();
+    this->profile_index_ = 0;
+
+    bool dynamic = false;
+    for (const auto& shape : declared_input_shapes)
+    {
+        dynamic = dynamic || has_dynamic_dims(shape);
+    }
+    if (!dynamic)
+    {
+        // Static inputs accept exactly their declared shape.
+        this->input_shapes_ = declared_input_shapes;
+        for (const auto& shape : declared_input_shapes)
+        {
+            this->input_profile_.push_back({shape, shape, shape});
+        }
+        return;
+    }
+
+    const auto& profiles = this->config_.profiles;
+    if (profiles.empty())
+    {
+        throw std::runtime_error("[CPU_BACKEND] Dynamic inputs need at least one 'profile' entry");
+    }
+    for (size_t p = 0; p < profiles.size(); p++)
+    {
+        const std::string where = "[CPU_BACKEND] Profile " + std::to_string(p);
+        if (profiles[p].inputs.size() != declared_input_shapes.size())
+        {
+            throw std::runtime_error(where + " does not cover every input");
+        }
+        for (int i = 0; i < this->num_inputs_; i++)
+        {
+            const ProfileShapes& range = profiles[p].inputs[i];
+            const TensorShape& declared = declared_input_shapes[i];
+            // The range must only vary the dynamic dimensions, and contain its opt shape.
+            if (resolve_dynamic_dims(declared, range.min) != range.min
+                || resolve_dynamic_dims(declared, range.max) != range.max
+                || !shape_within(range.opt, range.min, range.max) || shape_volume(range.min) == 0)
+            {
+                throw std::runtime_error(where + " has an invalid range for input " + this->input_names_[i]
+                    + " (" + shape_to_string(declared) + ")");
+            }
+        }
+    }
+
+    this->profile_index_ = select_profile(profiles, this->config_.batch_size);
+    if (this->profile_index_ < 0)
+    {
+        throw std::runtime_error("[CPU_BACKEND] No optimization profile accepts batch size "
+            + std::to_string(this->config_.batch_size));
+    }
+    this->input_profile_ = profiles[this->profile_index_].inputs;
+    for (const auto& range : this->input_profile_)
+    {
+        this->input_shapes_.push_back(range.max);
+    }
+    std::cout << "[CPU_BACKEND] Using optimization profile " << this->profile_index_
+              << " (max input " << shape_to_string(this->input_shapes_[0]) << ")" << std::endl;
+}
+
+void CpuInferenceBackend::calculate_output_shapes(const std::vector<TensorShape>& input_shapes,
+    std::vector<TensorShape>& output_shapes) const
+{
+    output_shapes.resize(this->num_outputs_);
+    for (int i = 0; i < this->num_outputs_; i++)
+    {
+        resolve_dynamic_dims(this->declared_output_shapes_[i], input_shapes[0], output_shapes[i]);
+    }
+}
+
+std::chrono::steady_clock::time_point CpuInferenceBackend::reserve_device_time(int frames)
+{
+    std::lock_guard<std::mutex> lock(this->device_mutex_);
+    auto lane = std::min_element(this->lane_free_at_.begin(), this->lane_free_at_.end());
+    const auto start = std::max(std::chrono::steady_clock::now(), *lane);
+    *lane = start + this->config_.service_time + std::max(0, frames - 1) * this->config_.frame_time;
+    return *lane;
+}
+
+uint32_t CpuInferenceBackend::input_seed(const std::vector<void*> &input_buf,
+    const std::vector<size_t> &size_in_param, int frame, int num_frames) const
+{
+    // FNV-1a over a sparse sample - cheap even for full-size image tensors.
+    constexpr size_t SAMPLE_STRIDE = 4096;
+    uint32_t hash = 2166136261u ^ this->config_.seed;
+    for (size_t i = 0; i < input_buf.size(); i++)
+    {
+        const size_t frame_bytes = size_in_param[i] / num_frames;
+        const auto* bytes = static_cast<const uint8_t*>(input_buf[i]) + frame * frame_bytes;
+        for (size_t j = 0; j < frame_bytes; j += SAMPLE_STRIDE)
+        {
+            hash = (hash ^ bytes[j]) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+void CpuInferenceBackend::fill_outputs(const std::vector<void*> &output_buf, const std::vector<void*> &input_buf,
+    const std::vector<size_t> &input_bytes, const std::vector<TensorShape>& output_shapes,
+    const TensorShape& image) const
+{
+    // Outputs batched like the first input get one result per frame; the others are written once.
+    const int batch = image.size() == 4 && image[0] > 1 ? image[0] : 1;
+    for (int frame = 0; frame < batch; frame++)
+    {
+        const uint32_t seed = this->input_seed(input_buf, input_bytes, frame, batch);
+        for (int i = 0; i < this->num_outputs_; i++)
+        {
+            const int frames = output_batch(output_shapes[i], batch);
+            if (frame >= frames)
+            {
+                continue;
+            }
+            const size_t frame_bytes = tensor_size_bytes(this->output_descs_[i], output_shapes[i]) / frames;
+            this->fill_output(i, static_cast<uint8_t*>(output_buf[i]) + frame * frame_bytes, seed, output_shapes,
+                image, batch);
+        }
+    }
+}
+
+void CpuInferenceBackend::fill_output(int i, void* buf, uint32_t seed, const std::vector<TensorShape>& output_shapes,
+    const TensorShape& image, int batch) const
+{
+    const std::string& name = this->output_names_[i];
+    const size_t elements = shape_volume(output_shapes[i]) / output_batch(output_shapes[i], batch);
+
+    // The per-detection outputs bound how many detections can be reported.
+    int detections = std::max(0, this->config_.synthetic_detections);
+    for (int o = 0; o < this->num_outputs_; o++)
+    {
+        const size_t rows = shape_volume(output_shapes[o]) / output_batch(output_shapes[o], batch)
+            / (this->output_names_[o] == "bboxes" ? 4 : 1);
+        if (this->output_names_[o] == "scores" || this->output_names_[o] == "labels"
+            || this->output_names_[o] == "bboxes")
+        {
+            detections = std::min(detections, static_cast<int>(rows));
+        }
+    }
+
+    // Boxes are placed inside the spatial extent of the first input (NCHW).
+    const int input_height = image.size() >= 2 ? image[image.size() - 2] : 1;
+    const int input_width = image.back();
+
+    // Each output restarts from the per-call seed, so its values do not depend on the output order.
+    XorShift32 rng(seed);
+
+    // Values are written in the output's declared data type.
+    const TensorDataType dtype = this->output_descs_[i].dtype;
+    std::memset(buf, 0, tensor_size_bytes(this->output_descs_[i], output_shapes[i])
+        / output_batch(output_shapes[i], batch));
+
+    if (name == "num_dets")
+    {
+        for (size_t e = 0; e < elements; e++)
+        {
+            store_element(buf, dtype, e, static_cast<float>(detections));
+        }
+    }
+    else if (name == "bboxes")
+    {
+        for (int r = 0; r < detections; r++)
+        {
+            const float w = 8.0f + rng.next_float() * input_width * 0.25f;
+            const float h = 8.0f + rng.next_float() * input_height * 0.25f;
+            const float x1 = rng.next_float() * (input_width - w);
+            const float y1 = rng.next_float() * (input_height - h);
+            store_element(buf, dtype, r * 4 + 0, x1);
+            store_element(buf, dtype, r * 4 + 1, y1);
+            store_element(buf, dtype, r * 4 + 2, x1 + w);
+            store_element(buf, dtype, r * 4 + 3, y1 + h);
+        }
+    }
+    else if (name == "scores")
+    {
+        // Descending, like the output of an NMS plugin.
+        float score = 0.95f;
+        for (int r = 0; r < detections; r++)
+        {
+            store_element(buf, dtype, r, score);
+            score *= 0.8f + 0.2f * rng.next_float();
+        }
+    }
+    else if (name == "labels")
+    {
+        const uint32_t classes = static_cast<uint32_t>(std::max(1, this->config_.synthetic_classes));
+        for (int r = 0; r < detections; r++)
+        {
+            store_element(buf, dtype, r, static_cast<float>(rng.next() % classes));
+        }
+    }
+    else
+    {
+        XorShift32 raw(seed ^ (0x85EBCA6Bu * static_cast<uint32_t>(i + 1)));
+        for (size_t e = 0; e < elements; e++)
+        {
+            store_element(buf, dtype, e, raw.next_float());
+        }
+    }
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "TRT_inference_backend.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// @brief Description of a single model binding, as read from a CPU backend descriptor.
+struct CpuBindingDesc
+{
+    std::string name;
+    bool is_input = false;
+    std::vector<int> shape; // -1 marks a dynamic dimension
+    TensorDataType dtype = TensorDataType::kFLOAT;
+};
+
+/// @brief Configuration of the CPU stand-in backend.
+struct CpuBackendConfig
+{
+    std::vector<CpuBindingDesc> bindings;
+
+    /// @brief Simulated time taken by one inference call (the call never returns earlier).
+    std::chrono::microseconds service_time{0};
+
+    /// @brief Simulated time added by each frame of a batch beyond the first
+    /// (a call with N frames takes service_time + (N - 1) * frame_time).
+    std::chrono::microseconds frame_time{0};
+
+    /// @brief Number of detections reported through a "num_dets" output.
+    int synthetic_detections = 10;
+
+    /// @brief Number of classes used when generating "labels".
+    int synthetic_classes = 80;
+
+    /// @brief Seed mixed into every synthetic output.
+    uint32_t seed = 1;
+
+    /// @brief Number of execution contexts (concurrent sync calls + in-flight async calls).
+    int contexts = 2;
+
+    /// @brief Number of requests the simulated device serves at the same time.
+    /// 0 means one per context, i.e. throughput scales linearly with the number of contexts.
+    int device_lanes = 0;
+
+    /// @brief Shape ranges of the inputs, one entry per optimization profile. Required when an input is dynamic.
+    std::vector<OptimizationProfile> profiles;
+
+    /// @brief Batch size the profile is selected for (see select_profile()). 0 selects profile 0.
+    int batch_size = 0;
+};
+
+/// @brief GPU-less inference backend.
+/// Exposes the same binding metadata as a TensorRT engine (read from a small text descriptor),
+/// and produces deterministic synthetic YOLO-shaped outputs after a configurable service time.
+/// Intended for capacity planning and regression benchmarks on machines without CUDA.
+///
+/// Descriptor format (one entry per line, '#' starts a comment):
+/// ```
+/// input   images    1x3x640x640
+/// output  num_dets  1x1       i32
+/// output  bboxes    1x100x4   f16
+/// output  scores    1x100     f16
+/// output  labels    1x100     i32
+/// service_time_us   4500
+/// frame_time_us     900
+/// detections        12
+/// classes           80
+/// seed              7
+/// contexts          4
+/// device_lanes      2
+/// ```
+/// Dynamic dimensions are written as -1 and need a shape range per optimization profile
+/// (`profile <index> <input> <min> <opt> <max>`, after the input line), e.g.
+/// ```
+/// input   images    -1x3x-1x-1
+/// output  bboxes    -1x100x4
+/// profile 0 images  1x3x320x320 1x3x640x640 1x3x640x640
+/// profile 1 images  1x3x640x640 4x3x640x640 8x3x640x640
+/// batch             4
+/// ```
+/// A dynamic output dimension takes the size of the same dimension of the first input.
+/// With a batch (dimension 0 of the first input) above 1, outputs with the same leading dimension get one
+/// synthetic result per frame, derived from that frame's input only.
+/// The optional third column is the data type (f32 by default; see data_type_name()), and every value is
+/// written in it. Outputs named num_dets / bboxes / scores / labels are filled like an NMS-embedded YOLO
+/// model. Any other output is filled with pseudo-random values in [0, 1).
+/// The synthetic outputs depend only on the seed and a sample of the input, so identical inputs
+/// always produce identical outputs (and a frame the same detections at any batch size or position).
+///
+/// With set_counted_outputs(), synchronous calls generate into a per-context staging area and copy out
+/// only the valid rows, like the device-to-host transfer of the CUDA backend, so the saved bytes
+/// reported by get_valid_row_stats() can be measured without a GPU.
+///
+/// Inference runs on a simulated device with device_lanes parallel lanes: each call is queued on the
+/// lane that frees up first and completes service_time after it starts there. infer_async() only
+/// releases the outputs once that simulated completion time has passed, so context exhaustion,
+/// completion ordering and scaling with the number of contexts behave like the GPU path. It reads
+/// the inputs at retrieval, not at submission, so a caller that reuses them while the inference
+/// is in flight gets wrong results here as it would on the GPU.
+class CpuInferenceBackend : public InferenceBackend
+{
+public:
+    /// @brief Loads the binding metadata and simulation settings from a descriptor file.
+    /// @throws std::runtime_error if the descriptor cannot be read or is invalid.
+    explicit CpuInferenceBackend(const std::string& descriptor_path);
+
+    /// @brief Creates the backend from an in-memory configuration.
+    /// @throws std::runtime_error if the configuration is invalid.
+    explicit CpuInferenceBackend(const CpuBackendConfig& config);
+
+    ~CpuInferenceBackend() override = default;
+
+    HostBufferPool& get_host_buffer_pool() const noexcept override { return malloc_host_pool(); }
+
+    /// @brief Get the active configuration.
+    const CpuBackendConfig& get_config() const noexcept { return this->config_; }
+
+    /// @brief Reads and parses a descriptor file.
+    /// @throws std::runtime_error if the file cannot be opened or is malformed.
+    static CpuBackendConfig load_descriptor(const std::string& descriptor_path);
+
+    /// @brief Parses a descriptor (see class documentation).
+    /// @throws std::runtime_error on a malformed line.
+    static CpuBackendConfig parse_descriptor(std::istream& in);
+
+    /// @brief Configuration matching the NMS-embedded YOLO model used by TRT::YOLO
+    /// (images f32 [1,3,640,640] -> num_dets i32 [1,1], bboxes f32 [1,100,4], scores f32 [1,100],
+    /// labels i32 [1,100]).
+    static CpuBackendConfig yolo_nms_config();
+
+protected:
+
+    bool execute_on_context(int context, const std::vector<void*> &input_buf,
+        const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf,
+        const std::vector<size_t> &size_out_param, const std::vector<TensorShape> *input_shapes,
+        std::vector<TensorShape> *output_shapes) override;
+
+    bool enqueue_on_context(int context, const std::vector<void*> &input_buf,
+        const std::vector<size_t> &size_in_param) override;
+
+    AsyncInferStatus collect_from_context(int context, const std::vector<void*> &output_buf,
+        const std::vector<size_t> &size_out_param, bool wait) override;
+
+private:
+
+    CpuBackendConfig config_;
+
+    // Output shapes as declared (with -1 for dynamic dimensions).
+    std::vector<TensorShape> declared_output_shapes_;
+
+    /// @brief Inputs and staged results of the async inference enqueued on one context.
+    struct ContextSlot
+    {
+        std::vector<void*> inputs;        // The caller's input buffers, read at retrieval
+        std::vector<size_t> input_sizes;
+        std::vector<size_t> shaped_input_bytes; // Input bytes covered by the shapes of a synchronous call
+        std::vector<std::vector<uint8_t>> outputs;
+        std::vector<void*> output_ptrs; // outputs[i].data()
+        std::chrono::steady_clock::time_point ready_at;
+    };
+
+    std::vector<ContextSlot> slots_; // Indexed by the InferenceBackend context index
+
+    // Time at which each lane of the simulated device finishes its last queued request.
+    std::mutex device_mutex_;
+    std::vector<std::chrono::steady_clock::time_point> lane_free_at_;
+
+    /// @brief Queues one request of frames frames on the first lane of the simulated device to free up.
+    /// @return The time at which that request completes.
+    std::chrono::steady_clock::time_point reserve_device_time(int frames);
+
+    /// @brief Populates the InferenceBackend metadata from config_.
+    void calculate_model_parameters();
+
+    /// @brief Selects the optimization profile and fills input_profile_ / input_shapes_.
+    void select_input_profile(const std::vector<TensorShape>& declared_input_shapes);
+
+    /// @brief Output shapes for the given input shapes (dynamic dimensions follow the first input).
+    void calculate_output_shapes(const std::vector<TensorShape>& input_shapes,
+        std::vector<TensorShape>& output_shapes) const;
+
+    /// @brief Derives a seed from the configured seed and a sparse sample of the input of one frame.
+    /// @param frame, num_frames Frame whose share of each input buffer is sampled
+    uint32_t input_seed(const std::vector<void*> &input_buf, const std::vector<size_t> &size_in_param,
+        int frame, int num_frames) const;
+
+    /// @brief Writes the synthetic value of every output, per frame of a batch.
+    /// @param input_bytes Bytes of each input holding data (all frames)
+    void fill_outputs(const std::vector<void*> &output_buf, const std::vector<void*> &input_buf,
+        const std::vector<size_t> &input_bytes, const std::vector<TensorShape>& output_shapes,
+        const TensorShape& image) const;
+
+    /// @brief Writes the synthetic value of output i (one frame of it, if it is batched) into buf.
+    /// @param output_shapes Actual shapes of every output (bounds the number of detections).
+    /// @param image Actual shape of the first input (boxes are placed inside its spatial extent).
+    /// @param batch Batch of the first input
+    void fill_output(int i, void* buf, uint32_t seed, const std::vector<TensorShape>& output_shapes,
+        const TensorShape& image, int batch) const;
+
+    /// @brief Get the number of frames output shape holds: batch if its leading dimension is the input batch, else 1.
+    static int output_batch(const TensorShape& shape, int batch) noexcept
+    {
+        return batch > 1 && shape.size() > 1 && shape[0] == batch ? batch : 1;
+    }
+};
@@ -0,0 +1,30 @@
+#include "TRT_device_arena.hpp"
+
+#include <stdexcept>
+#include <string>
+
+ArenaPlan plan_arena(const std::vector<size_t>& sizes, size_t alignment)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        throw std::invalid_argument("Arena alignment must be a power of two, got " + std::to_string(alignment));
+    }
+
+    ArenaPlan plan;
+    plan.alignment = alignment;
+    plan.sizes = sizes;
+    plan.offsets.reserve(sizes.size());
+
+    size_t cursor = 0;
+    for (size_t size : sizes)
+    {
+        cursor = (cursor + alignment - 1) & ~(alignment - 1);
+        plan.offsets.push_back(cursor);
+        cursor += size;
+        plan.payload_bytes += size;
+    }
+
+    // Round the tail up too, so arenas can be placed back to back.
+    plan.total_bytes = (cursor + alignment - 1) & ~(alignment - 1);
+    return plan;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// @brief Layout of several buffers packed into one contiguous allocation.
+struct ArenaPlan
+{
+    std::vector<size_t> offsets;  // Offset (bytes) of each block from the arena base
+    std::vector<size_t> sizes;    // Requested size (bytes) of each block
+    size_t alignment = 0;
+    size_t total_bytes = 0;       // Size of the single allocation backing the arena
+    size_t payload_bytes = 0;     // Sum of the requested sizes
+
+    /// @brief Bytes lost to alignment padding.
+    size_t padding_bytes() const noexcept { return this->total_bytes - this->payload_bytes; }
+
+    /// @brief Address of block i inside an arena starting at base.
+    void* block(void* base, size_t i) const noexcept
+    {
+        return static_cast<char*>(base) + this->offsets[i];
+    }
+};
+
+/// @brief Default alignment of arena blocks. Matches the cudaMalloc guarantee, which
+/// TensorRT requires of every I/O tensor and of activation memory.
+constexpr size_t DEVICE_ARENA_ALIGNMENT = 256;
+
+/// @brief Plans the offsets of blocks placed back to back, each aligned to alignment.
+/// Zero-sized blocks get a valid (aligned) offset but occupy no space.
+/// Pure host-side arithmetic - does not allocate device memory.
+/// @param sizes Size (bytes) of each block, in placement order.
+/// @param alignment Alignment (bytes) of every block; must be a power of two.
+/// @throws std::invalid_argument if alignment is not a power of two.
+ArenaPlan plan_arena(const std::vector<size_t>& sizes, size_t alignment = DEVICE_ARENA_ALIGNMENT);
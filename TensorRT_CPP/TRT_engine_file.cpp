@@ -0,0 +1,93 @@
+#include "TRT_engine_file.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+EngineFile::EngineFile(const std::string& path, const EngineLoadOptions& options)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::runtime_error("[TRT_ENGINE] Cannot open engine file " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0)
+    {
+        const std::string reason = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("[TRT_ENGINE] Cannot stat engine file " + path + ": " + reason);
+    }
+    if (!S_ISREG(info.st_mode))
+    {
+        ::close(fd);
+        throw std::runtime_error("[TRT_ENGINE] Engine path is not a regular file: " + path);
+    }
+    if (info.st_size == 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("[TRT_ENGINE] Engine file is empty: " + path);
+    }
+    this->size_ = static_cast<size_t>(info.st_size);
+
+    if (options.use_mmap)
+    {
+        int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        if (options.populate)
+        {
+            flags |= MAP_POPULATE;
+        }
+#endif
+        void* map = ::mmap(nullptr, this->size_, PROT_READ, flags, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            // The deserializer walks the blob front to back, once.
+            ::madvise(map, this->size_, MADV_SEQUENTIAL);
+            ::madvise(map, this->size_, MADV_WILLNEED);
+            this->map_ = map;
+        }
+        else
+        {
+            std::cerr << "[TRT_ENGINE] mmap failed (" << std::strerror(errno) 
+                      << "), falling back to a buffered read." << std::endl;
+        }
+    }
+    ::close(fd); // The mapping keeps its own reference to the file.
+
+    if (!this->map_)
+    {
+        this->read_into_buffer(path);
+    }
+}
+
+EngineFile::~EngineFile()
+{
+    if (this->map_)
+    {
+        ::munmap(this->map_, this->size_);
+    }
+}
+
+void EngineFile::read_into_buffer(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("[TRT_ENGINE] Cannot open engine file " + path);
+    }
+    this->buffer_.resize(this->size_);
+    if (!file.read(this->buffer_.data(), static_cast<std::streamsize>(this->size_)))
+    {
+        throw std::runtime_error("[TRT_ENGINE] Short read on engine file " + path + ": got " 
+            + std::to_string(file.gcount()) + " of " + std::to_string(this->size_) + " bytes");
+    }
+}
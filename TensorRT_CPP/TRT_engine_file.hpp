@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// @brief Options controlling how a serialized .engine file is read.
+struct EngineLoadOptions
+{
+    /// @brief Map the file instead of copying it into a heap buffer.
+    bool use_mmap = true;
+
+    /// @brief Pre-fault every page during mapping (MAP_POPULATE), so that deserialization
+    /// never stalls on storage. Costs the full read up front.
+    bool populate = false;
+
+    /// @brief Batch size the optimization profile of a dynamic-shape engine is selected for
+    /// (see select_profile()). 0 selects profile 0. Ignored for static engines.
+    int batch_size = 0;
+};
+
+/// @brief Timing breakdown of TrtInferenceEngine::load_engine().
+struct EngineLoadStats
+{
+    size_t file_bytes = 0;
+    bool mapped = false;        // TRUE if the file was memory-mapped rather than read.
+    double read_ms = 0.0;       // Open + map (or open + read). Without populate, page faults land in deserialize_ms.
+    double deserialize_ms = 0.0;
+    double context_ms = 0.0;    // Creation of the execution context(s).
+};
+
+/// @brief Read-only view of a serialized engine file.
+/// By default the file is memory-mapped with MADV_SEQUENTIAL | MADV_WILLNEED hints, so the
+/// deserializer reads straight from the page cache without a second host-side copy.
+/// Falls back to reading into a heap buffer when mapping is disabled or unsupported.
+class EngineFile
+{
+public:
+    /// @brief Opens (and maps or reads) the file.
+    /// @throws std::runtime_error if the file is missing, empty or cannot be read.
+    EngineFile(const std::string& path, const EngineLoadOptions& options = EngineLoadOptions());
+
+    ~EngineFile();
+
+    EngineFile(const EngineFile&) = delete;
+    EngineFile& operator=(const EngineFile&) = delete;
+
+    /// @brief Get a pointer to the file contents
+    const void* data() const noexcept { return this->map_ ? this->map_ : this->buffer_.data(); }
+
+    /// @brief Get the file size (bytes)
+    size_t size() const noexcept { return this->size_; }
+
+    /// @brief TRUE if the contents are memory-mapped
+    bool is_mapped() const noexcept { return this->map_ != nullptr; }
+
+private:
+    void* map_ = nullptr;
+    size_t size_ = 0;
+    std::vector<char> buffer_; // Only used when not mapped.
+
+    /// @brief Reads the file through a stream into buffer_.
+    void read_into_buffer(const std::string& path);
+};
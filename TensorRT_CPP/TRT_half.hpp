@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+/// @brief Converts a float to IEEE 754 binary16 bits (round to nearest even; overflow -> inf, NaN kept).
+inline uint16_t float_to_half(float value) noexcept
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const uint32_t abs = bits & 0x7FFFFFFFu;
+
+    if (abs >= 0x7F800000u) // Inf / NaN
+    {
+        return sign | 0x7C00u | (abs > 0x7F800000u ? 0x0200u | ((abs >> 13) & 0x03FFu) : 0u);
+    }
+    if (abs >= 0x477FF000u) // Rounds past 65504
+    {
+        return sign | 0x7C00u;
+    }
+    if (abs < 0x38800000u) // Below the smallest normal half: subnormal or zero
+    {
+        if (abs < 0x33000000u)
+        {
+            return sign;
+        }
+        const uint32_t mantissa = (abs & 0x007FFFFFu) | 0x00800000u;
+        const uint32_t shift = 126u - (abs >> 23);
+        const uint32_t result = mantissa >> shift;
+        const uint32_t rest = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1u);
+        return sign | static_cast<uint16_t>(result + (rest > halfway || (rest == halfway && (result & 1u))));
+    }
+
+    // Normal: rebias the exponent (127 -> 15) and round the 13 dropped mantissa bits.
+    const uint32_t result = (abs - 0x38000000u) >> 13;
+    const uint32_t rest = abs & 0x1FFFu;
+    return sign | static_cast<uint16_t>(result + (rest > 0x1000u || (rest == 0x1000u && (result & 1u))));
+}
+
+/// @brief Converts IEEE 754 binary16 bits to a float (exact; NaNs keep their payload and come back quiet, as the
+/// F16C / ARM conversions return them).
+inline float half_to_float(uint16_t half) noexcept
+{
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    uint32_t exponent = (half >> 10) & 0x1Fu;
+    uint32_t mantissa = half & 0x03FFu;
+
+    uint32_t bits;
+    if (exponent == 0x1Fu) // Inf / NaN
+    {
+        bits = sign | 0x7F800000u | (mantissa << 13) | (mantissa != 0 ? 0x00400000u : 0u);
+    }
+    else if (exponent != 0)
+    {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+    else if (mantissa == 0)
+    {
+        bits = sign;
+    }
+    else // Subnormal: normalize
+    {
+        exponent = 113u;
+        while (!(mantissa & 0x0400u))
+        {
+            mantissa <<= 1;
+            exponent--;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x03FFu) << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
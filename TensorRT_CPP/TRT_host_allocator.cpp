@@ -0,0 +1,139 @@
+#include "TRT_host_allocator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+void* MallocHostAllocator::allocate(size_t bytes)
+{
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, 64, bytes) != 0)
+    {
+        return nullptr;
+    }
+    return ptr;
+}
+
+void MallocHostAllocator::deallocate(void* ptr, size_t /*bytes*/)
+{
+    free(ptr);
+}
+
+HostBufferPool::HostBufferPool(std::unique_ptr<HostAllocator> upstream, size_t min_class_bytes)
+    : upstream_(std::move(upstream)), min_class_bytes_(std::max<size_t>(min_class_bytes, 64))
+{
+}
+
+HostBufferPool::~HostBufferPool()
+{
+    this->trim();
+    if (!this->in_use_.empty())
+    {
+        std::cerr << "[HOST_POOL] " << this->in_use_.size() << " " << this->upstream_->name()
+                  << " buffers still acquired at pool destruction (" << this->stats_.bytes_in_use
+                  << " bytes) - leaking them." << std::endl;
+    }
+}
+
+size_t HostBufferPool::size_class(size_t bytes) const noexcept
+{
+    if (bytes <= this->min_class_bytes_)
+    {
+        return this->min_class_bytes_;
+    }
+
+    // Four classes per power of two: round up to a multiple of (highest power of two) / 4.
+    size_t power = this->min_class_bytes_;
+    while (power * 2 <= bytes)
+    {
+        power *= 2;
+    }
+    const size_t step = std::max<size_t>(power / 4, 1);
+    return (bytes + step - 1) / step * step;
+}
+
+void* HostBufferPool::acquire(size_t bytes)
+{
+    const size_t size = this->size_class(bytes);
+    std::lock_guard<std::mutex> lock(this->mutex_);
+
+    void* ptr = nullptr;
+    auto cached = this->free_lists_.find(size);
+    if (cached != this->free_lists_.end() && !cached->second.empty())
+    {
+        ptr = cached->second.back();
+        cached->second.pop_back();
+        this->stats_.bytes_cached -= size;
+        this->stats_.reuses++;
+    }
+    else
+    {
+        ptr = this->upstream_->allocate(size);
+        if (!ptr)
+        {
+            std::cerr << "[HOST_POOL] Failed to allocate " << size << " bytes of "
+                      << this->upstream_->name() << " memory" << std::endl;
+            return nullptr;
+        }
+        this->stats_.upstream_allocations++;
+        this->stats_.upstream_bytes += size;
+    }
+
+    this->in_use_[ptr] = size;
+    this->stats_.acquisitions++;
+    this->stats_.bytes_in_use += size;
+    this->stats_.peak_bytes_in_use = std::max(this->stats_.peak_bytes_in_use, this->stats_.bytes_in_use);
+    return ptr;
+}
+
+void HostBufferPool::release(void* ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    auto it = this->in_use_.find(ptr);
+    if (it == this->in_use_.end())
+    {
+        std::cerr << "[HOST_POOL] Ignoring release of a buffer not acquired from this pool" << std::endl;
+        return;
+    }
+
+    const size_t size = it->second;
+    this->in_use_.erase(it);
+    this->free_lists_[size].push_back(ptr);
+    this->stats_.releases++;
+    this->stats_.bytes_in_use -= size;
+    this->stats_.bytes_cached += size;
+}
+
+void HostBufferPool::trim()
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    for (auto& entry : this->free_lists_)
+    {
+        for (void* ptr : entry.second)
+        {
+            this->upstream_->deallocate(ptr, entry.first);
+            this->stats_.upstream_bytes -= entry.first;
+        }
+    }
+    this->free_lists_.clear();
+    this->stats_.bytes_cached = 0;
+}
+
+HostBufferPoolStats HostBufferPool::get_stats() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->stats_;
+}
+
+HostBufferPool& malloc_host_pool()
+{
+    // Intentionally never destroyed, like pinned_host_pool(): objects holding its buffers (such as the model of
+    // load_model(), when unload_model() is never called) may be destroyed after a function-local static pool.
+    static HostBufferPool* pool = new HostBufferPool(std::make_unique<MallocHostAllocator>());
+    return *pool;
+}
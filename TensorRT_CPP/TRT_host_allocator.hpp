@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Source of host memory for a HostBufferPool.
+class HostAllocator
+{
+public:
+    virtual ~HostAllocator() = default;
+
+    /// @brief Allocates bytes of host memory.
+    /// @return The allocation, or nullptr on failure.
+    virtual void* allocate(size_t bytes) = 0;
+
+    /// @brief Frees memory returned by allocate(bytes).
+    virtual void deallocate(void* ptr, size_t bytes) = 0;
+
+    /// @brief Short name used in log messages.
+    virtual const char* name() const noexcept = 0;
+};
+
+/// @brief Pageable, 64-byte aligned host memory. Works without CUDA.
+class MallocHostAllocator : public HostAllocator
+{
+public:
+    void* allocate(size_t bytes) override;
+    void deallocate(void* ptr, size_t bytes) override;
+    const char* name() const noexcept override { return "malloc"; }
+};
+
+/// @brief Page-locked host memory from cudaHostAlloc, so host<->device copies are DMA'd directly
+/// (no driver bounce buffer) and cudaMemcpyAsync is truly asynchronous.
+/// Defined in TRT_pinned_host_allocator.cpp - CUDA builds only.
+class PinnedHostAllocator : public HostAllocator
+{
+public:
+    void* allocate(size_t bytes) override;
+    void deallocate(void* ptr, size_t bytes) override;
+    const char* name() const noexcept override { return "pinned"; }
+};
+
+/// @brief Counters of a HostBufferPool.
+struct HostBufferPoolStats
+{
+    size_t upstream_allocations = 0; // Buffers obtained from the upstream allocator
+    size_t upstream_bytes = 0;       // Bytes currently held from the upstream allocator
+    size_t reuses = 0;               // Acquisitions served from a cached buffer
+    size_t acquisitions = 0;
+    size_t releases = 0;
+    size_t bytes_in_use = 0;         // Size-class bytes currently handed out
+    size_t bytes_cached = 0;         // Size-class bytes waiting for reuse
+    size_t peak_bytes_in_use = 0;
+};
+
+/// @brief Pool of reusable host staging buffers.
+/// Requests are rounded up to a size class (four classes per power of two, so at most 25% slack),
+/// and released buffers are cached per class instead of being returned to the upstream allocator.
+/// Reloading a model of the same geometry therefore reuses the buffers of the previous load.
+/// Thread-safe.
+class HostBufferPool
+{
+public:
+    /// @param upstream Where new buffers come from.
+    /// @param min_class_bytes Smallest size class (bytes).
+    explicit HostBufferPool(std::unique_ptr<HostAllocator> upstream, size_t min_class_bytes = 4096);
+
+    /// @brief Frees every cached buffer. Buffers still acquired at this point are leaked (and reported).
+    ~HostBufferPool();
+
+    HostBufferPool(const HostBufferPool&) = delete;
+    HostBufferPool& operator=(const HostBufferPool&) = delete;
+
+    /// @brief Hands out a buffer of at least bytes.
+    /// @return The buffer, or nullptr if the upstream allocation failed.
+    void* acquire(size_t bytes);
+
+    /// @brief Returns a buffer obtained from acquire() to the pool. nullptr is ignored.
+    void release(void* ptr);
+
+    /// @brief Frees every cached (not acquired) buffer back to the upstream allocator.
+    void trim();
+
+    /// @brief Get a snapshot of the pool counters
+    HostBufferPoolStats get_stats() const;
+
+    /// @brief Get the upstream allocator name
+    const char* get_allocator_name() const noexcept { return this->upstream_->name(); }
+
+    /// @brief Size class that a request of bytes is rounded up to.
+    size_t size_class(size_t bytes) const noexcept;
+
+private:
+    mutable std::mutex mutex_;
+    std::unique_ptr<HostAllocator> upstream_;
+    size_t min_class_bytes_;
+
+    std::map<size_t, std::vector<void*>> free_lists_;  // Size class -> cached buffers
+    std::unordered_map<void*, size_t> in_use_;          // Acquired buffer -> size class
+    HostBufferPoolStats stats_;
+};
+
+/// @brief Process-wide pool backed by MallocHostAllocator. Never destroyed, so releases stay valid during exit.
+HostBufferPool& malloc_host_pool();
+
+/// @brief Process-wide pool backed by PinnedHostAllocator. Never destroyed, like malloc_host_pool().
+/// Defined in TRT_pinned_host_allocator.cpp - CUDA builds only.
+HostBufferPool& pinned_host_pool();
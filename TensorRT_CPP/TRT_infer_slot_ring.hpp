@@ -0,0 +1,162 @@
+#pragma once
+
+#include "TRT_context_pool.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/// @brief Handle to an inference submitted with InferenceBackend::infer_async().
+using InferTicket = uint64_t;
+
+/// @brief Ticket value that never refers to a submitted inference.
+constexpr InferTicket INVALID_INFER_TICKET = 0;
+
+/// @brief Result of InferenceBackend::retrieve_infer_result_async().
+enum class AsyncInferStatus
+{
+    kReady,         // Results were copied to the output buffers; the ticket is now spent.
+    kPending,       // Still in flight (only returned when not waiting); retry later.
+    kInvalidTicket, // Unknown or already retrieved ticket, or one another thread is retrieving.
+    kFailed         // Inference failed (the ticket is now spent),
+                    // or the output buffers were rejected (the ticket stays valid).
+};
+
+/// @brief Tracks the in-flight async inferences of a ContextPool.
+/// Each submission leases a free context (without waiting) and receives a unique, monotonically
+/// increasing ticket. The context stays leased until its ticket is released, so at most
+/// num_slots() inferences can be in flight, and synchronous callers of the same pool wait
+/// while async work occupies every context. Further submissions fail until a result is retrieved.
+/// A retriever claims its ticket first, so one ticket is never collected by two threads at once.
+/// Thread-safe.
+class InferSlotRing
+{
+public:
+    explicit InferSlotRing(ContextPool& pool)
+        : pool_(pool), slot_tickets_(pool.size(), INVALID_INFER_TICKET), slot_claimed_(pool.size(), 0),
+          slot_leases_(pool.size())
+    {
+    }
+
+    /// @brief Get the total number of slots.
+    int num_slots() const noexcept { return this->pool_.size(); }
+
+    /// @brief Leases the next free context of the pool.
+    /// @param ticket Receives the ticket of the reservation.
+    /// @return Slot (context) index, or -1 if every context is busy.
+    int acquire(InferTicket& ticket)
+    {
+        ContextLease lease = this->pool_.try_lease();
+        if (!lease)
+        {
+            ticket = INVALID_INFER_TICKET;
+            return -1;
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        const int slot = lease.index();
+        ticket = this->next_ticket_++;
+        this->slot_tickets_[slot] = ticket;
+        this->slot_claimed_[slot] = 0;
+        this->slot_leases_[slot] = std::move(lease);
+        return slot;
+    }
+
+    /// @brief Claims the slot reserved by a ticket for retrieval: until the ticket is released or unclaimed,
+    /// further claims of it fail.
+    /// @return Slot index, or -1 if the ticket is not in flight or already claimed.
+    int claim(InferTicket ticket)
+    {
+        if (ticket == INVALID_INFER_TICKET)
+        {
+            return -1;
+        }
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        for (int i = 0; i < this->num_slots(); i++)
+        {
+            if (this->slot_tickets_[i] == ticket)
+            {
+                if (this->slot_claimed_[i])
+                {
+                    return -1;
+                }
+                this->slot_claimed_[i] = 1;
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /// @brief Withdraws the claim on a ticket that stays in flight (e.g. still pending). Unknown tickets are ignored.
+    void unclaim(InferTicket ticket)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        for (int i = 0; i < this->num_slots(); i++)
+        {
+            if (this->slot_tickets_[i] == ticket)
+            {
+                this->slot_claimed_[i] = 0;
+                break;
+            }
+        }
+    }
+
+    /// @brief Looks up the slot reserved by a ticket.
+    /// @return Slot index, or -1 if the ticket is not in flight.
+    int find(InferTicket ticket) const
+    {
+        if (ticket == INVALID_INFER_TICKET)
+        {
+            return -1;
+        }
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        for (int i = 0; i < this->num_slots(); i++)
+        {
+            if (this->slot_tickets_[i] == ticket)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /// @brief Returns the context reserved by a ticket to the pool. Unknown tickets are ignored.
+    void release(InferTicket ticket)
+    {
+        ContextLease lease;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            for (int i = 0; i < this->num_slots(); i++)
+            {
+                if (this->slot_tickets_[i] == ticket)
+                {
+                    this->slot_tickets_[i] = INVALID_INFER_TICKET;
+                    this->slot_claimed_[i] = 0;
+                    lease = std::move(this->slot_leases_[i]);
+                    break;
+                }
+            }
+        }
+        // lease goes back to the pool here, outside mutex_.
+    }
+
+    /// @brief Get the number of slots currently reserved.
+    int in_flight() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        int count = 0;
+        for (auto slot_ticket : this->slot_tickets_)
+        {
+            count += (slot_ticket != INVALID_INFER_TICKET);
+        }
+        return count;
+    }
+
+private:
+    ContextPool& pool_;
+    mutable std::mutex mutex_;
+    std::vector<InferTicket> slot_tickets_; // Ticket occupying each slot, INVALID_INFER_TICKET if free.
+    std::vector<uint8_t> slot_claimed_;     // 1 while a retriever collects the slot's ticket.
+    std::vector<ContextLease> slot_leases_;
+    InferTicket next_ticket_ = INVALID_INFER_TICKET + 1;
+};
@@ -0,0 +1,252 @@
+#include "TRT_inference_backend.hpp"
+
+#include <cstring>
+#include <iostream>
+
+bool InferenceBackend::infer_b(const std::vector<void*> &input_buf, const std::vector<size_t> &size_in_param,
+    const std::vector<void*> &output_buf, const std::vector<size_t> &size_out_param)
+{
+    if (!this->validate_buffers(input_buf, size_in_param, output_buf, size_out_param))
+    {
+        std::cerr << "[TRT_BACKEND] Inference aborted - invalid I/O buffers." << std::endl;
+        return false;
+    }
+
+    const ContextLease lease = this->context_pool_.lease();
+    return this->execute_on_context(lease.index(), input_buf, size_in_param, output_buf, size_out_param,
+        nullptr, nullptr);
+}
+
+bool InferenceBackend::infer_b(const ContextLease &lease, const std::vector<void*> &input_buf,
+    const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf,
+    const std::vector<size_t> &size_out_param)
+{
+    if (!this->context_pool_.owns(lease))
+    {
+        std::cerr << "[TRT_BACKEND] Inference aborted - lease does not hold a context of this backend." << std::endl;
+        return false;
+    }
+    if (!this->validate_buffers(input_buf, size_in_param, output_buf, size_out_param))
+    {
+        std::cerr << "[TRT_BACKEND] Inference aborted - invalid I/O buffers." << std::endl;
+        return false;
+    }
+
+    return this->execute_on_context(lease.index(), input_buf, size_in_param, output_buf, size_out_param,
+        nullptr, nullptr);
+}
+
+bool InferenceBackend::infer_b(const std::vector<void*> &input_buf, const std::vector<size_t> &size_in_param,
+    const std::vector<void*> &output_buf, const std::vector<size_t> &size_out_param,
+    const std::vector<TensorShape> &input_shapes, std::vector<TensorShape> &output_shapes)
+{
+    // output_shapes keeps its storage across calls (the implementations assign into it).
+    const bool inputs_valid = this->validate_input_shapes(input_buf, size_in_param, input_shapes);
+    const bool outputs_valid = this->validate_outputs(output_buf, size_out_param);
+    if (!inputs_valid || !outputs_valid)
+    {
+        output_shapes.clear();
+        std::cerr << "[TRT_BACKEND] Inference aborted - invalid I/O buffers or shapes." << std::endl;
+        return false;
+    }
+
+    const ContextLease lease = this->context_pool_.lease();
+    return this->execute_on_context(lease.index(), input_buf, size_in_param, output_buf, size_out_param,
+        &input_shapes, &output_shapes);
+}
+
+bool InferenceBackend::infer_async(const std::vector<void*> &input_buf, const std::vector<size_t> &size_in_param,
+    InferTicket &ticket)
+{
+    ticket = INVALID_INFER_TICKET;
+    if (!this->validate_inputs(input_buf, size_in_param))
+    {
+        std::cerr << "[TRT_BACKEND] Async inference aborted - invalid input buffers." << std::endl;
+        return false;
+    }
+
+    const int context = this->async_ring_.acquire(ticket);
+    if (context < 0)
+    {
+        std::cerr << "[TRT_BACKEND] All " << this->async_ring_.num_slots()
+                  << " execution contexts are busy - retrieve a result first." << std::endl;
+        return false;
+    }
+
+    if (!this->enqueue_on_context(context, input_buf, size_in_param))
+    {
+        std::cerr << "[TRT_BACKEND] Failed to enqueue async inference on context " << context << std::endl;
+        this->async_ring_.release(ticket);
+        ticket = INVALID_INFER_TICKET;
+        return false;
+    }
+    return true;
+}
+
+AsyncInferStatus InferenceBackend::retrieve_infer_result_async(InferTicket ticket,
+    const std::vector<void*> &output_buf, const std::vector<size_t> &size_out_param, bool wait)
+{
+    // Claimed under the ring's mutex, so a second retriever of the same ticket cannot collect it too.
+    const int context = this->async_ring_.claim(ticket);
+    if (context < 0)
+    {
+        return AsyncInferStatus::kInvalidTicket;
+    }
+    if (!this->validate_outputs(output_buf, size_out_param))
+    {
+        std::cerr << "[TRT_BACKEND] Async retrieval rejected - invalid output buffers." << std::endl;
+        this->async_ring_.unclaim(ticket);
+        return AsyncInferStatus::kFailed;
+    }
+
+    const AsyncInferStatus status = this->collect_from_context(context, output_buf, size_out_param, wait);
+    if (status != AsyncInferStatus::kPending)
+    {
+        this->async_ring_.release(ticket);
+    }
+    else
+    {
+        this->async_ring_.unclaim(ticket);
+    }
+    return status;
+}
+
+bool InferenceBackend::set_counted_outputs(const std::vector<CountedOutputs>& mapping)
+{
+    std::string error;
+    if (!this->valid_rows_.build(mapping, this->output_descs_, error))
+    {
+        std::cerr << "[TRT_BACKEND] Valid-rows-only copies disabled - " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+size_t InferenceBackend::copy_valid_rows(const std::vector<void*>& staged, const std::vector<void*>& output_buf,
+    const std::vector<size_t>& size_out_param) const
+{
+    size_t copied = 0;
+    for (int i = 0; i < this->num_outputs_; i++)
+    {
+        // Counts are read from the staged copy, so the copy order does not matter.
+        size_t bytes = size_out_param[i];
+        const int count = this->valid_rows_.count_output(i);
+        if (count >= 0)
+        {
+            bytes = this->valid_rows_.valid_bytes(i, staged[count], bytes);
+        }
+        std::memcpy(output_buf[i], staged[i], bytes);
+        copied += bytes;
+    }
+    return copied;
+}
+
+bool InferenceBackend::validate_inputs(const std::vector<void*>& input_bufs,
+    const std::vector<size_t>& input_sizes) const
+{
+    // Check counts match
+    if (input_bufs.size() != static_cast<size_t>(this->num_inputs_) || input_sizes.size() != input_bufs.size())
+    {
+        std::cerr << "[TRT_BACKEND] Buffer count mismatch\n"
+                  << "Expected " << this->num_inputs_ << " inputs, got " << input_bufs.size()
+                  << " (" << input_sizes.size() << " sizes)" << std::endl;
+        return false;
+    }
+
+    // Check sizes match
+    const auto& expected_input_sizes = this->get_input_size_bytes();
+    bool valid = true;
+    for (int i = 0; i < this->num_inputs_; ++i) {
+        if (!input_bufs[i]) {
+            std::cerr << "[TRT_BACKEND] Null input buffer at index " << i << std::endl;
+            valid = false;
+        }
+        if (input_sizes[i] != expected_input_sizes[i]) {
+            std::cerr << "[TRT_BACKEND] Input " << i << " size mismatch\n"
+                      << "Expected " << expected_input_sizes[i] << " bytes, got "
+                      << input_sizes[i] << std::endl;
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+bool InferenceBackend::validate_input_shapes(const std::vector<void*>& input_bufs,
+    const std::vector<size_t>& input_sizes, const std::vector<TensorShape>& input_shapes) const
+{
+    // Check counts match
+    if (input_bufs.size() != static_cast<size_t>(this->num_inputs_) || input_sizes.size() != input_bufs.size()
+        || input_shapes.size() != input_bufs.size())
+    {
+        std::cerr << "[TRT_BACKEND] Buffer count mismatch\n"
+                  << "Expected " << this->num_inputs_ << " inputs, got " << input_bufs.size()
+                  << " (" << input_sizes.size() << " sizes, " << input_shapes.size() << " shapes)" << std::endl;
+        return false;
+    }
+
+    // Check each shape is within the profile, and each buffer holds it
+    bool valid = true;
+    for (int i = 0; i < this->num_inputs_; ++i) {
+        const ProfileShapes& range = this->input_profile_[i];
+        if (!input_bufs[i]) {
+            std::cerr << "[TRT_BACKEND] Null input buffer at index " << i << std::endl;
+            valid = false;
+        }
+        if (!shape_within(input_shapes[i], range.min, range.max)) {
+            std::cerr << "[TRT_BACKEND] Input " << i << " shape " << shape_to_string(input_shapes[i])
+                      << " outside profile " << this->profile_index_ << " range "
+                      << shape_to_string(range.min) << " .. " << shape_to_string(range.max) << std::endl;
+            valid = false;
+            continue;
+        }
+        const size_t needed = tensor_size_bytes(this->input_descs_[i], input_shapes[i]);
+        if (input_sizes[i] < needed) {
+            std::cerr << "[TRT_BACKEND] Input " << i << " too small for shape " << shape_to_string(input_shapes[i])
+                      << "\nExpected at least " << needed << " bytes, got " << input_sizes[i] << std::endl;
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+bool InferenceBackend::validate_outputs(const std::vector<void*>& output_bufs,
+    const std::vector<size_t>& output_sizes) const
+{
+    // Check counts match
+    if (output_bufs.size() != static_cast<size_t>(this->num_outputs_) || output_sizes.size() != output_bufs.size())
+    {
+        std::cerr << "[TRT_BACKEND] Buffer count mismatch\n"
+                  << "Expected " << this->num_outputs_ << " outputs, got " << output_bufs.size()
+                  << " (" << output_sizes.size() << " sizes)" << std::endl;
+        return false;
+    }
+
+    // Check sizes match
+    const auto& expected_output_sizes = this->get_output_size_bytes();
+    bool valid = true;
+    for (int i = 0; i < this->num_outputs_; ++i) {
+        if (!output_bufs[i]) {
+            std::cerr << "[TRT_BACKEND] Null output buffer at index " << i << std::endl;
+            valid = false;
+        }
+        if (output_sizes[i] != expected_output_sizes[i]) {
+            std::cerr << "[TRT_BACKEND] Output " << i << " size mismatch\n"
+                      << "Expected " << expected_output_sizes[i] << " bytes, got "
+                      << output_sizes[i] << std::endl;
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+bool InferenceBackend::validate_buffers(
+    const std::vector<void*>& input_bufs,
+    const std::vector<size_t>& input_sizes,
+    const std::vector<void*>& output_bufs,
+    const std::vector<size_t>& output_sizes) const
+{
+    // Evaluate both so that every problem is reported at once.
+    const bool inputs_valid = this->validate_inputs(input_bufs, input_sizes);
+    const bool outputs_valid = this->validate_outputs(output_bufs, output_sizes);
+    return inputs_valid && outputs_valid;
+}
@@ -0,0 +1,362 @@
+#pragma once
+
+#include "TRT_infer_slot_ring.hpp"
+#include "TRT_host_allocator.hpp"
+#include "TRT_tensor_desc.hpp"
+#include "TRT_valid_rows.hpp"
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+/// @brief Abstract inference backend.
+/// Holds the binding metadata (counts, shapes, names, element counts) shared by every
+/// implementation, and a pool of execution contexts that inference calls lease from.
+/// The public inference entry points validate buffers and manage context leases / async tickets;
+/// implementations only provide the per-context execute / enqueue / collect primitives.
+/// Implementations: TrtInferenceEngine (TensorRT + CUDA) and CpuInferenceBackend (GPU-less stand-in).
+class InferenceBackend
+{
+public:
+    /// @param num_contexts Number of execution contexts, i.e. the maximum number of concurrent
+    /// (synchronous + in-flight async) inferences.
+    explicit InferenceBackend(int num_contexts)
+        : context_pool_(num_contexts), async_ring_(context_pool_)
+    {
+    }
+
+    virtual ~InferenceBackend() = default;
+
+    InferenceBackend(const InferenceBackend&) = delete;
+    InferenceBackend& operator=(const InferenceBackend&) = delete;
+
+    /// @brief Performs inference using the loaded model. The input/output must be sized appropriately.
+    /// Recommended to pre-allocate them using get_input_size_bytes() and get_output_size_bytes()
+    /// prior to calling this function.
+    /// Thread-safe: waits for a free execution context, so up to get_num_contexts() threads run concurrently.
+    /// @param input_buf An std::vector containing the pointer to the input buffer(s).
+    /// @param size_in_param An std::vector containing the size (bytes) of the elements of input_buf.
+    /// Should == this->get_input_size_bytes()
+    /// @param output_buf An std::vector containing the pointer to the output buffer.
+    /// @param size_out_param An std::vector containing the size (bytes) of the elements of the output buffer.
+    /// Should == this->get_output_size_bytes()
+    /// @return TRUE if inference succeeded.
+    bool infer_b(const std::vector<void*> &input_buf, const std::vector<size_t> &size_in_param,
+        const std::vector<void*> &output_buf, const std::vector<size_t> &size_out_param);
+
+    /// @brief Performs inference on an execution context the caller already holds (see lease_context()).
+    /// @return TRUE if inference succeeded.
+    bool infer_b(const ContextLease &lease, const std::vector<void*> &input_buf, const std::vector<size_t> &size_in_param,
+        const std::vector<void*> &output_buf, const std::vector<size_t> &size_out_param);
+
+    /// @brief Performs inference at caller-chosen input shapes (dynamic-shape models).
+    /// Each input shape must lie within the selected optimization profile (see get_input_profile()), and each
+    /// input buffer must hold at least that many elements. Output buffers are sized as for infer_b() above,
+    /// i.e. for the profile's max shapes; only the part covered by the actual output shapes is written.
+    /// Thread-safe, like infer_b() above.
+    /// @param input_shapes The shape of every input for this call.
+    /// @param output_shapes Receives the actual shape of every output.
+    /// @return TRUE if inference succeeded.
+    bool infer_b(const std::vector<void*> &input_buf, const std::vector<size_t> &size_in_param,
+        const std::vector<void*> &output_buf, const std::vector<size_t> &size_out_param,
+        const std::vector<TensorShape> &input_shapes, std::vector<TensorShape> &output_shapes);
+
+    /// @brief Submits an inference without waiting for it to complete.
+    /// The input buffers are read while the inference runs (the CUDA backend copies pinned buffers to the
+    /// device asynchronously), so they must stay allocated and unmodified until its result is retrieved.
+    /// To prepare the next inputs meanwhile, use another set of buffers per in-flight inference.
+    /// Each in-flight inference holds one execution context until its result is retrieved.
+    /// @param input_buf An std::vector containing the pointer to the input buffer(s).
+    /// @param size_in_param An std::vector containing the size (bytes) of the elements of input_buf.
+    /// Should == this->get_input_size_bytes()
+    /// @param ticket Receives the ticket used to retrieve the result.
+    /// @return TRUE if successfully enqueued, FALSE if the inputs are invalid or every context is busy.
+    bool infer_async(const std::vector<void*> &input_buf, const std::vector<size_t> &size_in_param,
+        InferTicket &ticket);
+
+    /// @brief Retrieves the result of an inference submitted with infer_async().
+    /// Results may be retrieved in any order, from any thread; while one thread retrieves a ticket, others get
+    /// kInvalidTicket for it.
+    /// @param ticket The ticket returned by infer_async().
+    /// @param output_buf An std::vector containing the pointer to the output buffer.
+    /// @param size_out_param An std::vector containing the size (bytes) of the elements of the output buffer.
+    /// Should == this->get_output_size_bytes()
+    /// @param wait TRUE to block until the inference completes, FALSE to poll.
+    /// @return kReady once the outputs are written, kPending if polling and not yet complete.
+    AsyncInferStatus retrieve_infer_result_async(InferTicket ticket,
+        const std::vector<void*> &output_buf, const std::vector<size_t> &size_out_param, bool wait = true);
+
+    /// @brief Leases an execution context for exclusive use (e.g. one per camera thread).
+    /// Waits for a free context; waiting callers are served in arrival order.
+    ContextLease lease_context() { return this->context_pool_.lease(); }
+
+    /// @brief TRUE if lease holds one of this backend's execution contexts (leases of other backends are refused).
+    bool owns_context(const ContextLease &lease) const noexcept { return this->context_pool_.owns(lease); }
+
+    /// @brief Get the number of execution contexts
+    int get_num_contexts() const noexcept { return this->context_pool_.size(); }
+
+    /// @brief Get the number of execution contexts not currently leased (a snapshot: other threads may take them)
+    int get_num_free_contexts() const { return this->context_pool_.available(); }
+
+    /// @brief Get the maximum number of in-flight async inferences
+    int get_num_async_slots() const noexcept { return this->async_ring_.num_slots(); }
+
+    /// @brief Get lease counts and wait times of the execution context pool
+    ContextPoolStats get_context_pool_stats() const { return this->context_pool_.get_stats(); }
+
+    /// @brief Enables valid-rows-only output copies.
+    /// Synchronous inference then copies each count tensor first and, of every output it counts, only the
+    /// leading rows it reports as valid (e.g. 2 of 100 bboxes), instead of the whole buffer. The contents of
+    /// a counted output past its valid rows are unspecified after the call. Async retrieval applies the same
+    /// rule to its host-side copy. Calls with per-call input shapes always copy in full.
+    /// Not thread-safe with respect to running inferences - call it right after loading.
+    /// @param mapping Count tensor -> dependent tensors, by name.
+    /// @return TRUE if the mapping is valid, FALSE otherwise (an error message will print,
+    /// and every output is copied in full).
+    bool set_counted_outputs(const std::vector<CountedOutputs>& mapping);
+
+    /// @brief TRUE if valid-rows-only copies are enabled
+    bool has_counted_outputs() const noexcept { return !this->valid_rows_.empty(); }
+
+    /// @brief Get the bytes copied and saved by valid-rows-only copies so far
+    ValidRowStats get_valid_row_stats() const
+    {
+        ValidRowStats stats;
+        stats.inferences = this->valid_row_inferences_.load(std::memory_order_relaxed);
+        stats.bytes_copied = this->valid_row_bytes_copied_.load(std::memory_order_relaxed);
+        stats.bytes_skipped = this->valid_row_bytes_skipped_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /// @brief Get the pool that host staging buffers for this backend should come from
+    /// (page-locked for the CUDA backend, so copies avoid the driver bounce buffer).
+    virtual HostBufferPool& get_host_buffer_pool() const noexcept = 0;
+
+    /// @brief Get number of model inputs
+    int get_num_inputs() const noexcept { return this->num_inputs_; }
+
+    /// @brief Get number of model outputs
+    int get_num_outputs() const noexcept { return this->num_outputs_; }
+
+    /// @brief Get shapes for all inputs.
+    /// For dynamic-shape models these are the max shapes of the selected profile, which buffers are sized for.
+    const std::vector<std::vector<int>>& get_input_shapes() const
+    {
+        return this->input_shapes_;
+    }
+
+    /// @brief Get shapes for all outputs (at the input shapes returned by get_input_shapes())
+    const std::vector<std::vector<int>>& get_output_shapes() const
+    {
+        return this->output_shapes_;
+    }
+
+    /// @brief Get the accepted shape range of every input (min == opt == max for static inputs)
+    const std::vector<ProfileShapes>& get_input_profile() const
+    {
+        return this->input_profile_;
+    }
+
+    /// @brief Get the index of the optimization profile in use
+    int get_profile_index() const noexcept { return this->profile_index_; }
+
+    /// @brief TRUE if any input accepts more than one shape
+    bool is_dynamic() const noexcept
+    {
+        for (const auto& range : this->input_profile_)
+        {
+            if (range.min != range.max) return true;
+        }
+        return false;
+    }
+
+    /// @brief Get names for all inputs
+    const std::vector<std::string>& get_input_names() const
+    {
+        return this->input_names_;
+    }
+
+    /// @brief Get names for all outputs
+    const std::vector<std::string>& get_output_names() const
+    {
+        return this->output_names_;
+    }
+
+    /// @brief Get the index of the input tensor called name
+    /// @return Index into the input vectors, or -1 if there is no such input.
+    int get_input_index(const std::string& name) const noexcept
+    {
+        for (int i = 0; i < this->num_inputs_; i++)
+        {
+            if (this->input_names_[i] == name) return i;
+        }
+        return -1;
+    }
+
+    /// @brief Get the index of the output tensor called name
+    /// @return Index into the output vectors, or -1 if there is no such output.
+    int get_output_index(const std::string& name) const noexcept
+    {
+        for (int i = 0; i < this->num_outputs_; i++)
+        {
+            if (this->output_names_[i] == name) return i;
+        }
+        return -1;
+    }
+
+    /// @brief Get element counts for all inputs
+    const std::vector<size_t>& get_input_elements() const
+    {
+        return this->trt_input_element_counts_;
+    }
+
+    /// @brief Get element counts for all outputs
+    const std::vector<size_t>& get_output_elements() const
+    {
+        return this->trt_output_element_counts_;
+    }
+
+    /// @brief Get the layout (data type, shape, strides, vectorized format) of every input
+    const std::vector<TensorDesc>& get_input_descs() const
+    {
+        return this->input_descs_;
+    }
+
+    /// @brief Get the layout (data type, shape, strides, vectorized format) of every output
+    const std::vector<TensorDesc>& get_output_descs() const
+    {
+        return this->output_descs_;
+    }
+
+    /// @brief Get byte sizes for all inputs, from each input's data type and (padded) shape.
+    /// Computed once at load time.
+    const std::vector<size_t>& get_input_size_bytes() const noexcept
+    {
+        return this->input_size_bytes_;
+    }
+
+    /// @brief Get byte sizes for all outputs, from each output's data type and (padded) shape.
+    /// Computed once at load time.
+    const std::vector<size_t>& get_output_size_bytes() const noexcept
+    {
+        return this->output_size_bytes_;
+    }
+
+protected:
+
+    /// @brief Runs one inference to completion on execution context `context`.
+    /// Buffers have already been validated, and the caller holds the context exclusively.
+    /// @param input_shapes Per-call input shapes (already checked against the profile),
+    /// or nullptr to run at get_input_shapes().
+    /// @param output_shapes Receives the actual output shapes when input_shapes is given, else nullptr.
+    virtual bool execute_on_context(int context, const std::vector<void*> &input_buf,
+        const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf,
+        const std::vector<size_t> &size_out_param, const std::vector<TensorShape> *input_shapes,
+        std::vector<TensorShape> *output_shapes) = 0;
+
+    /// @brief Starts one inference on execution context `context` without waiting for it.
+    /// Inputs have already been validated, and the context stays reserved until collect_from_context().
+    /// The input buffers stay untouched until then, so they may be read at any point in between.
+    virtual bool enqueue_on_context(int context, const std::vector<void*> &input_buf,
+        const std::vector<size_t> &size_in_param) = 0;
+
+    /// @brief Copies out the result of the inference enqueued on `context`.
+    /// @return kReady, kPending (only when not waiting) or kFailed.
+    virtual AsyncInferStatus collect_from_context(int context, const std::vector<void*> &output_buf,
+        const std::vector<size_t> &size_out_param, bool wait) = 0;
+
+    // Model dimensions - these are assigned by the implementation when the model is loaded.
+    int num_inputs_ = 0; // Number of inputs (e.g. 1 image for YOLO)
+    int num_outputs_ = 0; // Number of outputs (e.g. 4 objects for YOLO)
+
+    // Shapes the I/O buffers are sized for (the max shapes of the selected profile for dynamic models).
+    std::vector<std::vector<int>> input_shapes_;
+    std::vector<std::vector<int>> output_shapes_;
+
+    // Accepted shape range of each input in the selected optimization profile.
+    std::vector<ProfileShapes> input_profile_;
+    int profile_index_ = 0;
+
+    // The names of each input or output
+    std::vector<std::string> input_names_;
+    std::vector<std::string> output_names_;
+
+    // The size of the I/O - in elements only - to get bytes you need to call
+    // this->get_output_size_bytes() or this->get_input_size_bytes()
+    std::vector<size_t> trt_input_element_counts_;
+    std::vector<size_t> trt_output_element_counts_;
+
+    // Layout of each input / output. Byte sizes come from here, never from an assumed float.
+    std::vector<TensorDesc> input_descs_;
+    std::vector<TensorDesc> output_descs_;
+
+    // Byte size of each input / output, cached from the descriptors by cache_binding_sizes().
+    std::vector<size_t> input_size_bytes_;
+    std::vector<size_t> output_size_bytes_;
+
+    /// @brief Caches the byte sizes of input_descs_ / output_descs_.
+    /// Implementations call this once the descriptors are final.
+    void cache_binding_sizes()
+    {
+        this->input_size_bytes_.clear();
+        this->output_size_bytes_.clear();
+        for (const auto& desc : this->input_descs_) this->input_size_bytes_.push_back(desc.size_bytes);
+        for (const auto& desc : this->output_descs_) this->output_size_bytes_.push_back(desc.size_bytes);
+    }
+
+    // Count tensor -> dependent tensor mapping of valid-rows-only copies (empty: copy everything).
+    ValidRowPlan valid_rows_;
+
+    /// @brief Copies staged host outputs to the caller's buffers, counted outputs only up to their valid rows.
+    /// @return Bytes copied.
+    size_t copy_valid_rows(const std::vector<void*>& staged, const std::vector<void*>& output_buf,
+        const std::vector<size_t>& size_out_param) const;
+
+    /// @brief Adds one valid-rows-only inference to the statistics.
+    /// @param copied Output bytes transferred.
+    /// @param total Output bytes a full copy would have transferred.
+    void record_valid_rows(size_t copied, size_t total) noexcept
+    {
+        this->valid_row_inferences_.fetch_add(1, std::memory_order_relaxed);
+        this->valid_row_bytes_copied_.fetch_add(copied, std::memory_order_relaxed);
+        this->valid_row_bytes_skipped_.fetch_add(total - copied, std::memory_order_relaxed);
+    }
+
+    /// @brief Checks the input buffers against the loaded model.
+    /// @return TRUE if valid, else FALSE. (An error message will print.)
+    bool validate_inputs(const std::vector<void*>& input_bufs, const std::vector<size_t>& input_sizes) const;
+
+    /// @brief Checks per-call input shapes against the selected profile, and the input buffers against those shapes.
+    /// @return TRUE if valid, else FALSE. (An error message will print.)
+    bool validate_input_shapes(const std::vector<void*>& input_bufs, const std::vector<size_t>& input_sizes,
+        const std::vector<TensorShape>& input_shapes) const;
+
+    /// @brief Checks the output buffers against the loaded model.
+    /// @return TRUE if valid, else FALSE. (An error message will print.)
+    bool validate_outputs(const std::vector<void*>& output_bufs, const std::vector<size_t>& output_sizes) const;
+
+    /// @brief Prior to inference, checks to make sure that the I/O buffers are
+    /// correctly sized for the loaded model.
+    /// @param input_bufs Input buffers
+    /// @param input_sizes Sizes of input buffers (bytes)
+    /// @param output_bufs Output buffers
+    /// @param output_sizes Sizes of output buffers (bytes)
+    /// @return TRUE if valid, else FALSE. (An error message will print.)
+    bool validate_buffers(
+        const std::vector<void*>& input_bufs,
+        const std::vector<size_t>& input_sizes,
+        const std::vector<void*>& output_bufs,
+        const std::vector<size_t>& output_sizes) const;
+
+private:
+
+    // Execution contexts, shared by synchronous calls (leased per call) and async calls (leased per ticket).
+    ContextPool context_pool_;
+    InferSlotRing async_ring_;
+
+    std::atomic<uint64_t> valid_row_inferences_{0};
+    std::atomic<uint64_t> valid_row_bytes_copied_{0};
+    std::atomic<uint64_t> valid_row_bytes_skipped_{0};
+};
@@ -1,151 +1,352 @@
 #include "TRT_inference_engine.hpp"
 
-/// @brief Performs inference using the loaded model. The input/output must be sized appropriately.
-/// Recommended to pre-allocate them using get_input_size_bytes() and get_output_size_bytes()
-/// prior to calling this function. 
-/// @param input_buf An std::vector containing the pointer to the input buffer(s).
-/// @param size_in_param An std::vector containing the size (bytes) of the elements of input_buf. 
-/// Should == this->get_input_size_bytes()
-/// @param output_buf An std::vector containing the pointer to the output buffer.
-/// @param size_out_param An std::vector containing the size (bytes) of the elements of the output buffer. 
-/// Should == this->get_output_size_bytes()
-/// @return TRUE if inference succeeded.
-bool TrtInferenceEngine::infer_b(const std::vector<void*> &input_buf, std::vector<size_t> &size_in_param, 
-    std::vector<void*> &output_buf, std::vector<size_t> &size_out_param)
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace
 {
-    if (input_size != this->get_input_size_bytes() || output_size != this->get_output_size_bytes()) 
+    nvinfer1::Dims to_dims(const TensorShape& shape)
     {
-        std::cerr << "[TRT_ENGINE] Buffer size mismatch\n"
-                << "\tExpected input: " << this->get_input_size_bytes() << " bytes\n"
-                << "\tReceived input: " << input_size << " bytes\n"
-                << "\tExpected output: " << this->get_output_size_bytes() << " bytes\n"
-                << "\tReceived output: " << output_size << " bytes" << std::endl;
-        return false;
+        nvinfer1::Dims dims{};
+        dims.nbDims = static_cast<int32_t>(shape.size());
+        for (size_t j = 0; j < shape.size(); ++j) {
+            dims.d[j] = shape[j];
+        }
+        return dims;
     }
 
-    if (input_buf.size() != this->input_cuda_buffers_.size() 
-        || output_buf.size() != this->output_cuda_buffers_.size()) 
+    void to_shape(const nvinfer1::Dims& dims, TensorShape& shape)
     {
-        std::cerr << "[TRT_ENGINE] Buffer size mismatch!\n"
-                << "\tInput buffer: [Actual]" << input_buf.size() << "\t[Expected] " << this->input_cuda_buffers_.size() << "\n"
-                << "\tOutput buffer: [Actual]" << output_buf.size() << "\t[Expected] " << this->output_cuda_buffers_.size() << std::endl;
+        shape.resize(dims.nbDims > 0 ? dims.nbDims : 0);
+        for (int j = 0; j < dims.nbDims; ++j) {
+            shape[j] = static_cast<int>(dims.d[j]);
+        }
+    }
+
+    TensorShape to_shape(const nvinfer1::Dims& dims)
+    {
+        TensorShape shape;
+        to_shape(dims, shape);
+        return shape;
+    }
+
+    bool same_dims(const nvinfer1::Dims& a, const nvinfer1::Dims& b)
+    {
+        return a.nbDims == b.nbDims && std::equal(a.d, a.d + a.nbDims, b.d);
+    }
+}
+
+/// @brief Enqueues a complete inference (H2D copy, execution, D2H copy) on a caller-supplied stream.
+/// Returns as soon as the work is enqueued - the host never blocks on the GPU here.
+/// The lease must be held, and the input/output buffers kept alive, until the stream has been synchronized.
+/// @param lease The execution context to run on (see lease_context()).
+/// @param stream The Cuda stream to enqueue on.
+/// @return TRUE if everything was enqueued.
+bool TrtInferenceEngine::enqueue(const ContextLease &lease, const std::vector<void*> &input_buf, 
+    const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf, 
+    const std::vector<size_t> &size_out_param, cudaStream_t stream)
+{
+    if (!this->owns_context(lease))
+    {
+        std::cerr << "[TRT_ENGINE] Enqueue aborted - lease does not hold a context of this engine." << std::endl;
+        return false;
+    }
+    if (!this->validate_buffers(input_buf, size_in_param, output_buf, size_out_param))
+    {
+        std::cerr << "[TRT_ENGINE] Enqueue aborted - invalid I/O buffers." << std::endl;
         return false;
     }
+    return this->enqueue_inference(lease.index(), input_buf, size_in_param, output_buf, size_out_param, stream);
+}
 
-    // Copy input to GPU.
-    for (int i = 0; i < this->input_cuda_buffers_.size(); i++)
+/// @brief Copies the inputs in, executes and copies the outputs out on the context's stream,
+/// then waits for that stream only.
+bool TrtInferenceEngine::execute_on_context(int context, const std::vector<void*> &input_buf,
+    const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf,
+    const std::vector<size_t> &size_out_param, const std::vector<TensorShape> *input_shapes,
+    std::vector<TensorShape> *output_shapes)
+{
+    if (this->has_counted_outputs() && !input_shapes)
     {
-        cudaMemcpy(this->input_cuda_buffers_[i], input_buf[i], size_in_param[i], cudaMemcpyHostToDevice);
+        return this->execute_valid_rows(context, input_buf, size_in_param, output_buf, size_out_param);
     }
 
-    // Execute inference.
-    // this->bindings_ should already have been populated with the appropriate members
-    // of this->input_cuda_buffers and this->output_cuda_buffers, so there
-    // should not be any need to update them prior to executing this function.
-    this->context_->executeV2(this->bindings_.data());
+    ExecutionSlot& slot = this->slots_[context];
+    const bool ok = this->enqueue_inference(context, input_buf, size_in_param, output_buf, size_out_param, 
+        slot.stream, input_shapes, output_shapes);
 
-    for (int i = 0; i < this->output_cuda_buffers_.size(); i++)
+    // Always drain the stream, so the context is idle when the lease is returned.
+    const cudaError_t state = cudaStreamSynchronize(slot.stream);
+    if (!ok || state != cudaSuccess)
     {
-        // Copy results back from GPU.
-        cudaMemcpy(output_buf[i], this->output_cuda_buffers_[i], size_out_param[i], cudaMemcpyDeviceToHost);
+        std::cerr << "[TRT_ENGINE] Inference failed on context " << context << ": " 
+                  << cudaGetErrorString(state) << std::endl;
+        return false;
     }
-    
     return true;
 }
 
-/// @brief Performs inference using the loaded model. The input/output must be sized appropriately.
-/// Recommended to pre-allocate them using get_input_size_bytes() and get_output_size_bytes()
-/// prior to calling this function. 
-/// This function enqueues the inference result using Cuda stream so that you can asynchronously
-/// execute other functions in the meantime.
-/// @param input_buf The pointer to the input buffer.
-/// @param size_in_param The size (bytes) of the input buffer. 
-/// Should == this->get_input_size_bytes()
-/// @return TRUE if successfully enqueued.
-bool TrtInferenceEngine::infer_async(const std::vector<void*> &input_buf, std::vector<size_t> &size_in_param)
+/// @brief Enqueues H2D copy, execution and D2H copy (into pinned staging) on the context's
+/// stream, and records its completion event.
+bool TrtInferenceEngine::enqueue_on_context(int context, const std::vector<void*> &input_buf,
+    const std::vector<size_t> &size_in_param)
 {
-    return false; // Not yet implemented!
+    ExecutionSlot& slot = this->slots_[context];
+
+    // The H2D copy of a pinned input runs asynchronously; the caller keeps input_buf untouched
+    // until the result is collected (see InferenceBackend::infer_async()).
+    bool enqueued = this->enqueue_inference(context, input_buf, size_in_param, 
+        slot.host_outputs, this->get_output_size_bytes(), slot.stream);
+    enqueued = enqueued && cudaEventRecord(slot.done, slot.stream) == cudaSuccess;
+
+    if (!enqueued)
+    {
+        cudaStreamSynchronize(slot.stream); // Drain whatever was enqueued before reusing the context.
+    }
+    return enqueued;
 }
 
-/// @brief Performs inference using the loaded model. The input/output must be sized appropriately.
-/// Recommended to pre-allocate them using get_input_size_bytes() and get_output_size_bytes()
-/// prior to calling this function. 
-/// This function retrieves an async result from the Cuda stream (if available).
-/// @param output_buf The pointer to the output buffer.
-/// @param size_out_param The size (bytes) of the output buffer. 
-/// Should == this->get_output_size_bytes()
-/// @return Output size, or 0 on failure.
-size_t TrtInferenceEngine::retrieve_infer_result_async(const std::vector<void*> &output_buf, 
-    std::vector<size_t> &size_out_param)
+/// @brief Polls or blocks on the context's completion event, then copies the staged outputs out.
+AsyncInferStatus TrtInferenceEngine::collect_from_context(int context, const std::vector<void*> &output_buf,
+    const std::vector<size_t> &size_out_param, bool wait)
 {
-    return false; // Not yet implemented!
+    ExecutionSlot& slot = this->slots_[context];
+    const cudaError_t state = wait ? cudaEventSynchronize(slot.done) : cudaEventQuery(slot.done);
+    if (state == cudaErrorNotReady)
+    {
+        return AsyncInferStatus::kPending;
+    }
+    if (state != cudaSuccess)
+    {
+        std::cerr << "[TRT_ENGINE] Async inference on context " << context << " failed: " 
+                  << cudaGetErrorString(state) << std::endl;
+        return AsyncInferStatus::kFailed;
+    }
+
+    // The whole outputs were transferred already; counted outputs only save the host-side copy here.
+    this->copy_valid_rows(slot.host_outputs, output_buf, size_out_param);
+    return AsyncInferStatus::kReady;
 }
 
 
 /// --- The functions below this line are internal use only ---
 
 
-void TrtInferenceEngine::load_engine(const std::string& engine_path)
+bool TrtInferenceEngine::enqueue_inference(int context, const std::vector<void*> &input_buf, 
+    const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf, 
+    const std::vector<size_t> &size_out_param, cudaStream_t stream,
+    const std::vector<TensorShape> *input_shapes, std::vector<TensorShape> *output_shapes)
+{
+    ExecutionSlot& slot = this->slots_[context];
+    bool ok = this->enqueue_execution(context, input_buf, size_in_param, stream, input_shapes);
+
+    if (output_shapes)
+    {
+        output_shapes->resize(this->num_outputs_);
+    }
+    for (int i = 0; i < this->num_outputs_ && ok; i++)
+    {
+        // The output shapes follow from the input dimensions set above.
+        size_t bytes = size_out_param[i];
+        if (output_shapes)
+        {
+            to_shape(slot.context->getTensorShape(this->output_names_[i].c_str()), (*output_shapes)[i]);
+            bytes = tensor_size_bytes(this->output_descs_[i], (*output_shapes)[i]);
+        }
+
+        // Copy results back from GPU.
+        ok = cudaMemcpyAsync(output_buf[i], slot.output_cuda_buffers[i], bytes, 
+            cudaMemcpyDeviceToHost, stream) == cudaSuccess;
+    }
+    return ok;
+}
+
+bool TrtInferenceEngine::enqueue_execution(int context, const std::vector<void*> &input_buf, 
+    const std::vector<size_t> &size_in_param, cudaStream_t stream, const std::vector<TensorShape> *input_shapes)
+{
+    ExecutionSlot& slot = this->slots_[context];
+
+    // Dynamic engines: set this call's input dimensions first.
+    if (!this->bind_input_shapes(slot, input_shapes))
+    {
+        return false;
+    }
+
+    // Copy input to GPU - only the part covered by the actual shape.
+    bool ok = true;
+    for (int i = 0; i < this->num_inputs_ && ok; i++)
+    {
+        const size_t bytes = input_shapes ? tensor_size_bytes(this->input_descs_[i], (*input_shapes)[i]) : size_in_param[i];
+        ok = cudaMemcpyAsync(slot.input_cuda_buffers[i], input_buf[i], bytes, 
+            cudaMemcpyHostToDevice, stream) == cudaSuccess;
+    }
+
+    // Execute inference.
+    // Every tensor address was bound by name in allocate_contexts(), so there
+    // should not be any need to update them prior to executing this function.
+    return ok && slot.context->enqueueV3(stream);
+}
+
+bool TrtInferenceEngine::execute_valid_rows(int context, const std::vector<void*> &input_buf,
+    const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf,
+    const std::vector<size_t> &size_out_param)
+{
+    ExecutionSlot& slot = this->slots_[context];
+    bool ok = this->enqueue_execution(context, input_buf, size_in_param, slot.stream, nullptr);
+
+    // First transfer: every output that is not counted - including the (tiny) count tensors.
+    size_t total = 0;
+    size_t copied = 0;
+    for (int i = 0; i < this->num_outputs_; i++)
+    {
+        total += size_out_param[i];
+        if (!ok || this->valid_rows_.count_output(i) >= 0)
+        {
+            continue;
+        }
+        ok = cudaMemcpyAsync(output_buf[i], slot.output_cuda_buffers[i], size_out_param[i], 
+            cudaMemcpyDeviceToHost, slot.stream) == cudaSuccess;
+        copied += size_out_param[i];
+    }
+    cudaError_t state = cudaStreamSynchronize(slot.stream);
+
+    // Second transfer: the valid prefix of each counted output, now that the counts are on the host.
+    for (int i = 0; i < this->num_outputs_ && ok && state == cudaSuccess; i++)
+    {
+        const int count = this->valid_rows_.count_output(i);
+        if (count < 0)
+        {
+            continue;
+        }
+        const size_t bytes = this->valid_rows_.valid_bytes(i, output_buf[count], size_out_param[i]);
+        if (bytes > 0)
+        {
+            ok = cudaMemcpyAsync(output_buf[i], slot.output_cuda_buffers[i], bytes, 
+                cudaMemcpyDeviceToHost, slot.stream) == cudaSuccess;
+        }
+        copied += bytes;
+    }
+    if (state == cudaSuccess)
+    {
+        state = cudaStreamSynchronize(slot.stream);
+    }
+
+    if (!ok || state != cudaSuccess)
+    {
+        std::cerr << "[TRT_ENGINE] Inference failed on context " << context << ": " 
+                  << cudaGetErrorString(state) << std::endl;
+        return false;
+    }
+    this->record_valid_rows(copied, total);
+    return true;
+}
+
+bool TrtInferenceEngine::bind_input_shapes(ExecutionSlot& slot, const std::vector<TensorShape> *input_shapes)
+{
+    if (!this->is_dynamic())
+    {
+        return true; // Static shapes are fixed when the engine is built.
+    }
+
+    for (int i = 0; i < this->num_inputs_; i++)
+    {
+        const nvinfer1::Dims dims = input_shapes ? to_dims((*input_shapes)[i]) : this->input_dims_[i];
+        if (same_dims(dims, slot.bound_input_dims[i]))
+        {
+            continue;
+        }
+        if (!slot.context->setInputShape(this->input_names_[i].c_str(), dims))
+        {
+            std::cerr << "[TRT_ENGINE] Failed to set shape " << shape_to_string(to_shape(dims)) 
+                      << " on input " << this->input_names_[i] << std::endl;
+            return false;
+        }
+        slot.bound_input_dims[i] = dims;
+    }
+    return true;
+}
+
+
+void TrtInferenceEngine::load_engine(const std::string& engine_path, const EngineLoadOptions& options)
 {
-    // Load .engine file
-    std::ifstream engine_file(engine_path, std::ios::binary);
-    engine_file.seekg(0, std::ios::end);
-    size_t size = engine_file.tellg();
-    engine_file.seekg(0, std::ios::beg);
-    std::vector<char> engine_data(size);
-    engine_file.read(engine_data.data(), size);
+    using clock = std::chrono::steady_clock;
+    const auto ms_since = [](clock::time_point t) {
+        return std::chrono::duration<double, std::milli>(clock::now() - t).count();
+    };
+
+    // Map (or read) the .engine file - throws if it is missing or unreadable.
+    auto t = clock::now();
+    EngineFile engine_file(engine_path, options);
+    this->load_stats_.file_bytes = engine_file.size();
+    this->load_stats_.mapped = engine_file.is_mapped();
+    this->load_stats_.read_ms = ms_since(t);
 
     // Instantiate the model
+    t = clock::now();
     this->runtime_ = std::unique_ptr<nvinfer1::IRuntime>(
         nvinfer1::createInferRuntime(this->logger_));
+    if (!this->runtime_)
+    {
+        throw std::runtime_error("[TRT_ENGINE] Failed to create TensorRT runtime");
+    }
     this->engine_ = std::unique_ptr<nvinfer1::ICudaEngine>(
-        this->runtime_->deserializeCudaEngine(engine_data.data(), size));
-    this->context_ = std::unique_ptr<nvinfer1::IExecutionContext>(
-        this->engine_->createExecutionContext());
+        this->runtime_->deserializeCudaEngine(engine_file.data(), engine_file.size()));
+    if (!this->engine_)
+    {
+        throw std::runtime_error("[TRT_ENGINE] Failed to deserialize engine: " + engine_path);
+    }
+    this->load_stats_.deserialize_ms = ms_since(t);
 
-    std::cout << "[TRT_ENGINE] Loaded TensorRT model from path: " << engine_path << std::endl;
+    std::cout << "[TRT_ENGINE] Loaded TensorRT model from path: " << engine_path << "\n"
+              << "\tFile: " << (this->load_stats_.file_bytes / (1024.0 * 1024.0)) << " MB ("
+              << (this->load_stats_.mapped ? "mapped" : "read") << ")\n"
+              << "\tRead: " << this->load_stats_.read_ms << " ms\n"
+              << "\tDeserialize: " << this->load_stats_.deserialize_ms << " ms" << std::endl;
 }
 
-void TrtInferenceEngine::calculate_model_parameters() 
+void TrtInferenceEngine::calculate_model_parameters(int batch_size) 
 {
     if (!this->engine_) 
     {
         throw std::runtime_error("Engine not initialized");
     }
 
-    const int num_bindings = this->engine_->getNbBindings();
+    const int num_tensors = this->engine_->getNbIOTensors();
     std::cout << "[TRT_ENGINE] Model Parameters:\n";
-    std::cout << "  Number of bindings: " << num_bindings << "\n";
+    std::cout << "  Number of I/O tensors: " << num_tensors << "\n";
 
     // Clear existing data
     this->input_dims_.clear();
     this->output_dims_.clear();
     this->input_names_.clear();
     this->output_names_.clear();
+    this->input_shapes_.clear();
+    this->output_shapes_.clear();
+    this->input_profile_.clear();
+    this->input_descs_.clear();
+    this->output_descs_.clear();
+    this->input_size_bytes_.clear();
+    this->output_size_bytes_.clear();
     this->trt_input_element_counts_.clear();
     this->trt_output_element_counts_.clear();
 
-    // Update counts
-    this->num_inputs_ = static_cast<int>(this->input_dims_.size());
-    this->num_outputs_ = static_cast<int>(this->output_dims_.size());
-
-    // Process all bindings
-    for (int i = 0; i < num_bindings; i++) {
-        const char* name = this->engine_->getBindingName(i);
-        const auto dims = this->engine_->getBindingDimensions(i);
-        const bool is_input = this->engine_->bindingIsInput(i);
+    // Process all I/O tensors - everything below is keyed by tensor name.
+    for (int i = 0; i < num_tensors; i++) {
+        const char* name = this->engine_->getIOTensorName(i);
+        const auto dims = this->engine_->getTensorShape(name);
+        const auto mode = this->engine_->getTensorIOMode(name);
+        if (mode == nvinfer1::TensorIOMode::kNONE) {
+            continue;
+        }
+        const bool is_input = (mode == nvinfer1::TensorIOMode::kINPUT);
 
         std::cout << (is_input ? "  Input" : "  Output") << " [" << i << "]: " 
                 << (name ? name : "unnamed") << "\n";
         std::cout << "    Dimensions: [";
         
-        // Validate dimensions
+        // Dynamic dimensions (-1) are resolved from the optimization profile below.
         for (int j = 0; j < dims.nbDims; j++) {
-            if (dims.d[j] <= 0) {
-                throw std::runtime_error("[TRT_ENGINE] Invalid dimension value in binding " + 
-                                    std::to_string(i) + " dimension " + 
-                                    std::to_string(j));
-            }
             std::cout << dims.d[j];
             if (j < dims.nbDims - 1) std::cout << " x ";
         }
@@ -155,19 +356,50 @@ void TrtInferenceEngine::calculate_model_parameters()
         if (is_input) {
             this->input_dims_.push_back(dims);
             this->input_names_.push_back(std::string(name));
-            std::vector<int> shape;
-            for (int j = 0; j < dims.nbDims; ++j) {
-                shape.push_back(dims.d[j]);
-            }
-            this->input_shapes_.push_back(shape);
+            this->input_shapes_.push_back(to_shape(dims));
         } else {
             this->output_dims_.push_back(dims);
             this->output_names_.push_back(std::string(name));            
-            std::vector<int> shape;
-            for (int j = 0; j < dims.nbDims; ++j) {
-                shape.push_back(dims.d[j]);
-            }
-            this->output_shapes_.push_back(shape);
+            this->output_shapes_.push_back(to_shape(dims));
+        }
+    }
+
+    // Update counts
+    this->num_inputs_ = static_cast<int>(this->input_dims_.size());
+    this->num_outputs_ = static_cast<int>(this->output_dims_.size());
+
+    // Size every buffer for the max shapes of the profile selected for batch_size.
+    bool dynamic = false;
+    for (const auto& shape : this->input_shapes_) {
+        dynamic = dynamic || has_dynamic_dims(shape);
+    }
+    this->profile_index_ = 0;
+    if (dynamic) {
+        const auto profiles = this->read_profiles(this->input_shapes_);
+        this->profile_index_ = select_profile(profiles, batch_size);
+        if (this->profile_index_ < 0) {
+            throw std::runtime_error("[TRT_ENGINE] No optimization profile accepts batch size " + 
+                                std::to_string(batch_size));
+        }
+        this->input_profile_ = profiles[this->profile_index_].inputs;
+        for (int i = 0; i < this->num_inputs_; i++) {
+            this->input_shapes_[i] = this->input_profile_[i].max;
+            this->input_dims_[i] = to_dims(this->input_profile_[i].max);
+        }
+        this->output_dims_ = this->resolve_output_dims();
+        for (int i = 0; i < this->num_outputs_; i++) {
+            this->output_shapes_[i] = to_shape(this->output_dims_[i]);
+        }
+
+        std::cout << "  Optimization profile " << this->profile_index_ << " of " << profiles.size() 
+                  << " (batch size " << batch_size << "):\n";
+        for (int i = 0; i < this->num_inputs_; i++) {
+            std::cout << "    " << this->input_names_[i] << ": " << shape_to_string(this->input_profile_[i].min) 
+                      << " .. " << shape_to_string(this->input_profile_[i].max) << "\n";
+        }
+    } else {
+        for (const auto& shape : this->input_shapes_) {
+            this->input_profile_.push_back({shape, shape, shape});
         }
     }
 
@@ -179,6 +411,15 @@ void TrtInferenceEngine::calculate_model_parameters()
         this->trt_output_element_counts_.push_back(this->validate_and_calculate_elements(dims, "output"));
     }
 
+    // Describe every binding - its data type and format decide its byte size.
+    for (int i = 0; i < this->num_inputs_; i++) {
+        this->input_descs_.push_back(this->describe_tensor(this->input_names_[i], true, this->input_shapes_[i]));
+    }
+    for (int i = 0; i < this->num_outputs_; i++) {
+        this->output_descs_.push_back(this->describe_tensor(this->output_names_[i], false, this->output_shapes_[i]));
+    }
+    this->cache_binding_sizes();
+
     // Print summary
     std::cout << "\tInput Count: " << this->num_inputs_ << "\n";
     std::cout << "\tOutput Count: " << this->num_outputs_ << "\n";
@@ -188,16 +429,91 @@ void TrtInferenceEngine::calculate_model_parameters()
     for (int i = 0; i < this->num_inputs_; i++) 
     {
         std::cout << "\tInput " << i << "\tElements: " << this->trt_input_element_counts_[i] 
-                << " (" << (this->trt_input_element_counts_[i] * sizeof(float) / KB_TO_BYTES) << " KB)\n";
+                << " " << data_type_name(this->input_descs_[i].dtype)
+                << " (" << (this->input_descs_[i].size_bytes / KB_TO_BYTES) << " KB)\n";
     }
     for (int i = 0; i < this->num_outputs_; i++) 
     {
         std::cout << "\tOutput " << i << "\tElements: " << this->trt_output_element_counts_[i] 
-                << " (" << (this->trt_output_element_counts_[i] * sizeof(float) / KB_TO_BYTES) << " KB)\n";
+                << " " << data_type_name(this->output_descs_[i].dtype)
+                << " (" << (this->output_descs_[i].size_bytes / KB_TO_BYTES) << " KB)\n";
     }
     std::cout << "\n";
 }
 
+TensorDesc TrtInferenceEngine::describe_tensor(const std::string& name, bool is_input, const TensorShape& shape) const
+{
+    TensorDataType dtype = TensorDataType::kFLOAT;
+    switch (this->engine_->getTensorDataType(name.c_str())) {
+        case nvinfer1::DataType::kFLOAT: dtype = TensorDataType::kFLOAT; break;
+        case nvinfer1::DataType::kHALF: dtype = TensorDataType::kHALF; break;
+        case nvinfer1::DataType::kBF16: dtype = TensorDataType::kBF16; break;
+        case nvinfer1::DataType::kFP8: dtype = TensorDataType::kFP8; break;
+        case nvinfer1::DataType::kINT8: dtype = TensorDataType::kINT8; break;
+        case nvinfer1::DataType::kUINT8: dtype = TensorDataType::kUINT8; break;
+        case nvinfer1::DataType::kINT32: dtype = TensorDataType::kINT32; break;
+        case nvinfer1::DataType::kINT64: dtype = TensorDataType::kINT64; break;
+        case nvinfer1::DataType::kINT4: dtype = TensorDataType::kINT4; break;
+        case nvinfer1::DataType::kBOOL: dtype = TensorDataType::kBOOL; break;
+        default:
+            throw std::runtime_error("[TRT_ENGINE] Unsupported data type for tensor " + name);
+    }
+
+    // Vectorized formats (e.g. kCHW32 for INT8 I/O) pad the vectorized dimension.
+    const int vectorized_dim = this->engine_->getTensorVectorizedDim(name.c_str());
+    const int components = this->engine_->getTensorComponentsPerElement(name.c_str());
+    return make_tensor_desc(name, is_input, dtype, shape, vectorized_dim, components);
+}
+
+std::vector<OptimizationProfile> TrtInferenceEngine::read_profiles(
+    const std::vector<TensorShape>& declared_input_shapes) const
+{
+    std::vector<OptimizationProfile> profiles(this->engine_->getNbOptimizationProfiles());
+    for (size_t p = 0; p < profiles.size(); p++) {
+        profiles[p].index = static_cast<int>(p);
+        for (int i = 0; i < this->num_inputs_; i++) {
+            const TensorShape& declared = declared_input_shapes[i];
+            if (!has_dynamic_dims(declared)) {
+                profiles[p].inputs.push_back({declared, declared, declared});
+                continue;
+            }
+            const char* name = this->input_names_[i].c_str();
+            profiles[p].inputs.push_back({
+                to_shape(this->engine_->getProfileShape(name, static_cast<int32_t>(p), nvinfer1::OptProfileSelector::kMIN)),
+                to_shape(this->engine_->getProfileShape(name, static_cast<int32_t>(p), nvinfer1::OptProfileSelector::kOPT)),
+                to_shape(this->engine_->getProfileShape(name, static_cast<int32_t>(p), nvinfer1::OptProfileSelector::kMAX))});
+        }
+    }
+    return profiles;
+}
+
+std::vector<nvinfer1::Dims> TrtInferenceEngine::resolve_output_dims() const
+{
+    // A throwaway context (no device memory is needed for shape inference) evaluates the output shapes.
+    std::unique_ptr<nvinfer1::IExecutionContext> context(this->engine_->createExecutionContext(
+        nvinfer1::ExecutionContextAllocationStrategy::kUSER_MANAGED));
+    bool ok = context && context->setOptimizationProfileAsync(this->profile_index_, nullptr)
+        && cudaStreamSynchronize(nullptr) == cudaSuccess;
+    for (int i = 0; i < this->num_inputs_ && ok; i++) {
+        ok = context->setInputShape(this->input_names_[i].c_str(), this->input_dims_[i]);
+    }
+    if (!ok) {
+        throw std::runtime_error("[TRT_ENGINE] Failed to apply optimization profile " + 
+                            std::to_string(this->profile_index_));
+    }
+
+    std::vector<nvinfer1::Dims> output_dims;
+    for (int i = 0; i < this->num_outputs_; i++) {
+        const nvinfer1::Dims dims = context->getTensorShape(this->output_names_[i].c_str());
+        if (dims.nbDims < 0 || has_dynamic_dims(to_shape(dims))) {
+            throw std::runtime_error("[TRT_ENGINE] Output " + this->output_names_[i] + 
+                                " has a data-dependent shape - not supported");
+        }
+        output_dims.push_back(dims);
+    }
+    return output_dims;
+}
+
 size_t TrtInferenceEngine::validate_and_calculate_elements(const nvinfer1::Dims& dims, const std::string& name) 
 {
     if (dims.nbDims == 0) {
@@ -231,7 +547,7 @@ void TrtInferenceEngine::print_strides(const nvinfer1::Dims& dims)
 void TrtInferenceEngine::allocate_buffers() 
 {
     // Check if buffers are already allocated
-    if (!this->input_cuda_buffers_.empty() || !this->output_cuda_buffers_.empty()) {
+    if (this->device_arena_ != nullptr) {
         std::cerr << "[TRT_ENGINE] Error: CUDA buffers already allocated!\n"
                   << "\tEnsure proper cleanup with deallocate_buffers() first." << std::endl;
         return;
@@ -245,119 +561,150 @@ void TrtInferenceEngine::allocate_buffers()
     }
 
     // Get required byte sizes
-    const auto input_sizes = this->get_input_size_bytes();
-    const auto output_sizes = this->get_output_size_bytes();
-
-    // Allocate input buffers
-    this->input_cuda_buffers_.resize(this->num_inputs_);
-    for (int i = 0; i < this->num_inputs_; ++i) {
-        if (cudaMalloc(&this->input_cuda_buffers_[i], input_sizes[i]) != cudaSuccess) {
-            std::cerr << "[TRT_ENGINE] Failed to allocate input buffer " << i 
-                      << " (" << input_sizes[i] << " bytes)" << std::endl;
-            deallocate_buffers(); // Clean up any partial allocations
-            return;
-        }
+    const auto& input_sizes = this->get_input_size_bytes();
+    const auto& output_sizes = this->get_output_size_bytes();
+    // Activation memory of the selected profile only.
+    const size_t activation_size = static_cast<size_t>(
+        this->engine_->getDeviceMemorySizeForProfileV2(this->profile_index_));
+
+    // One binding set (inputs, outputs, activation memory) per execution context,
+    // all inside a single allocation.
+    std::vector<size_t> block_sizes;
+    for (int context = 0; context < this->get_num_contexts(); ++context) {
+        block_sizes.insert(block_sizes.end(), input_sizes.begin(), input_sizes.end());
+        block_sizes.insert(block_sizes.end(), output_sizes.begin(), output_sizes.end());
+        block_sizes.push_back(activation_size);
     }
+    this->arena_plan_ = plan_arena(block_sizes);
 
-    // Allocate output buffers
-    this->output_cuda_buffers_.resize(this->num_outputs_);
-    for (int i = 0; i < this->num_outputs_; ++i) {
-        if (cudaMalloc(&this->output_cuda_buffers_[i], output_sizes[i]) != cudaSuccess) {
-            std::cerr << "[TRT_ENGINE] Failed to allocate output buffer " << i 
-                      << " (" << output_sizes[i] << " bytes)" << std::endl;
-            deallocate_buffers(); // Clean up any partial allocations
-            return;
-        }
+    if (cudaMalloc(&this->device_arena_, this->arena_plan_.total_bytes) != cudaSuccess) {
+        std::cerr << "[TRT_ENGINE] Failed to allocate device arena (" 
+                  << this->arena_plan_.total_bytes << " bytes)" << std::endl;
+        this->device_arena_ = nullptr;
+        return;
     }
 
-    // Update the references to the memory locations used during inference
-    this->bindings_.clear();
-    this->bindings_.insert(this->bindings_.end(), this->input_cuda_buffers_.begin(), this->input_cuda_buffers_.end());
-    this->bindings_.insert(this->bindings_.end(), this->output_cuda_buffers_.begin(), this->output_cuda_buffers_.end());
-
+    constexpr double MB = 1024.0 * 1024.0;
     std::cout << "[TRT_ENGINE] Successfully allocated " 
-              << this->num_inputs_ << " input and " << this->num_outputs_ << " output buffers\n";
-    std::cout << "\tTotal size of bindings is " 
-              << this->bindings_.size() << " elements." << std::endl;
+              << this->num_inputs_ << " input and " << this->num_outputs_ << " output buffers per context\n";
+    std::cout << "\tDevice arena: " << (this->arena_plan_.total_bytes / MB) << " MB for " 
+              << this->get_num_contexts() << " contexts (activation " 
+              << (activation_size / MB) << " MB each), padding " 
+              << this->arena_plan_.padding_bytes() << " bytes" << std::endl;
 }
 
-bool TrtInferenceEngine::validate_buffers(
-    const std::vector<void*>& input_bufs, 
-    const std::vector<size_t>& input_sizes,
-    const std::vector<void*>& output_bufs,
-    const std::vector<size_t>& output_sizes) const 
+void* TrtInferenceEngine::arena_block(int context, int block) const noexcept
 {
-    // Check counts match
-    if (input_bufs.size() != this->num_inputs_ || output_bufs.size() != this->num_outputs_) {
-        std::cerr << "[TRT_ENGINE] Buffer count mismatch\n"
-                  << "Expected " << this->num_inputs_ << " inputs, got " << input_bufs.size() << "\n"
-                  << "Expected " << this->num_outputs_ << " outputs, got " << output_bufs.size() << std::endl;
-        return false;
+    const size_t blocks_per_context = static_cast<size_t>(this->num_inputs_ + this->num_outputs_ + 1);
+    return this->arena_plan_.block(this->device_arena_, context * blocks_per_context + block);
+}
+
+void TrtInferenceEngine::allocate_contexts()
+{
+    if (!this->slots_.empty()) {
+        std::cerr << "[TRT_ENGINE] Error: Execution contexts already allocated!" << std::endl;
+        return;
+    }
+    if (this->device_arena_ == nullptr) {
+        throw std::runtime_error("[TRT_ENGINE] Device arena missing - cannot create execution contexts");
     }
 
-    // Check sizes match
-    const auto expected_input_sizes = this->get_input_size_bytes();
-    const auto expected_output_sizes = this->get_output_size_bytes();
-    
-    bool valid = true;
-    
-    // Validate input buffers
-    for (int i = 0; i < this->num_inputs_; ++i) {
-        if (!input_bufs[i]) {
-            std::cerr << "[TRT_ENGINE] Null input buffer at index " << i << std::endl;
-            valid = false;
+    const auto& output_sizes = this->get_output_size_bytes();
+    const int activation_block = this->num_inputs_ + this->num_outputs_;
+
+    this->slots_.resize(this->get_num_contexts());
+    for (int c = 0; c < this->get_num_contexts(); c++) {
+        ExecutionSlot& slot = this->slots_[c];
+
+        // Activation memory is supplied from the device arena.
+        const auto t = std::chrono::steady_clock::now();
+        slot.context = std::unique_ptr<nvinfer1::IExecutionContext>(this->engine_->createExecutionContext(
+            nvinfer1::ExecutionContextAllocationStrategy::kUSER_MANAGED));
+        this->load_stats_.context_ms += std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t).count();
+        bool ok = slot.context != nullptr
+            && cudaStreamCreateWithFlags(&slot.stream, cudaStreamNonBlocking) == cudaSuccess
+            && cudaEventCreateWithFlags(&slot.done, cudaEventDisableTiming) == cudaSuccess;
+
+        if (ok) {
+            slot.context->setDeviceMemoryV2(this->arena_block(c, activation_block), 
+                static_cast<int64_t>(this->arena_plan_.sizes[activation_block]));
+        }
+
+        // Dynamic engines: select the profile and start every context at the max shapes.
+        slot.bound_input_dims.assign(this->num_inputs_, nvinfer1::Dims{});
+        if (ok && this->is_dynamic()) {
+            ok = slot.context->setOptimizationProfileAsync(this->profile_index_, slot.stream)
+                && this->bind_input_shapes(slot, nullptr);
         }
-        if (input_sizes[i] != expected_input_sizes[i]) {
-            std::cerr << "[TRT_ENGINE] Input " << i << " size mismatch\n"
-                      << "Expected " << expected_input_sizes[i] << " bytes, got " 
-                      << input_sizes[i] << std::endl;
-            valid = false;
+
+        slot.input_cuda_buffers.resize(this->num_inputs_, nullptr);
+        for (int i = 0; i < this->num_inputs_; ++i) {
+            slot.input_cuda_buffers[i] = this->arena_block(c, i);
+        }
+        slot.output_cuda_buffers.resize(this->num_outputs_, nullptr);
+        slot.host_outputs.resize(this->num_outputs_, nullptr);
+        for (int i = 0; i < this->num_outputs_; ++i) {
+            slot.output_cuda_buffers[i] = this->arena_block(c, this->num_inputs_ + i);
+        }
+        for (int i = 0; i < this->num_outputs_ && ok; ++i) {
+            ok = (slot.host_outputs[i] = pinned_host_pool().acquire(output_sizes[i])) != nullptr;
         }
-    }
 
-    // Validate output buffers
-    for (int i = 0; i < this->num_outputs_; ++i) {
-        if (!output_bufs[i]) {
-            std::cerr << "[TRT_ENGINE] Null output buffer at index " << i << std::endl;
-            valid = false;
+        if (!ok) {
+            deallocate_contexts(); // Clean up any partial allocations
+            throw std::runtime_error("[TRT_ENGINE] Failed to create resources for execution context " 
+                + std::to_string(c));
         }
-        if (output_sizes[i] != expected_output_sizes[i]) {
-            std::cerr << "[TRT_ENGINE] Output " << i << " size mismatch\n"
-                      << "Expected " << expected_output_sizes[i] << " bytes, got " 
-                      << output_sizes[i] << std::endl;
-            valid = false;
+
+        // Bind every tensor address by name, once - the arena never moves.
+        for (int i = 0; i < this->num_inputs_ && ok; ++i) {
+            ok = slot.context->setTensorAddress(this->input_names_[i].c_str(), slot.input_cuda_buffers[i]);
+        }
+        for (int i = 0; i < this->num_outputs_ && ok; ++i) {
+            ok = slot.context->setTensorAddress(this->output_names_[i].c_str(), slot.output_cuda_buffers[i]);
+        }
+        if (!ok) {
+            deallocate_contexts();
+            throw std::runtime_error("[TRT_ENGINE] Failed to bind tensor addresses for execution context " 
+                + std::to_string(c));
         }
     }
 
-    return valid;
+    std::cout << "[TRT_ENGINE] Created " << this->slots_.size() << " execution contexts sharing one engine ("
+              << this->load_stats_.context_ms << " ms)" << std::endl;
 }
 
-void TrtInferenceEngine::deallocate_buffers() 
+void TrtInferenceEngine::deallocate_contexts()
 {
-    for (void* buf : input_cuda_buffers_) 
+    for (ExecutionSlot& slot : this->slots_)
     {
-        if (buf) {
-            cudaFree(buf);
-            buf = nullptr;
+        if (slot.stream) {
+            cudaStreamSynchronize(slot.stream);
+        }
+        // Device buffers live in the arena, which deallocate_buffers() frees.
+        for (void* buf : slot.host_outputs) {
+            pinned_host_pool().release(buf);
         }
+        if (slot.done) cudaEventDestroy(slot.done);
+        if (slot.stream) cudaStreamDestroy(slot.stream);
+        slot.context.reset();
     }
-    this->input_cuda_buffers_.clear();
+    this->slots_.clear();
+}
 
-    for (void* buf : output_cuda_buffers_) 
-    {
-        if (buf) {
-            cudaFree(buf);
-            buf = nullptr;
-        }
+void TrtInferenceEngine::deallocate_buffers() 
+{
+    // Every binding (and activation block) lives inside the arena - one free releases them all.
+    if (this->device_arena_) {
+        cudaFree(this->device_arena_);
+        this->device_arena_ = nullptr;
     }
-    this->output_cuda_buffers_.clear();
-    this->bindings_.clear();
     std::cout << "[TRT_ENGINE] Freed all Cuda allocated memory..." << std::endl;
 }
 
 void TrtInferenceEngine::shutdown_engine()
 {
-    this->context_.reset(); 
     this->engine_.reset();  
     this->runtime_.reset(); 
     std::cout << "[TRT_ENGINE] Deallocated TensorRT resources..." << std::endl;
@@ -4,12 +4,18 @@
 #include "NvInfer.h"
 #include "cuda_runtime_api.h"
 
+#include "TRT_inference_backend.hpp"
+#include "TRT_engine_file.hpp"
+#include "TRT_device_arena.hpp"
+
 #include <iostream>
 #include <vector>
 #include <cstring>
 #include <string>
 #include <memory>
 #include <fstream>
+#include <numeric>
+#include <functional>
 
 using namespace nvinfer1;
 
@@ -45,111 +51,80 @@ public:
 
 /// @brief Generic TensorRT inference engine class.
 /// This implements low-level inference functions.
-class TrtInferenceEngine 
+/// Tensors are addressed by name (getIOTensorName / setTensorAddress), and execution is always
+/// enqueued on a stream (enqueueV3).
+/// One deserialized ICudaEngine is shared by a pool of execution contexts. Each context owns its own
+/// binding set, activation memory, Cuda stream and completion event, so several threads (and several
+/// in-flight async inferences) run concurrently without paying for the weights more than once.
+class TrtInferenceEngine : public InferenceBackend
 {
 public:
-    explicit TrtInferenceEngine(const std::string& engine_path)
+    /// @param engine_path Path to the .engine file.
+    /// @param num_contexts Number of execution contexts (concurrent sync calls + in-flight async calls).
+    /// @param load_options How the .engine file is read (memory-mapped by default), and the batch size
+    /// the optimization profile of a dynamic-shape engine is selected for.
+    /// @throws std::runtime_error if the engine cannot be read or deserialized, or no profile fits.
+    explicit TrtInferenceEngine(const std::string& engine_path, int num_contexts = 2,
+        const EngineLoadOptions& load_options = EngineLoadOptions())
+        : InferenceBackend(num_contexts)
     {
-        this->load_engine(engine_path);
-        this->calculate_model_parameters();
+        this->load_engine(engine_path, load_options);
+        this->calculate_model_parameters(load_options.batch_size);
         this->allocate_buffers();
+        try
+        {
+            this->allocate_contexts();
+        }
+        catch (...)
+        {
+            this->deallocate_buffers(); // The destructor does not run for a throwing constructor.
+            throw;
+        }
     }
 
     ~TrtInferenceEngine()
     {                    
+        this->deallocate_contexts();
         this->deallocate_buffers();
         this->shutdown_engine();
     }
 
-    /// @brief Performs inference using the loaded model. The input/output must be sized appropriately.
-    /// Recommended to pre-allocate them using get_input_size_bytes() and get_output_size_bytes()
-    /// prior to calling this function. 
-    /// @param input_buf An std::vector containing the pointer to the input buffer(s).
-    /// @param size_in_param An std::vector containing the size (bytes) of the elements of input_buf. 
-    /// Should == this->get_input_size_bytes()
-    /// @param output_buf An std::vector containing the pointer to the output buffer.
-    /// @param size_out_param An std::vector containing the size (bytes) of the elements of the output buffer. 
-    /// Should == this->get_output_size_bytes()
-    /// @return TRUE if inference succeeded.
-    bool infer_b(const std::vector<void*> &input_buf, std::vector<size_t> &size_in_param, 
-        std::vector<void*> &output_buf, std::vector<size_t> &size_out_param);
-
-    /// @brief Performs inference using the loaded model. The input/output must be sized appropriately.
-    /// Recommended to pre-allocate them using get_input_size_bytes() and get_output_size_bytes()
-    /// prior to calling this function. 
-    /// This function enqueues the inference result using Cuda stream so that you can asynchronously
-    /// execute other functions in the meantime.
-    /// @param input_buf The pointer to the input buffer.
-    /// @param size_in_param The size (bytes) of the input buffer. 
-    /// Should == this->get_input_size_bytes()
-    /// @return TRUE if successfully enqueued.
-    bool infer_async(const std::vector<void*> &input_buf, std::vector<size_t> &size_in_param);
-
-    /// @brief Performs inference using the loaded model. The input/output must be sized appropriately.
-    /// Recommended to pre-allocate them using get_input_size_bytes() and get_output_size_bytes()
-    /// prior to calling this function. 
-    /// This function retrieves an async result from the Cuda stream (if available).
-    /// @param output_buf The pointer to the output buffer.
-    /// @param size_out_param The size (bytes) of the output buffer. 
-    /// Should == this->get_output_size_bytes()
-    /// @return Output size, or 0 on failure.
-    size_t retrieve_infer_result_async(const std::vector<void*> &output_buf, 
-        std::vector<size_t> &size_out_param);
-
-    /// @brief Get number of model inputs
-    int get_num_inputs() const noexcept { return this->num_inputs_; }
-
-    /// @brief Get number of model outputs
-    int get_num_outputs() const noexcept { return this->num_outputs_; }
-
-    /// @brief Get shapes for all inputs
-    const std::vector<std::vector<int>>& get_input_shapes() const 
-    {
-        return this->input_shapes_;
-    }
+    /// @brief Enqueues a complete inference (H2D copy, execution, D2H copy) on a caller-supplied stream.
+    /// Returns as soon as the work is enqueued - the host never blocks on the GPU here.
+    /// The lease must be held, and the input/output buffers kept alive, until the stream has been synchronized.
+    /// @param lease The execution context to run on (see lease_context()).
+    /// @param stream The Cuda stream to enqueue on.
+    /// @return TRUE if everything was enqueued.
+    bool enqueue(const ContextLease &lease, const std::vector<void*> &input_buf, 
+        const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf, 
+        const std::vector<size_t> &size_out_param, cudaStream_t stream);
 
-    /// @brief Get shapes for all outputs
-    const std::vector<std::vector<int>>& get_output_shapes() const 
-    {
-        return this->output_shapes_;
-    }
+    /// @brief Get the process-wide pinned host buffer pool
+    HostBufferPool& get_host_buffer_pool() const noexcept override { return pinned_host_pool(); }
 
-    /// @brief Get element counts for all inputs
-    const std::vector<size_t>& get_input_elements() const 
-    {
-        return this->trt_input_element_counts_;
-    }
+    /// @brief Get the layout of the device arena holding every binding and activation block
+    const ArenaPlan& get_arena_plan() const noexcept { return this->arena_plan_; }
 
-    /// @brief Get element counts for all outputs
-    const std::vector<size_t>& get_output_elements() const 
-    {
-        return this->trt_output_element_counts_;
-    }
+    /// @brief Get the timing breakdown of the engine load
+    const EngineLoadStats& get_load_stats() const noexcept { return this->load_stats_; }
 
-    /// @brief Get byte sizes for all inputs
-    /// @param element_size Size per element in bytes (default float32)
-    std::vector<size_t> get_input_size_bytes(size_t element_size = sizeof(float)) const 
-    {
-        const auto& elems = get_input_elements();
-        std::vector<size_t> sizes(this->num_inputs_);
-        for (int i = 0; i < this->num_inputs_; i++)
-        {
-            sizes[i] = trt_input_element_counts_[i] * element_size;
-        }
-        return sizes;
-    }
+protected:
 
-    /// @brief Get byte sizes for all outputs  
-    /// @param element_size Size per element in bytes (default float32)
-    std::vector<size_t> get_output_size_bytes(size_t element_size = sizeof(float)) const 
-    {
-        std::vector<size_t> sizes(this->num_outputs_);
-        for (int i = 0; i < this->num_outputs_; i++)
-        {
-            sizes[i] = trt_output_element_counts_[i] * element_size;
-        }
-        return sizes;
-    }
+    /// @brief Copies the inputs in, executes and copies the outputs out on the context's stream,
+    /// then waits for that stream only.
+    bool execute_on_context(int context, const std::vector<void*> &input_buf,
+        const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf,
+        const std::vector<size_t> &size_out_param, const std::vector<TensorShape> *input_shapes,
+        std::vector<TensorShape> *output_shapes) override;
+
+    /// @brief Enqueues H2D copy, execution and D2H copy (into pinned staging) on the context's
+    /// stream, and records its completion event.
+    bool enqueue_on_context(int context, const std::vector<void*> &input_buf,
+        const std::vector<size_t> &size_in_param) override;
+
+    /// @brief Polls or blocks on the context's completion event, then copies the staged outputs out.
+    AsyncInferStatus collect_from_context(int context, const std::vector<void*> &output_buf,
+        const std::vector<size_t> &size_out_param, bool wait) override;
 
 private:
 
@@ -159,72 +134,109 @@ private:
     // TensorRT runtime resources - must be initialized in constructor.
     std::unique_ptr<nvinfer1::IRuntime> runtime_;
     std::unique_ptr<nvinfer1::ICudaEngine> engine_;
-    std::unique_ptr<nvinfer1::IExecutionContext> context_;
 
-    // Model dimensions - these are assigned in the constructor when model is loaded.
-    int num_inputs_; // Number of inputs (e.g. 1 image for YOLO)
-    int num_outputs_; // Number of outputs (e.g. 4 objects for YOLO)
-    
+    // Dimensions the buffers are sized for (the max shapes of the selected profile for dynamic engines).
     std::vector<nvinfer1::Dims> input_dims_;
     std::vector<nvinfer1::Dims> output_dims_;
 
-    std::vector<std::vector<int>> input_shapes_;
-    std::vector<std::vector<int>> output_shapes_;
-
-    // The names of each input or output
-    std::vector<std::string> input_names_;
-    std::vector<std::string> output_names_;
-
     // Dynamically allocated buffers for inference.
     // Must be allocated in the constructor, and never again.
-    std::vector<void*> input_cuda_buffers_;  // Stores pointers to input buffers
-    std::vector<void*> output_cuda_buffers_; // Stores pointers to output buffers
-    std::vector<void*> bindings_; // References the combined input_cuda_buffers_ and output_cuda_buffers_. 
+    // A single cudaMalloc holding, for every execution context, the inputs, the outputs and
+    // the context activation memory.
+    void* device_arena_ = nullptr;
+    ArenaPlan arena_plan_;
 
-    // The size of the I/O - in elements only - to get bytes you need to call
-    // this->get_output_size_bytes() or this->get_input_size_bytes()
-    std::vector<size_t> trt_input_element_counts_;
-    std::vector<size_t> trt_output_element_counts_;
+    /// @brief Resources of one execution context.
+    struct ExecutionSlot
+    {
+        std::unique_ptr<nvinfer1::IExecutionContext> context;
+        cudaStream_t stream = nullptr;
+        cudaEvent_t done = nullptr; // Recorded after the D2H copy of an async inference.
+        std::vector<void*> input_cuda_buffers;  // Point into the device arena
+        std::vector<void*> output_cuda_buffers; // Point into the device arena
+        std::vector<void*> host_outputs; // From the pinned pool; async results land here before retrieval.
+        std::vector<nvinfer1::Dims> bound_input_dims; // Input shapes last set on the context (dynamic engines).
+    };
+
+    std::vector<ExecutionSlot> slots_; // Indexed by the InferenceBackend context index
+
+    EngineLoadStats load_stats_;
+
+    /// @brief Enqueues H2D copies, enqueueV3 and D2H copies for one context on stream. Never waits.
+    /// @param input_shapes Per-call input shapes, or nullptr for the full (max) shapes.
+    /// @param output_shapes Receives the actual output shapes when input_shapes is given.
+    bool enqueue_inference(int context, const std::vector<void*> &input_buf, 
+        const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf, 
+        const std::vector<size_t> &size_out_param, cudaStream_t stream,
+        const std::vector<TensorShape> *input_shapes = nullptr, std::vector<TensorShape> *output_shapes = nullptr);
+
+    /// @brief Enqueues input shapes, H2D copies and enqueueV3 for one context on stream. Never waits.
+    /// @param input_shapes Per-call input shapes, or nullptr for the full (max) shapes.
+    bool enqueue_execution(int context, const std::vector<void*> &input_buf, 
+        const std::vector<size_t> &size_in_param, cudaStream_t stream, const std::vector<TensorShape> *input_shapes);
+
+    /// @brief Synchronous inference with valid-rows-only output copies: transfers the uncounted outputs
+    /// (count tensors included), waits, then transfers only the valid prefix of each counted output.
+    bool execute_valid_rows(int context, const std::vector<void*> &input_buf,
+        const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf,
+        const std::vector<size_t> &size_out_param);
+
+    /// @brief Sets the input dimensions of a context, skipping the call when they are unchanged.
+    /// @param input_shapes Per-call input shapes, or nullptr for the full (max) shapes.
+    bool bind_input_shapes(ExecutionSlot& slot, const std::vector<TensorShape> *input_shapes);
 
     /// @brief Load the .engine file from a text string.
     /// This should only be called at the start of the program.
     /// @param engine_path Path to the .engine file...
-    void load_engine(const std::string& engine_path);
+    /// @param options How the file is read.
+    /// @throws std::runtime_error if the file is missing or the engine cannot be deserialized.
+    void load_engine(const std::string& engine_path, const EngineLoadOptions& options);
 
-    /// @brief Calculates and validates model parameters, populating input/output dimensions
-    /// @throws std::runtime_error if model structure is invalid
-    void calculate_model_parameters();
+    /// @brief Calculates and validates model parameters, populating input/output dimensions.
+    /// Dynamic inputs are resolved to the max shapes of the profile selected for batch_size.
+    /// @throws std::runtime_error if model structure is invalid or no profile accepts batch_size
+    void calculate_model_parameters(int batch_size);
+
+    /// @brief Builds the descriptor of a binding from its TensorRT data type and format.
+    /// @throws std::runtime_error for a data type without a TensorDataType equivalent.
+    TensorDesc describe_tensor(const std::string& name, bool is_input, const TensorShape& shape) const;
+
+    /// @brief Reads the shape range of every input in every optimization profile.
+    std::vector<OptimizationProfile> read_profiles(const std::vector<TensorShape>& declared_input_shapes) const;
+
+    /// @brief Output dimensions with every input set to its capacity (max) shape.
+    /// @throws std::runtime_error if an output shape cannot be resolved.
+    std::vector<nvinfer1::Dims> resolve_output_dims() const;
     
     /// @brief Helper function to validate and calculate the elements.
     size_t validate_and_calculate_elements(const nvinfer1::Dims& dims, const std::string& name);
 
-    /// @brief Helper function to count the number of input or output 
-    size_t count_number_of_io(const nvinfer1::Dims& dims, const std::string &name)
-
     /// @brief Helper function to print the memory layout of model.
     void print_strides(const nvinfer1::Dims& dims);
 
     /// @brief Allocate the CUDA buffers for inference.
     /// This must be called after load_engine() in the constructor. 
+    /// Plans and allocates the device arena used by every execution context.
     void allocate_buffers();
 
+    /// @brief Address of a block inside the device arena.
+    /// @param context Execution context index.
+    /// @param block Inputs first, then outputs, then the activation memory.
+    void* arena_block(int context, int block) const noexcept;
+
     /// @brief Calculate volume of dimensions (helper function)
     size_t dims_volume(const nvinfer1::Dims& d) noexcept {
         return std::accumulate(d.d, d.d + d.nbDims, 1, std::multiplies<size_t>());
     }
 
-    /// @brief Prior to inference, checks to make sure that the I/O buffers are
-    /// correctly sized for the loaded model.
-    /// @param input_bufs Input buffers
-    /// @param input_sizes Sizes of input buffers (bytes)
-    /// @param output_bufs Output buffers
-    /// @param output_sizes Sizes of output buffers (bytes)
-    /// @return TRUE if valid, else FALSE. (An error message will print.)
-    bool validate_buffers(
-        const std::vector<void*>& input_bufs, 
-        const std::vector<size_t>& input_sizes,
-        const std::vector<void*>& output_bufs,
-        const std::vector<size_t>& output_sizes) const ;
+    /// @brief Creates the execution context, stream, event and staging buffers of every pool entry.
+    /// This must be called after allocate_buffers() in the constructor.
+    /// @throws std::runtime_error if any resource cannot be created.
+    void allocate_contexts();
+
+    /// @brief Releases every execution context, waiting for in-flight work first.
+    /// This should be called in the destructor only.
+    void deallocate_contexts();
 
     /// @brief Deallocate the CUDA buffers.        
     // /// This should be called in the destructor only.
@@ -234,4 +246,3 @@ private:
     /// This should be called in the destructor only.
     void shutdown_engine();
 };
-
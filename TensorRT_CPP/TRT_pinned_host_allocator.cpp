@@ -0,0 +1,30 @@
+#include "TRT_host_allocator.hpp"
+
+#include "cuda_runtime_api.h"
+
+#include <iostream>
+
+void* PinnedHostAllocator::allocate(size_t bytes)
+{
+    void* ptr = nullptr;
+    const cudaError_t status = cudaHostAlloc(&ptr, bytes, cudaHostAllocPortable);
+    if (status != cudaSuccess)
+    {
+        std::cerr << "[HOST_POOL] cudaHostAlloc(" << bytes << ") failed: " << cudaGetErrorString(status) << std::endl;
+        return nullptr;
+    }
+    return ptr;
+}
+
+void PinnedHostAllocator::deallocate(void* ptr, size_t /*bytes*/)
+{
+    cudaFreeHost(ptr);
+}
+
+HostBufferPool& pinned_host_pool()
+{
+    // Intentionally never destroyed: static destructors may run after the CUDA runtime has
+    // been torn down, where cudaFreeHost would fail. The OS reclaims the memory at exit.
+    static HostBufferPool* pool = new HostBufferPool(std::make_unique<PinnedHostAllocator>());
+    return *pool;
+}
@@ -0,0 +1,192 @@
+#include "TRT_tensor_desc.hpp"
+#include "TRT_half.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    /// @brief Rounds value to the nearest integer and clamps it into [lo, hi].
+    template <typename T>
+    T saturate(float value, double lo, double hi) noexcept
+    {
+        if (std::isnan(value)) return T(0);
+        return static_cast<T>(std::min(std::max(std::nearbyint(static_cast<double>(value)), lo), hi));
+    }
+
+    /// @brief shape with the vectorized dimension rounded up to a multiple of components.
+    TensorShape pad_vectorized(const TensorShape& shape, int vectorized_dim, int components) noexcept
+    {
+        TensorShape padded = shape;
+        if (vectorized_dim >= 0 && vectorized_dim < static_cast<int>(padded.size()) && components > 1
+            && padded[vectorized_dim] > 0)
+        {
+            padded[vectorized_dim] = (padded[vectorized_dim] + components - 1) / components * components;
+        }
+        return padded;
+    }
+
+    /// @brief shape_volume(pad_vectorized(shape, ...)), without building the padded shape.
+    size_t padded_volume(const TensorShape& shape, int vectorized_dim, int components) noexcept
+    {
+        if (shape.empty())
+        {
+            return 0;
+        }
+        size_t volume = 1;
+        for (int d = 0; d < static_cast<int>(shape.size()); d++)
+        {
+            int dim = shape[d];
+            if (dim <= 0) return 0;
+            if (d == vectorized_dim && components > 1)
+            {
+                dim = (dim + components - 1) / components * components;
+            }
+            volume *= static_cast<size_t>(dim);
+        }
+        return volume;
+    }
+}
+
+size_t data_type_bits(TensorDataType dtype) noexcept
+{
+    switch (dtype)
+    {
+        case TensorDataType::kFLOAT: return 32;
+        case TensorDataType::kHALF: return 16;
+        case TensorDataType::kBF16: return 16;
+        case TensorDataType::kFP8: return 8;
+        case TensorDataType::kINT8: return 8;
+        case TensorDataType::kUINT8: return 8;
+        case TensorDataType::kINT32: return 32;
+        case TensorDataType::kINT64: return 64;
+        case TensorDataType::kINT4: return 4;
+        case TensorDataType::kBOOL: return 8;
+    }
+    return 32;
+}
+
+const char* data_type_name(TensorDataType dtype) noexcept
+{
+    switch (dtype)
+    {
+        case TensorDataType::kFLOAT: return "f32";
+        case TensorDataType::kHALF: return "f16";
+        case TensorDataType::kBF16: return "bf16";
+        case TensorDataType::kFP8: return "fp8";
+        case TensorDataType::kINT8: return "i8";
+        case TensorDataType::kUINT8: return "u8";
+        case TensorDataType::kINT32: return "i32";
+        case TensorDataType::kINT64: return "i64";
+        case TensorDataType::kINT4: return "i4";
+        case TensorDataType::kBOOL: return "bool";
+    }
+    return "unknown";
+}
+
+bool parse_data_type(const std::string& name, TensorDataType& dtype) noexcept
+{
+    static const TensorDataType all[] = {
+        TensorDataType::kFLOAT, TensorDataType::kHALF, TensorDataType::kBF16, TensorDataType::kFP8,
+        TensorDataType::kINT8, TensorDataType::kUINT8, TensorDataType::kINT32, TensorDataType::kINT64,
+        TensorDataType::kINT4, TensorDataType::kBOOL,
+    };
+    for (TensorDataType candidate : all)
+    {
+        if (name == data_type_name(candidate))
+        {
+            dtype = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+TensorDesc make_tensor_desc(const std::string& name, bool is_input, TensorDataType dtype, const TensorShape& shape,
+    int vectorized_dim, int components_per_element)
+{
+    TensorDesc desc;
+    desc.name = name;
+    desc.is_input = is_input;
+    desc.dtype = dtype;
+    desc.shape = shape;
+    desc.vectorized_dim = components_per_element > 1 ? vectorized_dim : -1;
+    desc.components_per_element = desc.vectorized_dim >= 0 ? components_per_element : 1;
+    desc.padded_shape = pad_vectorized(shape, desc.vectorized_dim, desc.components_per_element);
+
+    // Row-major, with the vector (if any) as the innermost, contiguous run.
+    desc.strides.assign(shape.size(), 0);
+    int64_t stride = desc.components_per_element;
+    for (int d = static_cast<int>(shape.size()) - 1; d >= 0; d--)
+    {
+        desc.strides[d] = stride;
+        const int64_t extent = std::max(desc.padded_shape[d], 0);
+        stride *= (d == desc.vectorized_dim) ? extent / desc.components_per_element : extent;
+    }
+
+    desc.elements = shape_volume(desc.padded_shape);
+    desc.size_bytes = tensor_size_bytes(desc, shape);
+    return desc;
+}
+
+size_t tensor_size_bytes(const TensorDesc& desc, const TensorShape& shape) noexcept
+{
+    const size_t elements = padded_volume(shape, desc.vectorized_dim, desc.components_per_element);
+    return (elements * data_type_bits(desc.dtype) + 7) / 8;
+}
+
+float load_element(const void* data, TensorDataType dtype, size_t index) noexcept
+{
+    switch (dtype)
+    {
+        case TensorDataType::kFLOAT: return static_cast<const float*>(data)[index];
+        case TensorDataType::kHALF: return half_to_float(static_cast<const uint16_t*>(data)[index]);
+        case TensorDataType::kBF16:
+        {
+            const uint32_t bits = static_cast<uint32_t>(static_cast<const uint16_t*>(data)[index]) << 16;
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        case TensorDataType::kINT8: return static_cast<const int8_t*>(data)[index];
+        case TensorDataType::kUINT8: return static_cast<const uint8_t*>(data)[index];
+        case TensorDataType::kBOOL: return static_cast<const uint8_t*>(data)[index] ? 1.0f : 0.0f;
+        case TensorDataType::kINT32: return static_cast<float>(static_cast<const int32_t*>(data)[index]);
+        case TensorDataType::kINT64: return static_cast<float>(static_cast<const int64_t*>(data)[index]);
+        case TensorDataType::kFP8:
+        case TensorDataType::kINT4:
+            break;
+    }
+    return 0.0f;
+}
+
+void store_element(void* data, TensorDataType dtype, size_t index, float value) noexcept
+{
+    switch (dtype)
+    {
+        case TensorDataType::kFLOAT: static_cast<float*>(data)[index] = value; break;
+        case TensorDataType::kHALF: static_cast<uint16_t*>(data)[index] = float_to_half(value); break;
+        case TensorDataType::kBF16:
+        {
+            // Round to nearest even on the 16 dropped bits (NaN stays NaN).
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            const uint32_t rounded = std::isnan(value) ? (bits | 0x00400000u) : bits + 0x7FFFu + ((bits >> 16) & 1u);
+            static_cast<uint16_t*>(data)[index] = static_cast<uint16_t>(rounded >> 16);
+            break;
+        }
+        case TensorDataType::kINT8: static_cast<int8_t*>(data)[index] = saturate<int8_t>(value, -128.0, 127.0); break;
+        case TensorDataType::kUINT8: static_cast<uint8_t*>(data)[index] = saturate<uint8_t>(value, 0.0, 255.0); break;
+        case TensorDataType::kBOOL: static_cast<uint8_t*>(data)[index] = value != 0.0f; break;
+        case TensorDataType::kINT32:
+            static_cast<int32_t*>(data)[index] = saturate<int32_t>(value, -2147483648.0, 2147483647.0);
+            break;
+        case TensorDataType::kINT64:
+            static_cast<int64_t*>(data)[index] = saturate<int64_t>(value, -9223372036854775808.0, 9223372036854774784.0);
+            break;
+        case TensorDataType::kFP8:
+        case TensorDataType::kINT4:
+            break;
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "TRT_tensor_shape.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief Element type of a binding (mirrors nvinfer1::DataType, without depending on TensorRT).
+enum class TensorDataType
+{
+    kFLOAT,
+    kHALF,
+    kBF16,
+    kFP8,
+    kINT8,
+    kUINT8,
+    kINT32,
+    kINT64,
+    kINT4,
+    kBOOL,
+};
+
+/// @brief Bits per element (4 for kINT4, which packs two elements per byte).
+size_t data_type_bits(TensorDataType dtype) noexcept;
+
+/// @brief Short name used in logs and descriptors ("f32", "f16", "bf16", "fp8", "i8", "u8", "i32", "i64", "i4", "bool").
+const char* data_type_name(TensorDataType dtype) noexcept;
+
+/// @brief Parses a name returned by data_type_name().
+/// @return FALSE if the name is unknown (dtype is left unchanged).
+bool parse_data_type(const std::string& name, TensorDataType& dtype) noexcept;
+
+/// @brief Layout of one binding: element type, shape, and vectorized format if any.
+/// Vectorized formats (e.g. kCHW32) pack components_per_element consecutive indices of vectorized_dim
+/// into one contiguous vector, padding that dimension up to a multiple of the vector width.
+struct TensorDesc
+{
+    std::string name;
+    bool is_input = false;
+    TensorDataType dtype = TensorDataType::kFLOAT;
+    TensorShape shape;                 // Shape the buffers are sized for
+    int vectorized_dim = -1;           // -1 for linear (scalar) formats
+    int components_per_element = 1;    // Vector width along vectorized_dim
+    TensorShape padded_shape;          // shape with vectorized_dim rounded up to the vector width
+    std::vector<int64_t> strides;      // Elements between neighbours along each dimension; along
+                                       // vectorized_dim, between neighbouring vectors
+    size_t elements = 0;               // Elements in padded_shape
+    size_t size_bytes = 0;
+
+    /// @brief Bytes per element, rounded up (kINT4 reports 1).
+    size_t element_size() const noexcept { return (data_type_bits(this->dtype) + 7) / 8; }
+};
+
+/// @brief Builds the descriptor of a binding: padded shape, strides, element count and byte size.
+/// Dynamic (-1) dimensions count as 0 elements.
+TensorDesc make_tensor_desc(const std::string& name, bool is_input, TensorDataType dtype, const TensorShape& shape,
+    int vectorized_dim = -1, int components_per_element = 1);
+
+/// @brief Bytes that a binding laid out like desc occupies at shape (e.g. a per-call dynamic shape).
+size_t tensor_size_bytes(const TensorDesc& desc, const TensorShape& shape) noexcept;
+
+/// @brief Reads element index of a buffer of type dtype, converted to float.
+/// kFP8 and kINT4 are not supported and read as 0.
+float load_element(const void* data, TensorDataType dtype, size_t index) noexcept;
+
+/// @brief Writes value to element index of a buffer of type dtype (integers are rounded and saturated).
+/// kFP8 and kINT4 are not supported and are left untouched.
+void store_element(void* data, TensorDataType dtype, size_t index, float value) noexcept;
@@ -0,0 +1,116 @@
+#include "TRT_tensor_shape.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+bool has_dynamic_dims(const TensorShape& shape) noexcept
+{
+    for (int dim : shape)
+    {
+        if (dim < 0) return true;
+    }
+    return false;
+}
+
+size_t shape_volume(const TensorShape& shape) noexcept
+{
+    if (shape.empty())
+    {
+        return 0;
+    }
+    size_t volume = 1;
+    for (int dim : shape)
+    {
+        if (dim <= 0) return 0;
+        volume *= static_cast<size_t>(dim);
+    }
+    return volume;
+}
+
+bool shape_within(const TensorShape& shape, const TensorShape& min, const TensorShape& max) noexcept
+{
+    if (shape.size() != min.size() || shape.size() != max.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < shape.size(); i++)
+    {
+        if (shape[i] < min[i] || shape[i] > max[i]) return false;
+    }
+    return true;
+}
+
+std::string shape_to_string(const TensorShape& shape)
+{
+    std::string text;
+    for (size_t i = 0; i < shape.size(); i++)
+    {
+        if (i > 0) text += "x";
+        text += std::to_string(shape[i]);
+    }
+    return text;
+}
+
+TensorShape resolve_dynamic_dims(const TensorShape& declared, const TensorShape& reference)
+{
+    TensorShape resolved;
+    resolve_dynamic_dims(declared, reference, resolved);
+    return resolved;
+}
+
+void resolve_dynamic_dims(const TensorShape& declared, const TensorShape& reference, TensorShape& resolved)
+{
+    resolved = declared;
+    for (size_t i = 0; i < resolved.size() && i < reference.size(); i++)
+    {
+        if (resolved[i] < 0)
+        {
+            resolved[i] = reference[i];
+        }
+    }
+}
+
+int select_profile(const std::vector<OptimizationProfile>& profiles, int batch_size)
+{
+    if (profiles.empty())
+    {
+        return -1;
+    }
+    if (batch_size <= 0)
+    {
+        return 0;
+    }
+
+    int best = -1;
+    size_t best_volume = std::numeric_limits<size_t>::max();
+    int best_distance = std::numeric_limits<int>::max();
+    for (size_t p = 0; p < profiles.size(); p++)
+    {
+        bool accepts = true;
+        size_t volume = 0;
+        int distance = 0;
+        for (const auto& input : profiles[p].inputs)
+        {
+            if (input.min.empty() || input.max.empty()
+                || batch_size < input.min[0] || batch_size > input.max[0])
+            {
+                accepts = false;
+                break;
+            }
+            volume += shape_volume(input.max);
+            distance = std::max(distance, std::abs(input.opt.empty() ? 0 : input.opt[0] - batch_size));
+        }
+        if (!accepts)
+        {
+            continue;
+        }
+        if (volume < best_volume || (volume == best_volume && distance < best_distance))
+        {
+            best = static_cast<int>(p);
+            best_volume = volume;
+            best_distance = distance;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// @brief Tensor dimensions, outermost first (e.g. {1, 3, 640, 640}). -1 marks a dynamic dimension.
+using TensorShape = std::vector<int>;
+
+/// @brief Value of a dynamic dimension in a declared shape.
+constexpr int DYNAMIC_DIM = -1;
+
+/// @brief Shape range of one input tensor within an optimization profile.
+struct ProfileShapes
+{
+    TensorShape min;
+    TensorShape opt;
+    TensorShape max;
+};
+
+/// @brief One optimization profile of an engine: a shape range for every input (in input order).
+struct OptimizationProfile
+{
+    int index = 0;
+    std::vector<ProfileShapes> inputs;
+};
+
+/// @brief TRUE if any dimension is dynamic (< 0).
+bool has_dynamic_dims(const TensorShape& shape) noexcept;
+
+/// @brief Number of elements. Returns 0 if the shape is empty or has a dynamic / zero dimension.
+size_t shape_volume(const TensorShape& shape) noexcept;
+
+/// @brief TRUE if shape has the same rank as min/max and min[i] <= shape[i] <= max[i] for every i.
+bool shape_within(const TensorShape& shape, const TensorShape& min, const TensorShape& max) noexcept;
+
+/// @brief Formats a shape as "1x3x640x640" ("-1" for dynamic dimensions).
+std::string shape_to_string(const TensorShape& shape);
+
+/// @brief Replaces every dynamic dimension of declared with the same dimension of reference.
+/// Dimensions that reference lacks (or that are dynamic there too) are left dynamic.
+TensorShape resolve_dynamic_dims(const TensorShape& declared, const TensorShape& reference);
+
+/// @brief As above, into resolved (reusing its storage, so per-call shapes need no allocation).
+void resolve_dynamic_dims(const TensorShape& declared, const TensorShape& reference, TensorShape& resolved);
+
+/// @brief Picks the profile best suited to running batch_size frames per call.
+/// Only profiles whose batch range (dimension 0 of every input) contains batch_size qualify.
+/// Among those, the one with the smallest max-shape volume wins (least memory reserved), and ties
+/// go to the profile whose opt batch is closest to batch_size.
+/// @param batch_size Requested batch; <= 0 selects profile 0.
+/// @return Index into profiles, or -1 if no profile accepts batch_size.
+int select_profile(const std::vector<OptimizationProfile>& profiles, int batch_size);
@@ -0,0 +1,96 @@
+#include "TRT_thread_pool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(int num_workers)
+{
+    if (num_workers < 0)
+    {
+        num_workers = std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    // Room for every worker to be wanted by a few nested loops at once before the queue has to grow.
+    this->queue_.reserve(static_cast<size_t>(num_workers) * 4);
+    for (int i = 0; i < num_workers; i++)
+    {
+        this->workers_.emplace_back(&ThreadPool::worker_loop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->stopping_ = true;
+    }
+    this->wake_.notify_all();
+    for (auto& worker : this->workers_)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::run(Job& job)
+{
+    // The caller takes one share of the work itself.
+    const size_t helpers = std::min(job.count - 1, this->workers_.size());
+    if (helpers > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->queue_.insert(this->queue_.end(), helpers, &job);
+        }
+        if (helpers == 1)
+        {
+            this->wake_.notify_one();
+        }
+        else
+        {
+            this->wake_.notify_all();
+        }
+    }
+
+    work(job);
+
+    if (helpers > 0)
+    {
+        // Every index has been handed out: helpers that have not picked the job up are no longer needed,
+        // and the ones inside it are finishing their last index.
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        this->queue_.erase(std::remove(this->queue_.begin(), this->queue_.end(), &job), this->queue_.end());
+        this->helpers_done_.wait(lock, [&job] { return job.helpers == 0; });
+    }
+}
+
+void ThreadPool::work(Job& job)
+{
+    for (size_t index = job.next.fetch_add(1, std::memory_order_relaxed); index < job.count;
+        index = job.next.fetch_add(1, std::memory_order_relaxed))
+    {
+        job.call(job.body, index);
+    }
+}
+
+void ThreadPool::worker_loop()
+{
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    while (true)
+    {
+        this->wake_.wait(lock, [this] { return this->stopping_ || !this->queue_.empty(); });
+        if (this->queue_.empty())
+        {
+            return; // Stopping
+        }
+        Job* job = this->queue_.front();
+        this->queue_.erase(this->queue_.begin());
+        job->helpers++;
+
+        lock.unlock();
+        work(*job);
+        lock.lock();
+
+        if (--job->helpers == 0)
+        {
+            this->helpers_done_.notify_all();
+        }
+    }
+}
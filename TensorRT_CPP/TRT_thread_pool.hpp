@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// @brief Fixed set of worker threads for data-parallel loops (see parallel_for()).
+/// The calling thread always works on its own loop, so a loop body may start another loop (the workers
+/// are never all blocked waiting on each other), and a pool without workers runs every loop on the caller.
+/// Thread-safe; in steady state parallel_for() performs no heap allocation.
+class ThreadPool
+{
+public:
+    /// @param num_workers Worker threads besides the callers (-1: one per hardware thread, minus one)
+    explicit ThreadPool(int num_workers = -1);
+
+    /// @brief Joins the workers. No parallel_for() may be running.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief Get the number of worker threads
+    int size() const noexcept { return static_cast<int>(this->workers_.size()); }
+
+    /// @brief Calls fn(i) for every i in [0, count), spread over the calling thread and the idle workers,
+    /// and returns once every call has returned. Indices are handed out one at a time, in order.
+    /// fn must not throw.
+    template <class Fn>
+    void parallel_for(size_t count, Fn&& fn)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        using Body = std::remove_reference_t<Fn>;
+        Job job;
+        job.count = count;
+        job.body = const_cast<void*>(static_cast<const void*>(&fn));
+        job.call = [](void* body, size_t index) { (*static_cast<Body*>(body))(index); };
+        this->run(job);
+    }
+
+private:
+
+    /// @brief One parallel_for() call. Lives on the caller's stack until every helper has left it.
+    struct Job
+    {
+        size_t count = 0;
+        std::atomic<size_t> next{0};
+        void* body = nullptr;
+        void (*call)(void*, size_t) = nullptr;
+        int helpers = 0; // Workers currently inside the job (guarded by mutex_)
+    };
+
+    /// @brief Works on job with as many idle workers as it can use, then waits for them to leave it.
+    void run(Job& job);
+
+    /// @brief Runs indices of job until none are left.
+    static void work(Job& job);
+
+    void worker_loop();
+
+    std::mutex mutex_;
+    std::condition_variable wake_;         // Work was queued, or the pool is stopping
+    std::condition_variable helpers_done_; // The last helper left a job
+    std::vector<Job*> queue_;              // One entry per helper a job wants, oldest first
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+};
@@ -0,0 +1,114 @@
+#include "TRT_valid_rows.hpp"
+
+#include <algorithm>
+
+namespace
+{
+    int find_output(const std::vector<TensorDesc>& outputs, const std::string& name)
+    {
+        for (size_t i = 0; i < outputs.size(); i++)
+        {
+            if (outputs[i].name == name) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    bool is_integer(TensorDataType dtype)
+    {
+        return dtype == TensorDataType::kINT32 || dtype == TensorDataType::kINT64
+            || dtype == TensorDataType::kINT8 || dtype == TensorDataType::kUINT8;
+    }
+}
+
+bool ValidRowPlan::build(const std::vector<CountedOutputs>& mapping, const std::vector<TensorDesc>& outputs,
+    std::string& error)
+{
+    this->clear();
+    std::vector<int> count_output(outputs.size(), -1);
+    std::vector<TensorDataType> count_type(outputs.size(), TensorDataType::kINT32);
+    std::vector<size_t> row_bytes(outputs.size(), 0);
+
+    for (const auto& entry : mapping)
+    {
+        const int count = find_output(outputs, entry.count_tensor);
+        if (count < 0)
+        {
+            error = "no output named '" + entry.count_tensor + "'";
+            return false;
+        }
+        if (!is_integer(outputs[count].dtype) || shape_volume(outputs[count].shape) != 1)
+        {
+            error = "count tensor '" + entry.count_tensor + "' must hold a single integer";
+            return false;
+        }
+
+        for (const auto& name : entry.dependent_tensors)
+        {
+            const int dependent = find_output(outputs, name);
+            if (dependent < 0)
+            {
+                error = "no output named '" + name + "'";
+                return false;
+            }
+            const TensorDesc& desc = outputs[dependent];
+            if (dependent == count || count_output[dependent] >= 0 || count_output[count] >= 0)
+            {
+                error = "output '" + name + "' cannot be counted by '" + entry.count_tensor + "'";
+                return false;
+            }
+            if (desc.vectorized_dim >= 0 || desc.dtype == TensorDataType::kINT4)
+            {
+                error = "output '" + name + "' is not a linear, byte-addressable tensor";
+                return false;
+            }
+
+            // Rows run along the first dimension that is not 1.
+            size_t rows = 1;
+            for (int dim : desc.shape)
+            {
+                if (dim != 1)
+                {
+                    rows = static_cast<size_t>(std::max(dim, 1));
+                    break;
+                }
+            }
+            count_output[dependent] = count;
+            count_type[dependent] = outputs[count].dtype;
+            row_bytes[dependent] = desc.size_bytes / rows;
+        }
+    }
+
+    // A count tensor must not itself depend on another count.
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        if (count_output[i] >= 0 && count_output[count_output[i]] >= 0)
+        {
+            error = "output '" + outputs[count_output[i]].name + "' is both a count and a dependent tensor";
+            return false;
+        }
+    }
+
+    this->count_output_ = std::move(count_output);
+    this->count_type_ = std::move(count_type);
+    this->row_bytes_ = std::move(row_bytes);
+    return true;
+}
+
+void ValidRowPlan::clear() noexcept
+{
+    this->count_output_.clear();
+    this->count_type_.clear();
+    this->row_bytes_.clear();
+}
+
+size_t ValidRowPlan::valid_bytes(int output, const void* count_data, size_t full_bytes) const noexcept
+{
+    const float count = load_element(count_data, this->count_type_[output], 0);
+    if (!(count > 0.0f))
+    {
+        return 0;
+    }
+    // A corrupt count never reads or writes past the buffer.
+    const double bytes = static_cast<double>(count) * static_cast<double>(this->row_bytes_[output]);
+    return bytes >= static_cast<double>(full_bytes) ? full_bytes : static_cast<size_t>(bytes);
+}
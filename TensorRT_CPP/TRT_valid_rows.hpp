@@ -0,0 +1,67 @@
+#pragma once
+
+#include "TRT_tensor_desc.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief A count output and the outputs whose leading rows it counts,
+/// e.g. num_dets -> {bboxes, scores, labels} for an NMS-embedded YOLO export.
+struct CountedOutputs
+{
+    std::string count_tensor;
+    std::vector<std::string> dependent_tensors;
+};
+
+/// @brief Bytes moved by valid-rows-only output copies.
+struct ValidRowStats
+{
+    uint64_t inferences = 0;    // Inferences that used valid-rows-only copies
+    uint64_t bytes_copied = 0;  // Output bytes transferred
+    uint64_t bytes_skipped = 0; // Output bytes a full copy would have transferred on top
+
+    /// @brief Get the average number of bytes saved per inference
+    double skipped_bytes_per_inference() const noexcept
+    {
+        return this->inferences ? static_cast<double>(this->bytes_skipped) / this->inferences : 0.0;
+    }
+};
+
+/// @brief Which outputs only need their leading rows copied, and how many bytes a row is.
+/// A row is a slice along the first dimension of extent other than 1 (the 100 of [1, 100, 4]);
+/// the count tensor holds a single integer, the number of valid rows.
+class ValidRowPlan
+{
+public:
+    /// @brief Resolves the mapping against the output descriptors.
+    /// Count tensors must be single-element integer outputs; dependent tensors must be linear outputs,
+    /// each counted by one count tensor only.
+    /// @param error Receives the reason when the mapping is rejected.
+    /// @return TRUE if the mapping is valid (the plan is left empty otherwise).
+    bool build(const std::vector<CountedOutputs>& mapping, const std::vector<TensorDesc>& outputs, std::string& error);
+
+    /// @brief Forgets the mapping.
+    void clear() noexcept;
+
+    /// @brief TRUE if no output is counted
+    bool empty() const noexcept { return this->count_output_.empty(); }
+
+    /// @brief Get the index of the count output of output, or -1 if output is copied in full
+    int count_output(int output) const noexcept
+    {
+        return this->empty() ? -1 : this->count_output_[output];
+    }
+
+    /// @brief Bytes of the valid prefix of a dependent output.
+    /// @param output Index of a dependent output (count_output(output) >= 0).
+    /// @param count_data Host copy of its count output.
+    /// @param full_bytes Size of the whole output (the result never exceeds it).
+    size_t valid_bytes(int output, const void* count_data, size_t full_bytes) const noexcept;
+
+private:
+    std::vector<int> count_output_;          // Per output: index of its count output, or -1
+    std::vector<TensorDataType> count_type_; // Per output: data type of its count output
+    std::vector<size_t> row_bytes_;          // Per output: bytes per row
+};
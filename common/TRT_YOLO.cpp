@@ -1,177 +1,1191 @@
 
+#include "TensorRT_CPP/TRT_cpu_backend.hpp"
+#include "include/TRT_YOLO.hpp"
+
+#if defined(TRT_ENABLE_CUDA)
 #include "TensorRT_CPP/TRT_inference_engine.hpp"
+#endif
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
 
 namespace TRT::YOLO
 {       
 
-    /// @brief Flag indicating the initialization status of the model.
-    static bool initialized = false;
+    namespace
+    {
+        /// @brief Creates the backend for a model path: CpuInferenceBackend for .cpudesc, else TrtInferenceEngine
+        /// (nullptr in builds without TRT_ENABLE_CUDA).
+        std::unique_ptr<InferenceBackend> open_backend(const std::string& path_to_model, int num_contexts)
+        {
+            const std::string cpu_suffix = ".cpudesc";
+            const bool is_cpu_descriptor = path_to_model.size() >= cpu_suffix.size()
+                && path_to_model.compare(path_to_model.size() - cpu_suffix.size(), cpu_suffix.size(), cpu_suffix) == 0;
+            if (is_cpu_descriptor)
+            {
+                return std::make_unique<CpuInferenceBackend>(path_to_model);
+            }
+#if defined(TRT_ENABLE_CUDA)
+            return std::make_unique<TrtInferenceEngine>(path_to_model, num_contexts);
+#else
+            (void)num_contexts;
+            std::cerr << "[TRT-YOLO] " << path_to_model << " needs the TensorRT engine, which this build "
+                      << "does not include (TRT_ENABLE_CUDA is off); only " << cpu_suffix << " models can load." << std::endl;
+            return nullptr;
+#endif
+        }
 
-    static std::unique_ptr<TrtInferenceEngine> engine = nullptr;
+        /// @brief Returns config, pointing at the descriptor next to the model if it names none.
+        DetectorConfig with_model_descriptor(const std::string& path_to_model, DetectorConfig config)
+        {
+            if (config.model_descriptor_path.empty())
+            {
+                config.model_descriptor_path = ModelDescriptor::find_for_model(path_to_model);
+            }
+            return config;
+        }
 
-    static std::vector<size_t> input_sizes;
-    static std::vector<size_t> output_sizes;
+        std::runtime_error descriptor_mismatch(const ModelDescriptor& descriptor, const std::string& what,
+            const std::string& declared, const std::string& actual)
+        {
+            return std::runtime_error("[TRT-YOLO] Model descriptor " + descriptor.path + " does not match the engine: "
+                + what + " is " + actual + ", the descriptor declares " + declared);
+        }
+    }
 
-    static std::vector<void*> input_data;
-    static std::vector<void*> output_data;
+    Detector::Detector(const std::string& path_to_model, const DetectorConfig& config)
+        : Detector(open_backend(path_to_model, config.num_contexts), with_model_descriptor(path_to_model, config))
+    {
+    }
 
-    static std::vector<std::string> input_names;
-    static std::vector<std::string> output_names;
+    Detector::Detector(std::unique_ptr<InferenceBackend> backend, const DetectorConfig& config)
+        : engine_(std::move(backend)), config_(config)
+    {
+        if (this->engine_ == nullptr) 
+        {
+            throw std::runtime_error("[TRT-YOLO] TRT engine loading failed!");
+        }
+        this->load_descriptor();
+        this->thresholds_ = std::make_shared<const ClassThresholds>(this->config_.class_thresholds_path.empty()
+            ? ClassThresholds(this->config_.confidence_threshold)
+            : ClassThresholds::load(this->config_.class_thresholds_path, this->config_.confidence_threshold));
+        this->initialize();
+    }
 
-    /// @brief output_cuda_buffer_izes the detection model by loading it into CPU or GPU memory (implementation-defined)
-    /// @param path_to_model Path to the model, such as ONNX or TensorRT engine file.
-    /// @return 0 on success.
-    int load_model(std::string &path_to_model)
+    Detector::~Detector()
     {
-        if (initialized || engine != nullptr)
+        // Return the staging buffers to the pool for reuse by the next load...
+        HostBufferPool& pool = this->engine_->get_host_buffer_pool();
+        for (const auto& set : this->all_staging_)
         {
-            std::cerr << "[TRT-YOLO] TensorRT instance already initialized! Initialization aborted." << std::endl;
+            for (void* chunk : set->inputs)
+            {
+                if (chunk != nullptr)
+                {
+                    pool.release(chunk);
+                }
+            }        
+            for (size_t slot = 1; slot < set->chunk_inputs.size(); slot++)
+            {
+                if (set->chunk_inputs[slot] != nullptr)
+                {
+                    pool.release(set->chunk_inputs[slot]);
+                }
+            }
+            for (void* chunk : set->outputs)
+            {
+                pool.release(chunk);
+            }
+        }
+    }
+
+    void Detector::initialize()
+    {
+        // Validate single input, and the NMS-embedded (4) or raw head (1) outputs
+        const int num_outputs = this->engine_->get_num_outputs();
+        if (this->engine_->get_num_inputs() != MODEL_NUM_INPUTS 
+            || (num_outputs != MODEL_NUM_OUTPUTS && num_outputs != RAW_HEAD_NUM_OUTPUTS)) 
+        {
+            throw std::runtime_error("[TRT-YOLO] Unexpected I/O count (" 
+                + std::to_string(this->engine_->get_num_inputs()) + " inputs, " 
+                + std::to_string(num_outputs) + " outputs)");
+        }
+
+        // Get required buffer sizes
+        this->input_sizes_ = this->engine_->get_input_size_bytes();
+        this->output_sizes_ = this->engine_->get_output_size_bytes();
+
+        // Frames per inference: dimension 0 of an NCHW input. Buffers are sized for the largest batch the
+        // profile accepts; a dynamic batch runs at the number of frames of each call.
+        const TensorShape& input_shape = this->engine_->get_input_shapes()[0];
+        const auto& input_profile = this->engine_->get_input_profile();
+        this->max_batch_ = input_shape.size() == 4 ? static_cast<size_t>(input_shape[0]) : 1;
+        this->min_batch_ = input_shape.size() == 4 && !input_profile.empty() && input_profile[0].min.size() == 4
+            ? static_cast<size_t>(input_profile[0].min[0]) : this->max_batch_;
+        this->batch_dynamic_ = this->min_batch_ != this->max_batch_;
+        if (this->max_batch_ > 1)
+        {
+            for (const auto& desc : this->engine_->get_output_descs())
+            {
+                if (desc.shape.empty() || static_cast<size_t>(desc.shape[0]) != this->max_batch_)
+                {
+                    throw std::runtime_error("[TRT-YOLO] Output " + desc.name + " " + shape_to_string(desc.shape)
+                        + " is not batched like the input " + shape_to_string(input_shape));
+                }
+            }
+        }
+        this->frame_elements_ = this->engine_->get_input_elements()[0] / this->max_batch_;
+        this->frame_input_bytes_ = this->input_sizes_[0] / this->max_batch_;
+        this->output_frame_bytes_.clear();
+        for (size_t bytes : this->output_sizes_)
+        {
+            this->output_frame_bytes_.push_back(bytes / this->max_batch_);
+        }
+
+        // Images are letterboxed into a [N, 3, H, W] input, normalized as the model descriptor declares.
+        this->image_input_ = input_shape.size() == 4 && input_shape[1] == 3 && input_shape[2] > 0 && input_shape[3] > 0;
+        if (this->image_input_)
+        {
+            this->preprocess_config_ = PreprocessConfig::from_descriptor(this->descriptor_, input_shape[3], input_shape[2]);
+        }
+        this->preprocess_config_.simd_level = this->config_.simd_level;
+
+        this->raw_head_ = num_outputs == RAW_HEAD_NUM_OUTPUTS;
+        if (this->raw_head_)
+        {
+            // [batch, 4 + classes, anchors]: every anchor is a candidate, and the host NMS bounds the results.
+            const TensorShape& shape = this->engine_->get_output_descs()[0].shape;
+            if (shape.size() != 3 || static_cast<size_t>(shape[0]) != this->max_batch_ 
+                || shape[1] <= RAW_HEAD_BOX_ROWS || shape[2] <= 0)
+            {
+                throw std::runtime_error("[TRT-YOLO] Unexpected raw head shape " + shape_to_string(shape)
+                    + " (expected " + std::to_string(this->max_batch_) + "x(4+classes)xanchors)");
+            }
+            this->raw_head_classes_ = static_cast<size_t>(shape[1] - RAW_HEAD_BOX_ROWS);
+            this->raw_head_anchors_ = static_cast<size_t>(shape[2]);
+            this->max_candidates_ = this->raw_head_anchors_;
+            this->max_detections_ = this->config_.nms.top_k > 0 
+                ? std::min(this->config_.nms.top_k, this->raw_head_anchors_) : this->raw_head_anchors_;
+        }
+        else
+        {
+            this->resolve_nms_outputs();
+        }
+        this->validate_descriptor();
+
+        // Post-processing compiled for this exact output geometry and types, if there is one.
+        const auto& output_descs = this->engine_->get_output_descs();
+        if (this->raw_head_)
+        {
+            this->output_spec_ = {OutputLayout::kRawHead, this->raw_head_anchors_, this->raw_head_classes_,
+                output_descs[0].dtype, output_descs[0].dtype, TensorDataType::kINT32};
+        }
+        else
+        {
+            this->output_spec_ = {OutputLayout::kEmbeddedNms, this->max_detections_, 0, 
+                output_descs[this->output_index_bboxes_].dtype, output_descs[this->output_index_scores_].dtype,
+                output_descs[this->output_index_labels_].dtype};
+        }
+        this->specialized_postprocess_ = this->config_.specialized_postprocess 
+            ? find_specialized_postprocess(this->output_spec_) : nullptr;
+
+        // Bindings may be FP16 or integer typed - they are converted element-wise while copying in and out,
+        // which needs a linear layout and a data type with a host conversion.
+        std::vector<TensorDesc> descs = this->engine_->get_input_descs();
+        descs.insert(descs.end(), this->engine_->get_output_descs().begin(), this->engine_->get_output_descs().end());
+        for (const auto& desc : descs)
+        {
+            if (desc.vectorized_dim >= 0 || desc.dtype == TensorDataType::kFP8 || desc.dtype == TensorDataType::kINT4)
+            {
+                throw std::runtime_error("[TRT-YOLO] Unsupported layout for tensor " + desc.name + " (" 
+                    + data_type_name(desc.dtype) + (desc.vectorized_dim >= 0 ? ", vectorized" : "") + ")");
+            }
+        }
+    }
+
+    void Detector::load_descriptor()
+    {
+        if (this->config_.model_descriptor_path.empty())
+        {
+            return;
+        }
+
+        // Keys the descriptor leaves out keep the configured values.
+        ModelDescriptor defaults;
+        defaults.confidence_threshold = this->config_.confidence_threshold;
+        defaults.class_thresholds_path = this->config_.class_thresholds_path;
+        defaults.cpu_nms = this->config_.cpu_nms;
+        defaults.nms = this->config_.nms;
+        this->descriptor_ = ModelDescriptor::load(this->config_.model_descriptor_path, defaults);
+
+        this->config_.confidence_threshold = this->descriptor_.confidence_threshold;
+        this->config_.class_thresholds_path = this->descriptor_.class_thresholds_path;
+        this->config_.cpu_nms = this->descriptor_.cpu_nms;
+        this->config_.nms = this->descriptor_.nms;
+        std::cout << "[TRT-YOLO] Loaded model descriptor from path: " << this->descriptor_.path 
+                  << (this->descriptor_.name.empty() ? "" : " (" + this->descriptor_.name + ")") << std::endl;
+    }
+
+    void Detector::validate_descriptor() const
+    {
+        const ModelDescriptor& descriptor = this->descriptor_;
+        if (descriptor.path.empty())
+        {
+            return;
+        }
+
+        // Input: [N, C, H, W]
+        const TensorDesc& input = this->engine_->get_input_descs()[0];
+        if (!descriptor.input_tensor.empty() && descriptor.input_tensor != input.name)
+        {
+            throw descriptor_mismatch(descriptor, "the input tensor", descriptor.input_tensor, input.name);
+        }
+        const int declared_dims[3] = {descriptor.input_channels, descriptor.input_height, descriptor.input_width};
+        const char* dim_names[3] = {"input channels", "input height", "input width"};
+        for (int d = 0; d < 3; d++)
+        {
+            if (declared_dims[d] > 0 && (input.shape.size() != 4 || input.shape[d + 1] != declared_dims[d]))
+            {
+                throw descriptor_mismatch(descriptor, std::string("the input shape (") + dim_names[d] + ")",
+                    std::to_string(declared_dims[d]), shape_to_string(input.shape));
+            }
+        }
+        if (descriptor.has_input_type && descriptor.input_type != input.dtype)
+        {
+            throw descriptor_mismatch(descriptor, "the input data type", data_type_name(descriptor.input_type),
+                data_type_name(input.dtype));
+        }
+
+        // Outputs
+        const OutputLayout layout = this->raw_head_ ? OutputLayout::kRawHead : OutputLayout::kEmbeddedNms;
+        if (descriptor.has_layout && descriptor.layout != layout)
+        {
+            throw descriptor_mismatch(descriptor, "the output layout", output_layout_name(descriptor.layout),
+                output_layout_name(layout) + std::string(this->raw_head_ ? " (1 output)" : " (4 outputs)"));
+        }
+        const auto& output_descs = this->engine_->get_output_descs();
+        const size_t rows = this->raw_head_ ? this->raw_head_anchors_ : this->max_detections_;
+        if (descriptor.rows > 0 && descriptor.rows != rows)
+        {
+            throw descriptor_mismatch(descriptor, this->raw_head_ ? "the number of anchors" : "the number of detections",
+                std::to_string(descriptor.rows), std::to_string(rows));
+        }
+        // Only a raw head reveals the class count; NMS-embedded outputs carry it in their labels.
+        if (this->raw_head_ && descriptor.num_classes > 0 && descriptor.num_classes != this->raw_head_classes_)
+        {
+            throw descriptor_mismatch(descriptor, "the number of classes", std::to_string(descriptor.num_classes),
+                std::to_string(this->raw_head_classes_));
+        }
+        if (descriptor.has_output_type)
+        {
+            const int checked[2] = {this->raw_head_ ? 0 : this->output_index_bboxes_,
+                this->raw_head_ ? 0 : this->output_index_scores_};
+            for (int index : checked)
+            {
+                if (descriptor.output_type != output_descs[index].dtype)
+                {
+                    throw descriptor_mismatch(descriptor, "the data type of output " + output_descs[index].name,
+                        data_type_name(descriptor.output_type), data_type_name(output_descs[index].dtype));
+                }
+            }
+        }
+    }
+
+    void Detector::resolve_nms_outputs()
+    {
+        // Names set by the model descriptor must exist; the defaults fall back to their positions.
+        const ModelDescriptor& names = this->descriptor_;
+        this->output_index_num_dets_ = this->resolve_output_index(names.num_dets_tensor, OUTPUT_INDEX_NUM_DETS,
+            names.num_dets_tensor != OUTPUT_NAME_NUM_DETS);
+        this->output_index_bboxes_ = this->resolve_output_index(names.bboxes_tensor, OUTPUT_INDEX_BBOXES,
+            names.bboxes_tensor != OUTPUT_NAME_BBOXES);
+        this->output_index_scores_ = this->resolve_output_index(names.scores_tensor, OUTPUT_INDEX_SCORES,
+            names.scores_tensor != OUTPUT_NAME_SCORES);
+        this->output_index_labels_ = this->resolve_output_index(names.labels_tensor, OUTPUT_INDEX_LABELS,
+            names.labels_tensor != OUTPUT_NAME_LABELS);
+        this->max_detections_ = this->engine_->get_output_elements()[this->output_index_scores_] / this->max_batch_;
+        this->max_candidates_ = this->max_detections_;
+
+        // Only the first num_dets rows are read below, so only those need to leave the device.
+        // (Falls back to full copies if the engine's outputs are named differently. A count tensor holds a
+        // single value, so a batched engine always copies in full.)
+        if (this->config_.valid_rows_only && this->max_batch_ == 1)
+        {
+            this->engine_->set_counted_outputs(
+                {{names.num_dets_tensor, {names.bboxes_tensor, names.scores_tensor, names.labels_tensor}}});
+        }
+    }
+
+    int Detector::resolve_output_index(const std::string& name, int fallback_index, bool required) const
+    {
+        const int index = this->engine_->get_output_index(name);
+        if (index >= 0)
+        {
+            return index;
+        }
+        if (required)
+        {
+            throw std::runtime_error("[TRT-YOLO] Model descriptor " + this->descriptor_.path + " names output '" 
+                + name + "', which the engine does not have");
+        }
+        std::cerr << "[TRT-YOLO] Warning: no output named '" << name << "', assuming output index " 
+                  << fallback_index << std::endl;
+        return fallback_index;
+    }
+
+    void Detector::set_class_thresholds(ClassThresholds thresholds)
+    {
+        std::atomic_store(&this->thresholds_, std::shared_ptr<const ClassThresholds>(
+            std::make_shared<const ClassThresholds>(std::move(thresholds))));
+    }
+
+    std::shared_ptr<const ClassThresholds> Detector::get_class_thresholds() const
+    {
+        return std::atomic_load(&this->thresholds_);
+    }
+
+    size_t Detector::get_num_staging_sets() const
+    {
+        std::lock_guard<std::mutex> lock(this->staging_mutex_);
+        return this->all_staging_.size();
+    }
+
+    Detector::StagingSet* Detector::acquire_staging()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->staging_mutex_);
+            if (!this->free_staging_.empty())
+            {
+                StagingSet* set = this->free_staging_.back();
+                this->free_staging_.pop_back();
+                return set;
+            }
+        }
+
+        // Every set is in use - allocate another from the backend's (pinned, for CUDA) host pool.
+        // float32 single-frame inputs are read from the caller's buffer, so only other input types, and batches
+        // (gathered from separate frames), get a staging buffer.
+        auto set = std::make_unique<StagingSet>();
+        HostBufferPool& pool = this->engine_->get_host_buffer_pool();
+        const auto& input_descs = this->engine_->get_input_descs();
+        bool ok = true;
+        for (size_t i = 0; i < this->input_sizes_.size() && ok; i++)
+        {
+            const bool needs_staging = input_descs[i].dtype != TensorDataType::kFLOAT || this->max_batch_ > 1;
+            set->inputs.push_back(needs_staging ? pool.acquire(this->input_sizes_[i]) : nullptr);
+            ok = !needs_staging || set->inputs.back() != nullptr;
+            if (ok && needs_staging)
+            {
+                // Padding frames of a fixed batch are never written; start them at zero.
+                std::memset(set->inputs.back(), 0, this->input_sizes_[i]);
+            }
+        }
+        for (size_t i = 0; i < this->output_sizes_.size() && ok; i++)
+        {
+            set->outputs.push_back(pool.acquire(this->output_sizes_[i]));
+            ok = set->outputs.back() != nullptr;
+        }
+        if (!ok)
+        {
+            std::cerr << "[TRT-YOLO] Failed to allocate staging buffers" << std::endl;
+            for (void* chunk : set->inputs) if (chunk != nullptr) pool.release(chunk);
+            for (void* chunk : set->outputs) pool.release(chunk);
+            return nullptr;
+        }
+        set->call_inputs.resize(set->inputs.size(), nullptr);
+        set->call_input_sizes = this->input_sizes_;
+        set->input_shapes = this->engine_->get_input_shapes();
+        set->output_shapes = this->engine_->get_output_shapes();
+        set->frames.resize(this->max_batch_);
+        set->tickets.resize(std::max(1, this->engine_->get_num_async_slots()), INVALID_INFER_TICKET);
+        set->chunk_inputs.resize(set->tickets.size(), nullptr);
+        for (FrameScratch& frame : set->frames)
+        {
+            frame.detections.reset(this->max_detections_);
+            if (this->config_.cpu_nms || this->raw_head_)
+            {
+                frame.candidates.reset(this->max_candidates_);
+                frame.nms_workspace.reserve(this->max_candidates_);
+            }
+            if (this->raw_head_ && this->engine_->get_output_descs()[0].dtype != TensorDataType::kFLOAT)
+            {
+                frame.raw_head.resize(this->engine_->get_output_elements()[0] / this->max_batch_);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(this->staging_mutex_);
+        this->all_staging_.push_back(std::move(set));
+        return this->all_staging_.back().get();
+    }
+
+    void Detector::release_staging(StagingSet* set)
+    {
+        std::lock_guard<std::mutex> lock(this->staging_mutex_);
+        this->free_staging_.push_back(set);
+    }
+
+    int Detector::identify_objects(const std::vector<float> &input_img, std::vector<detected_object_info_t> &results_detections,
+        const LetterboxInfo* letterbox)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        StagingSet* set = this->acquire_staging();
+        if (set == nullptr)
+        {
+            results_detections.clear();
             return -1;
         }
-        
-        engine = std::make_unique<TrtInferenceEngine>(path_to_model);
-        if (engine == nullptr) 
+        FrameSource source;
+        const float* frame = input_img.data();
+        source.tensors = &frame;
+        source.num_elements = input_img.size();
+        source.letterboxes = letterbox;
+        DetectionBatch& detections = set->frames[0].detections;
+        const int result = this->run(source, *set, detections);
+        if (result >= 0)
+        {
+            detections.copy_to(results_detections);
+        }
+        else
+        {
+            results_detections.clear();
+        }
+        this->release_staging(set);
+        this->record_throughput(source, 1, start);
+        return result;
+    }
+
+    int Detector::identify_objects(const float* input_img, size_t num_elements, DetectionBatch &results_detections,
+        const LetterboxInfo* letterbox)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        StagingSet* set = this->acquire_staging();
+        if (set == nullptr)
         {
-            std::cerr << "[TRT-YOLO] TRT engine loading failed!" << std::endl;
+            results_detections.clear();
             return -1;
         }
-        
-        // Get required buffer sizes
-        input_sizes = engine->get_input_sizes_bytes();
-        output_sizes = engine->get_output_sizes_bytes();
+        FrameSource source;
+        source.tensors = &input_img;
+        source.num_elements = num_elements;
+        source.letterboxes = letterbox;
+        const int result = this->run(source, *set, results_detections);
+        this->release_staging(set);
+        this->record_throughput(source, 1, start);
+        return result;
+    }
 
-        // Get the names of inputs and outputs
-        input_names = engine->get_input_names();
-        output_names = engine->get_output_names();
-        
-        // Allocate buffers to hold inputs and outputs...
-        for (int i = 0; i < MODEL_NUM_INPUTS; i++)
+    int Detector::identify_objects(const float* const* input_imgs, size_t num_frames, size_t num_elements,
+        DetectionBatch* results_detections, const LetterboxInfo* letterboxes)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (num_frames == 0)
         {
-            void* chunk = calloc(input_sizes[i], sizeof(uint8_t));
-            input_data.push_back(chunk);
-        }        
-        for (int i = 0; i < MODEL_NUM_OUTPUTS; i++)
+            return 0;
+        }
+        if (input_imgs == nullptr || results_detections == nullptr)
         {
-            void* chunk = calloc(output_sizes[i], sizeof(uint8_t));
-            output_data.push_back(chunk);
+            std::cerr << "[TRT-YOLO] Null frame or result array" << std::endl;
+            if (results_detections != nullptr)
+            {
+                for (size_t f = 0; f < num_frames; f++) results_detections[f].clear();
+            }
+            return -1;
         }
+        FrameSource source;
+        source.tensors = input_imgs;
+        source.num_elements = num_elements;
+        source.letterboxes = letterboxes;
+        const int result = this->run_frames(source, num_frames, results_detections);
+        this->record_throughput(source, num_frames, start);
+        return result;
+    }
 
-        initialized = true;
-        return 0;
+    int Detector::identify_objects(const ImageView& image, DetectionBatch &results_detections)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        StagingSet* set = this->acquire_staging();
+        if (set == nullptr)
+        {
+            results_detections.clear();
+            return -1;
+        }
+        FrameSource source;
+        source.images = &image;
+        const int result = this->run(source, *set, results_detections);
+        this->release_staging(set);
+        this->record_throughput(source, 1, start);
+        return result;
     }
 
-    /// @brief Performs inference on the input buffer and stores detection results
-    /// @param input_img Input image data (must match model input dimensions)
-    /// @param results_detections Output vector for detection results
-    /// @return Number of detections (-1 on failure)
-    int identify_objects(const std::vector<float> &input_img, std::vector<detected_object_info_t> &results_detections)
+    int Detector::identify_objects(const ImageView& image, std::vector<detected_object_info_t> &results_detections)
     {
-        // Validate engine state
-        if (!initialized || !engine) 
+        const auto start = std::chrono::steady_clock::now();
+        StagingSet* set = this->acquire_staging();
+        if (set == nullptr)
         {
-            std::cerr << "[TRT-YOLO] Engine or buffers not initialized!" << std::endl;
+            results_detections.clear();
             return -1;
         }
+        FrameSource source;
+        source.images = &image;
+        DetectionBatch& detections = set->frames[0].detections;
+        const int result = this->run(source, *set, detections);
+        if (result >= 0)
+        {
+            detections.copy_to(results_detections);
+        }
+        else
+        {
+            results_detections.clear();
+        }
+        this->release_staging(set);
+        this->record_throughput(source, 1, start);
+        return result;
+    }
 
-        // Validate single input/output
-        if (engine->get_num_inputs() != MODEL_NUM_INPUTS || engine->get_num_outputs() != MODEL_NUM_OUTPUTS) {
-            std::cerr << "[TRT-YOLO] Unexpected I/O count ("
-                    << engine->get_num_inputs() << " inputs, " 
-                    << engine->get_num_outputs() << " outputs)" << std::endl;
+    int Detector::identify_objects(const ImageView* images, size_t num_frames, DetectionBatch* results_detections)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (num_frames == 0)
+        {
+            return 0;
+        }
+        if (images == nullptr || results_detections == nullptr)
+        {
+            std::cerr << "[TRT-YOLO] Null image or result array" << std::endl;
+            if (results_detections != nullptr)
+            {
+                for (size_t f = 0; f < num_frames; f++) results_detections[f].clear();
+            }
             return -1;
         }
+        FrameSource source;
+        source.images = images;
+        const int result = this->run_frames(source, num_frames, results_detections);
+        this->record_throughput(source, num_frames, start);
+        return result;
+    }
 
-        // From model file:
-        // images tensor: float32 [1, 3, 640, 640]
-        if (input_sizes[0] != input_img.size() * sizeof(float))
+    int Detector::identify_objects(const InputFrame& frame, DetectionBatch &results_detections)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        StagingSet* set = this->acquire_staging();
+        if (set == nullptr)
         {
-            std::cerr << "[TRT-YOLO] Input sizes do not match! Expected: "
-                << std::to_string(input_sizes[0]) << " got: " 
-                << std::to_string(input_img.size() * sizeof(float)) << std::endl;
+            results_detections.clear();
             return -1;
         }
-        memcpy(input_data[0], input_img.data(), input_img.size() * sizeof(float));
+        FrameSource source;
+        source.frames = &frame;
+        const int result = this->run(source, *set, results_detections);
+        this->release_staging(set);
+        this->record_throughput(source, 1, start);
+        return result;
+    }
 
-        // Run inference (synchronous)
-        bool success = engine->infer_b(
-            input_data,    // Input buffers
-            input_sizes,   // Input sizes
-            output_data, // Output buffers
-            output_sizes   // Output sizes
-        );
+    int Detector::identify_objects(const InputFrame* frames, size_t num_frames, DetectionBatch* results_detections)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (num_frames == 0)
+        {
+            return 0;
+        }
+        if (frames == nullptr || results_detections == nullptr)
+        {
+            std::cerr << "[TRT-YOLO] Null frame or result array" << std::endl;
+            if (results_detections != nullptr)
+            {
+                for (size_t f = 0; f < num_frames; f++) results_detections[f].clear();
+            }
+            return -1;
+        }
+        FrameSource source;
+        source.frames = frames;
+        const int result = this->run_frames(source, num_frames, results_detections);
+        this->record_throughput(source, num_frames, start);
+        return result;
+    }
 
-        if (!success) {
+    int Detector::run_frames(const FrameSource& source, size_t num_frames, DetectionBatch* results_detections)
+    {
+        for (size_t f = 0; f < num_frames; f++)
+        {
+            results_detections[f].clear();
+        }
+        StagingSet* set = this->check_frames(source, num_frames) ? this->acquire_staging() : nullptr;
+        if (set == nullptr)
+        {
+            return -1;
+        }
+
+        // One inference per chunk of max_batch_ frames (per frame on a single-frame engine). Chunks are
+        // submitted asynchronously, one per free execution context, and collected in order: while the device
+        // runs the later ones, the frames of the oldest are post-processed. The device reads a chunk's input
+        // until it is collected, so each in-flight chunk is staged in the buffer of its ring slot; all of them
+        // are read back into the set's outputs when collected.
+        const size_t num_chunks = (num_frames + this->max_batch_ - 1) / this->max_batch_;
+        const size_t window = set->tickets.size();
+        size_t submitted = 0;
+        size_t collected = 0;
+        size_t staged = num_chunks;
+        bool failed = false;
+        size_t total = 0;
+        auto finish_chunk = [&](size_t chunk, bool success)
+        {
+            const size_t first = chunk * this->max_batch_;
+            const size_t count = std::min(this->max_batch_, num_frames - first);
+            const int result = success ? this->postprocess_frames(*set, count, results_detections + first,
+                source, first, true) : -1;
+            if (!success)
+            {
+                std::cerr << "[TRT-YOLO] Inference failed!" << std::endl;
+            }
+            failed = failed || result < 0;
+            total += result > 0 ? static_cast<size_t>(result) : 0;
+            collected++;
+        };
+        auto collect_oldest = [&]()
+        {
+            const bool success = this->engine_->retrieve_infer_result_async(set->tickets[collected % window],
+                set->outputs, this->output_sizes_) == AsyncInferStatus::kReady;
+            finish_chunk(collected, success);
+        };
+
+        while (collected < num_chunks)
+        {
+            if (submitted == num_chunks || submitted - collected == window)
+            {
+                collect_oldest();
+                continue;
+            }
+            const size_t first = submitted * this->max_batch_;
+            const size_t count = std::min(this->max_batch_, num_frames - first);
+            if (staged != submitted)
+            {
+                if (!this->stage_inputs(source, first, count, *set, submitted % window))
+                {
+                    failed = true;
+                    break;
+                }
+                staged = submitted;
+            }
+
+            // Async inferences run at the full batch: a partial chunk of a dynamic batch runs synchronously.
+            const bool at_full_batch = !this->batch_dynamic_ || count == this->max_batch_;
+            if (at_full_batch && this->engine_->get_num_free_contexts() > 0 && this->engine_->infer_async(set->call_inputs, set->call_input_sizes,
+                set->tickets[submitted % window]))
+            {
+                submitted++;
+            }
+            else if (collected < submitted)
+            {
+                collect_oldest(); // Every context is busy (or the synchronous chunk must wait its turn)
+            }
+            else
+            {
+                const bool success = this->infer(*set, count);
+                submitted++;
+                finish_chunk(collected, success);
+            }
+        }
+        while (collected < submitted)
+        {
+            collect_oldest(); // Only after a staging failure
+        }
+        set->call_inputs[0] = nullptr;
+        this->release_staging(set);
+        return failed ? -1 : static_cast<int>(total);
+    }
+
+    int Detector::identify_objects(const std::vector<std::vector<float>> &input_imgs,
+        std::vector<std::vector<detected_object_info_t>> &results_detections, const LetterboxInfo* letterboxes)
+    {
+        const size_t num_frames = input_imgs.size();
+        results_detections.resize(num_frames);
+        std::vector<const float*> frames(num_frames);
+        std::vector<DetectionBatch> detections;
+        detections.reserve(num_frames);
+        for (size_t f = 0; f < num_frames; f++)
+        {
+            if (input_imgs[f].size() != input_imgs[0].size())
+            {
+                std::cerr << "[TRT-YOLO] Frame sizes differ (frame 0: " << input_imgs[0].size() << " elements, frame " 
+                          << f << ": " << input_imgs[f].size() << ")" << std::endl;
+                for (auto& results : results_detections) results.clear();
+                return -1;
+            }
+            frames[f] = input_imgs[f].data();
+            detections.emplace_back(this->max_detections_);
+        }
+
+        const int result = this->identify_objects(frames.data(), num_frames, 
+            num_frames > 0 ? input_imgs[0].size() : 0, detections.data(), letterboxes);
+        for (size_t f = 0; f < num_frames; f++)
+        {
+            detections[f].copy_to(results_detections[f]);
+        }
+        return result;
+    }
+
+    std::vector<ThroughputStats> Detector::get_throughput_stats() const
+    {
+        std::lock_guard<std::mutex> lock(this->stats_mutex_);
+        std::vector<ThroughputStats> stats;
+        for (const auto& entry : this->throughput_)
+        {
+            if (entry.calls > 0)
+            {
+                stats.push_back(entry);
+            }
+        }
+        return stats;
+    }
+
+    std::vector<InputStats> Detector::get_input_stats() const
+    {
+        std::lock_guard<std::mutex> lock(this->stats_mutex_);
+        std::vector<InputStats> stats;
+        for (const auto& entry : this->input_stats_)
+        {
+            if (entry.frames > 0)
+            {
+                stats.push_back(entry);
+            }
+        }
+        return stats;
+    }
+
+    void Detector::record_throughput(const FrameSource& source, size_t num_frames, 
+        std::chrono::steady_clock::time_point start)
+    {
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::lock_guard<std::mutex> lock(this->stats_mutex_);
+        for (size_t f = 0; f < num_frames; f++)
+        {
+            const InputFrame frame = frame_at(source, f);
+            InputStats& input = this->input_stats_[static_cast<int>(frame.format)];
+            input.format = frame.format;
+            input.frames++;
+            input.bytes += frame_bytes(frame, this->frame_elements_);
+        }
+        if (this->throughput_.size() < num_frames)
+        {
+            // Only grows the first time a call has this many frames.
+            const size_t old_size = this->throughput_.size();
+            this->throughput_.resize(num_frames);
+            for (size_t i = old_size; i < num_frames; i++)
+            {
+                this->throughput_[i].frames_per_call = i + 1;
+            }
+        }
+        ThroughputStats& entry = this->throughput_[num_frames - 1];
+        entry.calls++;
+        entry.frames += num_frames;
+        entry.total_ms += ms;
+    }
+
+    ThreadPool& Detector::get_batch_pool()
+    {
+        std::call_once(this->batch_pool_once_, [this] 
+        {
+            this->batch_pool_ = std::make_unique<ThreadPool>(this->config_.batch_threads);
+        });
+        return *this->batch_pool_;
+    }
+
+    int Detector::run(const FrameSource& source, StagingSet& set, DetectionBatch &results_detections)
+    {
+        results_detections.clear();
+        if (!this->check_frames(source, 1) || !this->stage_inputs(source, 0, 1, set))
+        {
+            return -1;
+        }
+        const bool success = this->infer(set, 1);
+        set.call_inputs[0] = nullptr;
+
+        if (!success) 
+        {
             std::cerr << "[TRT-YOLO] Inference failed!" << std::endl;
             return -1;
         }
+        return this->postprocess_frames(set, 1, &results_detections, source, 0, false);
+    }
+
+    bool Detector::check_frames(const FrameSource& source, size_t num_frames) const
+    {
+        for (size_t f = 0; f < num_frames; f++)
+        {
+            const InputFrame frame = frame_at(source, f);
+            if ((frame.format == FrameFormat::kU8Packed || frame.format == FrameFormat::kU8Planar) && !this->image_input_)
+            {
+                std::cerr << "[TRT-YOLO] Model input " << shape_to_string(this->engine_->get_input_shapes()[0]) 
+                          << " does not take " << frame_format_name(frame.format) << " frames (expected [N, 3, H, W])" 
+                          << std::endl;
+                return false;
+            }
+            if (frame.format == FrameFormat::kU8Packed)
+            {
+                const ImageView& image = frame.image;
+                if (!image.is_valid())
+                {
+                    std::cerr << "[TRT-YOLO] Invalid " << pixel_format_name(image.format) << " image (" << image.width 
+                              << "x" << image.height << ", stride " << image.row_stride() 
+                              << (image.data == nullptr ? ", no data)" : ")") << std::endl;
+                    return false;
+                }
+                continue;
+            }
+
+            const LetterboxInfo* letterbox = frame.letterbox;
+            if (letterbox != nullptr && !letterbox->is_valid())
+            {
+                std::cerr << "[TRT-YOLO] Invalid letterbox (source " << letterbox->source_width << "x" 
+                    << letterbox->source_height << ", scale " << letterbox->scale << ")" << std::endl;
+                return false;
+            }
+
+            // From model file:
+            // images tensor: float32 (or float16) [batch, 3, 640, 640]
+            // Planar InputFrames are model-size by definition; float tensors come with their size.
+            const size_t num_elements = source.tensors != nullptr ? source.num_elements : this->frame_elements_;
+            if (frame.data == nullptr || this->frame_elements_ != num_elements)
+            {
+                std::cerr << "[TRT-YOLO] Input sizes do not match! Expected: "
+                    << std::to_string(this->frame_elements_) << " elements, got: " 
+                    << (frame.data == nullptr ? std::string("null buffer") : std::to_string(num_elements)) << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    InputFrame Detector::frame_at(const FrameSource& source, size_t frame) noexcept
+    {
+        if (source.frames != nullptr)
+        {
+            return source.frames[frame];
+        }
+        if (source.images != nullptr)
+        {
+            return InputFrame::packed(source.images[frame]);
+        }
+        return InputFrame::planar(FrameFormat::kF32Planar, source.tensors[frame], 
+            source.letterboxes != nullptr ? source.letterboxes + frame : nullptr);
+    }
+
+    const LetterboxInfo* Detector::frame_letterbox(const FrameSource& source, size_t frame, LetterboxInfo& storage) const
+    {
+        const InputFrame input = frame_at(source, frame);
+        if (input.format == FrameFormat::kU8Packed)
+        {
+            // What preprocess_image() applied to the frame.
+            storage = LetterboxInfo::fit(input.image.width, input.image.height, 
+                this->preprocess_config_.model_width, this->preprocess_config_.model_height);
+            return &storage;
+        }
+        return input.letterbox;
+    }
+
+    bool Detector::stage_inputs(const FrameSource& source, size_t first, size_t num_frames, StagingSet& set, size_t slot)
+    {
+        // A single frame already in the input's type (float32, or float16) is handed to the backend in place
+        // (it only reads it); other formats and batches are gathered (and converted) into the set's staging
+        // buffer. Padding frames of a fixed batch keep whatever they held, and their outputs are ignored.
+        const TensorDataType input_type = this->engine_->get_input_descs()[0].dtype;
+        const size_t batch = this->batch_dynamic_ ? std::max(num_frames, this->min_batch_) : this->max_batch_;
+        if (batch == 1)
+        {
+            const InputFrame frame = frame_at(source, first);
+            const bool in_place = (frame.format == FrameFormat::kF32Planar && input_type == TensorDataType::kFLOAT)
+                || (frame.format == FrameFormat::kF16Planar && input_type == TensorDataType::kHALF);
+            if (in_place)
+            {
+                set.call_inputs[0] = const_cast<void*>(frame.data);
+                set.call_input_sizes[0] = this->frame_input_bytes_;
+                return true;
+            }
+        }
+        void*& staging = slot == 0 ? set.inputs[0] : set.chunk_inputs[slot];
+        if (staging == nullptr)
+        {
+            // Converted frames on a single-frame float32 model, and ring slots past the first: the cases without a
+            // staging buffer from acquire_staging().
+            staging = this->engine_->get_host_buffer_pool().acquire(this->input_sizes_[0]);
+            if (staging == nullptr)
+            {
+                std::cerr << "[TRT-YOLO] Failed to allocate staging buffers" << std::endl;
+                return false;
+            }
+            std::memset(staging, 0, this->input_sizes_[0]);
+        }
+
+        // Each frame goes straight into its slice of the staging buffer (an image through the frame's float32
+        // scratch if the input is neither float32 nor float16).
+        auto stage_frame = [&](size_t f)
+        {
+            const InputFrame frame = frame_at(source, first + f);
+            void* frame_input = static_cast<char*>(staging) + f * this->frame_input_bytes_;
+            if (frame.format != FrameFormat::kU8Packed)
+            {
+                convert_planar_frame(frame, this->frame_elements_, this->preprocess_config_, frame_input, input_type);
+                return;
+            }
+            FrameScratch& scratch = set.frames[f];
+            if (input_type == TensorDataType::kFLOAT || input_type == TensorDataType::kHALF)
+            {
+                preprocess_image(frame.image, this->preprocess_config_, frame_input, input_type, scratch.preprocess);
+                return;
+            }
+            scratch.image.resize(this->frame_elements_);
+            preprocess_image(frame.image, this->preprocess_config_, scratch.image.data(), scratch.preprocess);
+            convert_planar_frame(InputFrame::planar(FrameFormat::kF32Planar, scratch.image.data()), this->frame_elements_,
+                this->preprocess_config_, frame_input, input_type);
+        };
+        if (num_frames > 1)
+        {
+            this->get_batch_pool().parallel_for(num_frames, stage_frame);
+        }
+        else
+        {
+            stage_frame(0);
+        }
+        set.call_inputs[0] = staging;
+        set.call_input_sizes[0] = this->input_sizes_[0];
+        return true;
+    }
+
+    bool Detector::infer(StagingSet& set, size_t num_frames)
+    {
+        // Run inference (synchronous), at the call's batch if it is dynamic
+        if (this->batch_dynamic_)
+        {
+            set.input_shapes[0][0] = static_cast<int>(std::max(num_frames, this->min_batch_));
+            return this->engine_->infer_b(set.call_inputs, set.call_input_sizes, set.outputs, this->output_sizes_,
+                set.input_shapes, set.output_shapes);
+        }
+        return this->engine_->infer_b(
+            set.call_inputs,      // Input buffers
+            set.call_input_sizes, // Input sizes
+            set.outputs,          // Output buffers
+            this->output_sizes_   // Output sizes
+        );
+    }
+
+    int Detector::postprocess_frames(StagingSet& set, size_t num_frames, DetectionBatch* results_detections,
+        const FrameSource& source, size_t first, bool parallel)
+    {
+        std::atomic<bool> failed{false};
+        std::atomic<size_t> total{0};
+        auto postprocess_frame = [&](size_t f)
+        {
+            LetterboxInfo letterbox;
+            const int result = this->postprocess(set, f, set.frames[f], results_detections[f], 
+                this->frame_letterbox(source, first + f, letterbox));
+            if (result < 0)
+            {
+                failed.store(true, std::memory_order_relaxed);
+            }
+            else
+            {
+                total.fetch_add(static_cast<size_t>(result), std::memory_order_relaxed);
+            }
+        };
+        if (parallel && num_frames > 1)
+        {
+            this->get_batch_pool().parallel_for(num_frames, postprocess_frame);
+        }
+        else
+        {
+            for (size_t f = 0; f < num_frames; f++) postprocess_frame(f);
+        }
+        return failed.load() ? -1 : static_cast<int>(total.load());
+    }
 
-        // Post-process the results.
-        results_buffer.clear();
+    int Detector::postprocess(const StagingSet& set, size_t frame, FrameScratch& scratch, 
+        DetectionBatch &results_detections, const LetterboxInfo* letterbox) const
+    {
+        if (!this->config_.cpu_nms && !this->raw_head_)
+        {
+            return this->filter_outputs(set, frame, scratch, results_detections, letterbox);
+        }
+        // Suppression runs in model space (clipping would distort the IoUs); the kept boxes are back-projected.
+        if (this->filter_outputs(set, frame, scratch, scratch.candidates, nullptr) < 0)
+        {
+            return -1;
+        }
+        non_max_suppression(scratch.candidates, results_detections, this->config_.nms, scratch.nms_workspace, 
+            this->config_.simd_level, letterbox);
+        return static_cast<int>(results_detections.size());
+    }
 
-        // From model file:
+    int Detector::filter_outputs(const StagingSet& set, size_t frame, FrameScratch& scratch, 
+        DetectionBatch &results_detections, const LetterboxInfo* letterbox) const
+    {
+        // From model file (NMS-embedded), per frame of the batch:
         // num_dets tensor: int32 [1,1]
-        // bboxes tensor: float32 [1,100,4]
-        // scores tensor: float32 [1,100]
+        // bboxes tensor: float32 (or float16) [1,100,4]
+        // scores tensor: float32 (or float16) [1,100]
         // labels tensor: int32 [1,100]
-        int32_t num_dets = *static_cast<int32_t*>(output_data[OUTPUT_INDEX_NUM_DETS]); 
-        float* bboxes = static_cast<float*>(output_data[OUTPUT_INDEX_BBOXES]);
-        float* scores = static_cast<float*>(output_data[OUTPUT_INDEX_SCORES]);
-        int32_t* labels = static_cast<int32_t*>(output_data[OUTPUT_INDEX_LABELS]);
+        // or (raw head):
+        // output0 tensor: float32 (or float16) [1, 4 + classes, anchors]
+        // Each value is read in its tensor's data type.
+        auto frame_output = [&](int index) -> const void*
+        {
+            return static_cast<const char*>(set.outputs[index]) + frame * this->output_frame_bytes_[index];
+        };
+        PostprocessInput input;
+        if (this->raw_head_)
+        {
+            input.head = frame_output(0);
+            input.head_scratch = scratch.raw_head.data();
+        }
+        else
+        {
+            const auto& descs = this->engine_->get_output_descs();
+            const int32_t num_dets = static_cast<int32_t>(load_element(frame_output(this->output_index_num_dets_), 
+                descs[this->output_index_num_dets_].dtype, 0));
+            const int max_dets = static_cast<int>(this->max_detections_);
+            if (num_dets < 0 || num_dets > max_dets)
+            {
+                std::cerr << "[TRT-YOLO] Error: Aborted - Received impossible number of detections (0-" << max_dets << "): " 
+                          << std::to_string(num_dets) << std::endl;
+                return -1;
+            }
+            input.bboxes = frame_output(this->output_index_bboxes_);
+            input.scores = frame_output(this->output_index_scores_);
+            input.labels = frame_output(this->output_index_labels_);
+            input.count = static_cast<size_t>(num_dets);
+        }
+
+        // Post-process by rejecting scores below their class threshold (and decoding a raw head).
+        // The model's own NMS has run already, if it has one; postprocess() may add a host NMS pass.
+        const std::shared_ptr<const ClassThresholds> thresholds = this->get_class_thresholds();
+        if (this->specialized_postprocess_ != nullptr)
+        {
+            this->specialized_postprocess_(input, *thresholds, results_detections, this->config_.simd_level, letterbox);
+        }
+        else
+        {
+            postprocess_outputs(this->output_spec_, input, *thresholds, results_detections, this->config_.simd_level, 
+                letterbox);
+        }
+        return static_cast<int>(results_detections.size());
+    }
+
+
+    /// --- Single-model interface ---
 
-        if (num_dets < 0 || num_dets > 100)
+
+    /// @brief The model loaded by load_model().
+    static std::unique_ptr<Detector> default_detector = nullptr;
+
+    int load_model(std::unique_ptr<InferenceBackend> backend)
+    {
+        if (default_detector != nullptr)
         {
-            std::cerr << "[TRT-YOLO] Error: Aborted - Received impossible number of detections (0-100): " << std::to_string(num_dets) << std::endl;
+            std::cerr << "[TRT-YOLO] TensorRT instance already initialized! Initialization aborted." << std::endl;
             return -1;
         }
 
-        // Post-process by rejecting low-confidence scores.
-        // For now, it is assumed NMS is done within the model.
-        int index_best_detection = 0;
-        float best_score = -1;
-        detected_object_info_t current_obj;
-        for (int i = 0; i < num_dets; ++i) 
+        try
         {
-            float x1 = bboxes[i * 4 + 0];
-            float y1 = bboxes[i * 4 + 1];
-            float x2 = bboxes[i * 4 + 2];
-            float y2 = bboxes[i * 4 + 3];
-            float score = scores[i];
-            int32_t label = labels[i];
-            if (score < CONFIDENCE_SCORE_THRESHOLD)
-            {
-                continue;
-            }                
-            current_obj.rect.x = x1;
-            current_obj.rect.y = y1;
-            current_obj.rect.width = x2 - x1;
-            current_obj.rect.height = y2 - y1;
-            current_obj.confidence = score;
-            current_obj.class_id = label;
-            results_detections.push_back(current_obj);
+            default_detector = std::make_unique<Detector>(std::move(backend));
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[TRT-YOLO] Model loading failed: " << e.what() << std::endl;
+            return -1;
         }
+        return 0;
+    }
 
-        return results_buffer.size();
+    int load_model(std::string &path_to_model)
+    {
+        if (default_detector != nullptr)
+        {
+            std::cerr << "[TRT-YOLO] TensorRT instance already initialized! Initialization aborted." << std::endl;
+            return -1;
+        }
+
+        try
+        {
+            default_detector = std::make_unique<Detector>(path_to_model);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[TRT-YOLO] Model loading failed: " << e.what() << std::endl;
+            return -1;
+        }
+        return 0;
     }
 
-    /// @brief Unloads Cuda/Tensor RT resources prior to exit.
-    /// Could also in principle be used to re-initialize the engine for a new model.
-    void unload_model()
+    int identify_objects(const std::vector<float> &input_img, std::vector<detected_object_info_t> &results_detections,
+        const LetterboxInfo* letterbox)
     {
-        engine.reset(); engine = nullptr;
-        // Deallocate buffers for inputs and outputs...
-        for (int i = 0; i < MODEL_NUM_INPUTS; i++)
+        // Validate engine state
+        if (!default_detector) 
         {
-            free(input_data[i]);
-        }        
-        for (int i = 0; i < MODEL_NUM_OUTPUTS; i++)
+            std::cerr << "[TRT-YOLO] Engine or buffers not initialized!" << std::endl;
+            return -1;
+        }
+        return default_detector->identify_objects(input_img, results_detections, letterbox);
+    }
+
+    int identify_objects(const float* input_img, size_t num_elements, DetectionBatch &results_detections,
+        const LetterboxInfo* letterbox)
+    {
+        if (!default_detector) 
         {
-            free(output_data[i]);
+            std::cerr << "[TRT-YOLO] Engine or buffers not initialized!" << std::endl;
+            results_detections.clear();
+            return -1;
         }
-        input_data.clear();
-        output_data.clear();
-        input_sizes.clear();
-        output_sizes.clear();
-        initialized = false;
+        return default_detector->identify_objects(input_img, num_elements, results_detections, letterbox);
+    }
+
+    int identify_objects(const float* const* input_imgs, size_t num_frames, size_t num_elements,
+        DetectionBatch* results_detections, const LetterboxInfo* letterboxes)
+    {
+        if (!default_detector) 
+        {
+            std::cerr << "[TRT-YOLO] Engine or buffers not initialized!" << std::endl;
+            for (size_t f = 0; f < num_frames && results_detections != nullptr; f++) results_detections[f].clear();
+            return -1;
+        }
+        return default_detector->identify_objects(input_imgs, num_frames, num_elements, results_detections, letterboxes);
+    }
+
+    int identify_objects(const ImageView& image, DetectionBatch &results_detections)
+    {
+        if (!default_detector) 
+        {
+            std::cerr << "[TRT-YOLO] Engine or buffers not initialized!" << std::endl;
+            results_detections.clear();
+            return -1;
+        }
+        return default_detector->identify_objects(image, results_detections);
+    }
+
+    int identify_objects(const InputFrame& frame, DetectionBatch &results_detections)
+    {
+        if (!default_detector) 
+        {
+            std::cerr << "[TRT-YOLO] Engine or buffers not initialized!" << std::endl;
+            results_detections.clear();
+            return -1;
+        }
+        return default_detector->identify_objects(frame, results_detections);
+    }
+
+    size_t get_max_detections()
+    {
+        return default_detector ? default_detector->get_max_detections() : 0;
+    }
+
+    void unload_model()
+    {
+        default_detector.reset();
     }
 
 } // namespace TRT::YOLO
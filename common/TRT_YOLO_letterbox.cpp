@@ -0,0 +1,52 @@
+
+#include "include/TRT_YOLO_letterbox.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace TRT::YOLO
+{
+
+    LetterboxInfo LetterboxInfo::fit(int source_width, int source_height, int model_width, int model_height)
+    {
+        if (source_width <= 0 || source_height <= 0 || model_width <= 0 || model_height <= 0)
+        {
+            throw std::invalid_argument("[TRT-YOLO] Invalid letterbox size (source " + std::to_string(source_width)
+                + "x" + std::to_string(source_height) + ", model " + std::to_string(model_width) + "x"
+                + std::to_string(model_height) + ")");
+        }
+
+        LetterboxInfo info;
+        info.source_width = source_width;
+        info.source_height = source_height;
+        info.scale = std::min(static_cast<float>(model_width) / source_width,
+            static_cast<float>(model_height) / source_height);
+
+        // The resized image covers whole pixels; the padding is split, the odd pixel going right / bottom.
+        const int scaled_width = std::min(model_width, static_cast<int>(std::lround(source_width * info.scale)));
+        const int scaled_height = std::min(model_height, static_cast<int>(std::lround(source_height * info.scale)));
+        info.pad_x = static_cast<float>((model_width - scaled_width) / 2);
+        info.pad_y = static_cast<float>((model_height - scaled_height) / 2);
+        return info;
+    }
+
+    bool LetterboxInfo::is_valid() const noexcept
+    {
+        return this->source_width > 0 && this->source_height > 0 && this->scale > 0.0f && std::isfinite(this->scale);
+    }
+
+    bounding_box_t LetterboxInfo::to_source(const bounding_box_t& box) const noexcept
+    {
+        const float inverse_scale = 1.0f / this->scale;
+        const float width = static_cast<float>(this->source_width);
+        const float height = static_cast<float>(this->source_height);
+        const float x1 = letterbox_project(box.x, this->pad_x, inverse_scale, width);
+        const float y1 = letterbox_project(box.y, this->pad_y, inverse_scale, height);
+        const float x2 = letterbox_project(box.x + box.width, this->pad_x, inverse_scale, width);
+        const float y2 = letterbox_project(box.y + box.height, this->pad_y, inverse_scale, height);
+        return {x1, y1, x2 - x1, y2 - y1};
+    }
+
+} // namespace TRT::YOLO
@@ -0,0 +1,358 @@
+#include "include/TRT_YOLO_model_descriptor.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace TRT::YOLO
+{
+
+    namespace
+    {
+
+        std::string trim(const std::string& text)
+        {
+            const size_t first = text.find_first_not_of(" \t\r");
+            if (first == std::string::npos)
+            {
+                return std::string();
+            }
+            return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+        }
+
+        /// @brief Parses a number, or a fraction "a/b" (e.g. 1/255).
+        float parse_float(const std::string& value)
+        {
+            const size_t slash = value.find('/');
+            if (slash != std::string::npos)
+            {
+                const float denominator = parse_float(value.substr(slash + 1));
+                if (denominator == 0.0f)
+                {
+                    throw std::invalid_argument("division by zero in '" + value + "'");
+                }
+                return parse_float(value.substr(0, slash)) / denominator;
+            }
+
+            std::stringstream ss(value);
+            float number = 0.0f;
+            std::string rest;
+            if (!(ss >> number) || ss >> rest || !std::isfinite(number))
+            {
+                throw std::invalid_argument("expected a number, got '" + value + "'");
+            }
+            return number;
+        }
+
+        size_t parse_count(const std::string& value)
+        {
+            const bool is_number = !value.empty() && value.size() <= 9
+                && value.find_first_not_of("0123456789") == std::string::npos;
+            if (!is_number)
+            {
+                throw std::invalid_argument("expected a non-negative integer, got '" + value + "'");
+            }
+            return static_cast<size_t>(std::stoul(value));
+        }
+
+        bool parse_bool(const std::string& value)
+        {
+            if (value == "true" || value == "1" || value == "yes" || value == "on") return true;
+            if (value == "false" || value == "0" || value == "no" || value == "off") return false;
+            throw std::invalid_argument("expected true or false, got '" + value + "'");
+        }
+
+        TensorDataType parse_type(const std::string& value)
+        {
+            TensorDataType dtype = TensorDataType::kFLOAT;
+            if (!parse_data_type(value, dtype))
+            {
+                throw std::invalid_argument("unknown data type '" + value + "'");
+            }
+            return dtype;
+        }
+
+        /// @brief Parses three per-channel values separated by commas and/or spaces.
+        void parse_triplet(const std::string& value, float (&out)[3])
+        {
+            std::string spaced = value;
+            for (char& c : spaced)
+            {
+                if (c == ',') c = ' ';
+            }
+            std::stringstream ss(spaced);
+            std::string item;
+            int count = 0;
+            while (ss >> item)
+            {
+                if (count == 3)
+                {
+                    throw std::invalid_argument("expected 3 values, got '" + value + "'");
+                }
+                out[count++] = parse_float(item);
+            }
+            if (count == 1)
+            {
+                out[1] = out[2] = out[0]; // One value applies to every channel
+            }
+            else if (count != 3)
+            {
+                throw std::invalid_argument("expected 1 or 3 values, got '" + value + "'");
+            }
+        }
+
+        void parse_input_key(ModelDescriptor& descriptor, const std::string& key, const std::string& value)
+        {
+            if (key == "tensor")
+            {
+                descriptor.input_tensor = value;
+            }
+            else if (key == "width" || key == "height" || key == "channels")
+            {
+                const size_t size = parse_count(value);
+                if (size == 0)
+                {
+                    throw std::invalid_argument(key + " must be positive");
+                }
+                int& field = key == "width" ? descriptor.input_width
+                    : key == "height"       ? descriptor.input_height
+                                            : descriptor.input_channels;
+                field = static_cast<int>(size);
+            }
+            else if (key == "dtype")
+            {
+                descriptor.input_type = parse_type(value);
+                descriptor.has_input_type = true;
+            }
+            else if (key == "format")
+            {
+                if (value == "rgb") descriptor.input_format = InputFormat::kRGB;
+                else if (value == "bgr") descriptor.input_format = InputFormat::kBGR;
+                else throw std::invalid_argument("unknown input format '" + value + "' (rgb, bgr)");
+            }
+            else if (key == "scale")
+            {
+                descriptor.input_scale = parse_float(value);
+                if (!(descriptor.input_scale > 0.0f))
+                {
+                    throw std::invalid_argument("scale must be positive");
+                }
+            }
+            else if (key == "mean")
+            {
+                parse_triplet(value, descriptor.input_mean);
+            }
+            else if (key == "std")
+            {
+                parse_triplet(value, descriptor.input_std);
+                for (float deviation : descriptor.input_std)
+                {
+                    if (deviation == 0.0f)
+                    {
+                        throw std::invalid_argument("std must not be zero");
+                    }
+                }
+            }
+            else
+            {
+                throw std::invalid_argument("unknown key '" + key + "' in [input]");
+            }
+        }
+
+        void parse_output_key(ModelDescriptor& descriptor, const std::string& key, const std::string& value)
+        {
+            if (key == "layout")
+            {
+                if (value == "nms_embedded") descriptor.layout = OutputLayout::kEmbeddedNms;
+                else if (value == "raw_v8" || value == "raw_v11") descriptor.layout = OutputLayout::kRawHead;
+                else throw std::invalid_argument("unknown layout '" + value + "' (nms_embedded, raw_v8, raw_v11)");
+                descriptor.has_layout = true;
+            }
+            else if (key == "classes")
+            {
+                descriptor.num_classes = parse_count(value);
+            }
+            else if (key == "rows")
+            {
+                descriptor.rows = parse_count(value);
+            }
+            else if (key == "dtype")
+            {
+                descriptor.output_type = parse_type(value);
+                descriptor.has_output_type = true;
+            }
+            else if (key == "num_dets") descriptor.num_dets_tensor = value;
+            else if (key == "bboxes") descriptor.bboxes_tensor = value;
+            else if (key == "scores") descriptor.scores_tensor = value;
+            else if (key == "labels") descriptor.labels_tensor = value;
+            else
+            {
+                throw std::invalid_argument("unknown key '" + key + "' in [output]");
+            }
+        }
+
+        void parse_postprocess_key(ModelDescriptor& descriptor, const std::string& key, const std::string& value)
+        {
+            if (key == "confidence")
+            {
+                descriptor.confidence_threshold = parse_float(value);
+                if (!std::isfinite(descriptor.confidence_threshold)) // A fraction can overflow
+                {
+                    throw std::invalid_argument("confidence must be finite");
+                }
+            }
+            else if (key == "class_thresholds")
+            {
+                descriptor.class_thresholds_path = value;
+            }
+            else if (key == "cpu_nms")
+            {
+                descriptor.cpu_nms = parse_bool(value);
+            }
+            else if (key == "iou")
+            {
+                // 0 would suppress every box touching a kept one (of its class).
+                descriptor.nms.iou_threshold = parse_float(value);
+                if (!(descriptor.nms.iou_threshold > 0.0f && descriptor.nms.iou_threshold <= 1.0f))
+                {
+                    throw std::invalid_argument("iou must be in (0, 1], got '" + value + "'");
+                }
+            }
+            else if (key == "top_k")
+            {
+                descriptor.nms.top_k = parse_count(value);
+            }
+            else if (key == "max_candidates")
+            {
+                descriptor.nms.max_candidates = parse_count(value);
+            }
+            else if (key == "class_agnostic")
+            {
+                descriptor.nms.class_agnostic = parse_bool(value);
+            }
+            else
+            {
+                throw std::invalid_argument("unknown key '" + key + "' in [postprocess]");
+            }
+        }
+
+    }
+
+    ModelDescriptor ModelDescriptor::load(const std::string& path, const ModelDescriptor& defaults)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            throw std::runtime_error("[TRT-YOLO] Cannot open model descriptor: " + path);
+        }
+        ModelDescriptor descriptor = parse(file, defaults);
+        descriptor.path = path;
+
+        // A relative threshold file set by this descriptor sits next to it.
+        const std::string& thresholds = descriptor.class_thresholds_path;
+        const size_t slash = path.find_last_of('/');
+        if (thresholds != defaults.class_thresholds_path && !thresholds.empty() && thresholds[0] != '/'
+            && slash != std::string::npos)
+        {
+            descriptor.class_thresholds_path = path.substr(0, slash + 1) + thresholds;
+        }
+        return descriptor;
+    }
+
+    ModelDescriptor ModelDescriptor::load(const std::string& path)
+    {
+        return load(path, ModelDescriptor());
+    }
+
+    ModelDescriptor ModelDescriptor::parse(std::istream& in)
+    {
+        return parse(in, ModelDescriptor());
+    }
+
+    ModelDescriptor ModelDescriptor::parse(std::istream& in, const ModelDescriptor& defaults)
+    {
+        ModelDescriptor descriptor = defaults;
+        std::string section;
+        std::string line;
+        int line_number = 0;
+        while (std::getline(in, line))
+        {
+            line_number++;
+            const size_t comment = line.find('#');
+            if (comment != std::string::npos)
+            {
+                line.erase(comment);
+            }
+
+            line = trim(line);
+            if (line.empty())
+            {
+                continue; // Blank line
+            }
+
+            try
+            {
+                if (line.front() == '[')
+                {
+                    section = line.back() == ']' ? trim(line.substr(1, line.size() - 2)) : std::string();
+                    if (section != "input" && section != "output" && section != "postprocess")
+                    {
+                        throw std::invalid_argument("unknown section '" + line + "'");
+                    }
+                    continue;
+                }
+
+                const size_t equals = line.find('=');
+                const std::string key = equals == std::string::npos ? std::string() : trim(line.substr(0, equals));
+                const std::string value = equals == std::string::npos ? std::string() : trim(line.substr(equals + 1));
+                if (key.empty() || value.empty())
+                {
+                    throw std::invalid_argument("expected '<key> = <value>'");
+                }
+
+                if (section.empty())
+                {
+                    if (key != "name")
+                    {
+                        throw std::invalid_argument("unknown key '" + key + "' outside a section");
+                    }
+                    descriptor.name = value;
+                }
+                else if (section == "input")
+                {
+                    parse_input_key(descriptor, key, value);
+                }
+                else if (section == "output")
+                {
+                    parse_output_key(descriptor, key, value);
+                }
+                else
+                {
+                    parse_postprocess_key(descriptor, key, value);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                throw std::runtime_error("[TRT-YOLO] Model descriptor line " + std::to_string(line_number)
+                    + ": " + e.what());
+            }
+        }
+        return descriptor;
+    }
+
+    std::string ModelDescriptor::find_for_model(const std::string& model_path)
+    {
+        const size_t slash = model_path.find_last_of('/');
+        const size_t dot = model_path.find_last_of('.');
+        const bool has_extension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+        const std::string path = (has_extension ? model_path.substr(0, dot) : model_path) + ".ini";
+        return std::ifstream(path).good() ? path : std::string();
+    }
+
+    const char* output_layout_name(OutputLayout layout) noexcept
+    {
+        return layout == OutputLayout::kRawHead ? "raw_v8" : "nms_embedded";
+    }
+
+}
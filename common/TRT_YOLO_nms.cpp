@@ -0,0 +1,553 @@
+
+#include "include/TRT_YOLO_nms.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+// TRT_YOLO_EMULATE_NEON builds the NEON kernels on any host, over tests/neon_emulation/arm_neon.h.
+#if defined(__aarch64__) || defined(TRT_YOLO_EMULATE_NEON)
+#define TRT_YOLO_NEON_KERNELS 1
+#include <arm_neon.h>
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TRT_YOLO_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace TRT::YOLO
+{
+
+    void NmsWorkspace::reserve(size_t candidates)
+    {
+        if (this->order.size() >= candidates)
+        {
+            return;
+        }
+        for (auto* v : {&this->keys, &this->keys_swap, &this->order, &this->order_swap, &this->ranked,
+                        &this->position, &this->group_end, &this->selected})
+        {
+            v->resize(candidates);
+        }
+        for (auto* v : {&this->x1, &this->y1, &this->x2, &this->y2, &this->area,
+                        &this->fused_weight, &this->fused_x1, &this->fused_y1, &this->fused_x2, &this->fused_y2})
+        {
+            v->resize(candidates);
+        }
+        this->class_id.resize(candidates);
+        this->view.resize(candidates);
+        this->suppressed.resize(candidates);
+    }
+
+    namespace
+    {
+        /// @brief Below this many candidates a comparison sort beats the radix passes.
+        constexpr size_t RADIX_SORT_MIN_CANDIDATES = 256;
+
+        /// @brief Sort key of a score: ascending keys give descending scores (-0 ranks as +0).
+        inline uint32_t descending_key(float score) noexcept
+        {
+            if (score == 0.0f)
+            {
+                score = 0.0f;
+            }
+            uint32_t bits;
+            std::memcpy(&bits, &score, sizeof(bits));
+            const uint32_t ordered = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+            return ~ordered;
+        }
+
+        /// @brief Stable LSD radix sort of workspace.order[0, n) by workspace.keys, one byte per pass.
+        /// Passes where every key has the same byte (e.g. the exponent of scores in [0, 1], or the high bytes
+        /// of class ids) are skipped.
+        /// @return The array holding the sorted order (workspace.order or workspace.order_swap)
+        uint32_t* radix_sort(NmsWorkspace& workspace, size_t n) noexcept
+        {
+            uint32_t* keys = workspace.keys.data();
+            uint32_t* order = workspace.order.data();
+            uint32_t* keys_out = workspace.keys_swap.data();
+            uint32_t* order_out = workspace.order_swap.data();
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                size_t counts[256] = {};
+                for (size_t i = 0; i < n; i++)
+                {
+                    counts[(keys[i] >> shift) & 0xFF]++;
+                }
+                if (counts[(keys[0] >> shift) & 0xFF] == n)
+                {
+                    continue;
+                }
+                size_t offset = 0;
+                for (size_t& count : counts)
+                {
+                    const size_t bucket = count;
+                    count = offset;
+                    offset += bucket;
+                }
+                for (size_t i = 0; i < n; i++)
+                {
+                    const size_t dst = counts[(keys[i] >> shift) & 0xFF]++;
+                    keys_out[dst] = keys[i];
+                    order_out[dst] = order[i];
+                }
+                std::swap(keys, keys_out);
+                std::swap(order, order_out);
+            }
+            return order;
+        }
+
+        /// @brief Ranks the candidates by descending confidence (ties by index) and keeps the first max_candidates.
+        /// @return The ranked candidate indices; count receives their number.
+        const uint32_t* rank_candidates(const DetectionBatch& candidates, const NmsConfig& config,
+            NmsWorkspace& workspace, size_t& count)
+        {
+            const float* confidence = candidates.confidence();
+            uint32_t* order = workspace.order.data();
+            size_t n = 0;
+            for (size_t i = 0; i < candidates.size(); i++)
+            {
+                if (!std::isnan(confidence[i]))
+                {
+                    workspace.keys[n] = descending_key(confidence[i]);
+                    order[n] = static_cast<uint32_t>(i);
+                    n++;
+                }
+            }
+            count = config.max_candidates > 0 ? std::min(config.max_candidates, n) : n;
+            if (n == 0)
+            {
+                return order;
+            }
+
+            auto ranks_before = [confidence](uint32_t a, uint32_t b) {
+                return confidence[a] > confidence[b] || (confidence[a] == confidence[b] && a < b);
+            };
+            if (count < n / 8)
+            {
+                // Only a few of many candidates survive the cut: select them, then sort just those.
+                std::nth_element(order, order + count, order + n, ranks_before);
+                std::sort(order, order + count, ranks_before);
+                return order;
+            }
+            if (n >= RADIX_SORT_MIN_CANDIDATES)
+            {
+                return radix_sort(workspace, n);
+            }
+            std::sort(order, order + n, ranks_before);
+            return order;
+        }
+
+        /// @brief Ranked candidates as corners, read by the suppression kernels. suppressed[j] is 0, or the
+        /// grouped position + 1 of the first box that suppressed box j.
+        struct RankedBoxes
+        {
+            const float* x1;
+            const float* y1;
+            const float* x2;
+            const float* y2;
+            const float* area;
+            const int32_t* class_id;
+            const int32_t* view; // Read only with SuppressParams::views
+            int32_t* suppressed;
+        };
+
+        /// @brief Settings of one suppression scan.
+        struct SuppressParams
+        {
+            float threshold;
+            bool class_agnostic;
+            bool smaller_area; // OverlapMetric::kIoS
+            bool views;        // Boxes of the same view never suppress each other
+        };
+
+        // Same NaN handling as the SSE / AVX min and max instructions (the second operand wins), so every
+        // kernel gives identical results.
+        inline float min_like_simd(float a, float b) noexcept { return a < b ? a : b; }
+        inline float max_like_simd(float a, float b) noexcept { return a > b ? a : b; }
+
+        /// @brief Reference kernel: marks the boxes in [begin, end) that box i suppresses (unless already marked).
+        void suppress_scalar(const RankedBoxes& boxes, size_t i, size_t begin, size_t end,
+            const SuppressParams& params) noexcept
+        {
+            const float bx1 = boxes.x1[i], by1 = boxes.y1[i], bx2 = boxes.x2[i], by2 = boxes.y2[i];
+            const float barea = boxes.area[i];
+            const int32_t bclass = boxes.class_id[i];
+            const int32_t bview = boxes.view[i];
+            const int32_t owner = static_cast<int32_t>(i) + 1;
+            for (size_t j = begin; j < end; j++)
+            {
+                // IoU > t  <=>  intersection > t * union (no division; a zero union never suppresses), and
+                // likewise with the smaller area for IoS.
+                const float iw = max_like_simd(min_like_simd(bx2, boxes.x2[j]) - max_like_simd(bx1, boxes.x1[j]), 0.0f);
+                const float ih = max_like_simd(min_like_simd(by2, boxes.y2[j]) - max_like_simd(by1, boxes.y1[j]), 0.0f);
+                const float inter = iw * ih;
+                const float base = params.smaller_area ? min_like_simd(barea, boxes.area[j]) : barea + boxes.area[j] - inter;
+                const bool overlaps = inter > params.threshold * base;
+                if (overlaps && (params.class_agnostic || boxes.class_id[j] == bclass)
+                    && !(params.views && boxes.view[j] == bview) && boxes.suppressed[j] == 0)
+                {
+                    boxes.suppressed[j] = owner;
+                }
+            }
+        }
+
+#if defined(TRT_YOLO_X86_KERNELS)
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+// GCC's AVX-512 intrinsics seed results with _mm512_undefined_*(), which trips a false positive.
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+        /// @return First box not processed (the rest is left to suppress_scalar())
+        __attribute__((target("avx2")))
+        size_t suppress_avx2(const RankedBoxes& boxes, size_t i, size_t begin, size_t end,
+            const SuppressParams& params) noexcept
+        {
+            const __m256 bx1 = _mm256_set1_ps(boxes.x1[i]);
+            const __m256 by1 = _mm256_set1_ps(boxes.y1[i]);
+            const __m256 bx2 = _mm256_set1_ps(boxes.x2[i]);
+            const __m256 by2 = _mm256_set1_ps(boxes.y2[i]);
+            const __m256 barea = _mm256_set1_ps(boxes.area[i]);
+            const __m256i bclass = _mm256_set1_epi32(boxes.class_id[i]);
+            const __m256i any_class = _mm256_set1_epi32(params.class_agnostic ? -1 : 0);
+            const __m256i bview = _mm256_set1_epi32(boxes.view[i]);
+            const __m256i views = _mm256_set1_epi32(params.views ? -1 : 0);
+            const __m256 smaller_area = _mm256_castsi256_ps(_mm256_set1_epi32(params.smaller_area ? -1 : 0));
+            const __m256 threshold = _mm256_set1_ps(params.threshold);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256i owner = _mm256_set1_epi32(static_cast<int32_t>(i) + 1);
+            size_t j = begin;
+            for (; j + 8 <= end; j += 8)
+            {
+                const __m256 iw = _mm256_max_ps(_mm256_sub_ps(_mm256_min_ps(bx2, _mm256_loadu_ps(boxes.x2 + j)),
+                    _mm256_max_ps(bx1, _mm256_loadu_ps(boxes.x1 + j))), zero);
+                const __m256 ih = _mm256_max_ps(_mm256_sub_ps(_mm256_min_ps(by2, _mm256_loadu_ps(boxes.y2 + j)),
+                    _mm256_max_ps(by1, _mm256_loadu_ps(boxes.y1 + j))), zero);
+                const __m256 inter = _mm256_mul_ps(iw, ih);
+                const __m256 area = _mm256_loadu_ps(boxes.area + j);
+                const __m256 base = _mm256_blendv_ps(_mm256_sub_ps(_mm256_add_ps(barea, area), inter),
+                    _mm256_min_ps(barea, area), smaller_area);
+                const __m256 overlaps = _mm256_cmp_ps(inter, _mm256_mul_ps(threshold, base), _CMP_GT_OQ);
+                const __m256i same_class = _mm256_or_si256(any_class, _mm256_cmpeq_epi32(bclass,
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boxes.class_id + j))));
+                const __m256i same_view = _mm256_and_si256(views, _mm256_cmpeq_epi32(bview,
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boxes.view + j))));
+                __m256i* flags = reinterpret_cast<__m256i*>(boxes.suppressed + j);
+                const __m256i current = _mm256_loadu_si256(flags);
+                const __m256i hit = _mm256_andnot_si256(same_view, _mm256_and_si256(_mm256_and_si256(
+                    _mm256_castps_si256(overlaps), same_class), _mm256_cmpeq_epi32(current, _mm256_setzero_si256())));
+                _mm256_storeu_si256(flags, _mm256_blendv_epi8(current, owner, hit));
+            }
+            return j;
+        }
+
+        /// @return First box not processed (the rest is left to suppress_scalar())
+        __attribute__((target("avx512f")))
+        size_t suppress_avx512(const RankedBoxes& boxes, size_t i, size_t begin, size_t end,
+            const SuppressParams& params) noexcept
+        {
+            const __m512 bx1 = _mm512_set1_ps(boxes.x1[i]);
+            const __m512 by1 = _mm512_set1_ps(boxes.y1[i]);
+            const __m512 bx2 = _mm512_set1_ps(boxes.x2[i]);
+            const __m512 by2 = _mm512_set1_ps(boxes.y2[i]);
+            const __m512 barea = _mm512_set1_ps(boxes.area[i]);
+            const __m512i bclass = _mm512_set1_epi32(boxes.class_id[i]);
+            const __mmask16 any_class = params.class_agnostic ? 0xFFFF : 0;
+            const __m512i bview = _mm512_set1_epi32(boxes.view[i]);
+            const __mmask16 views = params.views ? 0xFFFF : 0;
+            const __mmask16 smaller_area = params.smaller_area ? 0xFFFF : 0;
+            const __m512 threshold = _mm512_set1_ps(params.threshold);
+            const __m512 zero = _mm512_setzero_ps();
+            const __m512i owner = _mm512_set1_epi32(static_cast<int32_t>(i) + 1);
+            size_t j = begin;
+            for (; j + 16 <= end; j += 16)
+            {
+                const __m512 iw = _mm512_max_ps(_mm512_sub_ps(_mm512_min_ps(bx2, _mm512_loadu_ps(boxes.x2 + j)),
+                    _mm512_max_ps(bx1, _mm512_loadu_ps(boxes.x1 + j))), zero);
+                const __m512 ih = _mm512_max_ps(_mm512_sub_ps(_mm512_min_ps(by2, _mm512_loadu_ps(boxes.y2 + j)),
+                    _mm512_max_ps(by1, _mm512_loadu_ps(boxes.y1 + j))), zero);
+                const __m512 inter = _mm512_mul_ps(iw, ih);
+                const __m512 area = _mm512_loadu_ps(boxes.area + j);
+                const __m512 base = _mm512_mask_blend_ps(smaller_area, _mm512_sub_ps(_mm512_add_ps(barea, area), inter),
+                    _mm512_min_ps(barea, area));
+                const __mmask16 overlaps = _mm512_cmp_ps_mask(inter, _mm512_mul_ps(threshold, base), _CMP_GT_OQ);
+                const __mmask16 same_class = any_class | _mm512_cmpeq_epi32_mask(bclass, _mm512_loadu_si512(boxes.class_id + j));
+                const __mmask16 other_view = ~(views & _mm512_cmpeq_epi32_mask(bview, _mm512_loadu_si512(boxes.view + j)));
+                const __mmask16 unmarked = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(boxes.suppressed + j),
+                    _mm512_setzero_si512());
+                _mm512_mask_storeu_epi32(boxes.suppressed + j, overlaps & same_class & other_view & unmarked, owner);
+            }
+            return j;
+        }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif // TRT_YOLO_X86_KERNELS
+
+#if defined(TRT_YOLO_NEON_KERNELS)
+
+        // vminq / vmaxq propagate NaN; these pick like the scalar reference instead.
+        inline float32x4_t min_like_simd(float32x4_t a, float32x4_t b) noexcept { return vbslq_f32(vcltq_f32(a, b), a, b); }
+        inline float32x4_t max_like_simd(float32x4_t a, float32x4_t b) noexcept { return vbslq_f32(vcgtq_f32(a, b), a, b); }
+
+        /// @return First box not processed (the rest is left to suppress_scalar())
+        size_t suppress_neon(const RankedBoxes& boxes, size_t i, size_t begin, size_t end,
+            const SuppressParams& params) noexcept
+        {
+            const float32x4_t bx1 = vdupq_n_f32(boxes.x1[i]);
+            const float32x4_t by1 = vdupq_n_f32(boxes.y1[i]);
+            const float32x4_t bx2 = vdupq_n_f32(boxes.x2[i]);
+            const float32x4_t by2 = vdupq_n_f32(boxes.y2[i]);
+            const float32x4_t barea = vdupq_n_f32(boxes.area[i]);
+            const int32x4_t bclass = vdupq_n_s32(boxes.class_id[i]);
+            const uint32x4_t any_class = vdupq_n_u32(params.class_agnostic ? 0xFFFFFFFFu : 0u);
+            const int32x4_t bview = vdupq_n_s32(boxes.view[i]);
+            const uint32x4_t views = vdupq_n_u32(params.views ? 0xFFFFFFFFu : 0u);
+            const uint32x4_t smaller_area = vdupq_n_u32(params.smaller_area ? 0xFFFFFFFFu : 0u);
+            const float32x4_t threshold = vdupq_n_f32(params.threshold);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            const int32x4_t owner = vdupq_n_s32(static_cast<int32_t>(i) + 1);
+            size_t j = begin;
+            for (; j + 4 <= end; j += 4)
+            {
+                const float32x4_t iw = max_like_simd(vsubq_f32(min_like_simd(bx2, vld1q_f32(boxes.x2 + j)),
+                    max_like_simd(bx1, vld1q_f32(boxes.x1 + j))), zero);
+                const float32x4_t ih = max_like_simd(vsubq_f32(min_like_simd(by2, vld1q_f32(boxes.y2 + j)),
+                    max_like_simd(by1, vld1q_f32(boxes.y1 + j))), zero);
+                const float32x4_t inter = vmulq_f32(iw, ih);
+                const float32x4_t area = vld1q_f32(boxes.area + j);
+                const float32x4_t base = vbslq_f32(smaller_area, min_like_simd(barea, area),
+                    vsubq_f32(vaddq_f32(barea, area), inter));
+                const uint32x4_t overlaps = vcgtq_f32(inter, vmulq_f32(threshold, base));
+                const uint32x4_t same_class = vorrq_u32(any_class, vceqq_s32(bclass, vld1q_s32(boxes.class_id + j)));
+                const uint32x4_t same_view = vandq_u32(views, vceqq_s32(bview, vld1q_s32(boxes.view + j)));
+                const int32x4_t current = vld1q_s32(boxes.suppressed + j);
+                const uint32x4_t hit = vbicq_u32(vandq_u32(vandq_u32(overlaps, same_class),
+                    vceqq_s32(current, vdupq_n_s32(0))), same_view);
+                vst1q_s32(boxes.suppressed + j, vbslq_s32(hit, owner, current));
+            }
+            return j;
+        }
+
+#endif // TRT_YOLO_NEON_KERNELS
+
+        void suppress(SimdLevel level, const RankedBoxes& boxes, size_t i, size_t begin, size_t end,
+            const SuppressParams& params) noexcept
+        {
+            switch (level)
+            {
+#if defined(TRT_YOLO_X86_KERNELS)
+                case SimdLevel::kAVX512:
+                    begin = suppress_avx512(boxes, i, begin, end, params);
+                    break;
+                case SimdLevel::kAVX2:
+                    begin = suppress_avx2(boxes, i, begin, end, params);
+                    break;
+#endif
+#if defined(TRT_YOLO_NEON_KERNELS)
+                case SimdLevel::kNEON:
+                    begin = suppress_neon(boxes, i, begin, end, params);
+                    break;
+#endif
+                default:
+                    break;
+            }
+            suppress_scalar(boxes, i, begin, end, params);
+        }
+
+        /// @brief The greedy pass shared by non_max_suppression() and weighted_box_fusion(): ranks and groups the
+        /// candidates into the workspace, then keeps up to top_k boxes, each suppressing (and claiming, in
+        /// workspace.suppressed) what it overlaps further down its group.
+        /// @param count Receives the number of ranked candidates (workspace.ranked[0, count))
+        /// @return Number of kept boxes, whose ranks are workspace.selected[0, n)
+        size_t select_boxes(const DetectionBatch& candidates, const NmsConfig& config, NmsWorkspace& workspace,
+            SimdLevel level, const int32_t* views, size_t& count)
+        {
+            workspace.reserve(candidates.size());
+
+            count = 0;
+            const uint32_t* order = rank_candidates(candidates, config, workspace, count);
+            std::copy(order, order + count, workspace.ranked.begin());
+            const uint32_t* ranked = workspace.ranked.data();
+            const int32_t* class_ids = candidates.class_id();
+
+            // Boxes only suppress boxes of their own class, so group the ranks by class (a stable sort keeps
+            // rank order within each class) and let every kept box scan the rest of its own group only.
+            for (size_t r = 0; r < count; r++)
+            {
+                workspace.keys[r] = config.class_agnostic ? 0u : static_cast<uint32_t>(class_ids[ranked[r]]) ^ 0x80000000u;
+                workspace.order[r] = static_cast<uint32_t>(r);
+            }
+            const uint32_t* grouped = count > 0 ? radix_sort(workspace, count) : workspace.order.data();
+
+            // Gather the grouped boxes as corners.
+            const float* x = candidates.x();
+            const float* y = candidates.y();
+            const float* width = candidates.width();
+            const float* height = candidates.height();
+            for (size_t g = 0; g < count; g++)
+            {
+                const uint32_t c = ranked[grouped[g]];
+                workspace.x1[g] = x[c];
+                workspace.y1[g] = y[c];
+                workspace.x2[g] = x[c] + width[c];
+                workspace.y2[g] = y[c] + height[c];
+                workspace.area[g] = max_like_simd(workspace.x2[g] - workspace.x1[g], 0.0f)
+                    * max_like_simd(workspace.y2[g] - workspace.y1[g], 0.0f);
+                workspace.class_id[g] = class_ids[c];
+                if (views != nullptr)
+                {
+                    workspace.view[g] = views[c];
+                }
+                workspace.suppressed[g] = 0;
+                workspace.position[grouped[g]] = static_cast<uint32_t>(g);
+            }
+            for (size_t g = count; g-- > 0; )
+            {
+                const bool last_of_group = g + 1 == count || (!config.class_agnostic && workspace.class_id[g + 1] != workspace.class_id[g]);
+                workspace.group_end[g] = last_of_group ? static_cast<uint32_t>(g + 1) : workspace.group_end[g + 1];
+            }
+            const RankedBoxes boxes{workspace.x1.data(), workspace.y1.data(), workspace.x2.data(), workspace.y2.data(),
+                workspace.area.data(), workspace.class_id.data(), workspace.view.data(), workspace.suppressed.data()};
+
+            // Greedy pass in rank order: the best remaining box is kept and suppresses what it overlaps further
+            // down its group.
+            const SimdLevel resolved = resolve_simd_level(level);
+            const SuppressParams params{config.iou_threshold, config.class_agnostic, config.metric == OverlapMetric::kIoS,
+                views != nullptr};
+            const size_t limit = config.top_k > 0 ? config.top_k : count;
+            size_t selected = 0;
+            for (size_t r = 0; r < count && selected < limit; r++)
+            {
+                const uint32_t g = workspace.position[r];
+                if (boxes.suppressed[g])
+                {
+                    continue;
+                }
+                workspace.selected[selected++] = static_cast<uint32_t>(r);
+                suppress(resolved, boxes, g, g + 1, workspace.group_end[g], params);
+            }
+            return selected;
+        }
+
+        /// @brief Appends a box given by its model-space corners, mapped back to source pixels like the filter kernels.
+        void emit_projected(DetectionBatch& output, const LetterboxInfo& letterbox, float x1, float y1, float x2,
+            float y2, float confidence, int32_t class_id)
+        {
+            const float inverse_scale = 1.0f / letterbox.scale;
+            const float source_width = static_cast<float>(letterbox.source_width);
+            const float source_height = static_cast<float>(letterbox.source_height);
+            x1 = letterbox_project(x1, letterbox.pad_x, inverse_scale, source_width);
+            y1 = letterbox_project(y1, letterbox.pad_y, inverse_scale, source_height);
+            x2 = letterbox_project(x2, letterbox.pad_x, inverse_scale, source_width);
+            y2 = letterbox_project(y2, letterbox.pad_y, inverse_scale, source_height);
+            output.push_back(x1, y1, x2 - x1, y2 - y1, confidence, class_id);
+        }
+    }
+
+    size_t non_max_suppression(const DetectionBatch& candidates, DetectionBatch& kept, const NmsConfig& config,
+        NmsWorkspace& workspace, SimdLevel level, const LetterboxInfo* letterbox, const int32_t* views)
+    {
+        kept.clear();
+        size_t count = 0;
+        const size_t selected = select_boxes(candidates, config, workspace, level, views, count);
+        for (size_t s = 0; s < selected; s++)
+        {
+            const uint32_t r = workspace.selected[s];
+            const uint32_t g = workspace.position[r];
+            const uint32_t c = workspace.ranked[r];
+            if (letterbox != nullptr)
+            {
+                emit_projected(kept, *letterbox, workspace.x1[g], workspace.y1[g], workspace.x2[g], workspace.y2[g],
+                    candidates.confidence()[c], candidates.class_id()[c]);
+            }
+            else
+            {
+                kept.push_back(candidates.x()[c], candidates.y()[c], candidates.width()[c], candidates.height()[c],
+                    candidates.confidence()[c], candidates.class_id()[c]);
+            }
+        }
+        return kept.size();
+    }
+
+    size_t weighted_box_fusion(const DetectionBatch& candidates, DetectionBatch& fused, const NmsConfig& config,
+        NmsWorkspace& workspace, SimdLevel level, const LetterboxInfo* letterbox, const int32_t* views)
+    {
+        fused.clear();
+        size_t count = 0;
+        const size_t selected = select_boxes(candidates, config, workspace, level, views, count);
+        const float* confidence = candidates.confidence();
+
+        // Each cluster starts with its kept box, then gathers the boxes that box suppressed first (the owner
+        // recorded by the kernels; only kept boxes suppress). Weights are the confidences, clamped at 0.
+        for (size_t s = 0; s < selected; s++)
+        {
+            const uint32_t g = workspace.position[workspace.selected[s]];
+            workspace.fused_weight[g] = 0.0f;
+            workspace.fused_x1[g] = 0.0f;
+            workspace.fused_y1[g] = 0.0f;
+            workspace.fused_x2[g] = 0.0f;
+            workspace.fused_y2[g] = 0.0f;
+        }
+        const size_t last_kept = selected > 0 ? workspace.selected[selected - 1] : 0;
+        for (size_t r = 0; r < count; r++)
+        {
+            const uint32_t g = workspace.position[r];
+            const int32_t owner = workspace.suppressed[g];
+            if (owner == 0 && r > last_kept)
+            {
+                continue; // Never suppressed, but ranked after the top_k-th kept box: not in any cluster
+            }
+            const uint32_t cluster = owner != 0 ? static_cast<uint32_t>(owner - 1) : g;
+            const float weight = max_like_simd(confidence[workspace.ranked[r]], 0.0f);
+            workspace.fused_weight[cluster] += weight;
+            workspace.fused_x1[cluster] += weight * workspace.x1[g];
+            workspace.fused_y1[cluster] += weight * workspace.y1[g];
+            workspace.fused_x2[cluster] += weight * workspace.x2[g];
+            workspace.fused_y2[cluster] += weight * workspace.y2[g];
+        }
+
+        for (size_t s = 0; s < selected; s++)
+        {
+            const uint32_t r = workspace.selected[s];
+            const uint32_t g = workspace.position[r];
+            const uint32_t c = workspace.ranked[r];
+            float x1 = workspace.x1[g], y1 = workspace.y1[g], x2 = workspace.x2[g], y2 = workspace.y2[g];
+            const float weight = workspace.fused_weight[g];
+            if (weight > 0.0f)
+            {
+                const float inverse_weight = 1.0f / weight;
+                x1 = workspace.fused_x1[g] * inverse_weight;
+                y1 = workspace.fused_y1[g] * inverse_weight;
+                x2 = workspace.fused_x2[g] * inverse_weight;
+                y2 = workspace.fused_y2[g] * inverse_weight;
+            }
+            if (letterbox != nullptr)
+            {
+                emit_projected(fused, *letterbox, x1, y1, x2, y2, confidence[c], candidates.class_id()[c]);
+            }
+            else
+            {
+                fused.push_back(x1, y1, x2 - x1, y2 - y1, confidence[c], candidates.class_id()[c]);
+            }
+        }
+        return fused.size();
+    }
+
+    size_t non_max_suppression(const DetectionBatch* candidates, DetectionBatch* kept, size_t num_frames,
+        const NmsConfig& config, NmsWorkspace& workspace, SimdLevel level, const LetterboxInfo* letterboxes)
+    {
+        size_t total = 0;
+        for (size_t f = 0; f < num_frames; f++)
+        {
+            total += non_max_suppression(candidates[f], kept[f], config, workspace, level, 
+                letterboxes != nullptr ? &letterboxes[f] : nullptr);
+        }
+        return total;
+    }
+
+} // namespace TRT::YOLO
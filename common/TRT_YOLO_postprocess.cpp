@@ -0,0 +1,1172 @@
+
+#include "include/TRT_YOLO_postprocess.hpp"
+#include "TensorRT_CPP/TRT_half.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+// TRT_YOLO_EMULATE_NEON builds the NEON kernels on any host, over tests/neon_emulation/arm_neon.h.
+#if defined(__aarch64__) || defined(TRT_YOLO_EMULATE_NEON)
+#define TRT_YOLO_NEON_KERNELS 1
+#include <arm_neon.h>
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TRT_YOLO_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace TRT::YOLO
+{
+
+    ClassThresholds::ClassThresholds(float default_threshold)
+        : table_(1, default_threshold)
+    {
+    }
+
+    void ClassThresholds::set(int class_id, float threshold)
+    {
+        if (class_id < 0 || class_id > MAX_THRESHOLD_CLASS_ID)
+        {
+            throw std::out_of_range("[TRT-YOLO] Class id out of range (0-" + std::to_string(MAX_THRESHOLD_CLASS_ID)
+                + "): " + std::to_string(class_id));
+        }
+        if (static_cast<uint32_t>(class_id) >= this->num_classes())
+        {
+            // New classes up to class_id start at the default, which stays the last entry.
+            this->table_.resize(class_id + 2, this->get_default());
+        }
+        this->table_[class_id] = threshold;
+    }
+
+    ClassThresholds ClassThresholds::load(const std::string& path, float default_threshold)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            throw std::runtime_error("[TRT-YOLO] Cannot open threshold file: " + path);
+        }
+        return parse(file, default_threshold);
+    }
+
+    ClassThresholds ClassThresholds::parse(std::istream& in, float default_threshold)
+    {
+        std::vector<std::pair<int, float>> entries;
+        std::string line;
+        int line_number = 0;
+        while (std::getline(in, line))
+        {
+            line_number++;
+            const size_t comment = line.find('#');
+            if (comment != std::string::npos)
+            {
+                line.erase(comment);
+            }
+
+            std::stringstream ss(line);
+            std::string key;
+            if (!(ss >> key))
+            {
+                continue; // Blank line
+            }
+
+            try
+            {
+                float threshold = 0.0f;
+                if (!(ss >> threshold) || std::isnan(threshold))
+                {
+                    throw std::invalid_argument("expected '<class_id | default> <threshold>'");
+                }
+                if (key == "default")
+                {
+                    default_threshold = threshold;
+                    continue;
+                }
+                const bool is_number = key.size() <= 5 && key.find_first_not_of("0123456789") == std::string::npos;
+                const int class_id = is_number ? std::stoi(key) : -1;
+                if (class_id < 0 || class_id > MAX_THRESHOLD_CLASS_ID)
+                {
+                    throw std::invalid_argument("invalid class id '" + key + "'");
+                }
+                entries.emplace_back(class_id, threshold);
+            }
+            catch (const std::exception& e)
+            {
+                throw std::runtime_error("[TRT-YOLO] Threshold file line " + std::to_string(line_number)
+                    + ": " + e.what());
+            }
+        }
+
+        // Applied after reading everything, so a 'default' line may come anywhere.
+        ClassThresholds thresholds(default_threshold);
+        for (const auto& entry : entries)
+        {
+            thresholds.set(entry.first, entry.second);
+        }
+        return thresholds;
+    }
+
+    namespace
+    {
+        /// @brief Destination of a filter kernel, with the running counts.
+        struct FilterOutput
+        {
+            float* x;
+            float* y;
+            float* width;
+            float* height;
+            float* confidence;
+            int32_t* class_id;
+            size_t capacity;
+            size_t padded_capacity;
+            size_t count;
+            size_t dropped;
+
+            // Back-projection to source pixels (when project is set), see letterbox_project().
+            bool project;
+            float pad_x;
+            float pad_y;
+            float inverse_scale;
+            float limit_x;
+            float limit_y;
+        };
+
+        FilterOutput make_filter_output(DetectionBatch& out, const LetterboxInfo* letterbox) noexcept
+        {
+            FilterOutput result{out.x(), out.y(), out.width(), out.height(), out.confidence(), out.class_id(),
+                out.capacity(), out.padded_capacity(), 0, 0, false, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f};
+            if (letterbox != nullptr)
+            {
+                result.project = true;
+                result.pad_x = letterbox->pad_x;
+                result.pad_y = letterbox->pad_y;
+                result.inverse_scale = 1.0f / letterbox->scale;
+                result.limit_x = static_cast<float>(letterbox->source_width);
+                result.limit_y = static_cast<float>(letterbox->source_height);
+            }
+            return result;
+        }
+
+        /// @brief Stores one box given by its corners, back-projected first if out.project is set.
+        inline void store_corners(float x1, float y1, float x2, float y2, FilterOutput& out) noexcept
+        {
+            if (out.project)
+            {
+                x1 = letterbox_project(x1, out.pad_x, out.inverse_scale, out.limit_x);
+                y1 = letterbox_project(y1, out.pad_y, out.inverse_scale, out.limit_y);
+                x2 = letterbox_project(x2, out.pad_x, out.inverse_scale, out.limit_x);
+                y2 = letterbox_project(y2, out.pad_y, out.inverse_scale, out.limit_y);
+            }
+            out.x[out.count] = x1;
+            out.y[out.count] = y1;
+            out.width[out.count] = x2 - x1;
+            out.height[out.count] = y2 - y1;
+        }
+
+        /// @brief Reference kernel; also finishes the rows a vector kernel leaves over.
+        void filter_scalar(const float* boxes_xyxy, const float* scores, const int32_t* class_ids,
+            size_t begin, size_t end, const float* table, uint32_t num_classes, FilterOutput& out) noexcept
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const uint32_t slot = static_cast<uint32_t>(class_ids[i]);
+                const float score = scores[i];
+                if (!(score >= table[slot < num_classes ? slot : num_classes]))
+                {
+                    continue;
+                }
+                if (out.count == out.capacity)
+                {
+                    out.dropped++;
+                    continue;
+                }
+                const float* box = boxes_xyxy + i * 4;
+                store_corners(box[0], box[1], box[2], box[3], out);
+                out.confidence[out.count] = score;
+                out.class_id[out.count] = class_ids[i];
+                out.count++;
+            }
+        }
+
+        /// @brief Clamps a block's survivors to the room left in out, counting the rest as dropped.
+        /// Survivors are kept in row order, so the same rows are dropped as by filter_scalar().
+        inline size_t fit_survivors(size_t survivors, FilterOutput& out) noexcept
+        {
+            const size_t room = out.capacity - out.count;
+            if (survivors > room)
+            {
+                out.dropped += survivors - room;
+                return room;
+            }
+            return survivors;
+        }
+
+        /// @brief Anchors per block of the raw-head decoders: the class rows are scanned a block at a time, so
+        /// each row contributes a few whole cache lines and the running maxima stay in registers.
+        constexpr size_t DECODE_BLOCK = 16;
+
+        /// @brief Stores one decoded anchor if its score passes the threshold of its class.
+        inline void decode_anchor(const float* head, size_t num_anchors, size_t anchor, float score, int32_t class_id,
+            const float* table, uint32_t threshold_classes, FilterOutput& out) noexcept
+        {
+            const uint32_t slot = static_cast<uint32_t>(class_id);
+            if (!(score >= table[slot < threshold_classes ? slot : threshold_classes]))
+            {
+                return;
+            }
+            if (out.count == out.capacity)
+            {
+                out.dropped++;
+                return;
+            }
+            const float cx = head[anchor];
+            const float cy = head[num_anchors + anchor];
+            const float w = head[2 * num_anchors + anchor];
+            const float h = head[3 * num_anchors + anchor];
+            if (out.project)
+            {
+                store_corners(cx - w * 0.5f, cy - h * 0.5f, cx + w * 0.5f, cy + h * 0.5f, out);
+            }
+            else
+            {
+                out.x[out.count] = cx - w * 0.5f;
+                out.y[out.count] = cy - h * 0.5f;
+                out.width[out.count] = w;
+                out.height[out.count] = h;
+            }
+            out.confidence[out.count] = score;
+            out.class_id[out.count] = class_id;
+            out.count++;
+        }
+
+        /// @brief Reference raw-head decoder; also finishes the anchors a vector kernel leaves over.
+        template <class Dims>
+        void decode_scalar(const float* head, Dims dims, size_t begin,
+            const float* table, uint32_t threshold_classes, FilterOutput& out) noexcept
+        {
+            const size_t num_classes = dims.classes();
+            const size_t num_anchors = dims.anchors();
+            const float* scores = head + 4 * num_anchors;
+            float best[DECODE_BLOCK];
+            int32_t best_class[DECODE_BLOCK];
+            for (size_t i = begin; i < num_anchors; i += DECODE_BLOCK)
+            {
+                const size_t n = std::min(DECODE_BLOCK, num_anchors - i);
+                for (size_t j = 0; j < n; j++)
+                {
+                    best[j] = scores[i + j];
+                    best_class[j] = 0;
+                }
+                for (size_t c = 1; c < num_classes; c++)
+                {
+                    const float* row = scores + c * num_anchors + i;
+                    for (size_t j = 0; j < n; j++)
+                    {
+                        if (row[j] > best[j])
+                        {
+                            best[j] = row[j];
+                            best_class[j] = static_cast<int32_t>(c);
+                        }
+                    }
+                }
+                for (size_t j = 0; j < n; j++)
+                {
+                    decode_anchor(head, num_anchors, i + j, best[j], best_class[j], table, threshold_classes, out);
+                }
+            }
+        }
+
+#if defined(TRT_YOLO_X86_KERNELS)
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+// GCC's AVX-512 intrinsics seed results with _mm512_undefined_*(), which trips false positives.
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+        /// @brief For every 8-bit lane mask, the lanes that are set, in order (then zeros).
+        struct alignas(32) CompactionTable
+        {
+            int32_t lanes[256][8];
+        };
+
+        const CompactionTable& compaction_table() noexcept
+        {
+            static const CompactionTable table = [] {
+                CompactionTable t{};
+                for (int mask = 0; mask < 256; mask++)
+                {
+                    int k = 0;
+                    for (int lane = 0; lane < 8; lane++)
+                    {
+                        if (mask & (1 << lane))
+                        {
+                            t.lanes[mask][k++] = lane;
+                        }
+                    }
+                }
+                return t;
+            }();
+            return table;
+        }
+
+        /// @brief letterbox_project() of 8 coordinates.
+        __attribute__((target("avx2")))
+        inline __m256 project_avx2(__m256 value, float pad, float inverse_scale, float limit) noexcept
+        {
+            const __m256 projected = _mm256_mul_ps(_mm256_sub_ps(value, _mm256_set1_ps(pad)), _mm256_set1_ps(inverse_scale));
+            return _mm256_min_ps(_mm256_max_ps(projected, _mm256_setzero_ps()), _mm256_set1_ps(limit));
+        }
+
+        __attribute__((target("avx2")))
+        inline void project_corners_avx2(__m256& x1, __m256& y1, __m256& x2, __m256& y2, const FilterOutput& out) noexcept
+        {
+            x1 = project_avx2(x1, out.pad_x, out.inverse_scale, out.limit_x);
+            y1 = project_avx2(y1, out.pad_y, out.inverse_scale, out.limit_y);
+            x2 = project_avx2(x2, out.pad_x, out.inverse_scale, out.limit_x);
+            y2 = project_avx2(y2, out.pad_y, out.inverse_scale, out.limit_y);
+        }
+
+        /// @return Number of rows processed (a multiple of 8)
+        __attribute__((target("avx2")))
+        size_t filter_avx2(const float* boxes_xyxy, const float* scores, const int32_t* class_ids, size_t count,
+            const float* table, uint32_t num_classes, FilterOutput& out) noexcept
+        {
+            const CompactionTable& compaction = compaction_table();
+            const __m256i max_slot = _mm256_set1_epi32(static_cast<int>(num_classes));
+            const __m256i lane_index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            const __m256i transposed_lane = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7); // Lane of row r after the transpose
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                // Per-lane threshold, looked up by class (out-of-table ids clamp to the default entry).
+                const __m256 score = _mm256_loadu_ps(scores + i);
+                const __m256i id = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(class_ids + i));
+                const __m256 threshold = _mm256_i32gather_ps(table, _mm256_min_epu32(id, max_slot), 4);
+                const int mask = _mm256_movemask_ps(_mm256_cmp_ps(score, threshold, _CMP_GE_OQ));
+                if (mask == 0)
+                {
+                    continue;
+                }
+                const size_t survivors = fit_survivors(static_cast<size_t>(__builtin_popcount(mask)), out);
+                if (survivors == 0)
+                {
+                    continue;
+                }
+
+                // Transpose the 8 contiguous rows of (x1, y1, x2, y2) into one vector per coordinate.
+                // Lanes come out in row order 0, 2, 4, 6, 1, 3, 5, 7.
+                const float* rows = boxes_xyxy + i * 4;
+                const __m256 r01 = _mm256_loadu_ps(rows + 0);
+                const __m256 r23 = _mm256_loadu_ps(rows + 8);
+                const __m256 r45 = _mm256_loadu_ps(rows + 16);
+                const __m256 r67 = _mm256_loadu_ps(rows + 24);
+                const __m256 lo_a = _mm256_unpacklo_ps(r01, r23);
+                const __m256 hi_a = _mm256_unpackhi_ps(r01, r23);
+                const __m256 lo_b = _mm256_unpacklo_ps(r45, r67);
+                const __m256 hi_b = _mm256_unpackhi_ps(r45, r67);
+                const __m256 x1_t = _mm256_shuffle_ps(lo_a, lo_b, 0x44);
+                const __m256 y1_t = _mm256_shuffle_ps(lo_a, lo_b, 0xEE);
+                const __m256 x2_t = _mm256_shuffle_ps(hi_a, hi_b, 0x44);
+                const __m256 y2_t = _mm256_shuffle_ps(hi_a, hi_b, 0xEE);
+
+                // Compact the passing lanes to the front (box lanes via the transposed row order).
+                const __m256i lanes = _mm256_load_si256(reinterpret_cast<const __m256i*>(compaction.lanes[mask]));
+                const __m256i box_lanes = _mm256_permutevar8x32_epi32(transposed_lane, lanes);
+                __m256 x1 = _mm256_permutevar8x32_ps(x1_t, box_lanes);
+                __m256 y1 = _mm256_permutevar8x32_ps(y1_t, box_lanes);
+                __m256 x2 = _mm256_permutevar8x32_ps(x2_t, box_lanes);
+                __m256 y2 = _mm256_permutevar8x32_ps(y2_t, box_lanes);
+                if (out.project)
+                {
+                    project_corners_avx2(x1, y1, x2, y2, out);
+                }
+
+                const __m256i store = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(survivors)), lane_index);
+                const size_t n = out.count;
+                _mm256_maskstore_ps(out.x + n, store, x1);
+                _mm256_maskstore_ps(out.y + n, store, y1);
+                _mm256_maskstore_ps(out.width + n, store, _mm256_sub_ps(x2, x1));
+                _mm256_maskstore_ps(out.height + n, store, _mm256_sub_ps(y2, y1));
+                _mm256_maskstore_ps(out.confidence + n, store, _mm256_permutevar8x32_ps(score, lanes));
+                _mm256_maskstore_epi32(reinterpret_cast<int*>(out.class_id + n), store, _mm256_permutevar8x32_epi32(id, lanes));
+                out.count += survivors;
+            }
+            return i;
+        }
+
+        /// @brief Coordinate k of 16 rows of 4 floats held in r0..r3 (4 rows per register).
+        __attribute__((target("avx512f")))
+        inline __m512 box_coordinate(__m512 r0, __m512 r1, __m512 r2, __m512 r3, int k) noexcept
+        {
+            // Every 4th value from k, across two registers; lanes 8-15 repeat lanes 0-7.
+            const __m512i pick = _mm512_add_epi32(
+                _mm512_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28, 0, 4, 8, 12, 16, 20, 24, 28), _mm512_set1_epi32(k));
+            return _mm512_shuffle_f32x4(_mm512_permutex2var_ps(r0, pick, r1), _mm512_permutex2var_ps(r2, pick, r3), 0x44);
+        }
+
+        /// @brief letterbox_project() of 16 coordinates.
+        __attribute__((target("avx512f")))
+        inline __m512 project_avx512(__m512 value, float pad, float inverse_scale, float limit) noexcept
+        {
+            const __m512 projected = _mm512_mul_ps(_mm512_sub_ps(value, _mm512_set1_ps(pad)), _mm512_set1_ps(inverse_scale));
+            return _mm512_min_ps(_mm512_max_ps(projected, _mm512_setzero_ps()), _mm512_set1_ps(limit));
+        }
+
+        __attribute__((target("avx512f")))
+        inline void project_corners_avx512(__m512& x1, __m512& y1, __m512& x2, __m512& y2, const FilterOutput& out) noexcept
+        {
+            x1 = project_avx512(x1, out.pad_x, out.inverse_scale, out.limit_x);
+            y1 = project_avx512(y1, out.pad_y, out.inverse_scale, out.limit_y);
+            x2 = project_avx512(x2, out.pad_x, out.inverse_scale, out.limit_x);
+            y2 = project_avx512(y2, out.pad_y, out.inverse_scale, out.limit_y);
+        }
+
+        /// @return Number of rows processed (a multiple of 16)
+        __attribute__((target("avx512f")))
+        size_t filter_avx512(const float* boxes_xyxy, const float* scores, const int32_t* class_ids, size_t count,
+            const float* table, uint32_t num_classes, FilterOutput& out) noexcept
+        {
+            const __m512i max_slot = _mm512_set1_epi32(static_cast<int>(num_classes));
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m512 score = _mm512_loadu_ps(scores + i);
+                const __m512i id = _mm512_loadu_si512(class_ids + i);
+                const __m512 threshold = _mm512_i32gather_ps(_mm512_min_epu32(id, max_slot), table, 4);
+                const __mmask16 pass = _mm512_cmp_ps_mask(score, threshold, _CMP_GE_OQ);
+                if (pass == 0)
+                {
+                    continue;
+                }
+                const size_t survivors = fit_survivors(static_cast<size_t>(__builtin_popcount(pass)), out);
+                if (survivors == 0)
+                {
+                    continue;
+                }
+
+                // De-interleave the 16 contiguous rows of (x1, y1, x2, y2) into one vector per coordinate.
+                const float* rows = boxes_xyxy + i * 4;
+                const __m512 r0 = _mm512_loadu_ps(rows + 0);
+                const __m512 r1 = _mm512_loadu_ps(rows + 16);
+                const __m512 r2 = _mm512_loadu_ps(rows + 32);
+                const __m512 r3 = _mm512_loadu_ps(rows + 48);
+                __m512 x1 = _mm512_maskz_compress_ps(pass, box_coordinate(r0, r1, r2, r3, 0));
+                __m512 y1 = _mm512_maskz_compress_ps(pass, box_coordinate(r0, r1, r2, r3, 1));
+                __m512 x2 = _mm512_maskz_compress_ps(pass, box_coordinate(r0, r1, r2, r3, 2));
+                __m512 y2 = _mm512_maskz_compress_ps(pass, box_coordinate(r0, r1, r2, r3, 3));
+                if (out.project)
+                {
+                    project_corners_avx512(x1, y1, x2, y2, out);
+                }
+
+                const __mmask16 store = static_cast<__mmask16>((1u << survivors) - 1);
+                const size_t n = out.count;
+                _mm512_mask_storeu_ps(out.x + n, store, x1);
+                _mm512_mask_storeu_ps(out.y + n, store, y1);
+                _mm512_mask_storeu_ps(out.width + n, store, _mm512_sub_ps(x2, x1));
+                _mm512_mask_storeu_ps(out.height + n, store, _mm512_sub_ps(y2, y1));
+                _mm512_mask_storeu_ps(out.confidence + n, store, _mm512_maskz_compress_ps(pass, score));
+                _mm512_mask_storeu_epi32(out.class_id + n, store, _mm512_maskz_compress_epi32(pass, id));
+                out.count += survivors;
+            }
+            return i;
+        }
+
+        /// @brief Thresholds and stores 8 decoded anchors starting at anchor i.
+        __attribute__((target("avx2")))
+        inline void decode_emit_avx2(const float* head, size_t num_anchors, size_t i, __m256 best, __m256i best_class,
+            const float* table, __m256i max_slot, const CompactionTable& compaction, FilterOutput& out) noexcept
+        {
+            const __m256 threshold = _mm256_i32gather_ps(table, _mm256_min_epu32(best_class, max_slot), 4);
+            const int mask = _mm256_movemask_ps(_mm256_cmp_ps(best, threshold, _CMP_GE_OQ));
+            if (mask == 0)
+            {
+                return;
+            }
+            const size_t survivors = fit_survivors(static_cast<size_t>(__builtin_popcount(mask)), out);
+            if (survivors == 0)
+            {
+                return;
+            }
+
+            // The box rows are already one vector per coordinate; compact the passing lanes to the front.
+            const __m256i lanes = _mm256_load_si256(reinterpret_cast<const __m256i*>(compaction.lanes[mask]));
+            const __m256 half = _mm256_set1_ps(0.5f);
+            const __m256 cx = _mm256_loadu_ps(head + i);
+            const __m256 cy = _mm256_loadu_ps(head + num_anchors + i);
+            __m256 w = _mm256_loadu_ps(head + 2 * num_anchors + i);
+            __m256 h = _mm256_loadu_ps(head + 3 * num_anchors + i);
+            __m256 x = _mm256_sub_ps(cx, _mm256_mul_ps(w, half));
+            __m256 y = _mm256_sub_ps(cy, _mm256_mul_ps(h, half));
+            if (out.project)
+            {
+                __m256 x2 = _mm256_add_ps(cx, _mm256_mul_ps(w, half));
+                __m256 y2 = _mm256_add_ps(cy, _mm256_mul_ps(h, half));
+                project_corners_avx2(x, y, x2, y2, out);
+                w = _mm256_sub_ps(x2, x);
+                h = _mm256_sub_ps(y2, y);
+            }
+
+            const __m256i store = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(survivors)),
+                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            const size_t n = out.count;
+            _mm256_maskstore_ps(out.x + n, store, _mm256_permutevar8x32_ps(x, lanes));
+            _mm256_maskstore_ps(out.y + n, store, _mm256_permutevar8x32_ps(y, lanes));
+            _mm256_maskstore_ps(out.width + n, store, _mm256_permutevar8x32_ps(w, lanes));
+            _mm256_maskstore_ps(out.height + n, store, _mm256_permutevar8x32_ps(h, lanes));
+            _mm256_maskstore_ps(out.confidence + n, store, _mm256_permutevar8x32_ps(best, lanes));
+            _mm256_maskstore_epi32(reinterpret_cast<int*>(out.class_id + n), store,
+                _mm256_permutevar8x32_epi32(best_class, lanes));
+            out.count += survivors;
+        }
+
+        /// @brief Decodes 8 * V anchors starting at anchor i.
+        template <int V, class Dims>
+        __attribute__((target("avx2")))
+        inline void decode_block_avx2(const float* head, Dims dims, size_t i,
+            const float* table, __m256i max_slot, const CompactionTable& compaction, FilterOutput& out) noexcept
+        {
+            const size_t num_classes = dims.classes();
+            const size_t num_anchors = dims.anchors();
+            const float* scores = head + 4 * num_anchors + i;
+            __m256 best[V];
+            __m256i best_class[V];
+            for (int v = 0; v < V; v++)
+            {
+                best[v] = _mm256_loadu_ps(scores + 8 * v);
+                best_class[v] = _mm256_setzero_si256();
+            }
+            for (size_t c = 1; c < num_classes; c++)
+            {
+                // A strictly greater score takes over, so ties keep the lower class id.
+                const float* row = scores + c * num_anchors;
+                const __m256 class_id = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(c)));
+                for (int v = 0; v < V; v++)
+                {
+                    const __m256 score = _mm256_loadu_ps(row + 8 * v);
+                    const __m256 greater = _mm256_cmp_ps(score, best[v], _CMP_GT_OQ);
+                    best[v] = _mm256_blendv_ps(best[v], score, greater);
+                    best_class[v] = _mm256_castps_si256(
+                        _mm256_blendv_ps(_mm256_castsi256_ps(best_class[v]), class_id, greater));
+                }
+            }
+            for (int v = 0; v < V; v++)
+            {
+                decode_emit_avx2(head, num_anchors, i + 8 * v, best[v], best_class[v], table, max_slot, compaction, out);
+            }
+        }
+
+        /// @return Number of anchors processed (a multiple of 8)
+        template <class Dims>
+        __attribute__((target("avx2")))
+        size_t decode_avx2(const float* head, Dims dims,
+            const float* table, uint32_t threshold_classes, FilterOutput& out) noexcept
+        {
+            const size_t num_anchors = dims.anchors();
+            const CompactionTable& compaction = compaction_table();
+            const __m256i max_slot = _mm256_set1_epi32(static_cast<int>(threshold_classes));
+            size_t i = 0;
+            for (; i + 4 * 8 <= num_anchors; i += 4 * 8)
+            {
+                decode_block_avx2<4>(head, dims, i, table, max_slot, compaction, out);
+            }
+            for (; i + 8 <= num_anchors; i += 8)
+            {
+                decode_block_avx2<1>(head, dims, i, table, max_slot, compaction, out);
+            }
+            return i;
+        }
+
+        /// @brief Thresholds and stores 16 decoded anchors starting at anchor i.
+        __attribute__((target("avx512f")))
+        inline void decode_emit_avx512(const float* head, size_t num_anchors, size_t i, __m512 best,
+            __m512i best_class, const float* table, __m512i max_slot, FilterOutput& out) noexcept
+        {
+            const __m512 threshold = _mm512_i32gather_ps(_mm512_min_epu32(best_class, max_slot), table, 4);
+            const __mmask16 pass = _mm512_cmp_ps_mask(best, threshold, _CMP_GE_OQ);
+            if (pass == 0)
+            {
+                return;
+            }
+            const size_t survivors = fit_survivors(static_cast<size_t>(__builtin_popcount(pass)), out);
+            if (survivors == 0)
+            {
+                return;
+            }
+
+            const __m512 half = _mm512_set1_ps(0.5f);
+            const __m512 cx = _mm512_loadu_ps(head + i);
+            const __m512 cy = _mm512_loadu_ps(head + num_anchors + i);
+            __m512 w = _mm512_loadu_ps(head + 2 * num_anchors + i);
+            __m512 h = _mm512_loadu_ps(head + 3 * num_anchors + i);
+            __m512 x = _mm512_sub_ps(cx, _mm512_mul_ps(w, half));
+            __m512 y = _mm512_sub_ps(cy, _mm512_mul_ps(h, half));
+            if (out.project)
+            {
+                __m512 x2 = _mm512_add_ps(cx, _mm512_mul_ps(w, half));
+                __m512 y2 = _mm512_add_ps(cy, _mm512_mul_ps(h, half));
+                project_corners_avx512(x, y, x2, y2, out);
+                w = _mm512_sub_ps(x2, x);
+                h = _mm512_sub_ps(y2, y);
+            }
+
+            const __mmask16 store = static_cast<__mmask16>((1u << survivors) - 1);
+            const size_t n = out.count;
+            _mm512_mask_storeu_ps(out.x + n, store, _mm512_maskz_compress_ps(pass, x));
+            _mm512_mask_storeu_ps(out.y + n, store, _mm512_maskz_compress_ps(pass, y));
+            _mm512_mask_storeu_ps(out.width + n, store, _mm512_maskz_compress_ps(pass, w));
+            _mm512_mask_storeu_ps(out.height + n, store, _mm512_maskz_compress_ps(pass, h));
+            _mm512_mask_storeu_ps(out.confidence + n, store, _mm512_maskz_compress_ps(pass, best));
+            _mm512_mask_storeu_epi32(out.class_id + n, store, _mm512_maskz_compress_epi32(pass, best_class));
+            out.count += survivors;
+        }
+
+        /// @brief Decodes 16 * V anchors starting at anchor i.
+        template <int V, class Dims>
+        __attribute__((target("avx512f")))
+        inline void decode_block_avx512(const float* head, Dims dims, size_t i,
+            const float* table, __m512i max_slot, FilterOutput& out) noexcept
+        {
+            const size_t num_classes = dims.classes();
+            const size_t num_anchors = dims.anchors();
+            const float* scores = head + 4 * num_anchors + i;
+            __m512 best[V];
+            __m512i best_class[V];
+            for (int v = 0; v < V; v++)
+            {
+                best[v] = _mm512_loadu_ps(scores + 16 * v);
+                best_class[v] = _mm512_setzero_si512();
+            }
+            for (size_t c = 1; c < num_classes; c++)
+            {
+                // A strictly greater score takes over, so ties keep the lower class id.
+                const float* row = scores + c * num_anchors;
+                const __m512i class_id = _mm512_set1_epi32(static_cast<int>(c));
+                for (int v = 0; v < V; v++)
+                {
+                    const __m512 score = _mm512_loadu_ps(row + 16 * v);
+                    const __mmask16 greater = _mm512_cmp_ps_mask(score, best[v], _CMP_GT_OQ);
+                    best[v] = _mm512_mask_mov_ps(best[v], greater, score);
+                    best_class[v] = _mm512_mask_mov_epi32(best_class[v], greater, class_id);
+                }
+            }
+            for (int v = 0; v < V; v++)
+            {
+                decode_emit_avx512(head, num_anchors, i + 16 * v, best[v], best_class[v], table, max_slot, out);
+            }
+        }
+
+        /// @return Number of anchors processed (a multiple of 16)
+        template <class Dims>
+        __attribute__((target("avx512f")))
+        size_t decode_avx512(const float* head, Dims dims,
+            const float* table, uint32_t threshold_classes, FilterOutput& out) noexcept
+        {
+            const size_t num_anchors = dims.anchors();
+            const __m512i max_slot = _mm512_set1_epi32(static_cast<int>(threshold_classes));
+            size_t i = 0;
+            for (; i + 4 * 16 <= num_anchors; i += 4 * 16)
+            {
+                decode_block_avx512<4>(head, dims, i, table, max_slot, out);
+            }
+            for (; i + 16 <= num_anchors; i += 16)
+            {
+                decode_block_avx512<1>(head, dims, i, table, max_slot, out);
+            }
+            return i;
+        }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif // TRT_YOLO_X86_KERNELS
+
+#if defined(TRT_YOLO_NEON_KERNELS)
+
+        /// @brief For every 4-bit lane mask, a byte shuffle moving the set 32-bit lanes to the front.
+        struct CompactionTable
+        {
+            uint8_t bytes[16][16];
+        };
+
+        const CompactionTable& compaction_table() noexcept
+        {
+            static const CompactionTable table = [] {
+                CompactionTable t{};
+                for (int mask = 0; mask < 16; mask++)
+                {
+                    int k = 0;
+                    for (int lane = 0; lane < 4; lane++)
+                    {
+                        if (mask & (1 << lane))
+                        {
+                            for (int b = 0; b < 4; b++)
+                            {
+                                t.bytes[mask][k * 4 + b] = static_cast<uint8_t>(lane * 4 + b);
+                            }
+                            k++;
+                        }
+                    }
+                    for (int b = k * 4; b < 16; b++)
+                    {
+                        t.bytes[mask][b] = 0xFF; // Out-of-range index: the lane becomes zero
+                    }
+                }
+                return t;
+            }();
+            return table;
+        }
+
+        /// @brief letterbox_project() of 4 coordinates (selects instead of vmaxq / vminq, which propagate NaN).
+        inline float32x4_t project_neon(float32x4_t value, float pad, float inverse_scale, float limit) noexcept
+        {
+            const float32x4_t projected = vmulq_f32(vsubq_f32(value, vdupq_n_f32(pad)), vdupq_n_f32(inverse_scale));
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            const float32x4_t upper = vdupq_n_f32(limit);
+            const float32x4_t low = vbslq_f32(vcgtq_f32(projected, zero), projected, zero);
+            return vbslq_f32(vcltq_f32(low, upper), low, upper);
+        }
+
+        inline void project_corners_neon(float32x4_t& x1, float32x4_t& y1, float32x4_t& x2, float32x4_t& y2,
+            const FilterOutput& out) noexcept
+        {
+            x1 = project_neon(x1, out.pad_x, out.inverse_scale, out.limit_x);
+            y1 = project_neon(y1, out.pad_y, out.inverse_scale, out.limit_y);
+            x2 = project_neon(x2, out.pad_x, out.inverse_scale, out.limit_x);
+            y2 = project_neon(y2, out.pad_y, out.inverse_scale, out.limit_y);
+        }
+
+        /// @return Number of rows processed (a multiple of 4)
+        size_t filter_neon(const float* boxes_xyxy, const float* scores, const int32_t* class_ids, size_t count,
+            const float* table, uint32_t num_classes, FilterOutput& out) noexcept
+        {
+            const CompactionTable& compaction = compaction_table();
+            const uint32x4_t max_slot = vdupq_n_u32(num_classes);
+            const uint32_t bit_values[4] = {1, 2, 4, 8};
+            const uint32x4_t lane_bits = vld1q_u32(bit_values);
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                // Full-width stores below need 4 lanes of room before the end of the padded arrays.
+                if (out.count + 4 > out.padded_capacity)
+                {
+                    filter_scalar(boxes_xyxy, scores, class_ids, i, i + 4, table, num_classes, out);
+                    continue;
+                }
+
+                const float32x4_t score = vld1q_f32(scores + i);
+                const int32x4_t id = vld1q_s32(class_ids + i);
+                const uint32x4_t slot = vminq_u32(vreinterpretq_u32_s32(id), max_slot);
+                float32x4_t threshold = vld1q_dup_f32(table + vgetq_lane_u32(slot, 0));
+                threshold = vld1q_lane_f32(table + vgetq_lane_u32(slot, 1), threshold, 1);
+                threshold = vld1q_lane_f32(table + vgetq_lane_u32(slot, 2), threshold, 2);
+                threshold = vld1q_lane_f32(table + vgetq_lane_u32(slot, 3), threshold, 3);
+                const uint32_t mask = vaddvq_u32(vandq_u32(vcgeq_f32(score, threshold), lane_bits));
+                if (mask == 0)
+                {
+                    continue;
+                }
+                const size_t survivors = fit_survivors(static_cast<size_t>(__builtin_popcount(mask)), out);
+                if (survivors == 0)
+                {
+                    continue;
+                }
+
+                // De-interleave 4 rows of (x1, y1, x2, y2), convert to xywh, then compact all fields.
+                float32x4x4_t box = vld4q_f32(boxes_xyxy + i * 4);
+                if (out.project)
+                {
+                    project_corners_neon(box.val[0], box.val[1], box.val[2], box.val[3], out);
+                }
+                const uint8x16_t shuffle = vld1q_u8(compaction.bytes[mask]);
+                auto compact = [&](float32x4_t v) {
+                    return vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(v), shuffle));
+                };
+                const size_t n = out.count;
+                vst1q_f32(out.x + n, compact(box.val[0]));
+                vst1q_f32(out.y + n, compact(box.val[1]));
+                vst1q_f32(out.width + n, compact(vsubq_f32(box.val[2], box.val[0])));
+                vst1q_f32(out.height + n, compact(vsubq_f32(box.val[3], box.val[1])));
+                vst1q_f32(out.confidence + n, compact(score));
+                vst1q_s32(out.class_id + n, vreinterpretq_s32_u8(vqtbl1q_u8(vreinterpretq_u8_s32(id), shuffle)));
+                out.count += survivors;
+            }
+            return i;
+        }
+
+        /// @brief Thresholds and stores 4 decoded anchors starting at anchor i.
+        inline void decode_emit_neon(const float* head, size_t num_anchors, size_t i, float32x4_t best,
+            uint32x4_t best_class, const float* table, uint32x4_t max_slot, uint32x4_t lane_bits,
+            const CompactionTable& compaction, FilterOutput& out) noexcept
+        {
+            // Full-width stores below need 4 lanes of room before the end of the padded arrays.
+            if (out.count + 4 > out.padded_capacity)
+            {
+                float best_lanes[4];
+                uint32_t class_lanes[4];
+                vst1q_f32(best_lanes, best);
+                vst1q_u32(class_lanes, best_class);
+                for (int lane = 0; lane < 4; lane++)
+                {
+                    decode_anchor(head, num_anchors, i + lane, best_lanes[lane], static_cast<int32_t>(class_lanes[lane]),
+                        table, vgetq_lane_u32(max_slot, 0), out);
+                }
+                return;
+            }
+
+            const uint32x4_t slot = vminq_u32(best_class, max_slot);
+            float32x4_t threshold = vld1q_dup_f32(table + vgetq_lane_u32(slot, 0));
+            threshold = vld1q_lane_f32(table + vgetq_lane_u32(slot, 1), threshold, 1);
+            threshold = vld1q_lane_f32(table + vgetq_lane_u32(slot, 2), threshold, 2);
+            threshold = vld1q_lane_f32(table + vgetq_lane_u32(slot, 3), threshold, 3);
+            const uint32_t mask = vaddvq_u32(vandq_u32(vcgeq_f32(best, threshold), lane_bits));
+            if (mask == 0)
+            {
+                return;
+            }
+            const size_t survivors = fit_survivors(static_cast<size_t>(__builtin_popcount(mask)), out);
+            if (survivors == 0)
+            {
+                return;
+            }
+
+            const uint8x16_t shuffle = vld1q_u8(compaction.bytes[mask]);
+            const float32x4_t half = vdupq_n_f32(0.5f);
+            const float32x4_t cx = vld1q_f32(head + i);
+            const float32x4_t cy = vld1q_f32(head + num_anchors + i);
+            float32x4_t w = vld1q_f32(head + 2 * num_anchors + i);
+            float32x4_t h = vld1q_f32(head + 3 * num_anchors + i);
+            float32x4_t x = vsubq_f32(cx, vmulq_f32(w, half));
+            float32x4_t y = vsubq_f32(cy, vmulq_f32(h, half));
+            if (out.project)
+            {
+                float32x4_t x2 = vaddq_f32(cx, vmulq_f32(w, half));
+                float32x4_t y2 = vaddq_f32(cy, vmulq_f32(h, half));
+                project_corners_neon(x, y, x2, y2, out);
+                w = vsubq_f32(x2, x);
+                h = vsubq_f32(y2, y);
+            }
+            const size_t n = out.count;
+            vst1q_f32(out.x + n, vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(x), shuffle)));
+            vst1q_f32(out.y + n, vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(y), shuffle)));
+            vst1q_f32(out.width + n, vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(w), shuffle)));
+            vst1q_f32(out.height + n, vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(h), shuffle)));
+            vst1q_f32(out.confidence + n, vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(best), shuffle)));
+            vst1q_s32(out.class_id + n, vreinterpretq_s32_u8(vqtbl1q_u8(vreinterpretq_u8_u32(best_class), shuffle)));
+            out.count += survivors;
+        }
+
+        /// @return Number of anchors processed (a multiple of 4)
+        template <class Dims>
+        size_t decode_neon(const float* head, Dims dims,
+            const float* table, uint32_t threshold_classes, FilterOutput& out) noexcept
+        {
+            const size_t num_classes = dims.classes();
+            const size_t num_anchors = dims.anchors();
+            constexpr int V = 4; // Vectors per block
+            const CompactionTable& compaction = compaction_table();
+            const uint32x4_t max_slot = vdupq_n_u32(threshold_classes);
+            const uint32_t bit_values[4] = {1, 2, 4, 8};
+            const uint32x4_t lane_bits = vld1q_u32(bit_values);
+            const float* scores = head + 4 * num_anchors;
+            size_t i = 0;
+            for (; i + 4 <= num_anchors; )
+            {
+                const int vectors = i + 4 * V <= num_anchors ? V : 1;
+                float32x4_t best[V];
+                uint32x4_t best_class[V];
+                for (int v = 0; v < vectors; v++)
+                {
+                    best[v] = vld1q_f32(scores + i + 4 * v);
+                    best_class[v] = vdupq_n_u32(0);
+                }
+                for (size_t c = 1; c < num_classes; c++)
+                {
+                    // A strictly greater score takes over, so ties keep the lower class id.
+                    const float* row = scores + c * num_anchors + i;
+                    const uint32x4_t class_id = vdupq_n_u32(static_cast<uint32_t>(c));
+                    for (int v = 0; v < vectors; v++)
+                    {
+                        const float32x4_t score = vld1q_f32(row + 4 * v);
+                        const uint32x4_t greater = vcgtq_f32(score, best[v]);
+                        best[v] = vbslq_f32(greater, score, best[v]);
+                        best_class[v] = vbslq_u32(greater, class_id, best_class[v]);
+                    }
+                }
+                for (int v = 0; v < vectors; v++)
+                {
+                    decode_emit_neon(head, num_anchors, i + 4 * v, best[v], best_class[v], table, max_slot, lane_bits,
+                        compaction, out);
+                }
+                i += 4 * vectors;
+            }
+            return i;
+        }
+
+#endif // TRT_YOLO_NEON_KERNELS
+
+    }
+
+    namespace
+    {
+        /// @brief Raw-head geometry known at run time.
+        struct RuntimeHeadDims
+        {
+            size_t num_classes;
+            size_t num_anchors;
+
+            size_t classes() const noexcept { return this->num_classes; }
+            size_t anchors() const noexcept { return this->num_anchors; }
+        };
+
+        /// @brief Raw-head geometry fixed at compile time: the decoders' trip counts and row strides become constants.
+        template <size_t Classes, size_t Anchors>
+        struct FixedHeadDims
+        {
+            static constexpr size_t classes() noexcept { return Classes; }
+            static constexpr size_t anchors() noexcept { return Anchors; }
+        };
+
+        template <class Dims>
+        size_t decode_head(const float* head, Dims dims, const ClassThresholds& thresholds, DetectionBatch& out,
+            SimdLevel level, const LetterboxInfo* letterbox) noexcept
+        {
+            out.clear();
+            if (dims.classes() == 0)
+            {
+                return 0;
+            }
+            FilterOutput result = make_filter_output(out, letterbox);
+            const float* table = thresholds.table();
+            const uint32_t threshold_classes = thresholds.num_classes();
+
+            size_t done = 0;
+            switch (resolve_simd_level(level))
+            {
+#if defined(TRT_YOLO_X86_KERNELS)
+                case SimdLevel::kAVX512:
+                    done = decode_avx512(head, dims, table, threshold_classes, result);
+                    break;
+                case SimdLevel::kAVX2:
+                    done = decode_avx2(head, dims, table, threshold_classes, result);
+                    break;
+#endif
+#if defined(TRT_YOLO_NEON_KERNELS)
+                case SimdLevel::kNEON:
+                    done = decode_neon(head, dims, table, threshold_classes, result);
+                    break;
+#endif
+                default:
+                    break;
+            }
+            decode_scalar(head, dims, done, table, threshold_classes, result);
+
+            out.set_size(result.count);
+            out.add_dropped(result.dropped);
+            return result.count;
+        }
+
+        /// @brief load_element() for a data type known at compile time (no per-element type switch).
+        template <TensorDataType Type>
+        inline float load_typed(const void* data, size_t index) noexcept
+        {
+            if constexpr (Type == TensorDataType::kFLOAT)
+            {
+                return static_cast<const float*>(data)[index];
+            }
+            else if constexpr (Type == TensorDataType::kHALF)
+            {
+                return half_to_float(static_cast<const uint16_t*>(data)[index]);
+            }
+            else if constexpr (Type == TensorDataType::kINT32)
+            {
+                return static_cast<float>(static_cast<const int32_t*>(data)[index]);
+            }
+            else if constexpr (Type == TensorDataType::kINT64)
+            {
+                return static_cast<float>(static_cast<const int64_t*>(data)[index]);
+            }
+            else
+            {
+                return load_element(data, Type, index);
+            }
+        }
+
+        /// @brief Reads NMS outputs in data types known at run time.
+        struct RuntimeLoader
+        {
+            const PostprocessInput& input;
+            const RuntimeModelSpec& spec;
+
+            float box(size_t index) const noexcept { return load_element(this->input.bboxes, this->spec.box_type, index); }
+            float score(size_t index) const noexcept { return load_element(this->input.scores, this->spec.score_type, index); }
+            float label(size_t index) const noexcept { return load_element(this->input.labels, this->spec.label_type, index); }
+        };
+
+        /// @brief Reads NMS outputs in the data types of Spec.
+        template <class Spec>
+        struct TypedLoader
+        {
+            const PostprocessInput& input;
+
+            float box(size_t index) const noexcept { return load_typed<Spec::box_type>(this->input.bboxes, index); }
+            float score(size_t index) const noexcept { return load_typed<Spec::score_type>(this->input.scores, index); }
+            float label(size_t index) const noexcept { return load_typed<Spec::label_type>(this->input.labels, index); }
+        };
+
+        /// @brief Filter for NMS outputs that are not float32 / int32, converting element by element.
+        template <class Loader>
+        size_t filter_elementwise(const Loader& load, size_t count, const ClassThresholds& thresholds, DetectionBatch& out,
+            const LetterboxInfo* letterbox) noexcept
+        {
+            out.clear();
+            FilterOutput result = make_filter_output(out, letterbox);
+            for (size_t i = 0; i < count; i++)
+            {
+                const float score = load.score(i);
+                const int32_t label = static_cast<int32_t>(load.label(i));
+                if (!(score >= thresholds.get(label)))
+                {
+                    continue;
+                }
+                if (result.count == result.capacity)
+                {
+                    result.dropped++;
+                    continue;
+                }
+                store_corners(load.box(i * 4 + 0), load.box(i * 4 + 1), load.box(i * 4 + 2), load.box(i * 4 + 3), result);
+                result.confidence[result.count] = score;
+                result.class_id[result.count] = label;
+                result.count++;
+            }
+            out.set_size(result.count);
+            out.add_dropped(result.dropped);
+            return result.count;
+        }
+    }
+
+    size_t filter_detections(const float* boxes_xyxy, const float* scores, const int32_t* class_ids, size_t count,
+        const ClassThresholds& thresholds, DetectionBatch& out, SimdLevel level, const LetterboxInfo* letterbox) noexcept
+    {
+        out.clear();
+        FilterOutput result = make_filter_output(out, letterbox);
+        const float* table = thresholds.table();
+        const uint32_t num_classes = thresholds.num_classes();
+
+        size_t done = 0;
+        switch (resolve_simd_level(level))
+        {
+#if defined(TRT_YOLO_X86_KERNELS)
+            case SimdLevel::kAVX512:
+                done = filter_avx512(boxes_xyxy, scores, class_ids, count, table, num_classes, result);
+                break;
+            case SimdLevel::kAVX2:
+                done = filter_avx2(boxes_xyxy, scores, class_ids, count, table, num_classes, result);
+                break;
+#endif
+#if defined(TRT_YOLO_NEON_KERNELS)
+            case SimdLevel::kNEON:
+                done = filter_neon(boxes_xyxy, scores, class_ids, count, table, num_classes, result);
+                break;
+#endif
+            default:
+                break;
+        }
+        filter_scalar(boxes_xyxy, scores, class_ids, done, count, table, num_classes, result);
+
+        out.set_size(result.count);
+        out.add_dropped(result.dropped);
+        return result.count;
+    }
+
+    size_t decode_raw_head(const float* head, size_t num_classes, size_t num_anchors,
+        const ClassThresholds& thresholds, DetectionBatch& out, SimdLevel level, const LetterboxInfo* letterbox) noexcept
+    {
+        return decode_head(head, RuntimeHeadDims{num_classes, num_anchors}, thresholds, out, level, letterbox);
+    }
+
+    template <class Spec>
+    size_t postprocess_outputs(const PostprocessInput& input, const ClassThresholds& thresholds, DetectionBatch& out,
+        SimdLevel level, const LetterboxInfo* letterbox) noexcept
+    {
+        if constexpr (Spec::layout == OutputLayout::kRawHead)
+        {
+            const float* head = static_cast<const float*>(input.head);
+            if constexpr (Spec::score_type != TensorDataType::kFLOAT)
+            {
+                constexpr size_t elements = (RAW_HEAD_BOX_ROWS + Spec::num_classes) * Spec::rows;
+                for (size_t e = 0; e < elements; e++)
+                {
+                    input.head_scratch[e] = load_typed<Spec::score_type>(input.head, e);
+                }
+                head = input.head_scratch;
+            }
+            return decode_head(head, FixedHeadDims<Spec::num_classes, Spec::rows>(), thresholds, out, level, letterbox);
+        }
+        else if constexpr (Spec::box_type == TensorDataType::kFLOAT && Spec::score_type == TensorDataType::kFLOAT
+            && Spec::label_type == TensorDataType::kINT32)
+        {
+            return filter_detections(static_cast<const float*>(input.bboxes), static_cast<const float*>(input.scores),
+                static_cast<const int32_t*>(input.labels), std::min(input.count, Spec::rows), thresholds, out, level,
+                letterbox);
+        }
+        else
+        {
+            return filter_elementwise(TypedLoader<Spec>{input}, std::min(input.count, Spec::rows), thresholds, out,
+                letterbox);
+        }
+    }
+
+    size_t postprocess_outputs(const RuntimeModelSpec& spec, const PostprocessInput& input,
+        const ClassThresholds& thresholds, DetectionBatch& out, SimdLevel level, const LetterboxInfo* letterbox) noexcept
+    {
+        if (spec.layout == OutputLayout::kRawHead)
+        {
+            const float* head = static_cast<const float*>(input.head);
+            if (spec.score_type != TensorDataType::kFLOAT)
+            {
+                const size_t elements = (RAW_HEAD_BOX_ROWS + spec.num_classes) * spec.rows;
+                for (size_t e = 0; e < elements; e++)
+                {
+                    input.head_scratch[e] = load_element(input.head, spec.score_type, e);
+                }
+                head = input.head_scratch;
+            }
+            return decode_head(head, RuntimeHeadDims{spec.num_classes, spec.rows}, thresholds, out, level, letterbox);
+        }
+        if (spec.box_type == TensorDataType::kFLOAT && spec.score_type == TensorDataType::kFLOAT
+            && spec.label_type == TensorDataType::kINT32)
+        {
+            return filter_detections(static_cast<const float*>(input.bboxes), static_cast<const float*>(input.scores),
+                static_cast<const int32_t*>(input.labels), std::min(input.count, spec.rows), thresholds, out, level,
+                letterbox);
+        }
+        return filter_elementwise(RuntimeLoader{input, spec}, std::min(input.count, spec.rows), thresholds, out,
+            letterbox);
+    }
+
+    PostprocessFunction find_specialized_postprocess(const RuntimeModelSpec& spec) noexcept
+    {
+        if (spec.matches<YoloNms100F32>()) return &postprocess_outputs<YoloNms100F32>;
+        if (spec.matches<YoloNms100F16>()) return &postprocess_outputs<YoloNms100F16>;
+        if (spec.matches<YoloRaw8400x80F32>()) return &postprocess_outputs<YoloRaw8400x80F32>;
+        if (spec.matches<YoloRaw8400x80F16>()) return &postprocess_outputs<YoloRaw8400x80F16>;
+        return nullptr;
+    }
+
+    // Compiled-in specs (see TRT_YOLO_model_spec.hpp). A new spec needs a line here and in find_specialized_postprocess().
+    template size_t postprocess_outputs<YoloNms100F32>(const PostprocessInput&, const ClassThresholds&,
+        DetectionBatch&, SimdLevel, const LetterboxInfo*) noexcept;
+    template size_t postprocess_outputs<YoloNms100F16>(const PostprocessInput&, const ClassThresholds&,
+        DetectionBatch&, SimdLevel, const LetterboxInfo*) noexcept;
+    template size_t postprocess_outputs<YoloRaw8400x80F32>(const PostprocessInput&, const ClassThresholds&,
+        DetectionBatch&, SimdLevel, const LetterboxInfo*) noexcept;
+    template size_t postprocess_outputs<YoloRaw8400x80F16>(const PostprocessInput&, const ClassThresholds&,
+        DetectionBatch&, SimdLevel, const LetterboxInfo*) noexcept;
+
+} // namespace TRT::YOLO
@@ -0,0 +1,1299 @@
+
+#include "include/TRT_YOLO_preprocess.hpp"
+#include "TensorRT_CPP/TRT_half.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// TRT_YOLO_EMULATE_NEON builds the NEON kernels on any host, over tests/neon_emulation/arm_neon.h.
+#if defined(__aarch64__) || defined(TRT_YOLO_EMULATE_NEON)
+#define TRT_YOLO_NEON_KERNELS 1
+#include <arm_neon.h>
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TRT_YOLO_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace TRT::YOLO
+{
+
+    const char* pixel_format_name(PixelFormat format) noexcept
+    {
+        switch (format)
+        {
+            case PixelFormat::kRGB8: return "rgb8";
+            case PixelFormat::kBGR8: return "bgr8";
+            case PixelFormat::kNV12: return "nv12";
+            case PixelFormat::kYUYV: return "yuyv";
+            case PixelFormat::kI420: return "i420";
+        }
+        return "?";
+    }
+
+    const char* frame_format_name(FrameFormat format) noexcept
+    {
+        switch (format)
+        {
+            case FrameFormat::kF32Planar: return "f32_planar";
+            case FrameFormat::kF16Planar: return "f16_planar";
+            case FrameFormat::kU8Planar: return "u8_planar";
+            case FrameFormat::kU8Packed: return "u8_packed";
+        }
+        return "?";
+    }
+
+    InputFrame InputFrame::planar(FrameFormat format, const void* data, const LetterboxInfo* letterbox) noexcept
+    {
+        InputFrame frame;
+        frame.format = format;
+        frame.data = data;
+        frame.letterbox = letterbox;
+        return frame;
+    }
+
+    InputFrame InputFrame::packed(const ImageView& image) noexcept
+    {
+        InputFrame frame;
+        frame.format = FrameFormat::kU8Packed;
+        frame.image = image;
+        return frame;
+    }
+
+    size_t frame_bytes(const InputFrame& frame, size_t num_elements) noexcept
+    {
+        switch (frame.format)
+        {
+            case FrameFormat::kF32Planar: return num_elements * sizeof(float);
+            case FrameFormat::kF16Planar: return num_elements * sizeof(uint16_t);
+            case FrameFormat::kU8Planar: return num_elements;
+            case FrameFormat::kU8Packed: return frame.image.num_bytes();
+        }
+        return 0;
+    }
+
+    size_t ImageView::row_stride() const noexcept
+    {
+        if (this->stride != 0)
+        {
+            return this->stride;
+        }
+        const size_t width = this->width > 0 ? static_cast<size_t>(this->width) : 0;
+        switch (this->format)
+        {
+            case PixelFormat::kNV12:
+            case PixelFormat::kI420: return width;
+            case PixelFormat::kYUYV: return (width + 1) / 2 * 4;
+            default: return width * 3;
+        }
+    }
+
+    size_t ImageView::chroma_row_stride() const noexcept
+    {
+        if (this->chroma_stride != 0)
+        {
+            return this->chroma_stride;
+        }
+        if (this->format == PixelFormat::kI420)
+        {
+            return (this->row_stride() + 1) / 2;
+        }
+        // Packed NV12 rows of an odd width: the U, V row holds one more byte than the Y row.
+        return this->stride != 0 ? this->stride : (static_cast<size_t>(std::max(this->width, 0)) + 1) / 2 * 2;
+    }
+
+    const uint8_t* ImageView::u_plane() const noexcept
+    {
+        if ((this->format != PixelFormat::kNV12 && this->format != PixelFormat::kI420) || this->data == nullptr
+            || this->height <= 0)
+        {
+            return nullptr;
+        }
+        return this->chroma != nullptr ? this->chroma : this->data + this->row_stride() * this->height;
+    }
+
+    const uint8_t* ImageView::v_plane() const noexcept
+    {
+        const uint8_t* u = this->u_plane();
+        if (u == nullptr)
+        {
+            return nullptr;
+        }
+        if (this->format == PixelFormat::kNV12)
+        {
+            return u + 1;
+        }
+        return this->chroma_v != nullptr ? this->chroma_v : u + this->chroma_row_stride() * ((this->height + 1) / 2);
+    }
+
+    size_t ImageView::num_bytes() const noexcept
+    {
+        if (this->width <= 0 || this->height <= 0)
+        {
+            return 0;
+        }
+        const size_t pixels = static_cast<size_t>(this->width) * this->height;
+        const size_t chroma_width = (static_cast<size_t>(this->width) + 1) / 2;
+        switch (this->format)
+        {
+            case PixelFormat::kNV12:
+            case PixelFormat::kI420: return pixels + 2 * chroma_width * ((this->height + 1) / 2);
+            case PixelFormat::kYUYV: return 4 * chroma_width * this->height;
+            default: return pixels * 3;
+        }
+    }
+
+    bool ImageView::is_valid() const noexcept
+    {
+        if (this->data == nullptr || this->width <= 0 || this->height <= 0)
+        {
+            return false;
+        }
+        const size_t width = static_cast<size_t>(this->width);
+        const size_t chroma_width = (width + 1) / 2;
+        switch (this->format)
+        {
+            case PixelFormat::kNV12: return this->row_stride() >= width && this->chroma_row_stride() >= 2 * chroma_width;
+            case PixelFormat::kI420: return this->row_stride() >= width && this->chroma_row_stride() >= chroma_width;
+            case PixelFormat::kYUYV: return this->row_stride() >= 4 * chroma_width;
+            default: return this->row_stride() >= width * 3;
+        }
+    }
+
+    ImageView ImageView::crop(int x, int y, int width, int height) const
+    {
+        if (!this->is_valid())
+        {
+            throw std::invalid_argument("cannot crop an invalid image");
+        }
+        if (x < 0 || y < 0 || width <= 0 || height <= 0 || x > this->width - width || y > this->height - height)
+        {
+            throw std::invalid_argument("crop region is empty or outside the image");
+        }
+        const bool subsampled_rows = this->format == PixelFormat::kNV12 || this->format == PixelFormat::kI420;
+        if (is_yuv(this->format) && (x % 2 != 0 || (subsampled_rows && y % 2 != 0)))
+        {
+            throw std::invalid_argument(std::string("crop of a ") + pixel_format_name(this->format)
+                + " image must start on a chroma sample");
+        }
+
+        ImageView region = *this;
+        region.width = width;
+        region.height = height;
+        region.stride = this->row_stride();
+        const size_t row = static_cast<size_t>(y) * region.stride;
+        switch (this->format)
+        {
+            case PixelFormat::kNV12:
+            case PixelFormat::kI420:
+            {
+                region.data = this->data + row + x;
+                region.chroma_stride = this->chroma_row_stride();
+                const size_t chroma_row = static_cast<size_t>(y / 2) * region.chroma_stride;
+                const size_t chroma_column = this->format == PixelFormat::kNV12 ? static_cast<size_t>(x) : x / 2;
+                region.chroma = this->u_plane() + chroma_row + chroma_column;
+                region.chroma_v = this->format == PixelFormat::kI420 ? this->v_plane() + chroma_row + chroma_column : nullptr;
+                break;
+            }
+            case PixelFormat::kYUYV: region.data = this->data + row + static_cast<size_t>(x) * 2; break;
+            default: region.data = this->data + row + static_cast<size_t>(x) * 3; break;
+        }
+        return region;
+    }
+
+    PreprocessConfig PreprocessConfig::from_descriptor(const ModelDescriptor& descriptor, int model_width, int model_height)
+    {
+        PreprocessConfig config;
+        config.model_width = model_width;
+        config.model_height = model_height;
+        config.channel_order = descriptor.input_format;
+        config.scale = descriptor.input_scale;
+        for (int c = 0; c < 3; c++)
+        {
+            config.mean[c] = descriptor.input_mean[c];
+            config.std[c] = descriptor.input_std[c];
+        }
+        return config;
+    }
+
+    namespace
+    {
+        // Bilinear weights are fixed-point: a pair sums to kWeightOne. A horizontally resampled value is
+        // pixel * kWeightOne, a vertically resampled one pixel * kWeightOne^2, rounded to pixel * kValueOne.
+        constexpr int kWeightBits = 11;
+        constexpr int32_t kWeightOne = 1 << kWeightBits;
+        constexpr int kValueShift = 2 * kWeightBits - 8;
+        constexpr int32_t kValueRound = 1 << (kValueShift - 1);
+        constexpr float kValueOne = 256.0f;
+
+        /// @brief Normalization of one model channel, applied to pixel * kValueOne: (value - offset) * gain.
+        /// (A subtraction then a product: no level can fuse it into a different-rounding FMA.)
+        struct ChannelNorm
+        {
+            float offset;
+            float gain;
+        };
+
+        /// @brief Normalization of config's channels.
+        /// @throws std::invalid_argument if the scale, a mean or a std is not usable.
+        void make_channel_norms(const PreprocessConfig& config, ChannelNorm (&norm)[3])
+        {
+            if (!(config.scale > 0.0f) || !std::isfinite(config.scale))
+            {
+                throw std::invalid_argument("[TRT-YOLO] Invalid input scale: " + std::to_string(config.scale));
+            }
+            for (int c = 0; c < 3; c++)
+            {
+                if (config.std[c] == 0.0f || !std::isfinite(config.std[c]) || !std::isfinite(config.mean[c]))
+                {
+                    throw std::invalid_argument("[TRT-YOLO] Invalid input mean / std: " + std::to_string(config.mean[c])
+                        + " / " + std::to_string(config.std[c]));
+                }
+                norm[c].offset = static_cast<float>(static_cast<double>(config.mean[c]) * kValueOne / config.scale);
+                norm[c].gain = static_cast<float>(static_cast<double>(config.scale) / (kValueOne * config.std[c]));
+            }
+        }
+
+        // YUV -> RGB coefficients are fixed-point too: 1.0 is 1 << kYuvBits.
+        constexpr int kYuvBits = 13;
+        constexpr int32_t kYuvRound = 1 << (kYuvBits - 1);
+        constexpr int32_t kChromaZero = 128;
+        constexpr int32_t kPixelMax = 255;
+
+        /// @brief YUV -> RGB conversion of 8-bit samples, in 1 / (1 << kYuvBits) steps: luma = (Y - luma_offset) *
+        /// luma_gain, R = luma + r_v * V', G = luma - g_u * U' - g_v * V', B = luma + b_u * U' (U', V' = U, V -
+        /// kChromaZero), rounded and clamped to 8 bits.
+        struct YuvToRgb
+        {
+            int32_t luma_offset;
+            int32_t luma_gain;
+            int32_t r_v;
+            int32_t g_u;
+            int32_t g_v;
+            int32_t b_u;
+        };
+
+        /// @brief Conversion of image's matrix and range.
+        YuvToRgb make_yuv_to_rgb(const ImageView& image) noexcept
+        {
+            const bool bt709 = image.matrix == YuvMatrix::kBT709;
+            const double kr = bt709 ? 0.2126 : 0.299;
+            const double kb = bt709 ? 0.0722 : 0.114;
+            const double kg = 1.0 - kr - kb;
+
+            // Limited range: luma spans 16-235, chroma 16-240 (centered on 128).
+            const double luma = image.full_range ? 1.0 : 255.0 / 219.0;
+            const double chroma = image.full_range ? 1.0 : 255.0 / 224.0;
+            auto fixed = [](double value) { return static_cast<int32_t>(std::lround(value * (1 << kYuvBits))); };
+            return {image.full_range ? 0 : 16, fixed(luma), fixed(2.0 * (1.0 - kr) * chroma),
+                fixed(2.0 * kb * (1.0 - kb) / kg * chroma), fixed(2.0 * kr * (1.0 - kr) / kg * chroma),
+                fixed(2.0 * (1.0 - kb) * chroma)};
+        }
+
+        /// @brief Source sample of one scaled coordinate: the lower pixel, the next one, and the next one's weight.
+        struct Sample
+        {
+            int first;
+            int next;
+            int32_t weight;
+        };
+
+        /// @brief Half-pixel-center mapping of scaled coordinate i (of scaled) onto a source axis of source pixels.
+        Sample sample(int i, int scaled, int source) noexcept
+        {
+            const double position = (i + 0.5) * source / scaled - 0.5;
+            int first = static_cast<int>(std::floor(position));
+            double fraction = position - first;
+            if (first < 0)
+            {
+                first = 0;
+                fraction = 0.0;
+            }
+            if (first >= source - 1)
+            {
+                first = source - 1;
+                fraction = 0.0;
+            }
+            return {first, std::min(first + 1, source - 1), static_cast<int32_t>(std::lround(fraction * kWeightOne))};
+        }
+
+        /// @brief Where the planes' (Y, U, V; or the RGB / BGR pixels) samples of source pixel x lie within their rows:
+        /// x * luma_step, or (x / 2) * chroma_step + chroma_offset[k] for chroma, shared by pixel pairs. row_bytes[k]
+        /// is the readable length of a row (the NV12 V plane starts one byte into the U, V row).
+        struct PlaneLayout
+        {
+            int num_planes;
+            int32_t luma_step;
+            int32_t chroma_step;
+            int32_t chroma_offset[3];
+            int32_t row_bytes[3];
+        };
+
+        PlaneLayout plane_layout(PixelFormat format, int source_width) noexcept
+        {
+            const int32_t chroma_width = (source_width + 1) / 2;
+            switch (format)
+            {
+                case PixelFormat::kNV12:
+                    return {3, 1, 2, {0, 0, 0}, {source_width, 2 * chroma_width, 2 * chroma_width - 1}};
+                case PixelFormat::kI420:
+                    return {3, 1, 1, {0, 0, 0}, {source_width, chroma_width, chroma_width}};
+                case PixelFormat::kYUYV:
+                    return {3, 2, 4, {0, 1, 3}, {4 * chroma_width, 4 * chroma_width, 4 * chroma_width}};
+                default:
+                    return {1, 3, 0, {0, 0, 0}, {3 * source_width, 0, 0}};
+            }
+        }
+
+        void build_tables(PreprocessWorkspace& ws, PixelFormat format, int source_width, int source_height,
+            int scaled_width, int scaled_height)
+        {
+            if (ws.format == format && ws.source_width == source_width && ws.source_height == source_height
+                && ws.scaled_width == scaled_width && ws.scaled_height == scaled_height)
+            {
+                return;
+            }
+            const PlaneLayout layout = plane_layout(format, source_width);
+            for (int k = 0; k < layout.num_planes; k++)
+            {
+                ws.x_offsets[k].resize(scaled_width);
+                ws.x_next_offsets[k].resize(scaled_width);
+            }
+            ws.x_weights.resize(scaled_width);
+            ws.vector_columns = 0;
+            for (int x = 0; x < scaled_width; x++)
+            {
+                const Sample s = sample(x, scaled_width, source_width);
+                ws.x_weights[x] = (kWeightOne - s.weight) | (s.weight << 16);
+
+                // The kernels read a whole 32-bit word at each sample: the next pixel's must not pass the row end.
+                bool vector = true;
+                for (int k = 0; k < layout.num_planes; k++)
+                {
+                    const bool luma = k == 0;
+                    const int32_t step = luma ? layout.luma_step : layout.chroma_step;
+                    ws.x_offsets[k][x] = (luma ? s.first : s.first / 2) * step + layout.chroma_offset[k];
+                    ws.x_next_offsets[k][x] = (luma ? s.next : s.next / 2) * step + layout.chroma_offset[k];
+                    vector = vector && ws.x_next_offsets[k][x] + 4 <= layout.row_bytes[k];
+                }
+                if (vector)
+                {
+                    ws.vector_columns = x + 1;
+                }
+            }
+            ws.y_rows.resize(scaled_height);
+            ws.y_next_rows.resize(scaled_height);
+            ws.y_weights.resize(scaled_height);
+            for (int y = 0; y < scaled_height; y++)
+            {
+                const Sample s = sample(y, scaled_height, source_height);
+                ws.y_rows[y] = s.first;
+                ws.y_next_rows[y] = s.next;
+                ws.y_weights[y] = s.weight;
+            }
+            ws.rows.resize(static_cast<size_t>(scaled_width) * 6);
+            ws.format = format;
+            ws.source_width = source_width;
+            ws.source_height = source_height;
+            ws.scaled_width = scaled_width;
+            ws.scaled_height = scaled_height;
+        }
+
+        /// @brief Horizontal pass from column begin: resampled[p][x] = pixel channel channels[p], times kWeightOne.
+        void resample_row_scalar(const uint8_t* row, const PreprocessWorkspace& ws, size_t begin, size_t end,
+            const int* channels, int32_t* const* resampled) noexcept
+        {
+            for (size_t x = begin; x < end; x++)
+            {
+                const uint8_t* first = row + ws.x_offsets[0][x];
+                const uint8_t* next = row + ws.x_next_offsets[0][x];
+                const int32_t first_weight = ws.x_weights[x] & 0xFFFF;
+                const int32_t next_weight = ws.x_weights[x] >> 16;
+                for (int p = 0; p < 3; p++)
+                {
+                    resampled[p][x] = first[channels[p]] * first_weight + next[channels[p]] * next_weight;
+                }
+            }
+        }
+
+        /// @brief Stores a normalized value as the output type: float32, or IEEE half (uint16_t).
+        inline void store_value(float* out, float value) noexcept
+        {
+            *out = value;
+        }
+
+        inline void store_value(uint16_t* out, float value) noexcept
+        {
+            *out = float_to_half(value);
+        }
+
+        /// @brief Vertical pass and normalization from column begin, into the three output planes.
+        template <typename T>
+        void blend_rows_scalar(const int32_t* const* upper, const int32_t* const* lower, int32_t weight,
+            size_t begin, size_t end, const ChannelNorm* norm, T* const* out) noexcept
+        {
+            const int32_t upper_weight = kWeightOne - weight;
+            for (int p = 0; p < 3; p++)
+            {
+                for (size_t x = begin; x < end; x++)
+                {
+                    const int32_t value = (upper[p][x] * upper_weight + lower[p][x] * weight + kValueRound) >> kValueShift;
+                    store_value(out[p] + x, (static_cast<float>(value) - norm[p].offset) * norm[p].gain);
+                }
+            }
+        }
+
+        /// @brief 8-bit R, G, B of one Y, U, V sample.
+        void yuv_to_rgb(const YuvToRgb& yuv, int32_t y, int32_t u, int32_t v, int32_t* rgb) noexcept
+        {
+            const int32_t luma = (y - yuv.luma_offset) * yuv.luma_gain + kYuvRound;
+            u -= kChromaZero;
+            v -= kChromaZero;
+            const int32_t sums[3] = {luma + yuv.r_v * v, luma - yuv.g_u * u - yuv.g_v * v, luma + yuv.b_u * u};
+            for (int c = 0; c < 3; c++)
+            {
+                rgb[c] = std::min(std::max(sums[c] >> kYuvBits, 0), kPixelMax);
+            }
+        }
+
+        /// @brief Horizontal pass of a YUV row (rows: its Y, U and V plane rows) from column begin: both source
+        /// pixels are converted, then resampled[p][x] = converted channel channels[p], times kWeightOne.
+        void resample_yuv_row_scalar(const uint8_t* const* rows, const PreprocessWorkspace& ws, size_t begin, size_t end,
+            const YuvToRgb& yuv, const int* channels, int32_t* const* resampled) noexcept
+        {
+            for (size_t x = begin; x < end; x++)
+            {
+                int32_t first[3];
+                int32_t next[3];
+                yuv_to_rgb(yuv, rows[0][ws.x_offsets[0][x]], rows[1][ws.x_offsets[1][x]], rows[2][ws.x_offsets[2][x]], first);
+                yuv_to_rgb(yuv, rows[0][ws.x_next_offsets[0][x]], rows[1][ws.x_next_offsets[1][x]],
+                    rows[2][ws.x_next_offsets[2][x]], next);
+                const int32_t first_weight = ws.x_weights[x] & 0xFFFF;
+                const int32_t next_weight = ws.x_weights[x] >> 16;
+                for (int p = 0; p < 3; p++)
+                {
+                    resampled[p][x] = first[channels[p]] * first_weight + next[channels[p]] * next_weight;
+                }
+            }
+        }
+
+#if defined(TRT_YOLO_X86_KERNELS)
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+// GCC's AVX-512 intrinsics seed results with _mm512_undefined_*(), which trips false positives.
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+        /// @return Number of columns processed (a multiple of 8)
+        __attribute__((target("avx2")))
+        size_t resample_row_avx2(const uint8_t* row, const PreprocessWorkspace& ws, const int* channels,
+            int32_t* const* resampled) noexcept
+        {
+            // One gather fetches the three channels of 8 pixels; each channel is shifted out, and the pixel pair
+            // is blended by a single 16-bit multiply-add (first | next << 16 times first_weight | next_weight << 16).
+            const int* base = reinterpret_cast<const int*>(row);
+            const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+            size_t x = 0;
+            for (; x + 8 <= ws.vector_columns; x += 8)
+            {
+                const __m256i first = _mm256_i32gather_epi32(base,
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ws.x_offsets[0].data() + x)), 1);
+                const __m256i next = _mm256_i32gather_epi32(base,
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ws.x_next_offsets[0].data() + x)), 1);
+                const __m256i weights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ws.x_weights.data() + x));
+                for (int p = 0; p < 3; p++)
+                {
+                    const __m128i shift = _mm_cvtsi32_si128(channels[p] * 8);
+                    const __m256i pair = _mm256_or_si256(_mm256_and_si256(_mm256_srl_epi32(first, shift), byte_mask),
+                        _mm256_slli_epi32(_mm256_and_si256(_mm256_srl_epi32(next, shift), byte_mask), 16));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(resampled[p] + x), _mm256_madd_epi16(pair, weights));
+                }
+            }
+            return x;
+        }
+
+        __attribute__((target("avx2,f16c")))
+        inline void store_values_avx2(float* out, __m256 values) noexcept
+        {
+            _mm256_storeu_ps(out, values);
+        }
+
+        __attribute__((target("avx2,f16c")))
+        inline void store_values_avx2(uint16_t* out, __m256 values) noexcept
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT));
+        }
+
+        /// @return Number of columns processed (a multiple of 8)
+        template <typename T>
+        __attribute__((target("avx2,f16c")))
+        size_t blend_rows_avx2(const int32_t* const* upper, const int32_t* const* lower, int32_t weight, size_t count,
+            const ChannelNorm* norm, T* const* out) noexcept
+        {
+            const __m256i upper_weight = _mm256_set1_epi32(kWeightOne - weight);
+            const __m256i lower_weight = _mm256_set1_epi32(weight);
+            const __m256i round = _mm256_set1_epi32(kValueRound);
+            const size_t end = count & ~static_cast<size_t>(7);
+            for (int p = 0; p < 3; p++)
+            {
+                const __m256 offset = _mm256_set1_ps(norm[p].offset);
+                const __m256 gain = _mm256_set1_ps(norm[p].gain);
+                for (size_t x = 0; x < end; x += 8)
+                {
+                    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(upper[p] + x));
+                    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lower[p] + x));
+                    const __m256i sum = _mm256_add_epi32(_mm256_mullo_epi32(a, upper_weight), _mm256_mullo_epi32(b, lower_weight));
+                    const __m256 value = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_add_epi32(sum, round), kValueShift));
+                    store_values_avx2(out[p] + x, _mm256_mul_ps(_mm256_sub_ps(value, offset), gain));
+                }
+            }
+            return end;
+        }
+
+        /// @return Number of columns processed (a multiple of 16)
+        __attribute__((target("avx512f")))
+        size_t resample_row_avx512(const uint8_t* row, const PreprocessWorkspace& ws, const int* channels,
+            int32_t* const* resampled) noexcept
+        {
+            // As resample_row_avx2(), with 32-bit products (the 16-bit multiply-add needs AVX-512BW).
+            const __m512i byte_mask = _mm512_set1_epi32(0xFF);
+            const __m512i weight_mask = _mm512_set1_epi32(0xFFFF);
+            size_t x = 0;
+            for (; x + 16 <= ws.vector_columns; x += 16)
+            {
+                const __m512i first = _mm512_i32gather_epi32(_mm512_loadu_si512(ws.x_offsets[0].data() + x), row, 1);
+                const __m512i next = _mm512_i32gather_epi32(_mm512_loadu_si512(ws.x_next_offsets[0].data() + x), row, 1);
+                const __m512i weights = _mm512_loadu_si512(ws.x_weights.data() + x);
+                const __m512i first_weight = _mm512_and_si512(weights, weight_mask);
+                const __m512i next_weight = _mm512_srli_epi32(weights, 16);
+                for (int p = 0; p < 3; p++)
+                {
+                    const __m128i shift = _mm_cvtsi32_si128(channels[p] * 8);
+                    const __m512i a = _mm512_and_si512(_mm512_srl_epi32(first, shift), byte_mask);
+                    const __m512i b = _mm512_and_si512(_mm512_srl_epi32(next, shift), byte_mask);
+                    _mm512_storeu_si512(resampled[p] + x,
+                        _mm512_add_epi32(_mm512_mullo_epi32(a, first_weight), _mm512_mullo_epi32(b, next_weight)));
+                }
+            }
+            return x;
+        }
+
+        __attribute__((target("avx512f")))
+        inline void store_values_avx512(float* out, __m512 values) noexcept
+        {
+            _mm512_storeu_ps(out, values);
+        }
+
+        __attribute__((target("avx512f")))
+        inline void store_values_avx512(uint16_t* out, __m512 values) noexcept
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm512_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT));
+        }
+
+        /// @return Number of columns processed (a multiple of 16)
+        template <typename T>
+        __attribute__((target("avx512f")))
+        size_t blend_rows_avx512(const int32_t* const* upper, const int32_t* const* lower, int32_t weight, size_t count,
+            const ChannelNorm* norm, T* const* out) noexcept
+        {
+            const __m512i upper_weight = _mm512_set1_epi32(kWeightOne - weight);
+            const __m512i lower_weight = _mm512_set1_epi32(weight);
+            const __m512i round = _mm512_set1_epi32(kValueRound);
+            const size_t end = count & ~static_cast<size_t>(15);
+            for (int p = 0; p < 3; p++)
+            {
+                const __m512 offset = _mm512_set1_ps(norm[p].offset);
+                const __m512 gain = _mm512_set1_ps(norm[p].gain);
+                for (size_t x = 0; x < end; x += 16)
+                {
+                    const __m512i a = _mm512_loadu_si512(upper[p] + x);
+                    const __m512i b = _mm512_loadu_si512(lower[p] + x);
+                    const __m512i sum = _mm512_add_epi32(_mm512_mullo_epi32(a, upper_weight), _mm512_mullo_epi32(b, lower_weight));
+                    const __m512 value = _mm512_cvtepi32_ps(_mm512_srai_epi32(_mm512_add_epi32(sum, round), kValueShift));
+                    store_values_avx512(out[p] + x, _mm512_mul_ps(_mm512_sub_ps(value, offset), gain));
+                }
+            }
+            return end;
+        }
+
+        /// @brief As yuv_to_rgb(), for 8 samples.
+        __attribute__((target("avx2")))
+        void yuv_to_rgb_avx2(const YuvToRgb& yuv, const __m256i* samples, __m256i* rgb) noexcept
+        {
+            const __m256i luma = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(samples[0],
+                _mm256_set1_epi32(yuv.luma_offset)), _mm256_set1_epi32(yuv.luma_gain)), _mm256_set1_epi32(kYuvRound));
+            const __m256i u = _mm256_sub_epi32(samples[1], _mm256_set1_epi32(kChromaZero));
+            const __m256i v = _mm256_sub_epi32(samples[2], _mm256_set1_epi32(kChromaZero));
+            const __m256i sums[3] = {
+                _mm256_add_epi32(luma, _mm256_mullo_epi32(v, _mm256_set1_epi32(yuv.r_v))),
+                _mm256_sub_epi32(_mm256_sub_epi32(luma, _mm256_mullo_epi32(u, _mm256_set1_epi32(yuv.g_u))),
+                    _mm256_mullo_epi32(v, _mm256_set1_epi32(yuv.g_v))),
+                _mm256_add_epi32(luma, _mm256_mullo_epi32(u, _mm256_set1_epi32(yuv.b_u)))};
+            for (int c = 0; c < 3; c++)
+            {
+                rgb[c] = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(sums[c], kYuvBits), _mm256_setzero_si256()),
+                    _mm256_set1_epi32(kPixelMax));
+            }
+        }
+
+        /// @return Number of columns processed (a multiple of 8)
+        __attribute__((target("avx2")))
+        size_t resample_yuv_row_avx2(const uint8_t* const* rows, const PreprocessWorkspace& ws, const YuvToRgb& yuv,
+            const int* channels, int32_t* const* resampled) noexcept
+        {
+            // One gather per plane and source pixel (the sample is the low byte of each word); both pixels are
+            // converted, then blended like resample_row_avx2().
+            const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+            size_t x = 0;
+            for (; x + 8 <= ws.vector_columns; x += 8)
+            {
+                __m256i first[3];
+                __m256i next[3];
+                for (int k = 0; k < 3; k++)
+                {
+                    const int* base = reinterpret_cast<const int*>(rows[k]);
+                    first[k] = _mm256_and_si256(_mm256_i32gather_epi32(base,
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ws.x_offsets[k].data() + x)), 1), byte_mask);
+                    next[k] = _mm256_and_si256(_mm256_i32gather_epi32(base,
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ws.x_next_offsets[k].data() + x)), 1), byte_mask);
+                }
+                __m256i first_rgb[3];
+                __m256i next_rgb[3];
+                yuv_to_rgb_avx2(yuv, first, first_rgb);
+                yuv_to_rgb_avx2(yuv, next, next_rgb);
+                const __m256i weights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ws.x_weights.data() + x));
+                for (int p = 0; p < 3; p++)
+                {
+                    const __m256i pair = _mm256_or_si256(first_rgb[channels[p]], _mm256_slli_epi32(next_rgb[channels[p]], 16));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(resampled[p] + x), _mm256_madd_epi16(pair, weights));
+                }
+            }
+            return x;
+        }
+
+        /// @brief As yuv_to_rgb(), for 16 samples.
+        __attribute__((target("avx512f")))
+        void yuv_to_rgb_avx512(const YuvToRgb& yuv, const __m512i* samples, __m512i* rgb) noexcept
+        {
+            const __m512i luma = _mm512_add_epi32(_mm512_mullo_epi32(_mm512_sub_epi32(samples[0],
+                _mm512_set1_epi32(yuv.luma_offset)), _mm512_set1_epi32(yuv.luma_gain)), _mm512_set1_epi32(kYuvRound));
+            const __m512i u = _mm512_sub_epi32(samples[1], _mm512_set1_epi32(kChromaZero));
+            const __m512i v = _mm512_sub_epi32(samples[2], _mm512_set1_epi32(kChromaZero));
+            const __m512i sums[3] = {
+                _mm512_add_epi32(luma, _mm512_mullo_epi32(v, _mm512_set1_epi32(yuv.r_v))),
+                _mm512_sub_epi32(_mm512_sub_epi32(luma, _mm512_mullo_epi32(u, _mm512_set1_epi32(yuv.g_u))),
+                    _mm512_mullo_epi32(v, _mm512_set1_epi32(yuv.g_v))),
+                _mm512_add_epi32(luma, _mm512_mullo_epi32(u, _mm512_set1_epi32(yuv.b_u)))};
+            for (int c = 0; c < 3; c++)
+            {
+                rgb[c] = _mm512_min_epi32(_mm512_max_epi32(_mm512_srai_epi32(sums[c], kYuvBits), _mm512_setzero_si512()),
+                    _mm512_set1_epi32(kPixelMax));
+            }
+        }
+
+        /// @return Number of columns processed (a multiple of 16)
+        __attribute__((target("avx512f")))
+        size_t resample_yuv_row_avx512(const uint8_t* const* rows, const PreprocessWorkspace& ws, const YuvToRgb& yuv,
+            const int* channels, int32_t* const* resampled) noexcept
+        {
+            const __m512i byte_mask = _mm512_set1_epi32(0xFF);
+            const __m512i weight_mask = _mm512_set1_epi32(0xFFFF);
+            size_t x = 0;
+            for (; x + 16 <= ws.vector_columns; x += 16)
+            {
+                __m512i first[3];
+                __m512i next[3];
+                for (int k = 0; k < 3; k++)
+                {
+                    first[k] = _mm512_and_si512(
+                        _mm512_i32gather_epi32(_mm512_loadu_si512(ws.x_offsets[k].data() + x), rows[k], 1), byte_mask);
+                    next[k] = _mm512_and_si512(
+                        _mm512_i32gather_epi32(_mm512_loadu_si512(ws.x_next_offsets[k].data() + x), rows[k], 1), byte_mask);
+                }
+                __m512i first_rgb[3];
+                __m512i next_rgb[3];
+                yuv_to_rgb_avx512(yuv, first, first_rgb);
+                yuv_to_rgb_avx512(yuv, next, next_rgb);
+                const __m512i weights = _mm512_loadu_si512(ws.x_weights.data() + x);
+                const __m512i first_weight = _mm512_and_si512(weights, weight_mask);
+                const __m512i next_weight = _mm512_srli_epi32(weights, 16);
+                for (int p = 0; p < 3; p++)
+                {
+                    _mm512_storeu_si512(resampled[p] + x, _mm512_add_epi32(_mm512_mullo_epi32(first_rgb[channels[p]], first_weight),
+                        _mm512_mullo_epi32(next_rgb[channels[p]], next_weight)));
+                }
+            }
+            return x;
+        }
+
+        /// @return Number of values converted (a multiple of 8)
+        __attribute__((target("avx2,f16c")))
+        size_t floats_to_halves_avx2(const float* values, uint16_t* halves, size_t count) noexcept
+        {
+            const size_t end = count & ~static_cast<size_t>(7);
+            for (size_t i = 0; i < end; i += 8)
+            {
+                store_values_avx2(halves + i, _mm256_loadu_ps(values + i));
+            }
+            return end;
+        }
+
+        /// @return Number of values converted (a multiple of 8)
+        __attribute__((target("avx2,f16c")))
+        size_t halves_to_floats_avx2(const uint16_t* halves, float* values, size_t count) noexcept
+        {
+            const size_t end = count & ~static_cast<size_t>(7);
+            for (size_t i = 0; i < end; i += 8)
+            {
+                _mm256_storeu_ps(values + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(halves + i))));
+            }
+            return end;
+        }
+
+        /// @return Number of values converted (a multiple of 16)
+        __attribute__((target("avx512f")))
+        size_t floats_to_halves_avx512(const float* values, uint16_t* halves, size_t count) noexcept
+        {
+            const size_t end = count & ~static_cast<size_t>(15);
+            for (size_t i = 0; i < end; i += 16)
+            {
+                store_values_avx512(halves + i, _mm512_loadu_ps(values + i));
+            }
+            return end;
+        }
+
+        /// @return Number of values converted (a multiple of 16)
+        __attribute__((target("avx512f")))
+        size_t halves_to_floats_avx512(const uint16_t* halves, float* values, size_t count) noexcept
+        {
+            const size_t end = count & ~static_cast<size_t>(15);
+            for (size_t i = 0; i < end; i += 16)
+            {
+                _mm512_storeu_ps(values + i, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(halves + i))));
+            }
+            return end;
+        }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif // TRT_YOLO_X86_KERNELS
+
+#if defined(TRT_YOLO_NEON_KERNELS)
+
+        /// @return Number of columns processed (a multiple of 4)
+        size_t resample_row_neon(const uint8_t* row, const PreprocessWorkspace& ws, const int* channels,
+            int32_t* const* resampled) noexcept
+        {
+            // No gather: the four 32-bit words are loaded one by one, then blended like resample_row_avx512().
+            const uint32x4_t byte_mask = vdupq_n_u32(0xFF);
+            const uint32x4_t weight_mask = vdupq_n_u32(0xFFFF);
+            size_t x = 0;
+            for (; x + 4 <= ws.vector_columns; x += 4)
+            {
+                uint32_t first_words[4];
+                uint32_t next_words[4];
+                for (int k = 0; k < 4; k++)
+                {
+                    std::memcpy(&first_words[k], row + ws.x_offsets[0][x + k], 4);
+                    std::memcpy(&next_words[k], row + ws.x_next_offsets[0][x + k], 4);
+                }
+                const uint32x4_t first = vld1q_u32(first_words);
+                const uint32x4_t next = vld1q_u32(next_words);
+                const uint32x4_t weights = vld1q_u32(reinterpret_cast<const uint32_t*>(ws.x_weights.data() + x));
+                const uint32x4_t first_weight = vandq_u32(weights, weight_mask);
+                const uint32x4_t next_weight = vshrq_n_u32(weights, 16);
+                for (int p = 0; p < 3; p++)
+                {
+                    const int32x4_t shift = vdupq_n_s32(-channels[p] * 8);
+                    const uint32x4_t a = vandq_u32(vshlq_u32(first, shift), byte_mask);
+                    const uint32x4_t b = vandq_u32(vshlq_u32(next, shift), byte_mask);
+                    vst1q_s32(resampled[p] + x, vreinterpretq_s32_u32(vmlaq_u32(vmulq_u32(a, first_weight), b, next_weight)));
+                }
+            }
+            return x;
+        }
+
+        inline void store_values_neon(float* out, float32x4_t values) noexcept
+        {
+            vst1q_f32(out, values);
+        }
+
+        inline void store_values_neon(uint16_t* out, float32x4_t values) noexcept
+        {
+            vst1_u16(out, vreinterpret_u16_f16(vcvt_f16_f32(values)));
+        }
+
+        /// @return Number of columns processed (a multiple of 4)
+        template <typename T>
+        size_t blend_rows_neon(const int32_t* const* upper, const int32_t* const* lower, int32_t weight, size_t count,
+            const ChannelNorm* norm, T* const* out) noexcept
+        {
+            const int32x4_t upper_weight = vdupq_n_s32(kWeightOne - weight);
+            const int32x4_t lower_weight = vdupq_n_s32(weight);
+            const size_t end = count & ~static_cast<size_t>(3);
+            for (int p = 0; p < 3; p++)
+            {
+                const float32x4_t offset = vdupq_n_f32(norm[p].offset);
+                const float32x4_t gain = vdupq_n_f32(norm[p].gain);
+                for (size_t x = 0; x < end; x += 4)
+                {
+                    const int32x4_t sum = vmlaq_s32(vmulq_s32(vld1q_s32(upper[p] + x), upper_weight),
+                        vld1q_s32(lower[p] + x), lower_weight);
+                    const float32x4_t value = vcvtq_f32_s32(vrshrq_n_s32(sum, kValueShift)); // (sum + round) >> shift
+                    store_values_neon(out[p] + x, vmulq_f32(vsubq_f32(value, offset), gain));
+                }
+            }
+            return end;
+        }
+
+        /// @brief As yuv_to_rgb(), for 4 samples.
+        void yuv_to_rgb_neon(const YuvToRgb& yuv, const int32x4_t* samples, int32x4_t* rgb) noexcept
+        {
+            const int32x4_t luma = vmlaq_n_s32(vdupq_n_s32(kYuvRound), vsubq_s32(samples[0], vdupq_n_s32(yuv.luma_offset)),
+                yuv.luma_gain);
+            const int32x4_t u = vsubq_s32(samples[1], vdupq_n_s32(kChromaZero));
+            const int32x4_t v = vsubq_s32(samples[2], vdupq_n_s32(kChromaZero));
+            const int32x4_t sums[3] = {
+                vmlaq_n_s32(luma, v, yuv.r_v),
+                vmlsq_n_s32(vmlsq_n_s32(luma, u, yuv.g_u), v, yuv.g_v),
+                vmlaq_n_s32(luma, u, yuv.b_u)};
+            for (int c = 0; c < 3; c++)
+            {
+                rgb[c] = vminq_s32(vmaxq_s32(vshrq_n_s32(sums[c], kYuvBits), vdupq_n_s32(0)), vdupq_n_s32(kPixelMax));
+            }
+        }
+
+        /// @return Number of columns processed (a multiple of 4)
+        size_t resample_yuv_row_neon(const uint8_t* const* rows, const PreprocessWorkspace& ws, const YuvToRgb& yuv,
+            const int* channels, int32_t* const* resampled) noexcept
+        {
+            // No gather: the samples are loaded byte by byte, then converted and blended like resample_row_neon().
+            size_t x = 0;
+            for (; x + 4 <= ws.vector_columns; x += 4)
+            {
+                int32x4_t first[3];
+                int32x4_t next[3];
+                for (int k = 0; k < 3; k++)
+                {
+                    int32_t first_samples[4];
+                    int32_t next_samples[4];
+                    for (int i = 0; i < 4; i++)
+                    {
+                        first_samples[i] = rows[k][ws.x_offsets[k][x + i]];
+                        next_samples[i] = rows[k][ws.x_next_offsets[k][x + i]];
+                    }
+                    first[k] = vld1q_s32(first_samples);
+                    next[k] = vld1q_s32(next_samples);
+                }
+                int32x4_t first_rgb[3];
+                int32x4_t next_rgb[3];
+                yuv_to_rgb_neon(yuv, first, first_rgb);
+                yuv_to_rgb_neon(yuv, next, next_rgb);
+                const int32x4_t weights = vld1q_s32(ws.x_weights.data() + x);
+                const int32x4_t first_weight = vandq_s32(weights, vdupq_n_s32(0xFFFF));
+                const int32x4_t next_weight = vshrq_n_s32(weights, 16);
+                for (int p = 0; p < 3; p++)
+                {
+                    vst1q_s32(resampled[p] + x, vmlaq_s32(vmulq_s32(first_rgb[channels[p]], first_weight),
+                        next_rgb[channels[p]], next_weight));
+                }
+            }
+            return x;
+        }
+
+        /// @return Number of values converted (a multiple of 4)
+        size_t floats_to_halves_neon(const float* values, uint16_t* halves, size_t count) noexcept
+        {
+            const size_t end = count & ~static_cast<size_t>(3);
+            for (size_t i = 0; i < end; i += 4)
+            {
+                store_values_neon(halves + i, vld1q_f32(values + i));
+            }
+            return end;
+        }
+
+        /// @return Number of values converted (a multiple of 4)
+        size_t halves_to_floats_neon(const uint16_t* halves, float* values, size_t count) noexcept
+        {
+            const size_t end = count & ~static_cast<size_t>(3);
+            for (size_t i = 0; i < end; i += 4)
+            {
+                vst1q_f32(values + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(halves + i))));
+            }
+            return end;
+        }
+
+#endif // TRT_YOLO_NEON_KERNELS
+
+        void resample_row(SimdLevel level, const uint8_t* row, const PreprocessWorkspace& ws, const int* channels,
+            int32_t* const* resampled) noexcept
+        {
+            size_t done = 0;
+            switch (level)
+            {
+#if defined(TRT_YOLO_X86_KERNELS)
+                case SimdLevel::kAVX512:
+                    done = resample_row_avx512(row, ws, channels, resampled);
+                    break;
+                case SimdLevel::kAVX2:
+                    done = resample_row_avx2(row, ws, channels, resampled);
+                    break;
+#endif
+#if defined(TRT_YOLO_NEON_KERNELS)
+                case SimdLevel::kNEON:
+                    done = resample_row_neon(row, ws, channels, resampled);
+                    break;
+#endif
+                default:
+                    break;
+            }
+            resample_row_scalar(row, ws, done, static_cast<size_t>(ws.scaled_width), channels, resampled);
+        }
+
+        template <typename T>
+        void blend_rows(SimdLevel level, const int32_t* const* upper, const int32_t* const* lower, int32_t weight,
+            size_t count, const ChannelNorm* norm, T* const* out) noexcept
+        {
+            size_t done = 0;
+            switch (level)
+            {
+#if defined(TRT_YOLO_X86_KERNELS)
+                case SimdLevel::kAVX512:
+                    done = blend_rows_avx512(upper, lower, weight, count, norm, out);
+                    break;
+                case SimdLevel::kAVX2:
+                    done = blend_rows_avx2(upper, lower, weight, count, norm, out);
+                    break;
+#endif
+#if defined(TRT_YOLO_NEON_KERNELS)
+                case SimdLevel::kNEON:
+                    done = blend_rows_neon(upper, lower, weight, count, norm, out);
+                    break;
+#endif
+                default:
+                    break;
+            }
+            blend_rows_scalar(upper, lower, weight, done, count, norm, out);
+        }
+
+        /// @brief float_to_half() of count values (the hardware conversions round to nearest even, like it).
+        void floats_to_halves(SimdLevel level, const float* values, uint16_t* halves, size_t count) noexcept
+        {
+            size_t done = 0;
+            switch (level)
+            {
+#if defined(TRT_YOLO_X86_KERNELS)
+                case SimdLevel::kAVX512:
+                    done = floats_to_halves_avx512(values, halves, count);
+                    break;
+                case SimdLevel::kAVX2:
+                    done = floats_to_halves_avx2(values, halves, count);
+                    break;
+#endif
+#if defined(TRT_YOLO_NEON_KERNELS)
+                case SimdLevel::kNEON:
+                    done = floats_to_halves_neon(values, halves, count);
+                    break;
+#endif
+                default:
+                    break;
+            }
+            for (size_t i = done; i < count; i++)
+            {
+                halves[i] = float_to_half(values[i]);
+            }
+        }
+
+        /// @brief half_to_float() of count values.
+        void halves_to_floats(SimdLevel level, const uint16_t* halves, float* values, size_t count) noexcept
+        {
+            size_t done = 0;
+            switch (level)
+            {
+#if defined(TRT_YOLO_X86_KERNELS)
+                case SimdLevel::kAVX512:
+                    done = halves_to_floats_avx512(halves, values, count);
+                    break;
+                case SimdLevel::kAVX2:
+                    done = halves_to_floats_avx2(halves, values, count);
+                    break;
+#endif
+#if defined(TRT_YOLO_NEON_KERNELS)
+                case SimdLevel::kNEON:
+                    done = halves_to_floats_neon(halves, values, count);
+                    break;
+#endif
+                default:
+                    break;
+            }
+            for (size_t i = done; i < count; i++)
+            {
+                values[i] = half_to_float(halves[i]);
+            }
+        }
+
+        void resample_yuv_row(SimdLevel level, const uint8_t* const* rows, const PreprocessWorkspace& ws,
+            const YuvToRgb& yuv, const int* channels, int32_t* const* resampled) noexcept
+        {
+            size_t done = 0;
+            switch (level)
+            {
+#if defined(TRT_YOLO_X86_KERNELS)
+                case SimdLevel::kAVX512:
+                    done = resample_yuv_row_avx512(rows, ws, yuv, channels, resampled);
+                    break;
+                case SimdLevel::kAVX2:
+                    done = resample_yuv_row_avx2(rows, ws, yuv, channels, resampled);
+                    break;
+#endif
+#if defined(TRT_YOLO_NEON_KERNELS)
+                case SimdLevel::kNEON:
+                    done = resample_yuv_row_neon(rows, ws, yuv, channels, resampled);
+                    break;
+#endif
+                default:
+                    break;
+            }
+            resample_yuv_row_scalar(rows, ws, done, static_cast<size_t>(ws.scaled_width), yuv, channels, resampled);
+        }
+
+        /// @brief preprocess_image() into planes of T: float, or IEEE half (uint16_t).
+        template <typename T>
+        LetterboxInfo preprocess_into(const ImageView& image, const PreprocessConfig& config, T* output,
+            PreprocessWorkspace& workspace)
+        {
+            if (!image.is_valid())
+            {
+                throw std::invalid_argument(std::string("[TRT-YOLO] Invalid ") + pixel_format_name(image.format)
+                    + " image (" + std::to_string(image.width) + "x" + std::to_string(image.height) + ", stride "
+                    + std::to_string(image.row_stride()) + (image.data == nullptr ? ", no data)" : ")"));
+            }
+            if (output == nullptr)
+            {
+                throw std::invalid_argument("[TRT-YOLO] Null preprocessing output");
+            }
+            ChannelNorm norm[3];
+            make_channel_norms(config, norm);
+            const LetterboxInfo letterbox = LetterboxInfo::fit(image.width, image.height, config.model_width,
+                config.model_height);
+
+            // Same scaled area as LetterboxInfo::fit(), at least one pixel.
+            const int scaled_width = std::max(1, std::min(config.model_width,
+                static_cast<int>(std::lround(image.width * letterbox.scale))));
+            const int scaled_height = std::max(1, std::min(config.model_height,
+                static_cast<int>(std::lround(image.height * letterbox.scale))));
+            const int pad_x = static_cast<int>(letterbox.pad_x);
+            const int pad_y = static_cast<int>(letterbox.pad_y);
+            build_tables(workspace, image.format, image.width, image.height, scaled_width, scaled_height);
+            workspace.cached_rows[0] = workspace.cached_rows[1] = -1; // A new image
+
+            // Model plane p takes source byte channels[p] (RGB / BGR), or converted channel channels[p] (YUV: R, G, B).
+            const bool yuv = is_yuv(image.format);
+            const bool source_rgb = yuv || image.format == PixelFormat::kRGB8;
+            const bool model_rgb = config.channel_order == InputFormat::kRGB;
+            const int channels[3] = {source_rgb == model_rgb ? 0 : 2, 1, source_rgb == model_rgb ? 2 : 0};
+
+            const size_t model_width = static_cast<size_t>(config.model_width);
+            const size_t plane_size = model_width * config.model_height;
+            T* planes[3] = {output, output + plane_size, output + 2 * plane_size};
+            T pad_value[3];
+            for (int p = 0; p < 3; p++)
+            {
+                store_value(&pad_value[p], (static_cast<float>(config.pad_value) * kValueOne - norm[p].offset) * norm[p].gain);
+            }
+
+            // Padding above and below the scaled area.
+            const size_t rows_below = static_cast<size_t>(config.model_height - pad_y - scaled_height);
+            for (int p = 0; p < 3; p++)
+            {
+                std::fill_n(planes[p], pad_y * model_width, pad_value[p]);
+                std::fill_n(planes[p] + (pad_y + scaled_height) * model_width, rows_below * model_width, pad_value[p]);
+            }
+
+            // Scaled area, one row at a time: blend two horizontally resampled source rows, each computed once while
+            // consecutive output rows share it.
+            const SimdLevel level = resolve_simd_level(config.simd_level);
+            const size_t stride = image.row_stride();
+
+            // YUV: the Y, U and V planes' data, row strides and row subsampling (4:2:0 chroma rows cover two rows).
+            const bool subsampled_rows = image.format == PixelFormat::kNV12 || image.format == PixelFormat::kI420;
+            const uint8_t* plane_data[3] = {image.data, image.data, image.data};
+            size_t plane_strides[3] = {stride, stride, stride};
+            if (subsampled_rows)
+            {
+                plane_data[1] = image.u_plane();
+                plane_data[2] = image.v_plane();
+                plane_strides[1] = plane_strides[2] = image.chroma_row_stride();
+            }
+            const YuvToRgb yuv_to_rgb = yuv ? make_yuv_to_rgb(image) : YuvToRgb{};
+
+            const size_t right_pad = model_width - pad_x - scaled_width;
+            auto source_row = [&](int row, int keep_row) -> int32_t*
+            {
+                int32_t* slots = workspace.rows.data();
+                for (int slot = 0; slot < 2; slot++)
+                {
+                    if (workspace.cached_rows[slot] == row)
+                    {
+                        return slots + slot * 3 * scaled_width;
+                    }
+                }
+                const int slot = workspace.cached_rows[0] == keep_row ? 1 : 0;
+                int32_t* resampled = slots + slot * 3 * scaled_width;
+                int32_t* resampled_planes[3] = {resampled, resampled + scaled_width, resampled + 2 * scaled_width};
+                if (yuv)
+                {
+                    const size_t chroma_row = subsampled_rows ? row / 2 : row;
+                    const uint8_t* rows[3] = {plane_data[0] + row * plane_strides[0],
+                        plane_data[1] + chroma_row * plane_strides[1], plane_data[2] + chroma_row * plane_strides[2]};
+                    resample_yuv_row(level, rows, workspace, yuv_to_rgb, channels, resampled_planes);
+                }
+                else
+                {
+                    resample_row(level, image.data + row * stride, workspace, channels, resampled_planes);
+                }
+                workspace.cached_rows[slot] = row;
+                return resampled;
+            };
+            for (int y = 0; y < scaled_height; y++)
+            {
+                const int upper_row = workspace.y_rows[y];
+                const int lower_row = workspace.y_next_rows[y];
+                const int32_t* upper = source_row(upper_row, lower_row);
+                const int32_t* lower = source_row(lower_row, upper_row);
+                const int32_t* upper_planes[3] = {upper, upper + scaled_width, upper + 2 * scaled_width};
+                const int32_t* lower_planes[3] = {lower, lower + scaled_width, lower + 2 * scaled_width};
+
+                T* out[3];
+                for (int p = 0; p < 3; p++)
+                {
+                    T* line = planes[p] + (pad_y + y) * model_width;
+                    std::fill_n(line, pad_x, pad_value[p]);
+                    std::fill_n(line + pad_x + scaled_width, right_pad, pad_value[p]);
+                    out[p] = line + pad_x;
+                }
+                blend_rows(level, upper_planes, lower_planes, workspace.y_weights[y], scaled_width, norm, out);
+            }
+            return letterbox;
+        }
+    }
+
+    LetterboxInfo preprocess_image(const ImageView& image, const PreprocessConfig& config, float* output,
+        PreprocessWorkspace& workspace)
+    {
+        return preprocess_into(image, config, output, workspace);
+    }
+
+    LetterboxInfo preprocess_image(const ImageView& image, const PreprocessConfig& config, void* output,
+        TensorDataType dtype, PreprocessWorkspace& workspace)
+    {
+        switch (dtype)
+        {
+            case TensorDataType::kFLOAT: return preprocess_into(image, config, static_cast<float*>(output), workspace);
+            case TensorDataType::kHALF: return preprocess_into(image, config, static_cast<uint16_t*>(output), workspace);
+            default:
+                throw std::invalid_argument(std::string("[TRT-YOLO] Images cannot be preprocessed into ")
+                    + data_type_name(dtype) + " values (float32 or float16 only)");
+        }
+    }
+
+    void convert_planar_frame(const InputFrame& frame, size_t num_elements, const PreprocessConfig& config,
+        void* output, TensorDataType dtype)
+    {
+        if (frame.format == FrameFormat::kU8Packed || frame.data == nullptr || output == nullptr)
+        {
+            throw std::invalid_argument(std::string("[TRT-YOLO] Not a planar frame (") + frame_format_name(frame.format)
+                + (frame.data == nullptr || output == nullptr ? ", null buffer)" : ")"));
+        }
+
+        switch (frame.format)
+        {
+            case FrameFormat::kF32Planar:
+            {
+                const float* values = static_cast<const float*>(frame.data);
+                if (dtype == TensorDataType::kFLOAT)
+                {
+                    std::memcpy(output, values, num_elements * sizeof(float));
+                }
+                else if (dtype == TensorDataType::kHALF)
+                {
+                    floats_to_halves(resolve_simd_level(config.simd_level), values, static_cast<uint16_t*>(output), num_elements);
+                }
+                else
+                {
+                    for (size_t i = 0; i < num_elements; i++) store_element(output, dtype, i, values[i]);
+                }
+                break;
+            }
+            case FrameFormat::kF16Planar:
+            {
+                const uint16_t* halves = static_cast<const uint16_t*>(frame.data);
+                if (dtype == TensorDataType::kHALF)
+                {
+                    std::memcpy(output, halves, num_elements * sizeof(uint16_t));
+                }
+                else if (dtype == TensorDataType::kFLOAT)
+                {
+                    halves_to_floats(resolve_simd_level(config.simd_level), halves, static_cast<float*>(output), num_elements);
+                }
+                else
+                {
+                    for (size_t i = 0; i < num_elements; i++) store_element(output, dtype, i, half_to_float(halves[i]));
+                }
+                break;
+            }
+            case FrameFormat::kU8Planar:
+            {
+                if (num_elements % 3 != 0)
+                {
+                    throw std::invalid_argument("[TRT-YOLO] An 8-bit planar frame needs 3 planes, got "
+                        + std::to_string(num_elements) + " values");
+                }
+                // 256 possible values per plane: normalize through a table, with preprocess_image()'s arithmetic.
+                ChannelNorm norm[3];
+                make_channel_norms(config, norm);
+                float table[3][256];
+                uint16_t half_table[3][256];
+                for (int p = 0; p < 3; p++)
+                {
+                    for (int v = 0; v < 256; v++)
+                    {
+                        table[p][v] = (static_cast<float>(v) * kValueOne - norm[p].offset) * norm[p].gain;
+                        half_table[p][v] = float_to_half(table[p][v]);
+                    }
+                }
+                const uint8_t* pixels = static_cast<const uint8_t*>(frame.data);
+                const size_t plane_size = num_elements / 3;
+                for (int p = 0; p < 3; p++)
+                {
+                    const uint8_t* plane = pixels + p * plane_size;
+                    const size_t base = p * plane_size;
+                    if (dtype == TensorDataType::kFLOAT)
+                    {
+                        float* values = static_cast<float*>(output) + base;
+                        for (size_t i = 0; i < plane_size; i++) values[i] = table[p][plane[i]];
+                    }
+                    else if (dtype == TensorDataType::kHALF)
+                    {
+                        uint16_t* halves = static_cast<uint16_t*>(output) + base;
+                        for (size_t i = 0; i < plane_size; i++) halves[i] = half_table[p][plane[i]];
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < plane_size; i++) store_element(output, dtype, base + i, table[p][plane[i]]);
+                    }
+                }
+                break;
+            }
+            case FrameFormat::kU8Packed:
+                break;
+        }
+    }
+
+} // namespace TRT::YOLO
@@ -0,0 +1,76 @@
+
+#include "include/TRT_YOLO_simd.hpp"
+
+namespace TRT::YOLO
+{
+
+    namespace
+    {
+        SimdLevel probe_simd_level() noexcept
+        {
+#if defined(__aarch64__) || defined(TRT_YOLO_EMULATE_NEON)
+            return SimdLevel::kNEON; // Advanced SIMD is mandatory on AArch64
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            // The x86 levels' half conversions use F16C (every AVX2 CPU has it; checked all the same).
+            const bool f16c = __builtin_cpu_supports("f16c");
+            if (__builtin_cpu_supports("avx512f") && f16c)
+            {
+                return SimdLevel::kAVX512;
+            }
+            if (__builtin_cpu_supports("avx2") && f16c)
+            {
+                return SimdLevel::kAVX2;
+            }
+#endif
+            return SimdLevel::kScalar;
+        }
+    }
+
+    SimdLevel detect_simd_level() noexcept
+    {
+        static const SimdLevel level = probe_simd_level();
+        return level;
+    }
+
+    bool simd_level_supported(SimdLevel level) noexcept
+    {
+        const SimdLevel best = detect_simd_level();
+        switch (level)
+        {
+            case SimdLevel::kAuto:
+            case SimdLevel::kScalar: return true;
+            case SimdLevel::kNEON: return best == SimdLevel::kNEON;
+            case SimdLevel::kAVX2: return best == SimdLevel::kAVX2 || best == SimdLevel::kAVX512;
+            case SimdLevel::kAVX512: return best == SimdLevel::kAVX512;
+        }
+        return false;
+    }
+
+    SimdLevel resolve_simd_level(SimdLevel level) noexcept
+    {
+        if (level == SimdLevel::kAuto)
+        {
+            return detect_simd_level();
+        }
+        if (level == SimdLevel::kAVX512 && !simd_level_supported(level))
+        {
+            level = SimdLevel::kAVX2;
+        }
+        return simd_level_supported(level) ? level : SimdLevel::kScalar;
+    }
+
+    const char* simd_level_name(SimdLevel level) noexcept
+    {
+        switch (level)
+        {
+            case SimdLevel::kAuto: return "auto";
+            case SimdLevel::kScalar: return "scalar";
+            case SimdLevel::kNEON: return "neon";
+            case SimdLevel::kAVX2: return "avx2";
+            case SimdLevel::kAVX512: return "avx512";
+        }
+        return "?";
+    }
+
+} // namespace TRT::YOLO
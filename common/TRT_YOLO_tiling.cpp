@@ -0,0 +1,283 @@
+#include "include/TRT_YOLO_tiling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+namespace TRT::YOLO
+{
+
+    namespace
+    {
+        /// @brief Largest TilingConfig::overlap: beyond it, tiles would mostly repeat each other.
+        constexpr float MAX_TILE_OVERLAP = 0.9f;
+
+        /// @brief Get the number of tiles along an axis: the fewest whose even spread keeps neighbours
+        /// overlapping by at least overlap of the tile.
+        int axis_tiles(int frame, int tile, float overlap) noexcept
+        {
+            if (frame <= tile)
+            {
+                return 1;
+            }
+            const int step = std::max(tile - static_cast<int>(std::ceil(overlap * tile)), 1);
+            return 1 + (frame - tile + step - 1) / step;
+        }
+
+        /// @brief Places tile i of count along an axis: origins spread evenly from 0 to frame - tile, the last
+        /// tile reaching the frame edge.
+        void place_tile(int frame, int tile, int count, int i, bool even_origins, int& origin, int& size) noexcept
+        {
+            if (count == 1)
+            {
+                origin = 0;
+                size = std::min(frame, tile);
+                return;
+            }
+            origin = static_cast<int>(std::lround(static_cast<double>(i) * (frame - tile) / (count - 1)));
+            if (even_origins)
+            {
+                origin &= ~1;
+            }
+            size = i == count - 1 ? frame - origin : tile;
+        }
+    }
+
+    void plan_tiles(int frame_width, int frame_height, int tile_width, int tile_height, float overlap,
+        bool even_origins, std::vector<TileRect>& tiles)
+    {
+        if (frame_width <= 0 || frame_height <= 0 || tile_width <= 0 || tile_height <= 0)
+        {
+            throw std::invalid_argument("frame and tile sizes must be positive");
+        }
+        if (!(overlap >= 0.0f && overlap <= MAX_TILE_OVERLAP))
+        {
+            throw std::invalid_argument("tile overlap must be in [0, 0.9]");
+        }
+
+        tiles.clear();
+        const int columns = axis_tiles(frame_width, tile_width, overlap);
+        const int rows = axis_tiles(frame_height, tile_height, overlap);
+        for (int row = 0; row < rows; row++)
+        {
+            TileRect tile;
+            place_tile(frame_height, tile_height, rows, row, even_origins, tile.y, tile.height);
+            for (int column = 0; column < columns; column++)
+            {
+                place_tile(frame_width, tile_width, columns, column, even_origins, tile.x, tile.width);
+                tiles.push_back(tile);
+            }
+        }
+    }
+
+    size_t merge_tile_detections(const std::vector<TileRect>& tiles, const DetectionBatch* tile_results,
+        const DetectionBatch* full_frame, DetectionBatch& merged, const TilingConfig& config,
+        TileMergeWorkspace& workspace, SimdLevel level)
+    {
+        merged.clear();
+        const size_t num_tiles = tiles.size();
+        size_t total = full_frame != nullptr ? full_frame->size() : 0;
+        for (size_t t = 0; t < num_tiles; t++)
+        {
+            total += tile_results[t].size();
+        }
+        if (workspace.seam.capacity() < total)
+        {
+            workspace.seam.reset(total);
+            workspace.interior.reset(total);
+        }
+        workspace.seam.clear();
+        workspace.interior.clear();
+        workspace.views.clear();
+        workspace.views.reserve(total);
+
+        // The part of each tile no neighbour covers: between the edges of the tiles before and after it in
+        // its row and column (empty when they overlap it by more than half).
+        const bool skip_interior = full_frame == nullptr && config.nms.top_k == 0 && config.nms.max_candidates == 0;
+        if (skip_interior)
+        {
+            size_t columns = 1;
+            while (columns < num_tiles && tiles[columns].y == tiles[0].y)
+            {
+                columns++;
+            }
+            workspace.exclusive.resize(num_tiles);
+            for (size_t t = 0; t < num_tiles; t++)
+            {
+                const TileRect& tile = tiles[t];
+                const size_t column = t % columns;
+                const int left = column > 0 ? tiles[t - 1].x + tiles[t - 1].width : tile.x;
+                const int right = column + 1 < columns ? tiles[t + 1].x : tile.x + tile.width;
+                const int top = t >= columns ? tiles[t - columns].y + tiles[t - columns].height : tile.y;
+                const int bottom = t + columns < num_tiles ? tiles[t + columns].y : tile.y + tile.height;
+                workspace.exclusive[t] = {left, top, right - left, bottom - top};
+            }
+        }
+
+        // Move the tiles' boxes to frame pixels, setting aside those that cannot have a duplicate.
+        for (size_t t = 0; t < num_tiles; t++)
+        {
+            const DetectionBatch& detections = tile_results[t];
+            const float offset_x = static_cast<float>(tiles[t].x);
+            const float offset_y = static_cast<float>(tiles[t].y);
+            float left = 0.0f, top = 0.0f, right = -1.0f, bottom = -1.0f;
+            if (skip_interior)
+            {
+                const TileRect& exclusive = workspace.exclusive[t];
+                left = static_cast<float>(exclusive.x);
+                top = static_cast<float>(exclusive.y);
+                right = static_cast<float>(exclusive.x + exclusive.width);
+                bottom = static_cast<float>(exclusive.y + exclusive.height);
+            }
+            for (size_t i = 0; i < detections.size(); i++)
+            {
+                const float x = detections.x()[i] + offset_x;
+                const float y = detections.y()[i] + offset_y;
+                const float width = detections.width()[i];
+                const float height = detections.height()[i];
+                const bool inside = x >= left && y >= top && x + width <= right && y + height <= bottom;
+                DetectionBatch& target = inside ? workspace.interior : workspace.seam;
+                target.push_back(x, y, width, height, detections.confidence()[i], detections.class_id()[i]);
+                if (!inside)
+                {
+                    workspace.views.push_back(static_cast<int32_t>(t));
+                }
+            }
+        }
+        if (full_frame != nullptr)
+        {
+            for (size_t i = 0; i < full_frame->size(); i++)
+            {
+                workspace.seam.push_back(full_frame->x()[i], full_frame->y()[i], full_frame->width()[i],
+                    full_frame->height()[i], full_frame->confidence()[i], full_frame->class_id()[i]);
+                workspace.views.push_back(static_cast<int32_t>(num_tiles));
+            }
+        }
+
+        // Only sightings from different views merge: the boxes of one tile (or of the full frame) were already
+        // suppressed against each other by its own NMS, wherever they lie.
+        if (config.merge == TileMerge::kWeightedBoxFusion)
+        {
+            weighted_box_fusion(workspace.seam, merged, config.nms, workspace.nms, level, nullptr,
+                workspace.views.data());
+        }
+        else
+        {
+            non_max_suppression(workspace.seam, merged, config.nms, workspace.nms, level, nullptr,
+                workspace.views.data());
+        }
+        const DetectionBatch& interior = workspace.interior;
+        for (size_t i = 0; i < interior.size(); i++)
+        {
+            merged.push_back(interior.x()[i], interior.y()[i], interior.width()[i], interior.height()[i],
+                interior.confidence()[i], interior.class_id()[i]);
+        }
+        return merged.size();
+    }
+
+    TiledDetector::TiledDetector(Detector& detector, const TilingConfig& config)
+        : detector_(detector), config_(config)
+    {
+        if (this->config_.tile_width < 0 || this->config_.tile_height < 0)
+        {
+            throw std::invalid_argument("tile size must not be negative");
+        }
+        if (this->config_.tile_width == 0)
+        {
+            this->config_.tile_width = detector.get_preprocess_config().model_width;
+        }
+        if (this->config_.tile_height == 0)
+        {
+            this->config_.tile_height = detector.get_preprocess_config().model_height;
+        }
+        if (!(this->config_.overlap >= 0.0f && this->config_.overlap <= MAX_TILE_OVERLAP))
+        {
+            throw std::invalid_argument("tile overlap must be in [0, 0.9]");
+        }
+        if (!(this->config_.nms.iou_threshold > 0.0f && this->config_.nms.iou_threshold <= 1.0f))
+        {
+            throw std::invalid_argument("tile merge threshold must be in (0, 1]");
+        }
+    }
+
+    void TiledDetector::update_tiles(int frame_width, int frame_height, bool even_origins)
+    {
+        if (frame_width == this->frame_width_ && frame_height == this->frame_height_ && even_origins == this->even_origins_)
+        {
+            return;
+        }
+        plan_tiles(frame_width, frame_height, this->config_.tile_width, this->config_.tile_height,
+            this->config_.overlap, even_origins, this->tiles_);
+        this->frame_width_ = frame_width;
+        this->frame_height_ = frame_height;
+        this->even_origins_ = even_origins;
+    }
+
+    size_t TiledDetector::get_max_detections(int frame_width, int frame_height) const
+    {
+        std::vector<TileRect> tiles;
+        plan_tiles(frame_width, frame_height, this->config_.tile_width, this->config_.tile_height,
+            this->config_.overlap, false, tiles);
+        const size_t views = tiles.size() + (this->config_.include_full_frame ? 1 : 0);
+        const size_t candidates = views * this->detector_.get_max_detections();
+        return this->config_.nms.top_k > 0 ? std::min(this->config_.nms.top_k, candidates) : candidates;
+    }
+
+    int TiledDetector::identify_objects(const ImageView& frame, DetectionBatch& results_detections)
+    {
+        results_detections.clear();
+        if (!frame.is_valid())
+        {
+            std::cerr << "[TRT-YOLO] Invalid frame for tiled inference" << std::endl;
+            return -1;
+        }
+        this->update_tiles(frame.width, frame.height, is_yuv(frame.format));
+
+        // Tiles are views into the frame; the Detector letterboxes each one like a frame of its own.
+        const size_t num_tiles = this->tiles_.size();
+        const size_t num_views = num_tiles + (this->config_.include_full_frame ? 1 : 0);
+        const size_t max_detections = this->detector_.get_max_detections();
+        if (this->views_.size() < num_views)
+        {
+            this->views_.resize(num_views);
+            this->results_.resize(num_views);
+        }
+        for (size_t v = 0; v < num_views; v++)
+        {
+            if (this->results_[v].capacity() != max_detections)
+            {
+                this->results_[v].reset(max_detections);
+            }
+            if (v < num_tiles)
+            {
+                const TileRect& tile = this->tiles_[v];
+                this->views_[v] = frame.crop(tile.x, tile.y, tile.width, tile.height);
+            }
+            else
+            {
+                this->views_[v] = frame;
+            }
+        }
+
+        const size_t chunk = this->config_.batch_size > 0 ? this->config_.batch_size : num_views;
+        for (size_t first = 0; first < num_views; first += chunk)
+        {
+            const size_t count = std::min(chunk, num_views - first);
+            if (this->detector_.identify_objects(&this->views_[first], count, &this->results_[first]) < 0)
+            {
+                return -1;
+            }
+        }
+
+        const DetectionBatch* full_frame = this->config_.include_full_frame ? &this->results_[num_tiles] : nullptr;
+        this->num_candidates_ = full_frame != nullptr ? full_frame->size() : 0;
+        for (size_t t = 0; t < num_tiles; t++)
+        {
+            this->num_candidates_ += this->results_[t].size();
+        }
+        return static_cast<int>(merge_tile_detections(this->tiles_, this->results_.data(), full_frame, results_detections,
+            this->config_, this->merge_workspace_, this->detector_.get_config().simd_level));
+    }
+
+}
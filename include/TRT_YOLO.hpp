@@ -0,0 +1,456 @@
+#pragma once
+
+#include "TensorRT_CPP/TRT_inference_backend.hpp"
+#include "TensorRT_CPP/TRT_thread_pool.hpp"
+#include "include/TRT_YOLO_defs.hpp"
+#include "include/TRT_YOLO_detections.hpp"
+#include "include/TRT_YOLO_letterbox.hpp"
+#include "include/TRT_YOLO_model_descriptor.hpp"
+#include "include/TRT_YOLO_nms.hpp"
+#include "include/TRT_YOLO_postprocess.hpp"
+#include "include/TRT_YOLO_preprocess.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace TRT::YOLO
+{
+
+    /// @brief Settings of a Detector.
+    struct DetectorConfig
+    {
+        /// @brief Detections scoring below this are dropped (the default of the per-class thresholds).
+        float confidence_threshold = CONFIDENCE_SCORE_THRESHOLD;
+
+        /// @brief Optional per-class threshold file (see ClassThresholds::parse()), read at load time.
+        std::string class_thresholds_path;
+
+        /// @brief Kernel level of the host-side post-processing (kAuto picks the best the CPU supports).
+        SimdLevel simd_level = SimdLevel::kAuto;
+
+        /// @brief Run non_max_suppression() on the host after the confidence filter, for engines exported
+        /// without an NMS plugin or whose embedded NMS needs tuning. Raw-head models always run it.
+        bool cpu_nms = false;
+
+        /// @brief Settings of the host NMS (used when cpu_nms is set).
+        NmsConfig nms;
+
+        /// @brief Use the compile-time post-processing of a matching ModelSpec (see find_specialized_postprocess())
+        /// when there is one; otherwise, and when unset, the generic one.
+        bool specialized_postprocess = true;
+
+        /// @brief Execution contexts of a TensorRT engine loaded from a path (concurrent inferences).
+        int num_contexts = 2;
+
+        /// @brief Worker threads of the multi-frame identify_objects(), started on its first call
+        /// (-1: one per hardware thread, minus one; 0: every frame runs on the calling thread).
+        int batch_threads = -1;
+
+        /// @brief Copy back only the first num_dets rows of bboxes / scores / labels (see set_counted_outputs()).
+        bool valid_rows_only = true;
+
+        /// @brief Model descriptor file (see ModelDescriptor), read at load time: its [postprocess] keys override
+        /// the fields above, and the rest is validated against the engine. If empty, a model loaded from a path
+        /// uses the descriptor next to it when there is one (see ModelDescriptor::find_for_model()).
+        std::string model_descriptor_path;
+    };
+
+    /// @brief Throughput of Detector::identify_objects() calls running a given number of frames.
+    struct ThroughputStats
+    {
+        size_t frames_per_call = 0;
+        uint64_t calls = 0;
+        uint64_t frames = 0;
+        double total_ms = 0.0; // Summed call durations
+
+        /// @brief Get the frames per second seen by one caller (frames over summed call time)
+        double frames_per_second() const noexcept
+        {
+            return this->total_ms > 0.0 ? this->frames * 1000.0 / this->total_ms : 0.0;
+        }
+    };
+
+    /// @brief Input traffic of Detector::identify_objects() in one FrameFormat.
+    struct InputStats
+    {
+        FrameFormat format = FrameFormat::kF32Planar;
+        uint64_t frames = 0;
+        uint64_t bytes = 0; // Summed frame_bytes() of the frames received
+
+        /// @brief Get the average bytes moved per frame
+        double bytes_per_frame() const noexcept
+        {
+            return this->frames > 0 ? static_cast<double>(this->bytes) / this->frames : 0.0;
+        }
+    };
+
+    /// @brief YOLO detector, for NMS-embedded exports (num_dets / bboxes / scores / labels outputs) and for raw
+    /// YOLOv8 / YOLO11 heads (a single [1, 4 + classes, anchors] output, decoded and suppressed on the host).
+    /// Owns its inference backend, its staging buffers and its configuration, so several detectors
+    /// (models) can live in one process. identify_objects() is thread-safe: each call leases its own set of
+    /// staging buffers (created on first use, then reused), and the backend runs up to its number of
+    /// execution contexts concurrently. Engines with a batch dimension (input [N, 3, H, W]) run up to N frames
+    /// per inference; every output must then be batched too.
+    class Detector
+    {
+    public:
+        /// @brief Loads a model: a TensorRT .engine file, or a CPU stand-in descriptor (.cpudesc, see CpuInferenceBackend),
+        /// with its model descriptor (see DetectorConfig::model_descriptor_path).
+        /// @throws std::runtime_error if the model cannot be loaded, does not have the expected I/O, or does not
+        /// match its model descriptor.
+        explicit Detector(const std::string& path_to_model, const DetectorConfig& config = DetectorConfig());
+
+        /// @brief Uses an already constructed inference backend.
+        /// @throws std::runtime_error if backend is null, does not have the expected I/O, or does not match
+        /// the model descriptor.
+        explicit Detector(std::unique_ptr<InferenceBackend> backend, const DetectorConfig& config = DetectorConfig());
+
+        /// @brief Returns every staging buffer to the backend's host pool.
+        /// No identify_objects() call may be running.
+        ~Detector();
+
+        Detector(const Detector&) = delete;
+        Detector& operator=(const Detector&) = delete;
+
+        /// @brief Performs inference on the input buffer and stores detection results.
+        /// Thread-safe.
+        /// @param input_img Input image data (must match model input dimensions)
+        /// @param results_detections Output vector for detection results
+        /// @param letterbox How the source frame was letterboxed into input_img. If not nullptr, boxes are
+        /// reported in source-image pixels, clipped to the frame; otherwise in model space.
+        /// @return Number of detections (-1 on failure)
+        int identify_objects(const std::vector<float> &input_img, std::vector<detected_object_info_t> &results_detections,
+            const LetterboxInfo* letterbox = nullptr);
+
+        /// @brief Allocation-free variant of identify_objects().
+        /// float32 models without a fixed batch above 1 read input_img in place (no staging copy); for the fastest
+        /// host-to-device copy, place frames in buffers from get_backend().get_host_buffer_pool().
+        /// Thread-safe; in steady state a call performs no heap allocation.
+        /// @param input_img Input image data (num_elements values, must match the model input)
+        /// @param num_elements Number of values in input_img
+        /// @param results_detections Caller-owned results; cleared first. Detections beyond its capacity are
+        /// dropped (see DetectionBatch::dropped()) - get_max_detections() is always enough.
+        /// @param letterbox If not nullptr, boxes are reported in source-image pixels (see above)
+        /// @return Number of detections stored (-1 on failure)
+        int identify_objects(const float* input_img, size_t num_elements, DetectionBatch &results_detections,
+            const LetterboxInfo* letterbox = nullptr);
+
+        /// @brief Runs num_frames frames in one call; the detections of frame i go to results_detections[i].
+        /// A batched engine runs chunks of get_max_batch() frames per inference; otherwise every frame is an
+        /// inference of its own. Inferences are pipelined over the execution contexts (up to
+        /// get_backend().get_num_async_slots() in flight) while the frames of finished ones are post-processed
+        /// in parallel on the batch thread pool (see DetectorConfig::batch_threads). get_throughput_stats() reports frames/s by frames per call.
+        /// Thread-safe; in steady state a call performs no heap allocation of its own (a dynamic-batch engine
+        /// still reports its output shapes per inference).
+        /// @param input_imgs num_frames frames of num_elements values each (one frame of the model input)
+        /// @param results_detections num_frames caller-owned results, each cleared first
+        /// @param letterboxes num_frames entries (letterboxes[i] applies to frame i), or nullptr
+        /// @return Total number of detections stored (-1 if any frame failed; its results are left empty)
+        int identify_objects(const float* const* input_imgs, size_t num_frames, size_t num_elements,
+            DetectionBatch* results_detections, const LetterboxInfo* letterboxes = nullptr);
+
+        /// @brief Multi-frame variant of the std::vector overload (see above). Every frame must have the same size.
+        int identify_objects(const std::vector<std::vector<float>> &input_imgs,
+            std::vector<std::vector<detected_object_info_t>> &results_detections,
+            const LetterboxInfo* letterboxes = nullptr);
+
+        /// @brief Runs an 8-bit RGB, BGR or YUV frame of any size: preprocess_image() letterboxes, converts, normalizes
+        /// and transposes it straight into the input staging buffer (see get_preprocess_config()), as float32 or IEEE half
+        /// per the input's type, and boxes are reported in source-image pixels. The model input must be [N, 3, H, W].
+        /// Thread-safe; in steady state a call performs no heap allocation.
+        /// @param results_detections Caller-owned results; cleared first (see above)
+        /// @return Number of detections stored (-1 on failure)
+        int identify_objects(const ImageView& image, DetectionBatch &results_detections);
+
+        /// @brief std::vector variant of the image overload.
+        int identify_objects(const ImageView& image, std::vector<detected_object_info_t> &results_detections);
+
+        /// @brief Multi-frame variant of the image overload, batched and pipelined like the float one (see above).
+        /// Frames may differ in size and format; each chunk is preprocessed in parallel on the batch thread pool.
+        /// @return Total number of detections stored (-1 if any frame failed; its results are left empty)
+        int identify_objects(const ImageView* images, size_t num_frames, DetectionBatch* results_detections);
+
+        /// @brief Runs a frame in the format the caller chose (see InputFrame): planar frames are converted to the
+        /// engine's input data type by convert_planar_frame() (kF32Planar into a float32 input and kF16Planar into
+        /// a float16 one are read in place when the engine runs single frames), packed images are preprocessed
+        /// (see above). get_input_stats() reports the bytes each format moved.
+        /// Thread-safe; in steady state a call performs no heap allocation.
+        /// @return Number of detections stored (-1 on failure)
+        int identify_objects(const InputFrame& frame, DetectionBatch &results_detections);
+
+        /// @brief Multi-frame variant of the InputFrame overload, batched and pipelined like the float one (see
+        /// above). The frames may use different formats.
+        /// @return Total number of detections stored (-1 if any frame failed; its results are left empty)
+        int identify_objects(const InputFrame* frames, size_t num_frames, DetectionBatch* results_detections);
+
+        /// @brief Get the maximum number of detections the model reports per frame
+        size_t get_max_detections() const noexcept { return this->max_detections_; }
+
+        /// @brief Get the number of frames one inference runs at most (the engine's batch; 1 if it has none)
+        size_t get_max_batch() const noexcept { return this->max_batch_; }
+
+        /// @brief Get the number of input values of one frame
+        size_t get_frame_elements() const noexcept { return this->frame_elements_; }
+
+        /// @brief Get the throughput of identify_objects() so far, one entry per number of frames per call seen
+        std::vector<ThroughputStats> get_throughput_stats() const;
+
+        /// @brief Get the frames and bytes identify_objects() received so far, one entry per FrameFormat seen
+        /// (the float overloads count as kF32Planar, the image ones as kU8Packed)
+        std::vector<InputStats> get_input_stats() const;
+
+        /// @brief TRUE if the model outputs a raw YOLOv8 / YOLO11 head (see decode_raw_head())
+        bool is_raw_head() const noexcept { return this->raw_head_; }
+
+        /// @brief Get the output geometry and data types, as read from the model
+        const RuntimeModelSpec& get_output_spec() const noexcept { return this->output_spec_; }
+
+        /// @brief TRUE if post-processing runs a compile-time instantiation for the model's spec
+        bool is_postprocess_specialized() const noexcept { return this->specialized_postprocess_ != nullptr; }
+
+        /// @brief Get the inference backend
+        InferenceBackend& get_backend() const noexcept { return *this->engine_; }
+
+        /// @brief Get the configuration, with the model descriptor's overrides applied
+        const DetectorConfig& get_config() const noexcept { return this->config_; }
+
+        /// @brief Get the model descriptor (its path is empty if the model has none)
+        const ModelDescriptor& get_descriptor() const noexcept { return this->descriptor_; }
+
+        /// @brief Get the settings the image overloads preprocess with: the model's input size, the model
+        /// descriptor's [input] channel order and normalization, and the configured SIMD level
+        const PreprocessConfig& get_preprocess_config() const noexcept { return this->preprocess_config_; }
+
+        /// @brief Replaces the per-class confidence thresholds. Thread-safe: calls already running finish
+        /// with the previous table, later calls use the new one.
+        void set_class_thresholds(ClassThresholds thresholds);
+
+        /// @brief Get the per-class confidence thresholds currently applied
+        std::shared_ptr<const ClassThresholds> get_class_thresholds() const;
+
+        /// @brief Get the number of staging buffer sets created so far (the peak number of concurrent calls)
+        size_t get_num_staging_sets() const;
+
+    private:
+
+        /// @brief Post-processing scratch of one frame of a batch.
+        struct FrameScratch
+        {
+            DetectionBatch detections;      // Results of the std::vector overload, before they are copied out
+            DetectionBatch candidates;      // Filtered detections entering the host NMS (cpu_nms or raw head only)
+            NmsWorkspace nms_workspace;
+            std::vector<float> raw_head;    // float32 copy of a raw head that is not float32 (else empty)
+            PreprocessWorkspace preprocess;
+            std::vector<float> image;       // Preprocessed image, for an input neither float32 nor float16 (grown on first use)
+        };
+
+        /// @brief Frames of one call: float32 model input tensors (with optional letterboxes), images to
+        /// preprocess, or InputFrames (see frame_at()).
+        struct FrameSource
+        {
+            const float* const* tensors = nullptr;
+            size_t num_elements = 0;
+            const LetterboxInfo* letterboxes = nullptr;
+            const ImageView* images = nullptr;
+            const InputFrame* frames = nullptr;
+        };
+
+        /// @brief Host buffers for one in-flight inference (one frame, or one chunk of a batch).
+        struct StagingSet
+        {
+            std::vector<void*> inputs;      // Staging buffers, for inputs that are not float32, are batched or take
+                                            // converted frames (else nullptr)
+            std::vector<void*> outputs;
+            std::vector<void*> call_inputs; // Input pointers handed to the backend for the current call
+            std::vector<size_t> call_input_sizes;
+            std::vector<TensorShape> input_shapes;  // Per-call shapes of a dynamic-batch engine
+            std::vector<TensorShape> output_shapes;
+            std::vector<FrameScratch> frames;       // One per frame of a batch
+            std::vector<InferTicket> tickets;       // In-flight chunks of a multi-frame call (ring, one per async slot)
+            std::vector<void*> chunk_inputs;        // Staging buffer of input 0 per ring slot, as an in-flight chunk's
+                                                    // input stays in use until collected ([0]: inputs[0] is used;
+                                                    // others are acquired on first use)
+        };
+
+        std::unique_ptr<InferenceBackend> engine_;
+        DetectorConfig config_;
+        ModelDescriptor descriptor_;
+
+        std::vector<size_t> input_sizes_;
+        std::vector<size_t> output_sizes_;
+        size_t max_detections_ = 0;
+        size_t max_candidates_ = 0; // Rows the filter or decoder can pass to the host NMS
+
+        // Frames per inference: the batch dimension of the input, dynamic between min_batch_ and max_batch_
+        // (buffers are sized for max_batch_). Each output holds max_batch_ slices of output_frame_bytes_.
+        size_t max_batch_ = 1;
+        size_t min_batch_ = 1;
+        bool batch_dynamic_ = false;
+        size_t frame_elements_ = 0;
+        size_t frame_input_bytes_ = 0;
+        std::vector<size_t> output_frame_bytes_;
+
+        // Image overloads: how frames are letterboxed into the input (if it is [N, 3, H, W]).
+        bool image_input_ = false;
+        PreprocessConfig preprocess_config_;
+
+        // Raw-head models: [1, 4 + raw_head_classes_, raw_head_anchors_] single output.
+        bool raw_head_ = false;
+        size_t raw_head_classes_ = 0;
+        size_t raw_head_anchors_ = 0;
+
+        RuntimeModelSpec output_spec_;
+        PostprocessFunction specialized_postprocess_ = nullptr; // nullptr: generic postprocess_outputs()
+
+        // Swapped with std::atomic_store by set_class_thresholds(), read with std::atomic_load.
+        std::shared_ptr<const ClassThresholds> thresholds_;
+
+        // Positions of each output within the output vectors, resolved by tensor name at load time.
+        int output_index_num_dets_ = OUTPUT_INDEX_NUM_DETS;
+        int output_index_bboxes_ = OUTPUT_INDEX_BBOXES;
+        int output_index_scores_ = OUTPUT_INDEX_SCORES;
+        int output_index_labels_ = OUTPUT_INDEX_LABELS;
+
+        // Staging sets not leased by a running call, and every set ever created.
+        mutable std::mutex staging_mutex_;
+        std::vector<StagingSet*> free_staging_;
+        std::vector<std::unique_ptr<StagingSet>> all_staging_;
+
+        // Runs the frames of multi-frame calls (created by the first one).
+        std::once_flag batch_pool_once_;
+        std::unique_ptr<ThreadPool> batch_pool_;
+
+        // Throughput by frames per call (entry i: i + 1 frames), and input traffic by FrameFormat.
+        mutable std::mutex stats_mutex_;
+        std::vector<ThroughputStats> throughput_;
+        InputStats input_stats_[NUM_FRAME_FORMATS];
+
+        /// @brief Validates the backend's I/O and resolves the output indices.
+        /// @throws std::runtime_error on an unexpected model.
+        void initialize();
+
+        /// @brief Reads the model descriptor, if any, and applies its post-processing settings to config_.
+        void load_descriptor();
+
+        /// @brief Checks the model descriptor against the engine's bindings.
+        /// @throws std::runtime_error on a mismatch.
+        void validate_descriptor() const;
+
+        /// @brief Resolves the output indices of an NMS-embedded model and enables valid-rows-only copies.
+        void resolve_nms_outputs();
+
+        /// @brief Looks an output up by name, falling back to its positional index.
+        /// @param required Throw std::runtime_error instead of falling back (names set by a descriptor)
+        int resolve_output_index(const std::string& name, int fallback_index, bool required) const;
+
+        /// @brief Takes a free staging set, creating one if every set is in use.
+        /// @return The set, or nullptr if its buffers could not be allocated.
+        StagingSet* acquire_staging();
+
+        /// @brief Returns a set taken by acquire_staging().
+        void release_staging(StagingSet* set);
+
+        /// @brief Get the thread pool of multi-frame calls, starting it on first use.
+        ThreadPool& get_batch_pool();
+
+        /// @brief Runs one frame through the backend using the buffers of set.
+        /// @return Number of detections stored (-1 on failure)
+        int run(const FrameSource& source, StagingSet& set, DetectionBatch &results_detections);
+
+        /// @brief Runs num_frames frames in chunks of max_batch_, pipelined over the execution contexts
+        /// (the multi-frame identify_objects()).
+        /// @return Total number of detections stored (-1 on failure)
+        int run_frames(const FrameSource& source, size_t num_frames, DetectionBatch* results_detections);
+
+        /// @brief Checks frames and letterboxes against the model.
+        /// @return TRUE if valid, else FALSE. (An error message will print.)
+        bool check_frames(const FrameSource& source, size_t num_frames) const;
+
+        /// @brief Get frame f of source as an InputFrame (a tensor is kF32Planar, an image kU8Packed).
+        static InputFrame frame_at(const FrameSource& source, size_t frame) noexcept;
+
+        /// @brief Get the letterbox of a frame: the one passed with a planar frame (or nullptr), or what
+        /// preprocess_image() applies to an image (in storage).
+        const LetterboxInfo* frame_letterbox(const FrameSource& source, size_t frame, LetterboxInfo& storage) const;
+
+        /// @brief Points set.call_inputs at frames [first, first + num_frames) (up to max_batch_), gathering (and
+        /// converting) them into the set's staging buffer unless a single float32 frame can be read in place.
+        /// Images are preprocessed into it.
+        /// @param slot Ring slot of the chunk (see StagingSet::chunk_inputs); 0 outside multi-frame calls
+        /// @return FALSE if the staging buffer of an image could not be allocated
+        bool stage_inputs(const FrameSource& source, size_t first, size_t num_frames, StagingSet& set, size_t slot = 0);
+
+        /// @brief Runs the staged frames to completion (at their own batch if it is dynamic).
+        /// @return TRUE if inference succeeded.
+        bool infer(StagingSet& set, size_t num_frames);
+
+        /// @brief Post-processes the first num_frames frames of the outputs in set.
+        /// @param parallel Post-process the frames on the batch thread pool
+        /// @return Number of detections stored (-1 on failure)
+        int postprocess_frames(StagingSet& set, size_t num_frames, DetectionBatch* results_detections,
+            const FrameSource& source, size_t first, bool parallel);
+
+        /// @brief Converts the outputs of one frame in set into detections (filter, then host NMS if configured).
+        /// The last stage back-projects the boxes if letterbox is not nullptr.
+        /// @return Number of detections stored (-1 on failure)
+        int postprocess(const StagingSet& set, size_t frame, FrameScratch& scratch, DetectionBatch &results_detections,
+            const LetterboxInfo* letterbox) const;
+
+        /// @brief Reads (or decodes) the outputs of one frame in set and keeps the rows passing their class threshold.
+        /// @return Number of detections stored (-1 on failure)
+        int filter_outputs(const StagingSet& set, size_t frame, FrameScratch& scratch,
+            DetectionBatch &results_detections, const LetterboxInfo* letterbox) const;
+
+        /// @brief Adds one identify_objects() call that started at start to the throughput and input statistics.
+        void record_throughput(const FrameSource& source, size_t num_frames, std::chrono::steady_clock::time_point start);
+    };
+
+    // --- Single-model interface, kept for existing callers. It wraps one process-wide Detector. ---
+
+    /// @brief Initializes the detection model using an already constructed inference backend
+    /// (e.g. a CpuInferenceBackend on machines without a GPU).
+    /// @return 0 on success.
+    int load_model(std::unique_ptr<InferenceBackend> backend);
+
+    /// @brief Initializes the detection model by loading it into CPU or GPU memory (implementation-defined)
+    /// @param path_to_model Path to the model, either a TensorRT .engine file or a CPU stand-in
+    /// descriptor (.cpudesc, see CpuInferenceBackend).
+    /// @return 0 on success.
+    int load_model(std::string &path_to_model);
+
+    /// @brief Performs inference with the model loaded by load_model().
+    /// @return Number of detections (-1 on failure)
+    int identify_objects(const std::vector<float> &input_img, std::vector<detected_object_info_t> &results_detections,
+        const LetterboxInfo* letterbox = nullptr);
+
+    /// @brief Allocation-free inference with the model loaded by load_model() (see Detector::identify_objects()).
+    /// @return Number of detections stored (-1 on failure)
+    int identify_objects(const float* input_img, size_t num_elements, DetectionBatch &results_detections,
+        const LetterboxInfo* letterbox = nullptr);
+
+    /// @brief Multi-frame inference with the model loaded by load_model() (see Detector::identify_objects()).
+    /// @return Total number of detections stored (-1 on failure)
+    int identify_objects(const float* const* input_imgs, size_t num_frames, size_t num_elements,
+        DetectionBatch* results_detections, const LetterboxInfo* letterboxes = nullptr);
+
+    /// @brief Image inference with the model loaded by load_model() (see Detector::identify_objects()).
+    /// @return Number of detections stored (-1 on failure)
+    int identify_objects(const ImageView& image, DetectionBatch &results_detections);
+
+    /// @brief Inference on a frame in any FrameFormat with the model loaded by load_model()
+    /// (see Detector::identify_objects()).
+    /// @return Number of detections stored (-1 on failure)
+    int identify_objects(const InputFrame& frame, DetectionBatch &results_detections);
+
+    /// @brief Get the capacity a DetectionBatch needs for the model loaded by load_model() (0 if none)
+    size_t get_max_detections();
+
+    /// @brief Unloads Cuda/Tensor RT resources prior to exit.
+    /// Could also in principle be used to re-initialize the engine for a new model.
+    void unload_model();
+
+} // namespace TRT::YOLO
@@ -19,7 +19,19 @@ namespace TRT::YOLO
     constexpr int OUTPUT_INDEX_SCORES = 2;
     constexpr int OUTPUT_INDEX_LABELS = 3;
 
-    constexpr int CONFIDENCE_SCORE_THRESHOLD = 0.25f;
+    // Output tensor names of an NMS-embedded export. Outputs are looked up by these names;
+    // the OUTPUT_INDEX_* order above is only a fallback for engines with other names.
+    constexpr const char* OUTPUT_NAME_NUM_DETS = "num_dets";
+    constexpr const char* OUTPUT_NAME_BBOXES = "bboxes";
+    constexpr const char* OUTPUT_NAME_SCORES = "scores";
+    constexpr const char* OUTPUT_NAME_LABELS = "labels";
+
+    // A raw (NMS-free) YOLOv8 / YOLO11 export has a single output, [1, 4 + classes, anchors] channel-major:
+    // rows cx, cy, w, h, then one score row per class (e.g. [1, 84, 8400] at 640 x 640 with 80 classes).
+    constexpr int RAW_HEAD_NUM_OUTPUTS = 1;
+    constexpr int RAW_HEAD_BOX_ROWS = 4;
+
+    constexpr float CONFIDENCE_SCORE_THRESHOLD = 0.25f;
 
     /// @brief A bounding box, consisting of a rectangle x, y, and height.
     typedef struct bounding_box
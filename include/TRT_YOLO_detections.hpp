@@ -0,0 +1,263 @@
+#pragma once
+
+#include "include/TRT_YOLO_defs.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace TRT::YOLO
+{
+
+    /// @brief Alignment (bytes) of every DetectionBatch array - one cache line, enough for AVX-512 loads.
+    constexpr size_t DETECTION_ALIGNMENT = 64;
+
+    /// @brief Number of elements each DetectionBatch array is padded to a multiple of.
+    constexpr size_t DETECTION_PADDING = DETECTION_ALIGNMENT / sizeof(float);
+
+    class DetectionBatch;
+
+    /// @brief Read-only view of one detection of a DetectionBatch (no copy until converted).
+    class DetectionRef
+    {
+    public:
+        DetectionRef(const DetectionBatch* batch, size_t index) noexcept : batch_(batch), index_(index) {}
+
+        inline float x() const noexcept;
+        inline float y() const noexcept;
+        inline float width() const noexcept;
+        inline float height() const noexcept;
+        inline float confidence() const noexcept;
+        inline int class_id() const noexcept;
+
+        bounding_box_t rect() const noexcept { return {this->x(), this->y(), this->width(), this->height()}; }
+
+        /// @brief Gathers the detection into the array-of-structures type used by the std::vector API.
+        detected_object_info_t to_info() const noexcept { return {this->rect(), this->class_id(), this->confidence()}; }
+        operator detected_object_info_t() const noexcept { return this->to_info(); }
+
+    private:
+        const DetectionBatch* batch_;
+        size_t index_;
+    };
+
+    /// @brief Fixed-capacity detection results stored as a structure of arrays.
+    /// Each field (x, y, width, height, confidence, class_id) is its own contiguous array, aligned to
+    /// DETECTION_ALIGNMENT and padded to a multiple of DETECTION_PADDING elements, so stages that scan one
+    /// field over all detections (zone filters, counters, trackers) can vectorize and may read or write
+    /// whole vectors up to padded_capacity(). Indexing / iterating yields DetectionRef views for code written
+    /// against detected_object_info_t.
+    /// Storage is allocated once, by the constructor or reset(); filling it never allocates.
+    /// Detections added past the capacity are dropped and counted.
+    class DetectionBatch
+    {
+    public:
+        /// @brief Random-access iterator over DetectionRef views.
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = detected_object_info_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = DetectionRef;
+
+            const_iterator(const DetectionBatch* batch, size_t index) noexcept : batch_(batch), index_(index) {}
+
+            DetectionRef operator*() const noexcept { return DetectionRef(this->batch_, this->index_); }
+            DetectionRef operator[](difference_type n) const noexcept { return DetectionRef(this->batch_, this->index_ + n); }
+
+            const_iterator& operator++() noexcept { this->index_++; return *this; }
+            const_iterator operator++(int) noexcept { const_iterator prev = *this; this->index_++; return prev; }
+            const_iterator& operator--() noexcept { this->index_--; return *this; }
+            const_iterator operator--(int) noexcept { const_iterator prev = *this; this->index_--; return prev; }
+            const_iterator& operator+=(difference_type n) noexcept { this->index_ += n; return *this; }
+            const_iterator& operator-=(difference_type n) noexcept { this->index_ -= n; return *this; }
+            const_iterator operator+(difference_type n) const noexcept { return const_iterator(this->batch_, this->index_ + n); }
+            const_iterator operator-(difference_type n) const noexcept { return const_iterator(this->batch_, this->index_ - n); }
+            difference_type operator-(const const_iterator& other) const noexcept
+            {
+                return static_cast<difference_type>(this->index_) - static_cast<difference_type>(other.index_);
+            }
+
+            bool operator==(const const_iterator& other) const noexcept { return this->index_ == other.index_; }
+            bool operator!=(const const_iterator& other) const noexcept { return this->index_ != other.index_; }
+            bool operator<(const const_iterator& other) const noexcept { return this->index_ < other.index_; }
+            bool operator>(const const_iterator& other) const noexcept { return this->index_ > other.index_; }
+            bool operator<=(const const_iterator& other) const noexcept { return this->index_ <= other.index_; }
+            bool operator>=(const const_iterator& other) const noexcept { return this->index_ >= other.index_; }
+
+        private:
+            const DetectionBatch* batch_;
+            size_t index_;
+        };
+
+        explicit DetectionBatch(size_t capacity = 0) { this->reset(capacity); }
+
+        /// @brief Takes the storage of other, which is left empty (capacity 0).
+        DetectionBatch(DetectionBatch&& other) noexcept { this->take(other); }
+
+        DetectionBatch& operator=(DetectionBatch&& other) noexcept
+        {
+            if (this != &other)
+            {
+                this->take(other);
+            }
+            return *this;
+        }
+
+        DetectionBatch(const DetectionBatch&) = delete;
+        DetectionBatch& operator=(const DetectionBatch&) = delete;
+
+        /// @brief Reallocates the storage for capacity detections (setup time only) and empties the batch.
+        /// The padding past size() is zero-filled.
+        void reset(size_t capacity)
+        {
+            const size_t padded = (capacity + DETECTION_PADDING - 1) / DETECTION_PADDING * DETECTION_PADDING;
+            this->storage_.reset();
+            if (padded > 0)
+            {
+                // One block for all six arrays; float and int32_t are the same size, so every array stays aligned.
+                static_assert(sizeof(float) == sizeof(int32_t), "DetectionBatch arrays share one stride");
+                const size_t bytes = padded * sizeof(float) * NUM_FIELDS;
+                this->storage_.reset(::operator new(bytes, std::align_val_t(DETECTION_ALIGNMENT)));
+                std::memset(this->storage_.get(), 0, bytes);
+            }
+            float* base = static_cast<float*>(this->storage_.get());
+            this->x_ = base;
+            this->y_ = base ? base + padded : nullptr;
+            this->width_ = base ? base + 2 * padded : nullptr;
+            this->height_ = base ? base + 3 * padded : nullptr;
+            this->confidence_ = base ? base + 4 * padded : nullptr;
+            this->class_id_ = base ? reinterpret_cast<int32_t*>(base + 5 * padded) : nullptr;
+            this->capacity_ = capacity;
+            this->padded_capacity_ = padded;
+            this->clear();
+        }
+
+        /// @brief Empties the batch, keeping the storage.
+        void clear() noexcept
+        {
+            this->size_ = 0;
+            this->dropped_ = 0;
+        }
+
+        /// @brief Appends a detection.
+        /// @return FALSE if the batch is full (the detection is dropped).
+        bool push_back(float x, float y, float width, float height, float confidence, int class_id) noexcept
+        {
+            if (this->size_ == this->capacity_)
+            {
+                this->dropped_++;
+                return false;
+            }
+            const size_t i = this->size_++;
+            this->x_[i] = x;
+            this->y_[i] = y;
+            this->width_[i] = width;
+            this->height_[i] = height;
+            this->confidence_[i] = confidence;
+            this->class_id_[i] = class_id;
+            return true;
+        }
+
+        bool push_back(const detected_object_info_t& detection) noexcept
+        {
+            return this->push_back(detection.rect.x, detection.rect.y, detection.rect.width, detection.rect.height,
+                detection.confidence, detection.class_id);
+        }
+
+        /// @brief Sets the number of valid detections after the arrays were written directly (clamped to capacity()).
+        void set_size(size_t size) noexcept { this->size_ = size < this->capacity_ ? size : this->capacity_; }
+
+        /// @brief Adds to the dropped() counter, for stages that write the arrays directly.
+        void add_dropped(size_t count) noexcept { this->dropped_ += count; }
+
+        size_t size() const noexcept { return this->size_; }
+        size_t capacity() const noexcept { return this->capacity_; }
+        bool empty() const noexcept { return this->size_ == 0; }
+
+        /// @brief Get the allocated length of every array (capacity() rounded up to DETECTION_PADDING)
+        size_t padded_capacity() const noexcept { return this->padded_capacity_; }
+
+        /// @brief Get the number of detections dropped since the last clear() because the batch was full
+        size_t dropped() const noexcept { return this->dropped_; }
+
+        /// @brief Field arrays, each valid for size() elements and allocated for padded_capacity().
+        float* x() noexcept { return this->x_; }
+        float* y() noexcept { return this->y_; }
+        float* width() noexcept { return this->width_; }
+        float* height() noexcept { return this->height_; }
+        float* confidence() noexcept { return this->confidence_; }
+        int32_t* class_id() noexcept { return this->class_id_; }
+        const float* x() const noexcept { return this->x_; }
+        const float* y() const noexcept { return this->y_; }
+        const float* width() const noexcept { return this->width_; }
+        const float* height() const noexcept { return this->height_; }
+        const float* confidence() const noexcept { return this->confidence_; }
+        const int32_t* class_id() const noexcept { return this->class_id_; }
+
+        DetectionRef operator[](size_t i) const noexcept { return DetectionRef(this, i); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator end() const noexcept { return const_iterator(this, this->size_); }
+
+        /// @brief Replaces the contents of out with the detections, as detected_object_info_t.
+        void copy_to(std::vector<detected_object_info_t>& out) const
+        {
+            out.resize(this->size_);
+            for (size_t i = 0; i < this->size_; i++)
+            {
+                out[i] = (*this)[i].to_info();
+            }
+        }
+
+    private:
+        static constexpr size_t NUM_FIELDS = 6;
+
+        struct AlignedDelete
+        {
+            void operator()(void* ptr) const noexcept { ::operator delete(ptr, std::align_val_t(DETECTION_ALIGNMENT)); }
+        };
+
+        /// @brief Moves the storage and state of other here, leaving other empty.
+        void take(DetectionBatch& other) noexcept
+        {
+            this->storage_ = std::move(other.storage_);
+            this->x_ = std::exchange(other.x_, nullptr);
+            this->y_ = std::exchange(other.y_, nullptr);
+            this->width_ = std::exchange(other.width_, nullptr);
+            this->height_ = std::exchange(other.height_, nullptr);
+            this->confidence_ = std::exchange(other.confidence_, nullptr);
+            this->class_id_ = std::exchange(other.class_id_, nullptr);
+            this->capacity_ = std::exchange(other.capacity_, 0);
+            this->padded_capacity_ = std::exchange(other.padded_capacity_, 0);
+            this->size_ = std::exchange(other.size_, 0);
+            this->dropped_ = std::exchange(other.dropped_, 0);
+        }
+
+        std::unique_ptr<void, AlignedDelete> storage_;
+        float* x_ = nullptr;
+        float* y_ = nullptr;
+        float* width_ = nullptr;
+        float* height_ = nullptr;
+        float* confidence_ = nullptr;
+        int32_t* class_id_ = nullptr;
+        size_t capacity_ = 0;
+        size_t padded_capacity_ = 0;
+        size_t size_ = 0;
+        size_t dropped_ = 0;
+    };
+
+    inline float DetectionRef::x() const noexcept { return this->batch_->x()[this->index_]; }
+    inline float DetectionRef::y() const noexcept { return this->batch_->y()[this->index_]; }
+    inline float DetectionRef::width() const noexcept { return this->batch_->width()[this->index_]; }
+    inline float DetectionRef::height() const noexcept { return this->batch_->height()[this->index_]; }
+    inline float DetectionRef::confidence() const noexcept { return this->batch_->confidence()[this->index_]; }
+    inline int DetectionRef::class_id() const noexcept { return this->batch_->class_id()[this->index_]; }
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "include/TRT_YOLO_defs.hpp"
+
+namespace TRT::YOLO
+{
+
+    /// @brief How a source frame was letterboxed into the model input: resized by scale (keeping its aspect
+    /// ratio) and placed at (pad_x, pad_y), the rest being padding. Post-processing uses it to report boxes in
+    /// source-image pixels.
+    struct LetterboxInfo
+    {
+        int source_width = 0;
+        int source_height = 0;
+
+        /// @brief Model pixels per source pixel
+        float scale = 1.0f;
+
+        /// @brief Model-space position of the source image's top-left corner
+        float pad_x = 0.0f;
+        float pad_y = 0.0f;
+
+        /// @brief Letterbox of a source_width x source_height frame into the model input: the largest scale that
+        /// fits, centered, with whole-pixel padding on the left / top (the smaller half when it is odd).
+        /// @throws std::invalid_argument if a size is not positive.
+        static LetterboxInfo fit(int source_width, int source_height,
+            int model_width = MODEL_INPUT_WIDTH, int model_height = MODEL_INPUT_HEIGHT);
+
+        /// @brief TRUE if the source size is set and scale is positive and finite
+        bool is_valid() const noexcept;
+
+        /// @brief Maps a model-space box to source pixels, clipped to the frame (what the post-processing
+        /// kernels apply to each box corner, see letterbox_project()).
+        bounding_box_t to_source(const bounding_box_t& box) const noexcept;
+    };
+
+    /// @brief Maps one model-space coordinate to source pixels: (value - pad) * inverse_scale, clipped to
+    /// [0, limit]. NaN maps to 0. The SIMD kernels compute exactly the same (max then min, like SSE).
+    inline float letterbox_project(float value, float pad, float inverse_scale, float limit) noexcept
+    {
+        const float projected = (value - pad) * inverse_scale;
+        const float low = projected > 0.0f ? projected : 0.0f;
+        return low < limit ? low : limit;
+    }
+
+}
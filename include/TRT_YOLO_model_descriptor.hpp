@@ -0,0 +1,113 @@
+#pragma once
+
+#include "include/TRT_YOLO_defs.hpp"
+#include "include/TRT_YOLO_model_spec.hpp"
+#include "include/TRT_YOLO_nms.hpp"
+
+#include <istream>
+#include <string>
+
+namespace TRT::YOLO
+{
+
+    /// @brief Channel order of the model input.
+    enum class InputFormat
+    {
+        kRGB,
+        kBGR
+    };
+
+    /// @brief Deployment settings of a model, read from an INI file next to the engine (see Detector), so a model
+    /// can be rolled out without rebuilding the server. Declared geometry and data types are validated against
+    /// the engine's bindings at load time; the post-processing settings override the DetectorConfig.
+    ///
+    /// File format ('#' starts a comment; every key is optional):
+    /// ```
+    /// name = yolov8n-coco
+    ///
+    /// [input]
+    /// tensor   = images          # Binding name
+    /// width    = 640
+    /// height   = 640
+    /// channels = 3
+    /// dtype    = f32             # See data_type_name()
+    /// format   = rgb             # rgb | bgr
+    /// scale    = 1/255           # normalized = (pixel * scale - mean) / std, per channel
+    /// mean     = 0, 0, 0
+    /// std      = 1, 1, 1
+    ///
+    /// [output]
+    /// layout   = raw_v8          # nms_embedded | raw_v8 | raw_v11
+    /// classes  = 80
+    /// rows     = 8400            # Max detections (nms_embedded) or anchors (raw_*)
+    /// dtype    = f16             # Head (raw_*), or bboxes and scores (nms_embedded)
+    /// num_dets = num_dets        # Output tensor names (nms_embedded)
+    /// bboxes   = bboxes
+    /// scores   = scores
+    /// labels   = labels
+    ///
+    /// [postprocess]
+    /// confidence       = 0.25
+    /// class_thresholds = yolov8n.thresholds   # Relative to the descriptor (see ClassThresholds::parse())
+    /// cpu_nms          = true
+    /// iou              = 0.45                 # In (0, 1]
+    /// top_k            = 300
+    /// max_candidates   = 30000
+    /// class_agnostic   = false
+    /// ```
+    struct ModelDescriptor
+    {
+        /// @brief File the descriptor was read from (empty if none)
+        std::string path;
+        std::string name;
+
+        // [input] - undeclared values (empty, 0 or has_* FALSE) are not validated.
+        std::string input_tensor;
+        int input_width = 0;
+        int input_height = 0;
+        int input_channels = 0;
+        bool has_input_type = false;
+        TensorDataType input_type = TensorDataType::kFLOAT;
+        InputFormat input_format = InputFormat::kRGB;
+        float input_scale = 1.0f / 255.0f;
+        float input_mean[3] = {0.0f, 0.0f, 0.0f};
+        float input_std[3] = {1.0f, 1.0f, 1.0f};
+
+        // [output] - undeclared values (0 or has_* FALSE) are not validated.
+        bool has_layout = false;
+        OutputLayout layout = OutputLayout::kEmbeddedNms;
+        size_t num_classes = 0;
+        size_t rows = 0;
+        bool has_output_type = false;
+        TensorDataType output_type = TensorDataType::kFLOAT;
+        std::string num_dets_tensor = OUTPUT_NAME_NUM_DETS;
+        std::string bboxes_tensor = OUTPUT_NAME_BBOXES;
+        std::string scores_tensor = OUTPUT_NAME_SCORES;
+        std::string labels_tensor = OUTPUT_NAME_LABELS;
+
+        // [postprocess] - keys the file leaves out keep the values the descriptor was parsed over.
+        float confidence_threshold = CONFIDENCE_SCORE_THRESHOLD;
+        std::string class_thresholds_path;
+        bool cpu_nms = false;
+        NmsConfig nms;
+
+        /// @brief Reads a descriptor file over defaults (see parse()); a relative class_thresholds path is resolved against
+        /// the descriptor's directory.
+        /// @throws std::runtime_error if the file cannot be opened or parsed.
+        static ModelDescriptor load(const std::string& path, const ModelDescriptor& defaults);
+        static ModelDescriptor load(const std::string& path);
+
+        /// @brief Parses a descriptor over defaults (a default-constructed descriptor if omitted), see the format above.
+        /// @throws std::runtime_error on a syntax error, an unknown section or key, or an invalid value.
+        static ModelDescriptor parse(std::istream& in, const ModelDescriptor& defaults);
+        static ModelDescriptor parse(std::istream& in);
+
+        /// @brief Get the descriptor path of a model: its path with the extension replaced by ".ini"
+        /// (yolov8n.engine -> yolov8n.ini), or an empty string if there is no such file.
+        static std::string find_for_model(const std::string& model_path);
+    };
+
+    /// @brief Get the descriptor name of layout ("nms_embedded", "raw_v8")
+    const char* output_layout_name(OutputLayout layout) noexcept;
+
+}
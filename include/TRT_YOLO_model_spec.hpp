@@ -0,0 +1,68 @@
+#pragma once
+
+#include "TensorRT_CPP/TRT_tensor_desc.hpp"
+
+#include <cstddef>
+
+namespace TRT::YOLO
+{
+
+    /// @brief How a model reports its detections.
+    enum class OutputLayout
+    {
+        kEmbeddedNms, // num_dets / bboxes [rows, 4] (xyxy) / scores [rows] / labels [rows]
+        kRawHead      // One [4 + classes, rows] head (cx, cy, w, h rows, then one score row per class)
+    };
+
+    /// @brief Output geometry and data types of a model, fixed at compile time. Post-processing instantiated for
+    /// a spec (see postprocess_outputs()) has constant trip counts, strides and element types.
+    /// @tparam Rows Max detections (kEmbeddedNms) or anchors (kRawHead)
+    /// @tparam Classes Number of classes (kRawHead; 0 for kEmbeddedNms, whose labels carry the class)
+    /// @tparam BoxType, ScoreType Data types of the box and score outputs (the same tensor for kRawHead)
+    template <OutputLayout Layout, size_t Rows, size_t Classes, TensorDataType BoxType, TensorDataType ScoreType,
+        TensorDataType LabelType = TensorDataType::kINT32>
+    struct ModelSpec
+    {
+        static_assert(Rows > 0, "A model spec needs at least one row");
+        static_assert(Layout != OutputLayout::kRawHead || (Classes > 0 && BoxType == ScoreType),
+            "A raw head has at least one class, and boxes and scores share its data type");
+
+        static constexpr OutputLayout layout = Layout;
+        static constexpr size_t rows = Rows;
+        static constexpr size_t num_classes = Classes;
+        static constexpr TensorDataType box_type = BoxType;
+        static constexpr TensorDataType score_type = ScoreType;
+        static constexpr TensorDataType label_type = LabelType;
+    };
+
+    /// @brief The same description, known only at run time (the generic fallback).
+    struct RuntimeModelSpec
+    {
+        OutputLayout layout = OutputLayout::kEmbeddedNms;
+        size_t rows = 0;
+        size_t num_classes = 0;
+        TensorDataType box_type = TensorDataType::kFLOAT;
+        TensorDataType score_type = TensorDataType::kFLOAT;
+        TensorDataType label_type = TensorDataType::kINT32;
+
+        /// @brief TRUE if this describes the same outputs as Spec
+        template <class Spec>
+        bool matches() const noexcept
+        {
+            return this->layout == Spec::layout && this->rows == Spec::rows && this->num_classes == Spec::num_classes
+                && this->box_type == Spec::box_type && this->score_type == Spec::score_type
+                && (this->layout == OutputLayout::kRawHead || this->label_type == Spec::label_type);
+        }
+    };
+
+    // Specs with compiled-in post-processing (instantiated in common/TRT_YOLO_postprocess.cpp; add new ones there).
+
+    /// @brief EfficientNMS export, 100 detections, float32 / float16 boxes and scores
+    using YoloNms100F32 = ModelSpec<OutputLayout::kEmbeddedNms, 100, 0, TensorDataType::kFLOAT, TensorDataType::kFLOAT>;
+    using YoloNms100F16 = ModelSpec<OutputLayout::kEmbeddedNms, 100, 0, TensorDataType::kHALF, TensorDataType::kHALF>;
+
+    /// @brief YOLOv8 / YOLO11 raw head at 640 x 640 with 80 classes ([1, 84, 8400]), float32 / float16
+    using YoloRaw8400x80F32 = ModelSpec<OutputLayout::kRawHead, 8400, 80, TensorDataType::kFLOAT, TensorDataType::kFLOAT>;
+    using YoloRaw8400x80F16 = ModelSpec<OutputLayout::kRawHead, 8400, 80, TensorDataType::kHALF, TensorDataType::kHALF>;
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "include/TRT_YOLO_detections.hpp"
+#include "include/TRT_YOLO_letterbox.hpp"
+#include "include/TRT_YOLO_simd.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace TRT::YOLO
+{
+
+    /// @brief How the overlap of two boxes is measured.
+    enum class OverlapMetric
+    {
+        kIoU, // Intersection over union
+        kIoS  // Intersection over the smaller box's area: also matches a box to a part of it (e.g. cut at a tile edge)
+    };
+
+    /// @brief Settings of non_max_suppression() and weighted_box_fusion().
+    struct NmsConfig
+    {
+        /// @brief A box is suppressed by a higher-scoring box overlapping it by more than this (see metric).
+        float iou_threshold = 0.45f;
+
+        /// @brief Overlap measure iou_threshold applies to.
+        OverlapMetric metric = OverlapMetric::kIoU;
+
+        /// @brief Maximum number of boxes kept per frame (0: no limit beyond the output capacity).
+        size_t top_k = 300;
+
+        /// @brief Only the highest-scoring candidates enter suppression (0: all of them).
+        size_t max_candidates = 30000;
+
+        /// @brief Boxes suppress each other regardless of class (by default only boxes of the same class do).
+        bool class_agnostic = false;
+    };
+
+    /// @brief Scratch memory of non_max_suppression(). It grows to the largest frame seen and is then reused,
+    /// so steady-state calls do not allocate. Not thread-safe: use one workspace per thread.
+    struct NmsWorkspace
+    {
+        /// @brief Pre-allocates room for frames of up to candidates boxes.
+        void reserve(size_t candidates);
+
+        // Sort keys and positions (with ping-pong copies for the radix passes).
+        std::vector<uint32_t> keys, keys_swap;
+        std::vector<uint32_t> order, order_swap;
+
+        // Candidate index of each rank (best first).
+        std::vector<uint32_t> ranked;
+
+        // Ranked candidates grouped by class (rank order within a class), as corners, for the IoU kernels.
+        std::vector<float> x1, y1, x2, y2, area;
+        std::vector<int32_t> class_id;
+        std::vector<int32_t> view;       // Only filled when the candidates come with views
+        std::vector<int32_t> suppressed; // 0, or 1 + the grouped position of the first box that suppressed it
+        std::vector<uint32_t> position;  // Grouped position of each rank
+        std::vector<uint32_t> group_end; // End of the class group containing each grouped position
+
+        // Grouped positions of the kept boxes, in rank order.
+        std::vector<uint32_t> selected;
+
+        // weighted_box_fusion(): confidence-weighted corner sums of each kept box's cluster (by grouped position).
+        std::vector<float> fused_weight, fused_x1, fused_y1, fused_x2, fused_y2;
+    };
+
+    /// @brief Greedy non-maximum suppression of one frame.
+    /// Candidates are ranked by confidence (ties keep their input order); NaN scores are ignored.
+    /// Each kept box suppresses every lower-ranked box of the same class (any class if class_agnostic)
+    /// overlapping it by more than iou_threshold (as measured by metric).
+    /// @param candidates Detections before suppression
+    /// @param kept Cleared first; receives the kept detections, highest confidence first. Boxes that survive
+    /// suppression but do not fit its capacity still suppress others and are counted in kept.dropped().
+    /// @param level Kernel for the IoU tests (levels the CPU lacks fall back, see resolve_simd_level()).
+    /// Every level produces identical results.
+    /// @param letterbox If not nullptr, kept boxes are stored in source-image pixels, clipped to the frame
+    /// (suppression itself runs in model space). Must be valid.
+    /// @param views If not nullptr, one view id per candidate: boxes of the same view never suppress each other
+    /// (e.g. the boxes of one tile, which that tile's own NMS already kept side by side).
+    /// @return Number of detections kept
+    size_t non_max_suppression(const DetectionBatch& candidates, DetectionBatch& kept, const NmsConfig& config,
+        NmsWorkspace& workspace, SimdLevel level = SimdLevel::kAuto, const LetterboxInfo* letterbox = nullptr,
+        const int32_t* views = nullptr);
+
+    /// @brief Weighted box fusion: the greedy pass of non_max_suppression(), but each kept box is replaced by the
+    /// confidence-weighted mean corners of its cluster (itself and the boxes it suppressed first), so duplicates
+    /// refine the box instead of being discarded. The fused box keeps the cluster's highest confidence and class.
+    /// Same parameters, ordering, capacity handling and kernels as non_max_suppression() (identical at every level).
+    /// With views, boxes of the same view never join one cluster.
+    /// @return Number of fused detections
+    size_t weighted_box_fusion(const DetectionBatch& candidates, DetectionBatch& fused, const NmsConfig& config,
+        NmsWorkspace& workspace, SimdLevel level = SimdLevel::kAuto, const LetterboxInfo* letterbox = nullptr,
+        const int32_t* views = nullptr);
+
+    /// @brief Runs non_max_suppression() on num_frames frames, candidates[i] into kept[i], sharing one workspace.
+    /// @param letterboxes num_frames entries (letterboxes[i] applies to frame i), or nullptr
+    /// @return Total number of detections kept
+    size_t non_max_suppression(const DetectionBatch* candidates, DetectionBatch* kept, size_t num_frames,
+        const NmsConfig& config, NmsWorkspace& workspace, SimdLevel level = SimdLevel::kAuto,
+        const LetterboxInfo* letterboxes = nullptr);
+
+}
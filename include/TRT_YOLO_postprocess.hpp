@@ -0,0 +1,134 @@
+#pragma once
+
+#include "include/TRT_YOLO_defs.hpp"
+#include "include/TRT_YOLO_detections.hpp"
+#include "include/TRT_YOLO_letterbox.hpp"
+#include "include/TRT_YOLO_model_spec.hpp"
+#include "include/TRT_YOLO_simd.hpp"
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace TRT::YOLO
+{
+
+    /// @brief Highest class id a ClassThresholds table accepts an entry for.
+    constexpr int MAX_THRESHOLD_CLASS_ID = 65535;
+
+    /// @brief Minimum confidence per class id. Classes without an entry (including ids that are negative
+    /// or outside the table) use the default threshold.
+    class ClassThresholds
+    {
+    public:
+        explicit ClassThresholds(float default_threshold = CONFIDENCE_SCORE_THRESHOLD);
+
+        /// @brief Sets the threshold of one class. Throws std::out_of_range outside [0, MAX_THRESHOLD_CLASS_ID].
+        void set(int class_id, float threshold);
+
+        /// @brief Get the threshold applied to class_id
+        float get(int class_id) const noexcept
+        {
+            const uint32_t slot = static_cast<uint32_t>(class_id);
+            return this->table_[slot < this->num_classes() ? slot : this->num_classes()];
+        }
+
+        float get_default() const noexcept { return this->table_.back(); }
+
+        /// @brief Get the number of table entries (highest class id set + 1)
+        uint32_t num_classes() const noexcept { return static_cast<uint32_t>(this->table_.size() - 1); }
+
+        /// @brief Get the lookup table: num_classes() per-class entries followed by the default threshold.
+        /// Kernels index it with min(uint32(class_id), num_classes()).
+        const float* table() const noexcept { return this->table_.data(); }
+
+        /// @brief Reads a threshold file. Throws std::runtime_error if it cannot be opened or parsed.
+        static ClassThresholds load(const std::string& path, float default_threshold = CONFIDENCE_SCORE_THRESHOLD);
+
+        /// @brief Parses a threshold file:
+        ///   default <threshold>       # Optional, overrides default_threshold
+        ///   <class_id> <threshold>    # One line per class
+        /// '#' starts a comment.
+        static ClassThresholds parse(std::istream& in, float default_threshold = CONFIDENCE_SCORE_THRESHOLD);
+
+    private:
+        std::vector<float> table_;
+    };
+
+    /// @brief Filters the rows of an NMS output by their class threshold and stores the survivors in out
+    /// as (x, y, width, height), in the same pass.
+    /// @param boxes_xyxy count rows of (x1, y1, x2, y2)
+    /// @param scores count confidences
+    /// @param class_ids count class ids
+    /// @param out Cleared first; rows past its capacity are dropped (see DetectionBatch::dropped()).
+    /// @param level Kernel to run (levels the CPU lacks fall back, see resolve_simd_level()).
+    /// Every level produces identical results; a NaN score never passes.
+    /// @param letterbox If not nullptr, boxes are stored in source-image pixels, clipped to the frame
+    /// (see LetterboxInfo::to_source()); otherwise in model space. Must be valid.
+    /// @return Number of detections stored
+    size_t filter_detections(const float* boxes_xyxy, const float* scores, const int32_t* class_ids, size_t count,
+        const ClassThresholds& thresholds, DetectionBatch& out, SimdLevel level = SimdLevel::kAuto,
+        const LetterboxInfo* letterbox = nullptr) noexcept;
+
+    /// @brief Decodes a raw (NMS-free) YOLOv8 / YOLO11 detection head into out, in one pass: for each anchor,
+    /// the class with the highest score (the lowest class id on ties), its class threshold, and the conversion
+    /// of (cx, cy, w, h) to (x, y, width, height). The head is read in place, a block of anchors at a time,
+    /// without transposing it first.
+    /// @param head Channel-major [4 + num_classes, num_anchors] floats: rows cx, cy, w, h, then one row of
+    /// scores per class (the [1, 84, 8400] output of a 640x640 COCO model)
+    /// @param out Cleared first; anchors past its capacity are dropped (see DetectionBatch::dropped()).
+    /// Detections come out in anchor order and still need non_max_suppression().
+    /// @param level Kernel to run (levels the CPU lacks fall back, see resolve_simd_level()).
+    /// Every level produces identical results; an anchor whose class 0 score is NaN never passes.
+    /// @param letterbox If not nullptr, boxes are stored in source-image pixels, clipped to the frame; otherwise in
+    /// model space. Leave it to non_max_suppression() when suppression follows, so IoUs are not distorted by clipping.
+    /// @return Number of detections stored
+    size_t decode_raw_head(const float* head, size_t num_classes, size_t num_anchors,
+        const ClassThresholds& thresholds, DetectionBatch& out, SimdLevel level = SimdLevel::kAuto,
+        const LetterboxInfo* letterbox = nullptr) noexcept;
+
+    /// @brief Output buffers of one frame, as handed to postprocess_outputs().
+    struct PostprocessInput
+    {
+        // kEmbeddedNms: the first count rows of bboxes / scores / labels are read (count <= rows).
+        const void* bboxes = nullptr;
+        const void* scores = nullptr;
+        const void* labels = nullptr;
+        size_t count = 0;
+
+        // kRawHead: the head, and room for (4 + classes) * rows floats to widen it into if it is not float32.
+        const void* head = nullptr;
+        float* head_scratch = nullptr;
+    };
+
+    /// @brief Filters (kEmbeddedNms) or decodes (kRawHead) one frame's outputs into out, in the output data types
+    /// of Spec: filter_detections() or decode_raw_head() with compile-time geometry, or a typed element-wise pass.
+    /// Only the specs instantiated in common/TRT_YOLO_postprocess.cpp can be called (see TRT_YOLO_model_spec.hpp).
+    /// @return Number of detections stored
+    template <class Spec>
+    size_t postprocess_outputs(const PostprocessInput& input, const ClassThresholds& thresholds, DetectionBatch& out,
+        SimdLevel level = SimdLevel::kAuto, const LetterboxInfo* letterbox = nullptr) noexcept;
+
+    /// @brief Generic postprocess_outputs(), for any spec (geometry and data types read at run time).
+    size_t postprocess_outputs(const RuntimeModelSpec& spec, const PostprocessInput& input,
+        const ClassThresholds& thresholds, DetectionBatch& out, SimdLevel level = SimdLevel::kAuto,
+        const LetterboxInfo* letterbox = nullptr) noexcept;
+
+    /// @brief Signature of the compile-time instantiations of postprocess_outputs().
+    using PostprocessFunction = size_t (*)(const PostprocessInput&, const ClassThresholds&, DetectionBatch&,
+        SimdLevel, const LetterboxInfo*) noexcept;
+
+    /// @brief Get the compile-time instantiation of postprocess_outputs() matching spec, or nullptr if there is none
+    PostprocessFunction find_specialized_postprocess(const RuntimeModelSpec& spec) noexcept;
+
+    extern template size_t postprocess_outputs<YoloNms100F32>(const PostprocessInput&, const ClassThresholds&,
+        DetectionBatch&, SimdLevel, const LetterboxInfo*) noexcept;
+    extern template size_t postprocess_outputs<YoloNms100F16>(const PostprocessInput&, const ClassThresholds&,
+        DetectionBatch&, SimdLevel, const LetterboxInfo*) noexcept;
+    extern template size_t postprocess_outputs<YoloRaw8400x80F32>(const PostprocessInput&, const ClassThresholds&,
+        DetectionBatch&, SimdLevel, const LetterboxInfo*) noexcept;
+    extern template size_t postprocess_outputs<YoloRaw8400x80F16>(const PostprocessInput&, const ClassThresholds&,
+        DetectionBatch&, SimdLevel, const LetterboxInfo*) noexcept;
+
+}
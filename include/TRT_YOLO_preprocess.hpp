@@ -0,0 +1,213 @@
+#pragma once
+
+#include "TensorRT_CPP/TRT_tensor_desc.hpp"
+#include "include/TRT_YOLO_defs.hpp"
+#include "include/TRT_YOLO_letterbox.hpp"
+#include "include/TRT_YOLO_model_descriptor.hpp"
+#include "include/TRT_YOLO_simd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace TRT::YOLO
+{
+
+    /// @brief Pixel layout of a source frame.
+    enum class PixelFormat
+    {
+        kRGB8,  // Packed R, G, B bytes
+        kBGR8,  // Packed B, G, R bytes (OpenCV's default)
+        kNV12,  // YUV 4:2:0: Y plane, then one plane of interleaved U, V pairs at half width and height
+        kYUYV,  // YUV 4:2:2 packed: Y0 U Y1 V for each pair of pixels
+        kI420   // YUV 4:2:0: Y plane, then U and V planes at half width and height
+    };
+
+    /// @brief Get the short name of format ("rgb8", "bgr8", "nv12", "yuyv", "i420")
+    const char* pixel_format_name(PixelFormat format) noexcept;
+
+    /// @brief TRUE for the YUV formats
+    inline bool is_yuv(PixelFormat format) noexcept
+    {
+        return format == PixelFormat::kNV12 || format == PixelFormat::kYUYV || format == PixelFormat::kI420;
+    }
+
+    /// @brief Color matrix of YUV samples.
+    enum class YuvMatrix
+    {
+        kBT601, // SD video, most USB and MIPI cameras
+        kBT709  // HD video
+    };
+
+    /// @brief A frame of 8-bit pixels in caller memory (not owned).
+    struct ImageView
+    {
+        /// @brief Packed pixels, or the Y plane of the 4:2:0 formats
+        const uint8_t* data = nullptr;
+        int width = 0;
+        int height = 0;
+
+        /// @brief Bytes from the start of one row to the next (0: rows are packed, see row_stride())
+        size_t stride = 0;
+
+        PixelFormat format = PixelFormat::kRGB8;
+
+        /// @brief Chroma planes of kNV12 (chroma: the U, V plane) and kI420 (chroma: U, chroma_v: V). nullptr: the
+        /// plane follows the previous one (Y, then U) in memory, as the formats are usually laid out.
+        const uint8_t* chroma = nullptr;
+        const uint8_t* chroma_v = nullptr;
+
+        /// @brief Bytes from one chroma row to the next (0: kNV12 uses stride, or the width rounded up to a pair of
+        /// bytes when rows are packed; kI420 uses (row_stride() + 1) / 2)
+        size_t chroma_stride = 0;
+
+        /// @brief YUV formats: color matrix, and full (0-255) rather than limited (16-235 / 16-240) range samples
+        YuvMatrix matrix = YuvMatrix::kBT601;
+        bool full_range = false;
+
+        /// @brief Get the bytes from one row to the next (when packed: width * 3 for RGB / BGR, width for
+        /// the Y plane of kNV12 / kI420, 2 bytes per pixel, rounded up to a pair, for kYUYV)
+        size_t row_stride() const noexcept;
+
+        /// @brief Get the bytes from one chroma row to the next (kNV12, kI420)
+        size_t chroma_row_stride() const noexcept;
+
+        /// @brief Get the U and V planes (kNV12: both point into the interleaved plane; nullptr for other formats)
+        const uint8_t* u_plane() const noexcept;
+        const uint8_t* v_plane() const noexcept;
+
+        /// @brief Get the bytes of pixel data in the frame, without row padding
+        size_t num_bytes() const noexcept;
+
+        /// @brief TRUE if data is set, the size is positive and the strides hold a row
+        bool is_valid() const noexcept;
+
+        /// @brief Get the width x height region at (x, y) as a view into the same memory (explicit strides and planes)
+        /// @throws std::invalid_argument if the view is not valid, the region is empty or not inside the frame, or
+        /// splits chroma samples (the YUV formats need an even x, and kNV12 / kI420 an even y).
+        ImageView crop(int x, int y, int width, int height) const;
+    };
+
+    /// @brief Encoding of a frame handed to Detector::identify_objects(), chosen per call. Planar formats hold one
+    /// model-size frame, [3, H, W] (more generally, the model input's elements), letterboxed by the client.
+    enum class FrameFormat
+    {
+        kF32Planar, // Normalized model input values, float32
+        kF16Planar, // Normalized model input values, IEEE half
+        kU8Planar,  // 8-bit pixels in the model's channel order, normalized by the server
+        kU8Packed   // 8-bit RGB / BGR / YUV image of any size (see ImageView), letterboxed and normalized by the server
+    };
+
+    constexpr int NUM_FRAME_FORMATS = 4;
+
+    /// @brief Get the short name of format ("f32_planar", "f16_planar", "u8_planar", "u8_packed")
+    const char* frame_format_name(FrameFormat format) noexcept;
+
+    /// @brief One frame in any FrameFormat (caller memory, not owned).
+    struct InputFrame
+    {
+        FrameFormat format = FrameFormat::kF32Planar;
+
+        /// @brief Planar formats: the frame
+        const void* data = nullptr;
+
+        /// @brief kU8Packed: the image
+        ImageView image;
+
+        /// @brief Planar formats: how the source frame was letterboxed (boxes are then reported in source-image
+        /// pixels), or nullptr. A kU8Packed frame's letterbox is the one preprocess_image() applies.
+        const LetterboxInfo* letterbox = nullptr;
+
+        static InputFrame planar(FrameFormat format, const void* data, const LetterboxInfo* letterbox = nullptr) noexcept;
+        static InputFrame packed(const ImageView& image) noexcept;
+    };
+
+    /// @brief Get the payload bytes of frame: num_elements values for planar formats, the image's pixel data
+    /// (see ImageView::num_bytes()) for kU8Packed
+    size_t frame_bytes(const InputFrame& frame, size_t num_elements) noexcept;
+
+    /// @brief Settings of preprocess_image().
+    struct PreprocessConfig
+    {
+        /// @brief Size of the model input
+        int model_width = MODEL_INPUT_WIDTH;
+        int model_height = MODEL_INPUT_HEIGHT;
+
+        /// @brief Channel order of the model input planes
+        InputFormat channel_order = InputFormat::kRGB;
+
+        /// @brief normalized = (pixel * scale - mean) / std, per model channel
+        float scale = 1.0f / 255.0f;
+        float mean[3] = {0.0f, 0.0f, 0.0f};
+        float std[3] = {1.0f, 1.0f, 1.0f};
+
+        /// @brief Pixel value of the padding, before normalization (YOLO's letterbox grey)
+        uint8_t pad_value = 114;
+
+        /// @brief Kernel level (kAuto picks the best the CPU supports). Every level produces identical results.
+        SimdLevel simd_level = SimdLevel::kAuto;
+
+        /// @brief Settings for a model_width x model_height input described by descriptor ([input] format, scale,
+        /// mean and std).
+        static PreprocessConfig from_descriptor(const ModelDescriptor& descriptor, int model_width, int model_height);
+    };
+
+    /// @brief Scratch memory of preprocess_image(): the sampling tables of the last source / model size pair
+    /// (rebuilt when it changes) and two resampled source rows. Reused, so steady-state calls on one stream do
+    /// not allocate. Not thread-safe: use one workspace per thread.
+    struct PreprocessWorkspace
+    {
+        // Size and format the tables below were built for.
+        PixelFormat format = PixelFormat::kRGB8;
+        int source_width = 0;
+        int source_height = 0;
+        int scaled_width = 0;
+        int scaled_height = 0;
+
+        // Per scaled column: byte offsets of the left and right source pixels, and their weights
+        // (left | right << 16, in 1/2048 steps). For YUV formats, one pair of offsets per plane (Y, U, V), each
+        // within its own row. Columns before vector_columns can be read 4 bytes at a time.
+        std::vector<int32_t> x_offsets[3], x_next_offsets[3];
+        std::vector<int32_t> x_weights;
+        size_t vector_columns = 0;
+
+        // Per scaled row: the upper and lower source rows and the lower row's weight (in 1/2048 steps).
+        std::vector<int32_t> y_rows, y_next_rows, y_weights;
+
+        // Two horizontally resampled source rows, three planes of scaled_width values each.
+        std::vector<int32_t> rows;
+        int cached_rows[2] = {-1, -1};
+    };
+
+    /// @brief Letterboxes a frame of any size into the model input in one pass: bilinear resize keeping the
+    /// aspect ratio (see LetterboxInfo::fit()), padding, channel swap (or YUV -> RGB conversion), normalization and
+    /// the HWC -> CHW transpose. The scaled area is produced row by row from two cached, horizontally resampled
+    /// source rows, so every source pixel it reads is touched once, and each output value is written once,
+    /// straight to its plane. Interpolation is fixed-point (11-bit weights, results kept to 1/256 of a pixel
+    /// step), like OpenCV's 8-bit INTER_LINEAR with half-pixel centers.
+    /// YUV frames are converted to 8-bit RGB as the horizontal pass reads them (13-bit fixed-point coefficients of
+    /// image.matrix and range, chroma replicated over its 2x1 or 2x2 pixels, like OpenCV's cvtColor), so the result
+    /// matches converting the frame then resizing it, but only the source pixels the resize samples are converted.
+    /// @param output model_height * model_width * 3 float32 values: the planes in config.channel_order
+    /// @return The letterbox applied (pass it to Detector::identify_objects() to get source-pixel boxes)
+    /// @throws std::invalid_argument if image is not valid, or the model size, scale or std is not usable.
+    LetterboxInfo preprocess_image(const ImageView& image, const PreprocessConfig& config, float* output,
+        PreprocessWorkspace& workspace);
+
+    /// @brief preprocess_image() into model input values of type dtype: kFLOAT, or kHALF, written as IEEE half
+    /// straight from the normalization (F16C on x86, the native conversion on ARM; round to nearest even, so every
+    /// value is bit-identical to float_to_half() of the float32 output). Halves the bytes an FP16-input engine copies.
+    /// @throws std::invalid_argument as the float32 overload, or if dtype is neither kFLOAT nor kHALF.
+    LetterboxInfo preprocess_image(const ImageView& image, const PreprocessConfig& config, void* output,
+        TensorDataType dtype, PreprocessWorkspace& workspace);
+
+    /// @brief Converts a planar frame of num_elements values into the model input, of type dtype: kU8Planar pixels
+    /// are normalized exactly like preprocess_image() does (config's scale, mean and std; the planes are already
+    /// in the model's channel order), and kF32Planar / kF16Planar values are copied, or converted (float32 <-> half
+    /// with config.simd_level's kernels, bit-identical to float_to_half() / half_to_float()).
+    /// @throws std::invalid_argument on a kU8Packed or null frame, a kU8Planar frame whose num_elements is not
+    /// a multiple of 3, or an unusable scale or std.
+    void convert_planar_frame(const InputFrame& frame, size_t num_elements, const PreprocessConfig& config,
+        void* output, TensorDataType dtype);
+
+}
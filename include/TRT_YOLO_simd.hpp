@@ -0,0 +1,29 @@
+#pragma once
+
+namespace TRT::YOLO
+{
+
+    /// @brief Instruction sets the host-side kernels (post-processing, pre-processing) are written for.
+    enum class SimdLevel
+    {
+        kAuto,     // Best level supported by the running CPU
+        kScalar,   // Portable C++ (reference implementation)
+        kNEON,     // AArch64 Advanced SIMD (Jetson)
+        kAVX2,     // x86-64 AVX2 (and F16C)
+        kAVX512    // x86-64 AVX-512F (and F16C)
+    };
+
+    /// @brief Get the best level supported by the running CPU (detected once, then cached)
+    SimdLevel detect_simd_level() noexcept;
+
+    /// @brief TRUE if the kernels for level were compiled in and the running CPU supports them.
+    /// kAuto and kScalar are always supported.
+    bool simd_level_supported(SimdLevel level) noexcept;
+
+    /// @brief Maps kAuto to detect_simd_level(), and levels the CPU lacks to the next lower supported level.
+    SimdLevel resolve_simd_level(SimdLevel level) noexcept;
+
+    /// @brief Get the short name of level ("auto", "scalar", "neon", "avx2", "avx512")
+    const char* simd_level_name(SimdLevel level) noexcept;
+
+}
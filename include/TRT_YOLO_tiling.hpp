@@ -0,0 +1,147 @@
+#pragma once
+
+#include "include/TRT_YOLO.hpp"
+#include "include/TRT_YOLO_detections.hpp"
+#include "include/TRT_YOLO_nms.hpp"
+#include "include/TRT_YOLO_preprocess.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace TRT::YOLO
+{
+
+    /// @brief How the detections of overlapping tiles are merged into one frame's results.
+    enum class TileMerge
+    {
+        kNms,              // non_max_suppression(): the best box of each group of duplicates
+        kWeightedBoxFusion // weighted_box_fusion(): the confidence-weighted mean of each group
+    };
+
+    /// @brief Settings of a TiledDetector.
+    struct TilingConfig
+    {
+        /// @brief Tile size in frame pixels (0: the model input size, so tiles run unscaled)
+        int tile_width = 0;
+        int tile_height = 0;
+
+        /// @brief Minimum overlap of neighbouring tiles, as a fraction of the tile size, in [0, 0.9]. Objects up
+        /// to this size that cross a seam are whole in at least one tile.
+        float overlap = 0.2f;
+
+        /// @brief Tiles per Detector::identify_objects() call (0: every tile of the frame in one call, which the
+        /// Detector runs in chunks of its engine batch)
+        size_t batch_size = 0;
+
+        /// @brief Also run the whole frame, letterboxed, for objects larger than a tile
+        bool include_full_frame = false;
+
+        /// @brief How duplicates along the seams are merged
+        TileMerge merge = TileMerge::kNms;
+
+        /// @brief Settings of the merge: by default, boxes of a class overlapping by more than half of the smaller
+        /// one (OverlapMetric::kIoS, so the part of an object cut off by a tile edge merges with the whole box of
+        /// the neighbouring tile), with no top_k or max_candidates limit.
+        NmsConfig nms = {0.5f, OverlapMetric::kIoS, 0, 0, false};
+    };
+
+    /// @brief One tile: a region of the frame, in frame pixels.
+    struct TileRect
+    {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    /// @brief Covers a frame_width x frame_height frame with tiles of tile_width x tile_height, overlapping by at
+    /// least overlap of the tile size, in a grid spread evenly from edge to edge (row-major). A frame smaller than
+    /// a tile along an axis gets one tile of the frame's size there. With even_origins, tiles start on even
+    /// pixels (YUV chroma); the last tile of an axis then grows by a pixel when needed to reach the frame edge.
+    /// @param tiles Cleared first; receives the tiles
+    /// @throws std::invalid_argument if a size is not positive or overlap is outside [0, 0.9].
+    void plan_tiles(int frame_width, int frame_height, int tile_width, int tile_height, float overlap,
+        bool even_origins, std::vector<TileRect>& tiles);
+
+    /// @brief Scratch memory of merge_tile_detections(). It grows to the largest frame seen and is then reused,
+    /// so steady-state calls do not allocate. Not thread-safe: use one workspace per thread.
+    struct TileMergeWorkspace
+    {
+        std::vector<TileRect> exclusive; // Per tile: the part of it no other tile covers
+        DetectionBatch seam;             // Detections entering the merge, in frame pixels
+        DetectionBatch interior;         // Detections passed through, in frame pixels
+        std::vector<int32_t> views;      // View of each seam detection: its tile, or tiles.size() for the full frame
+        NmsWorkspace nms;
+    };
+
+    /// @brief Merges the detections of a frame's tiles (and of the whole frame) into the frame's results: boxes are
+    /// moved to frame pixels, then duplicates are merged as config.merge and config.nms say. Only boxes of different
+    /// views (tiles, or a tile and the full frame) merge: each view's own NMS already ran. A box lying wholly in
+    /// the part of its tile that no other tile covers cannot overlap a box of another tile, so when there is no
+    /// full-frame pass and neither top_k nor max_candidates is set, such boxes skip the merge (the tiles' own
+    /// NMS already ran) and only the boxes near the seams are compared.
+    /// @param tiles Tiles from plan_tiles() (the row-major grid)
+    /// @param tile_results tiles.size() batches; tile_results[i] in pixels of tiles[i]
+    /// @param full_frame Detections of the whole frame, in frame pixels, or nullptr
+    /// @param merged Cleared first; receives the merged detections: the merged boxes, highest confidence first,
+    /// then the ones that skipped the merge, tile by tile. Detections beyond its capacity are dropped.
+    /// @param level Kernel of the overlap tests (see non_max_suppression())
+    /// @return Number of detections stored
+    size_t merge_tile_detections(const std::vector<TileRect>& tiles, const DetectionBatch* tile_results,
+        const DetectionBatch* full_frame, DetectionBatch& merged, const TilingConfig& config,
+        TileMergeWorkspace& workspace, SimdLevel level = SimdLevel::kAuto);
+
+    /// @brief Detects small objects in large frames (e.g. 4K overview cameras): the frame is sliced into overlapping
+    /// tiles (see plan_tiles()), each tile runs through the Detector's multi-frame image overload as its own frame
+    /// (so an engine with a batch dimension runs several tiles per inference), the detections of each tile are
+    /// moved to frame pixels, and duplicates along the seams are merged (see merge_tile_detections()).
+    /// The Detector can be shared; a TiledDetector holds the scratch of one stream and is not thread-safe.
+    /// Scratch grows to the largest frame seen, so steady-state calls on one frame size do not allocate.
+    class TiledDetector
+    {
+    public:
+        /// @throws std::invalid_argument if config is not usable (see plan_tiles(); the merge threshold must be
+        /// in (0, 1]).
+        explicit TiledDetector(Detector& detector, const TilingConfig& config = TilingConfig());
+
+        TiledDetector(const TiledDetector&) = delete;
+        TiledDetector& operator=(const TiledDetector&) = delete;
+
+        /// @brief Runs an 8-bit RGB, BGR or YUV frame of any size as tiles; boxes are reported in frame pixels.
+        /// @param results_detections Caller-owned results; cleared first. Detections beyond its capacity are
+        /// dropped (see DetectionBatch::dropped()) - get_max_detections() of the frame size is always enough.
+        /// @return Number of detections stored (-1 on failure)
+        int identify_objects(const ImageView& frame, DetectionBatch& results_detections);
+
+        /// @brief Get the maximum number of detections identify_objects() reports for a frame of this size
+        size_t get_max_detections(int frame_width, int frame_height) const;
+
+        /// @brief Get the tiles of the last frame (in frame pixels; the full frame, if run, is not listed)
+        const std::vector<TileRect>& get_tiles() const noexcept { return this->tiles_; }
+
+        /// @brief Get the number of detections of every tile before the merge, in the last frame
+        size_t get_num_candidates() const noexcept { return this->num_candidates_; }
+
+        /// @brief Get the configuration, with the tile size resolved
+        const TilingConfig& get_config() const noexcept { return this->config_; }
+
+    private:
+        Detector& detector_;
+        TilingConfig config_;
+
+        // Tiles of the last frame size and format seen.
+        std::vector<TileRect> tiles_;
+        int frame_width_ = 0;
+        int frame_height_ = 0;
+        bool even_origins_ = false;
+
+        std::vector<ImageView> views_;        // One per tile, then the full frame if configured
+        std::vector<DetectionBatch> results_; // Detections of each view, in view pixels
+        TileMergeWorkspace merge_workspace_;
+        size_t num_candidates_ = 0;
+
+        /// @brief Plans the tiles of a frame of this size unless they are already planned.
+        void update_tiles(int frame_width, int frame_height, bool even_origins);
+    };
+
+}
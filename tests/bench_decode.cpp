@@ -0,0 +1,89 @@
+#include "include/TRT_YOLO_postprocess.hpp"
+#include "tests/test_util.hpp"
+
+#include <cstdio>
+#include <random>
+
+namespace
+{
+    using namespace TRT::YOLO;
+
+    /// @brief The usual way to decode a raw head: transpose it to one row per anchor, then scan each row.
+    void naive_decode(const std::vector<float>& head, size_t num_classes, size_t num_anchors,
+        const ClassThresholds& thresholds, std::vector<float>& transposed, DetectionBatch& out)
+    {
+        const size_t rows = 4 + num_classes;
+        transposed.resize(head.size());
+        for (size_t r = 0; r < rows; r++)
+        {
+            for (size_t a = 0; a < num_anchors; a++) transposed[a * rows + r] = head[r * num_anchors + a];
+        }
+        out.clear();
+        for (size_t a = 0; a < num_anchors; a++)
+        {
+            const float* row = &transposed[a * rows];
+            float best = row[4];
+            int32_t best_class = 0;
+            for (size_t c = 1; c < num_classes; c++)
+            {
+                if (row[4 + c] > best)
+                {
+                    best = row[4 + c];
+                    best_class = static_cast<int32_t>(c);
+                }
+            }
+            if (best >= thresholds.get(best_class))
+            {
+                out.push_back(row[0] - row[2] * 0.5f, row[1] - row[3] * 0.5f, row[2], row[3], best, best_class);
+            }
+        }
+    }
+}
+
+// Decoding of a [1, 84, 8400] raw head (mostly low scores, a confident anchor every 50): naive transpose and scan
+// against decode_raw_head() at each SIMD level, in microseconds per frame.
+int main(int argc, char** argv)
+{
+    const bool quick = Test::quick_run(argc, argv);
+    const size_t num_classes = 80, num_anchors = 8400;
+    std::vector<float> head((4 + num_classes) * num_anchors);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (float& value : head)
+    {
+        const float u = unit(rng);
+        value = u * u * u * u * u * u * 0.2f;
+    }
+    for (size_t i = 0; i < 4 * num_anchors; i++) head[i] = unit(rng) * 640.0f;
+    for (size_t a = 0; a < num_anchors; a += 50) head[(4 + a % num_classes) * num_anchors + a] = 0.95f;
+
+    const int calls = quick ? 3 : 200;
+    std::printf("%9s %10s", "threshold", "naive");
+    for (SimdLevel level : Test::supported_simd_levels()) std::printf(" %10s", simd_level_name(level));
+    std::printf(" %8s   (us/frame)\n", "kept");
+    for (float threshold : {0.25f, 0.9f})
+    {
+        const ClassThresholds thresholds(threshold);
+        std::vector<float> transposed;
+        DetectionBatch expected(num_anchors), out(num_anchors);
+        const double naive_ms = Test::median_ms(quick ? 1 : 5, [&]
+        {
+            for (int c = 0; c < calls; c++) naive_decode(head, num_classes, num_anchors, thresholds, transposed, expected);
+        });
+        std::printf("%9.2f %10.1f", threshold, naive_ms * 1e3 / calls);
+        for (SimdLevel level : Test::supported_simd_levels())
+        {
+            const double ms = Test::median_ms(quick ? 1 : 5, [&]
+            {
+                for (int c = 0; c < calls; c++)
+                {
+                    decode_raw_head(head.data(), num_classes, num_anchors, thresholds, out, level);
+                }
+            });
+            TEST_CHECK(Test::same_detections(out, expected));
+            std::printf(" %10.1f", ms * 1e3 / calls);
+        }
+        std::printf(" %8zu\n", expected.size());
+    }
+    return Test::test_exit_code("bench_decode");
+}
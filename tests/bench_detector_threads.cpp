@@ -0,0 +1,67 @@
+#include "TensorRT_CPP/TRT_cpu_backend.hpp"
+#include "include/TRT_YOLO.hpp"
+#include "tests/test_util.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// Camera threads sharing one Detector: every thread checks its results against a single-threaded reference
+// while the throughput over the number of execution contexts and threads is measured.
+int main(int argc, char** argv)
+{
+    using namespace TRT::YOLO;
+    const bool quick = Test::quick_run(argc, argv);
+    const int frames_per_thread = quick ? 8 : 60;
+    const std::vector<int> context_counts = quick ? std::vector<int>{1, 2} : std::vector<int>{1, 2, 4};
+    const std::vector<int> thread_counts = quick ? std::vector<int>{1, 4} : std::vector<int>{1, 2, 4, 8};
+
+    std::printf("%8s %8s %10s %14s\n", "contexts", "threads", "fps", "staging sets");
+    for (int contexts : context_counts)
+    {
+        CpuBackendConfig config = CpuInferenceBackend::yolo_nms_config();
+        config.contexts = contexts;
+        config.service_time = std::chrono::microseconds(3000);
+        Detector detector(std::make_unique<CpuInferenceBackend>(config));
+
+        // One distinct frame per thread, and its single-threaded result.
+        const int max_threads = thread_counts.back();
+        std::vector<std::vector<float>> frames;
+        std::vector<DetectionBatch> expected;
+        for (int t = 0; t < max_threads; t++)
+        {
+            frames.emplace_back(detector.get_frame_elements(), 0.05f * static_cast<float>(t + 1));
+            expected.emplace_back(detector.get_max_detections());
+            TEST_CHECK(detector.identify_objects(frames[t].data(), frames[t].size(), expected[t]) >= 0);
+        }
+
+        for (int threads : thread_counts)
+        {
+            std::atomic<int> mismatches{0};
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; t++)
+            {
+                workers.emplace_back([&, t]
+                {
+                    DetectionBatch results(detector.get_max_detections());
+                    for (int i = 0; i < frames_per_thread; i++)
+                    {
+                        const int count = detector.identify_objects(frames[t].data(), frames[t].size(), results);
+                        if (count < 0 || !Test::same_detections(results, expected[t]))
+                        {
+                            mismatches++;
+                        }
+                    }
+                });
+            }
+            for (auto& worker : workers) worker.join();
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            TEST_CHECK(mismatches == 0);
+            std::printf("%8d %8d %10.0f %14zu\n", contexts, threads, threads * frames_per_thread / seconds,
+                detector.get_num_staging_sets());
+        }
+    }
+    return Test::test_exit_code("bench_detector_threads");
+}
@@ -0,0 +1,53 @@
+#include "include/TRT_YOLO_postprocess.hpp"
+#include "tests/test_util.hpp"
+
+#include <cstdio>
+#include <random>
+
+// Confidence filtering of NMS output rows: time per row at each SIMD level, over row counts and pass rates.
+int main(int argc, char** argv)
+{
+    using namespace TRT::YOLO;
+    const bool quick = Test::quick_run(argc, argv);
+    const std::vector<SimdLevel> levels = Test::supported_simd_levels();
+    ClassThresholds thresholds(0.25f);
+    thresholds.set(0, 0.5f);
+
+    std::mt19937 rng(1);
+    std::printf("%6s %8s", "pass", "rows");
+    for (SimdLevel level : levels) std::printf(" %10s", simd_level_name(level));
+    std::printf("   (ns/row)\n");
+    for (int pass_percent : {5, 30, 70})
+    {
+        for (size_t count : {100, 1000, 8400, 100000})
+        {
+            std::vector<float> boxes(count * 4), scores(count);
+            std::vector<int32_t> class_ids(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                for (int k = 0; k < 4; k++) boxes[i * 4 + k] = static_cast<float>(rng() % 640);
+                scores[i] = static_cast<int>(rng() % 100) < pass_percent ? 0.95f : 0.05f;
+                class_ids[i] = static_cast<int32_t>(rng() % 80);
+            }
+            DetectionBatch out(count), expected(count);
+            filter_detections(boxes.data(), scores.data(), class_ids.data(), count, thresholds, expected, SimdLevel::kScalar);
+
+            std::printf("%5d%% %8zu", pass_percent, count);
+            const int calls = static_cast<int>((quick ? 20000 : 2000000) / count) + 1;
+            for (SimdLevel level : levels)
+            {
+                const double ms = Test::median_ms(quick ? 3 : 7, [&]
+                {
+                    for (int c = 0; c < calls; c++)
+                    {
+                        filter_detections(boxes.data(), scores.data(), class_ids.data(), count, thresholds, out, level);
+                    }
+                });
+                TEST_CHECK(Test::same_detections(out, expected));
+                std::printf(" %10.3f", ms * 1e6 / calls / count);
+            }
+            std::printf("\n");
+        }
+    }
+    return Test::test_exit_code("bench_filter");
+}
@@ -0,0 +1,52 @@
+#include "include/TRT_YOLO_nms.hpp"
+#include "tests/test_util.hpp"
+
+#include <cstdio>
+#include <random>
+
+// Non-maximum suppression of 1k, 8k and 25k candidates (80 classes, or class-agnostic): time per frame at each
+// SIMD level. Every level must keep the same boxes as the scalar one.
+int main(int argc, char** argv)
+{
+    using namespace TRT::YOLO;
+    const bool quick = Test::quick_run(argc, argv);
+    const std::vector<SimdLevel> levels = Test::supported_simd_levels();
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::printf("%10s %10s", "candidates", "classes");
+    for (SimdLevel level : levels) std::printf(" %10s", simd_level_name(level));
+    std::printf(" %8s   (us/frame)\n", "kept");
+    for (size_t count : {1000, 8000, 25000})
+    {
+        DetectionBatch candidates(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const float width = 20.0f + unit(rng) * 80.0f, height = 20.0f + unit(rng) * 80.0f;
+            candidates.push_back(unit(rng) * 640.0f - width / 2, unit(rng) * 640.0f - height / 2, width, height,
+                unit(rng), static_cast<int>(rng() % 80));
+        }
+        for (bool agnostic : {false, true})
+        {
+            NmsConfig config;
+            config.class_agnostic = agnostic;
+            NmsWorkspace workspace;
+            DetectionBatch kept(count), expected(count);
+            non_max_suppression(candidates, expected, config, workspace, SimdLevel::kScalar);
+
+            std::printf("%10zu %10s", count, agnostic ? "agnostic" : "80");
+            const int calls = static_cast<int>((quick ? 2000 : 400000) / count) + 1;
+            for (SimdLevel level : levels)
+            {
+                const double ms = Test::median_ms(quick ? 1 : 5, [&]
+                {
+                    for (int c = 0; c < calls; c++) non_max_suppression(candidates, kept, config, workspace, level);
+                });
+                TEST_CHECK(Test::same_detections(kept, expected));
+                std::printf(" %10.1f", ms * 1e3 / calls);
+            }
+            std::printf(" %8zu\n", expected.size());
+        }
+    }
+    return Test::test_exit_code("bench_nms");
+}
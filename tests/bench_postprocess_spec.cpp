@@ -0,0 +1,134 @@
+#include "TensorRT_CPP/TRT_half.hpp"
+#include "include/TRT_YOLO_postprocess.hpp"
+#include "tests/test_util.hpp"
+
+#include <cstdio>
+#include <random>
+
+namespace
+{
+    using namespace TRT::YOLO;
+
+    /// @brief Random outputs of one frame in both data types, for the specs of find_specialized_postprocess().
+    struct Outputs
+    {
+        std::vector<float> head, head_scratch, boxes, scores;
+        std::vector<uint16_t> head_f16, boxes_f16, scores_f16;
+        std::vector<int32_t> labels;
+
+        explicit Outputs(std::mt19937& rng)
+        {
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+            // Raw head: mostly low scores, a confident anchor every 40.
+            this->head.resize(84 * 8400);
+            this->head_scratch.resize(this->head.size());
+            for (size_t i = 0; i < this->head.size(); i++)
+            {
+                const float u = unit(rng);
+                this->head[i] = i < 4 * 8400 ? u * 640.0f : u * u * u * u * u * u * 0.2f;
+            }
+            for (size_t a = 0; a < 8400; a += 40) this->head[(4 + a % 80) * 8400 + a] = 0.9f;
+
+            // EfficientNMS outputs: 100 rows.
+            this->boxes.resize(400);
+            this->scores.resize(100);
+            this->labels.resize(100);
+            for (float& value : this->boxes) value = unit(rng) * 640.0f;
+            for (float& value : this->scores) value = unit(rng);
+            for (int32_t& label : this->labels) label = static_cast<int32_t>(rng() % 80);
+
+            for (float value : this->head) this->head_f16.push_back(float_to_half(value));
+            for (float value : this->boxes) this->boxes_f16.push_back(float_to_half(value));
+            for (float value : this->scores) this->scores_f16.push_back(float_to_half(value));
+        }
+
+        PostprocessInput input(const RuntimeModelSpec& spec)
+        {
+            const bool half = spec.box_type == TensorDataType::kHALF;
+            PostprocessInput input;
+            if (spec.layout == OutputLayout::kRawHead)
+            {
+                input.head = half ? static_cast<const void*>(this->head_f16.data()) : this->head.data();
+                input.head_scratch = this->head_scratch.data();
+            }
+            else
+            {
+                input.bboxes = half ? static_cast<const void*>(this->boxes_f16.data()) : this->boxes.data();
+                input.scores = half ? static_cast<const void*>(this->scores_f16.data()) : this->scores.data();
+                input.labels = this->labels.data();
+                input.count = this->labels.size();
+            }
+            return input;
+        }
+    };
+
+    RuntimeModelSpec runtime_spec(OutputLayout layout, size_t rows, size_t classes, TensorDataType type)
+    {
+        RuntimeModelSpec spec;
+        spec.layout = layout;
+        spec.rows = rows;
+        spec.num_classes = classes;
+        spec.box_type = type;
+        spec.score_type = type;
+        return spec;
+    }
+}
+
+// Compile-time postprocess_outputs<Spec>() against the generic postprocess_outputs(RuntimeModelSpec) on the same
+// outputs: identical detections at every SIMD level (with and without letterbox projection), and the time of each
+// at the best level, in microseconds per frame.
+int main(int argc, char** argv)
+{
+    const bool quick = Test::quick_run(argc, argv);
+    std::mt19937 rng(7);
+    Outputs outputs(rng);
+    ClassThresholds thresholds(0.25f);
+    thresholds.set(3, 0.5f);
+    const LetterboxInfo letterbox = LetterboxInfo::fit(1920, 1080);
+
+    // Geometry or types no spec is compiled for fall back to the generic path.
+    TEST_CHECK(find_specialized_postprocess(runtime_spec(OutputLayout::kRawHead, 8400, 3, TensorDataType::kFLOAT)) == nullptr);
+    TEST_CHECK(find_specialized_postprocess(runtime_spec(OutputLayout::kEmbeddedNms, 300, 0, TensorDataType::kFLOAT)) == nullptr);
+
+    std::printf("%-22s %10s %12s %8s %6s   (us/frame)\n", "spec", "generic", "specialized", "speedup", "kept");
+    const std::pair<const char*, RuntimeModelSpec> specs[] = {
+        {"YoloNms100F32", runtime_spec(OutputLayout::kEmbeddedNms, 100, 0, TensorDataType::kFLOAT)},
+        {"YoloNms100F16", runtime_spec(OutputLayout::kEmbeddedNms, 100, 0, TensorDataType::kHALF)},
+        {"YoloRaw8400x80F32", runtime_spec(OutputLayout::kRawHead, 8400, 80, TensorDataType::kFLOAT)},
+        {"YoloRaw8400x80F16", runtime_spec(OutputLayout::kRawHead, 8400, 80, TensorDataType::kHALF)}};
+    for (const auto& [name, spec] : specs)
+    {
+        const PostprocessFunction specialized = find_specialized_postprocess(spec);
+        TEST_CHECK(specialized != nullptr);
+        if (specialized == nullptr)
+        {
+            continue;
+        }
+        const PostprocessInput input = outputs.input(spec);
+        DetectionBatch generic_out(spec.rows), specialized_out(spec.rows);
+        for (SimdLevel level : Test::supported_simd_levels())
+        {
+            for (const LetterboxInfo* projection : {static_cast<const LetterboxInfo*>(nullptr), &letterbox})
+            {
+                postprocess_outputs(spec, input, thresholds, generic_out, level, projection);
+                specialized(input, thresholds, specialized_out, level, projection);
+                TEST_CHECK(Test::same_detections(specialized_out, generic_out));
+                TEST_CHECK(specialized_out.dropped() == generic_out.dropped());
+            }
+        }
+
+        const int calls = static_cast<int>((quick ? 20000 : 20000000) / (spec.rows * (spec.num_classes + 4))) + 1;
+        const double generic_ms = Test::median_ms(quick ? 1 : 7, [&]
+        {
+            for (int c = 0; c < calls; c++) postprocess_outputs(spec, input, thresholds, generic_out);
+        });
+        const double specialized_ms = Test::median_ms(quick ? 1 : 7, [&]
+        {
+            for (int c = 0; c < calls; c++) specialized(input, thresholds, specialized_out, SimdLevel::kAuto, nullptr);
+        });
+        std::printf("%-22s %10.3f %12.3f %7.2fx %6zu\n", name, generic_ms * 1e3 / calls,
+            specialized_ms * 1e3 / calls, generic_ms / specialized_ms, specialized_out.size());
+    }
+    return Test::test_exit_code("bench_postprocess_spec");
+}
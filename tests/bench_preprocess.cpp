@@ -0,0 +1,199 @@
+#include "TensorRT_CPP/TRT_half.hpp"
+#include "include/TRT_YOLO_preprocess.hpp"
+#include "tests/test_util.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+namespace
+{
+    using namespace TRT::YOLO;
+
+    /// @brief The usual three passes, as with cv::resize + copyMakeBorder + blobFromImage: bilinear resize into a
+    /// packed 8-bit image, copy onto a grey canvas, then swap BGR to RGB, scale and transpose into float planes.
+    void naive_preprocess(const ImageView& image, int model_width, int model_height, float* output,
+        std::vector<uint8_t>& resized, std::vector<uint8_t>& canvas)
+    {
+        const LetterboxInfo letterbox = LetterboxInfo::fit(image.width, image.height, model_width, model_height);
+        const int scaled_width = std::min(model_width, static_cast<int>(std::lround(image.width * letterbox.scale)));
+        const int scaled_height = std::min(model_height, static_cast<int>(std::lround(image.height * letterbox.scale)));
+        auto sample = [](int i, int n, int size, int& first, int& second, float& weight)
+        {
+            const float position = (i + 0.5f) * size / n - 0.5f;
+            first = std::max(0, static_cast<int>(std::floor(position)));
+            weight = position < 0.0f ? 0.0f : position - std::floor(position);
+            if (first >= size - 1)
+            {
+                first = size - 1;
+                weight = 0.0f;
+            }
+            second = std::min(first + 1, size - 1);
+        };
+
+        resized.resize(static_cast<size_t>(scaled_width) * scaled_height * 3);
+        for (int y = 0; y < scaled_height; y++)
+        {
+            int y0, y1;
+            float wy;
+            sample(y, scaled_height, image.height, y0, y1, wy);
+            for (int x = 0; x < scaled_width; x++)
+            {
+                int x0, x1;
+                float wx;
+                sample(x, scaled_width, image.width, x0, x1, wx);
+                for (int c = 0; c < 3; c++)
+                {
+                    auto pixel = [&](int px, int py) { return static_cast<float>(image.data[py * image.row_stride() + px * 3 + c]); };
+                    const float value = (pixel(x0, y0) * (1 - wx) + pixel(x1, y0) * wx) * (1 - wy)
+                        + (pixel(x0, y1) * (1 - wx) + pixel(x1, y1) * wx) * wy;
+                    resized[(static_cast<size_t>(y) * scaled_width + x) * 3 + c] = static_cast<uint8_t>(std::lround(value));
+                }
+            }
+        }
+
+        canvas.assign(static_cast<size_t>(model_width) * model_height * 3, 114);
+        const int pad_x = static_cast<int>(letterbox.pad_x), pad_y = static_cast<int>(letterbox.pad_y);
+        for (int y = 0; y < scaled_height; y++)
+        {
+            std::copy_n(&resized[static_cast<size_t>(y) * scaled_width * 3], scaled_width * 3,
+                &canvas[(static_cast<size_t>(y + pad_y) * model_width + pad_x) * 3]);
+        }
+
+        const size_t plane = static_cast<size_t>(model_width) * model_height;
+        for (size_t i = 0; i < plane; i++)
+        {
+            for (int c = 0; c < 3; c++) output[(2 - c) * plane + i] = canvas[i * 3 + c] / 255.0f;
+        }
+    }
+}
+
+// Letterboxing a BGR frame into a 640x640 RGB input: the naive three passes against the fused preprocess_image()
+// at each SIMD level, in milliseconds per frame. Into float32 first, then into IEEE half (for FP16-input engines)
+// as a float32 pass followed by a conversion pass, or straight from the normalization. Last, the bulk conversions
+// of convert_planar_frame() between float32 and half planar frames.
+int main(int argc, char** argv)
+{
+    const bool quick = Test::quick_run(argc, argv);
+    const int repeats = quick ? 1 : 25;
+    const std::vector<SimdLevel> levels = Test::supported_simd_levels();
+    const PreprocessConfig defaults;
+    const size_t num_elements = static_cast<size_t>(defaults.model_width) * defaults.model_height * 3;
+    std::vector<float> output(num_elements);
+    std::vector<uint16_t> halves(num_elements), expected_halves(num_elements);
+    std::mt19937 rng(3);
+
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<ImageView> images;
+    const int sizes[][2] = {{1280, 720}, {1920, 1080}, {3840, 2160}};
+    for (const auto& size : sizes)
+    {
+        std::vector<uint8_t>& pixels = frames.emplace_back(static_cast<size_t>(size[0]) * size[1] * 3);
+        for (uint8_t& value : pixels) value = static_cast<uint8_t>(rng());
+        ImageView image;
+        image.data = pixels.data();
+        image.width = size[0];
+        image.height = size[1];
+        image.format = PixelFormat::kBGR8;
+        images.push_back(image);
+    }
+
+    std::printf("float32 output\n%10s %8s", "frame", "naive");
+    for (SimdLevel level : levels) std::printf(" %8s", simd_level_name(level));
+    std::printf("   (ms/frame)\n");
+    for (const ImageView& image : images)
+    {
+        std::vector<uint8_t> resized, canvas;
+        const double naive_ms = Test::median_ms(repeats, [&]
+        {
+            naive_preprocess(image, defaults.model_width, defaults.model_height, output.data(), resized, canvas);
+        });
+        std::printf("%5dx%-4d %8.2f", image.width, image.height, naive_ms);
+
+        std::vector<float> scalar;
+        for (SimdLevel level : levels)
+        {
+            PreprocessConfig config;
+            config.simd_level = level;
+            PreprocessWorkspace workspace;
+            const double ms = Test::median_ms(repeats, [&] { preprocess_image(image, config, output.data(), workspace); });
+            if (level == SimdLevel::kScalar) scalar = output;
+            TEST_CHECK(output == scalar);
+            std::printf(" %8.2f", ms);
+        }
+        std::printf("\n");
+    }
+
+    std::printf("\nhalf output: float32 then converted / straight into half\n%10s", "frame");
+    for (SimdLevel level : levels) std::printf(" %17s", simd_level_name(level));
+    std::printf("   (ms/frame)\n");
+    for (const ImageView& image : images)
+    {
+        std::printf("%5dx%-4d", image.width, image.height);
+        for (SimdLevel level : levels)
+        {
+            PreprocessConfig config;
+            config.simd_level = level;
+            PreprocessWorkspace workspace;
+            const InputFrame planar = InputFrame::planar(FrameFormat::kF32Planar, output.data());
+            const double two_pass_ms = Test::median_ms(repeats, [&]
+            {
+                preprocess_image(image, config, output.data(), workspace);
+                convert_planar_frame(planar, num_elements, config, expected_halves.data(), TensorDataType::kHALF);
+            });
+            const double direct_ms = Test::median_ms(repeats, [&]
+            {
+                preprocess_image(image, config, halves.data(), TensorDataType::kHALF, workspace);
+            });
+            bool same = halves == expected_halves;
+            for (size_t i = 0; i < num_elements; i += 97) same &= halves[i] == float_to_half(output[i]);
+            TEST_CHECK(same);
+            std::printf("   %6.2f / %6.2f", two_pass_ms, direct_ms);
+        }
+        std::printf("\n");
+    }
+
+    // A 640x640x3 planar frame of values in [0, 1], as a float32 preprocessor writes them.
+    std::vector<float> values(num_elements), widened(num_elements);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (float& value : values) value = unit(rng);
+    for (size_t i = 0; i < num_elements; i++) expected_halves[i] = float_to_half(values[i]);
+
+    std::printf("\nconvert_planar_frame(), %zu values\n%16s", num_elements, "");
+    for (SimdLevel level : levels) std::printf(" %8s", simd_level_name(level));
+    std::printf("   (ms/frame)\n");
+    const int convert_repeats = quick ? 1 : 101;
+    for (bool narrow : {true, false})
+    {
+        std::printf("%16s", narrow ? "float32 -> half" : "half -> float32");
+        for (SimdLevel level : levels)
+        {
+            PreprocessConfig config;
+            config.simd_level = level;
+            double ms = 0.0;
+            if (narrow)
+            {
+                const InputFrame frame = InputFrame::planar(FrameFormat::kF32Planar, values.data());
+                ms = Test::median_ms(convert_repeats, [&]
+                {
+                    convert_planar_frame(frame, num_elements, config, halves.data(), TensorDataType::kHALF);
+                });
+                TEST_CHECK(halves == expected_halves);
+            }
+            else
+            {
+                const InputFrame frame = InputFrame::planar(FrameFormat::kF16Planar, expected_halves.data());
+                ms = Test::median_ms(convert_repeats, [&]
+                {
+                    convert_planar_frame(frame, num_elements, config, widened.data(), TensorDataType::kFLOAT);
+                });
+                bool same = true;
+                for (size_t i = 0; i < num_elements; i++) same &= widened[i] == half_to_float(expected_halves[i]);
+                TEST_CHECK(same);
+            }
+            std::printf(" %8.2f", ms);
+        }
+        std::printf("\n");
+    }
+    return Test::test_exit_code("bench_preprocess");
+}
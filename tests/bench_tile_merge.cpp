@@ -0,0 +1,88 @@
+#include "include/TRT_YOLO_tiling.hpp"
+#include "tests/test_util.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+// Merging the tiles of a 4K frame (640 x 640 tiles, 20% overlap): every object is reported by each tile showing at
+// least 2 x 2 pixels of it (cut at the tile edge, jittered, scoring less when cut). Time per frame of NMS and
+// weighted box fusion at each SIMD level, comparing every box or only those near the seams.
+int main(int argc, char** argv)
+{
+    using namespace TRT::YOLO;
+    const bool quick = Test::quick_run(argc, argv);
+    const std::vector<SimdLevel> levels = Test::supported_simd_levels();
+    std::vector<TileRect> tiles;
+    plan_tiles(3840, 2160, 640, 640, 0.2f, false, tiles);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::printf("%7s %7s %10s %4s %10s", "classes", "objects", "tile boxes", "", "compared");
+    for (SimdLevel level : levels) std::printf(" %10s", simd_level_name(level));
+    std::printf(" %8s   (us/frame)\n", "merged");
+    for (int classes : {80, 1})
+    {
+        for (size_t objects : quick ? std::vector<size_t>{1000} : std::vector<size_t>{1000, 5000, 20000})
+        {
+            std::vector<DetectionBatch> results;
+            for (size_t t = 0; t < tiles.size(); t++) results.emplace_back(objects);
+            for (size_t o = 0; o < objects; o++)
+            {
+                const float width = 8.0f + unit(rng) * 56.0f, height = 8.0f + unit(rng) * 56.0f;
+                const float x = unit(rng) * (3840.0f - width), y = unit(rng) * (2160.0f - height);
+                const int class_id = static_cast<int>(rng() % classes);
+                const float confidence = 0.3f + 0.7f * unit(rng);
+                for (size_t t = 0; t < tiles.size(); t++)
+                {
+                    const TileRect& tile = tiles[t];
+                    const float x1 = std::max(x, static_cast<float>(tile.x)), y1 = std::max(y, static_cast<float>(tile.y));
+                    const float x2 = std::min(x + width, static_cast<float>(tile.x + tile.width));
+                    const float y2 = std::min(y + height, static_cast<float>(tile.y + tile.height));
+                    if (x2 - x1 < 2.0f || y2 - y1 < 2.0f)
+                    {
+                        continue;
+                    }
+                    const bool whole = (x2 - x1) * (y2 - y1) > 0.99f * width * height;
+                    results[t].push_back(x1 - tile.x + (unit(rng) - 0.5f) * 1.5f, y1 - tile.y + (unit(rng) - 0.5f) * 1.5f,
+                        x2 - x1, y2 - y1, std::min(1.0f, confidence * (0.9f + 0.2f * unit(rng)) * (whole ? 1.0f : 0.8f)),
+                        class_id);
+                }
+            }
+            size_t boxes = 0;
+            for (const DetectionBatch& batch : results) boxes += batch.size();
+
+            for (TileMerge merge : {TileMerge::kNms, TileMerge::kWeightedBoxFusion})
+            {
+                for (bool all_boxes : {true, false})
+                {
+                    TilingConfig config;
+                    config.merge = merge;
+                    config.nms.class_agnostic = classes == 1;
+                    if (all_boxes)
+                    {
+                        config.nms.max_candidates = static_cast<size_t>(-1); // A limit disables the seam shortcut
+                    }
+                    TileMergeWorkspace workspace;
+                    DetectionBatch merged(boxes), expected(boxes);
+                    merge_tile_detections(tiles, results.data(), nullptr, expected, config, workspace, SimdLevel::kScalar);
+
+                    std::printf("%7d %7zu %10zu %4s %10s", classes, objects, boxes,
+                        merge == TileMerge::kNms ? "nms" : "wbf", all_boxes ? "all" : "seams");
+                    const int repeats = quick ? 1 : (classes == 1 && all_boxes && objects >= 5000 ? 2 : 7);
+                    for (SimdLevel level : levels)
+                    {
+                        const double ms = Test::median_ms(repeats, [&]
+                        {
+                            merge_tile_detections(tiles, results.data(), nullptr, merged, config, workspace, level);
+                        });
+                        TEST_CHECK(Test::same_detections(merged, expected));
+                        std::printf(" %10.1f", ms * 1e3);
+                    }
+                    std::printf(" %8zu\n", expected.size());
+                }
+            }
+        }
+    }
+    return Test::test_exit_code("bench_tile_merge");
+}
@@ -0,0 +1,340 @@
+#pragma once
+
+// A scalar stand-in for <arm_neon.h>, covering the intrinsics the NEON kernels in common/ use, so that they build
+// and run on hosts without an AArch64 toolchain (see tests/CMakeLists.txt: TRT_YOLO_EMULATE_NEON). Each vector
+// type is a distinct struct, so mixing them up without a vreinterpret fails to compile as it does with the real
+// header; lanes follow the ACLE definitions (wrapping integer arithmetic, NaN-false comparisons, out-of-range
+// table indexes giving 0, round-to-nearest-even half conversions that quiet NaNs).
+// Only the results are emulated: timings of an emulated build mean nothing.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+template <typename T, int N, int Tag = 0>
+struct trt_neon_vector
+{
+    T lanes[N];
+};
+
+typedef trt_neon_vector<float, 4> float32x4_t;
+typedef trt_neon_vector<int32_t, 4> int32x4_t;
+typedef trt_neon_vector<uint32_t, 4> uint32x4_t;
+typedef trt_neon_vector<uint8_t, 16> uint8x16_t;
+typedef trt_neon_vector<uint16_t, 4> uint16x4_t;
+typedef trt_neon_vector<uint16_t, 4, 1> float16x4_t; // Binary16 bits
+
+struct float32x4x4_t
+{
+    float32x4_t val[4];
+};
+
+namespace trt_neon
+{
+    template <typename V, typename F>
+    inline V map(F f) noexcept
+    {
+        V result;
+        for (int i = 0; i < static_cast<int>(sizeof(result.lanes) / sizeof(result.lanes[0])); i++)
+        {
+            result.lanes[i] = f(i);
+        }
+        return result;
+    }
+
+    template <typename To, typename From>
+    inline To bit_cast(const From& from) noexcept
+    {
+        static_assert(sizeof(To) == sizeof(From), "Reinterprets keep the size");
+        To to;
+        std::memcpy(&to, &from, sizeof(to));
+        return to;
+    }
+
+    inline uint32_t mask(bool set) noexcept { return set ? 0xFFFFFFFFu : 0u; }
+
+    // Integer lanes wrap like the hardware's: computed on uint32_t, then brought back.
+    inline int32_t wrap(uint32_t value) noexcept { return bit_cast<int32_t>(value); }
+
+    inline float select(uint32_t mask, float a, float b) noexcept
+    {
+        return bit_cast<float>((mask & bit_cast<uint32_t>(a)) | (~mask & bit_cast<uint32_t>(b)));
+    }
+
+    /// @brief FCVT single to half, computed with doubles (independently of float_to_half()).
+    inline uint16_t to_half(float value) noexcept
+    {
+        const uint32_t bits = bit_cast<uint32_t>(value);
+        const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+        if (std::isnan(value))
+        {
+            return sign | 0x7E00u | static_cast<uint16_t>((bits >> 13) & 0x03FFu);
+        }
+        const double magnitude = std::fabs(static_cast<double>(value));
+        if (magnitude >= 65520.0) // Halfway between the largest half and 2^16, and above
+        {
+            return sign | 0x7C00u;
+        }
+        int exponent = 0;
+        std::frexp(magnitude, &exponent); // magnitude = m * 2^exponent, m in [0.5, 1)
+        exponent = magnitude < std::ldexp(1.0, -14) ? -14 : exponent - 1;
+        // Steps of the half's last mantissa bit; nearbyint() rounds half to even.
+        const uint32_t steps = static_cast<uint32_t>(std::nearbyint(std::ldexp(magnitude, 10 - exponent)));
+        if (steps < 1024u) // Subnormal (or zero); 1024 steps of 2^-24 encode the smallest normal as they are
+        {
+            return sign | static_cast<uint16_t>(steps);
+        }
+        return sign | static_cast<uint16_t>((static_cast<uint32_t>(exponent + 15) << 10) + (steps - 1024u));
+    }
+
+    /// @brief FCVT half to single (exact; NaNs come back quiet).
+    inline float from_half(uint16_t half) noexcept
+    {
+        const float sign = (half & 0x8000u) ? -1.0f : 1.0f;
+        const int exponent = (half >> 10) & 0x1F;
+        const uint32_t mantissa = half & 0x03FFu;
+        if (exponent == 0x1F)
+        {
+            if (mantissa == 0)
+            {
+                return sign * INFINITY;
+            }
+            return bit_cast<float>((static_cast<uint32_t>(half & 0x8000u) << 16) | 0x7FC00000u | (mantissa << 13));
+        }
+        if (exponent == 0)
+        {
+            return sign * static_cast<float>(std::ldexp(static_cast<double>(mantissa), -24));
+        }
+        return sign * static_cast<float>(std::ldexp(static_cast<double>(mantissa | 0x0400u), exponent - 25));
+    }
+}
+
+// Broadcasts, loads and stores
+inline float32x4_t vdupq_n_f32(float value) noexcept { return trt_neon::map<float32x4_t>([&](int) { return value; }); }
+inline int32x4_t vdupq_n_s32(int32_t value) noexcept { return trt_neon::map<int32x4_t>([&](int) { return value; }); }
+inline uint32x4_t vdupq_n_u32(uint32_t value) noexcept { return trt_neon::map<uint32x4_t>([&](int) { return value; }); }
+inline float32x4_t vld1q_f32(const float* p) noexcept { return trt_neon::map<float32x4_t>([&](int i) { return p[i]; }); }
+inline int32x4_t vld1q_s32(const int32_t* p) noexcept { return trt_neon::map<int32x4_t>([&](int i) { return p[i]; }); }
+inline uint32x4_t vld1q_u32(const uint32_t* p) noexcept { return trt_neon::map<uint32x4_t>([&](int i) { return p[i]; }); }
+inline uint8x16_t vld1q_u8(const uint8_t* p) noexcept { return trt_neon::map<uint8x16_t>([&](int i) { return p[i]; }); }
+inline uint16x4_t vld1_u16(const uint16_t* p) noexcept { return trt_neon::map<uint16x4_t>([&](int i) { return p[i]; }); }
+inline float32x4_t vld1q_dup_f32(const float* p) noexcept { return vdupq_n_f32(*p); }
+
+inline float32x4_t vld1q_lane_f32(const float* p, float32x4_t v, const int lane) noexcept
+{
+    v.lanes[lane] = *p;
+    return v;
+}
+
+inline float32x4x4_t vld4q_f32(const float* p) noexcept
+{
+    float32x4x4_t result;
+    for (int k = 0; k < 4; k++)
+    {
+        result.val[k] = trt_neon::map<float32x4_t>([&](int i) { return p[4 * i + k]; });
+    }
+    return result;
+}
+
+inline void vst1q_f32(float* p, float32x4_t v) noexcept { std::memcpy(p, v.lanes, sizeof(v.lanes)); }
+inline void vst1q_s32(int32_t* p, int32x4_t v) noexcept { std::memcpy(p, v.lanes, sizeof(v.lanes)); }
+inline void vst1q_u32(uint32_t* p, uint32x4_t v) noexcept { std::memcpy(p, v.lanes, sizeof(v.lanes)); }
+inline void vst1_u16(uint16_t* p, uint16x4_t v) noexcept { std::memcpy(p, v.lanes, sizeof(v.lanes)); }
+inline uint32_t vgetq_lane_u32(uint32x4_t v, const int lane) noexcept { return v.lanes[lane]; }
+
+// Float arithmetic and comparisons
+inline float32x4_t vaddq_f32(float32x4_t a, float32x4_t b) noexcept
+{
+    return trt_neon::map<float32x4_t>([&](int i) { return a.lanes[i] + b.lanes[i]; });
+}
+
+inline float32x4_t vsubq_f32(float32x4_t a, float32x4_t b) noexcept
+{
+    return trt_neon::map<float32x4_t>([&](int i) { return a.lanes[i] - b.lanes[i]; });
+}
+
+inline float32x4_t vmulq_f32(float32x4_t a, float32x4_t b) noexcept
+{
+    return trt_neon::map<float32x4_t>([&](int i) { return a.lanes[i] * b.lanes[i]; });
+}
+
+inline uint32x4_t vcgtq_f32(float32x4_t a, float32x4_t b) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) { return trt_neon::mask(a.lanes[i] > b.lanes[i]); });
+}
+
+inline uint32x4_t vcltq_f32(float32x4_t a, float32x4_t b) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) { return trt_neon::mask(a.lanes[i] < b.lanes[i]); });
+}
+
+inline uint32x4_t vcgeq_f32(float32x4_t a, float32x4_t b) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) { return trt_neon::mask(a.lanes[i] >= b.lanes[i]); });
+}
+
+inline float32x4_t vbslq_f32(uint32x4_t mask, float32x4_t a, float32x4_t b) noexcept
+{
+    return trt_neon::map<float32x4_t>([&](int i) { return trt_neon::select(mask.lanes[i], a.lanes[i], b.lanes[i]); });
+}
+
+// Integer arithmetic
+inline int32x4_t vsubq_s32(int32x4_t a, int32x4_t b) noexcept
+{
+    return trt_neon::map<int32x4_t>([&](int i) {
+        return trt_neon::wrap(static_cast<uint32_t>(a.lanes[i]) - static_cast<uint32_t>(b.lanes[i]));
+    });
+}
+
+inline int32x4_t vmulq_s32(int32x4_t a, int32x4_t b) noexcept
+{
+    return trt_neon::map<int32x4_t>([&](int i) {
+        return trt_neon::wrap(static_cast<uint32_t>(a.lanes[i]) * static_cast<uint32_t>(b.lanes[i]));
+    });
+}
+
+inline uint32x4_t vmulq_u32(uint32x4_t a, uint32x4_t b) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) { return a.lanes[i] * b.lanes[i]; });
+}
+
+inline int32x4_t vmlaq_s32(int32x4_t a, int32x4_t b, int32x4_t c) noexcept
+{
+    return trt_neon::map<int32x4_t>([&](int i) {
+        return trt_neon::wrap(static_cast<uint32_t>(a.lanes[i])
+            + static_cast<uint32_t>(b.lanes[i]) * static_cast<uint32_t>(c.lanes[i]));
+    });
+}
+
+inline uint32x4_t vmlaq_u32(uint32x4_t a, uint32x4_t b, uint32x4_t c) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) { return a.lanes[i] + b.lanes[i] * c.lanes[i]; });
+}
+
+inline int32x4_t vmlaq_n_s32(int32x4_t a, int32x4_t b, int32_t c) noexcept { return vmlaq_s32(a, b, vdupq_n_s32(c)); }
+
+inline int32x4_t vmlsq_n_s32(int32x4_t a, int32x4_t b, int32_t c) noexcept
+{
+    return vsubq_s32(a, vmulq_s32(b, vdupq_n_s32(c)));
+}
+
+inline int32x4_t vshrq_n_s32(int32x4_t a, const int n) noexcept
+{
+    return trt_neon::map<int32x4_t>([&](int i) { return a.lanes[i] >> n; });
+}
+
+inline uint32x4_t vshrq_n_u32(uint32x4_t a, const int n) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) { return a.lanes[i] >> n; });
+}
+
+/// @brief (a + 2^(n-1)) >> n, without the addition overflowing
+inline int32x4_t vrshrq_n_s32(int32x4_t a, const int n) noexcept
+{
+    return trt_neon::map<int32x4_t>([&](int i) {
+        return static_cast<int32_t>((static_cast<int64_t>(a.lanes[i]) + (int64_t{1} << (n - 1))) >> n);
+    });
+}
+
+/// @brief Shifts left by signed per-lane amounts (negative: logical right shift).
+inline uint32x4_t vshlq_u32(uint32x4_t a, int32x4_t shift) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) {
+        const int8_t amount = static_cast<int8_t>(shift.lanes[i]); // Only the low byte counts
+        if (amount <= -32 || amount >= 32)
+        {
+            return 0u;
+        }
+        return amount >= 0 ? a.lanes[i] << amount : a.lanes[i] >> -amount;
+    });
+}
+
+inline uint32x4_t vminq_u32(uint32x4_t a, uint32x4_t b) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) { return a.lanes[i] < b.lanes[i] ? a.lanes[i] : b.lanes[i]; });
+}
+
+inline int32x4_t vminq_s32(int32x4_t a, int32x4_t b) noexcept
+{
+    return trt_neon::map<int32x4_t>([&](int i) { return a.lanes[i] < b.lanes[i] ? a.lanes[i] : b.lanes[i]; });
+}
+
+inline int32x4_t vmaxq_s32(int32x4_t a, int32x4_t b) noexcept
+{
+    return trt_neon::map<int32x4_t>([&](int i) { return a.lanes[i] > b.lanes[i] ? a.lanes[i] : b.lanes[i]; });
+}
+
+inline uint32_t vaddvq_u32(uint32x4_t a) noexcept { return a.lanes[0] + a.lanes[1] + a.lanes[2] + a.lanes[3]; }
+
+inline uint32x4_t vceqq_s32(int32x4_t a, int32x4_t b) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) { return trt_neon::mask(a.lanes[i] == b.lanes[i]); });
+}
+
+// Bitwise operations and selects
+inline uint32x4_t vandq_u32(uint32x4_t a, uint32x4_t b) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) { return a.lanes[i] & b.lanes[i]; });
+}
+
+inline int32x4_t vandq_s32(int32x4_t a, int32x4_t b) noexcept
+{
+    return trt_neon::map<int32x4_t>([&](int i) { return a.lanes[i] & b.lanes[i]; });
+}
+
+inline uint32x4_t vorrq_u32(uint32x4_t a, uint32x4_t b) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) { return a.lanes[i] | b.lanes[i]; });
+}
+
+inline uint32x4_t vbicq_u32(uint32x4_t a, uint32x4_t b) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) { return a.lanes[i] & ~b.lanes[i]; });
+}
+
+inline uint32x4_t vbslq_u32(uint32x4_t mask, uint32x4_t a, uint32x4_t b) noexcept
+{
+    return trt_neon::map<uint32x4_t>([&](int i) { return (mask.lanes[i] & a.lanes[i]) | (~mask.lanes[i] & b.lanes[i]); });
+}
+
+inline int32x4_t vbslq_s32(uint32x4_t mask, int32x4_t a, int32x4_t b) noexcept
+{
+    return trt_neon::map<int32x4_t>([&](int i) {
+        return trt_neon::wrap((mask.lanes[i] & static_cast<uint32_t>(a.lanes[i]))
+            | (~mask.lanes[i] & static_cast<uint32_t>(b.lanes[i])));
+    });
+}
+
+/// @brief Byte table lookup: indexes past 15 give 0.
+inline uint8x16_t vqtbl1q_u8(uint8x16_t table, uint8x16_t index) noexcept
+{
+    return trt_neon::map<uint8x16_t>([&](int i) {
+        return index.lanes[i] < 16 ? table.lanes[index.lanes[i]] : static_cast<uint8_t>(0);
+    });
+}
+
+// Reinterprets and conversions
+inline uint8x16_t vreinterpretq_u8_f32(float32x4_t v) noexcept { return trt_neon::bit_cast<uint8x16_t>(v); }
+inline float32x4_t vreinterpretq_f32_u8(uint8x16_t v) noexcept { return trt_neon::bit_cast<float32x4_t>(v); }
+inline int32x4_t vreinterpretq_s32_u8(uint8x16_t v) noexcept { return trt_neon::bit_cast<int32x4_t>(v); }
+inline uint8x16_t vreinterpretq_u8_s32(int32x4_t v) noexcept { return trt_neon::bit_cast<uint8x16_t>(v); }
+inline uint8x16_t vreinterpretq_u8_u32(uint32x4_t v) noexcept { return trt_neon::bit_cast<uint8x16_t>(v); }
+inline uint32x4_t vreinterpretq_u32_s32(int32x4_t v) noexcept { return trt_neon::bit_cast<uint32x4_t>(v); }
+inline int32x4_t vreinterpretq_s32_u32(uint32x4_t v) noexcept { return trt_neon::bit_cast<int32x4_t>(v); }
+inline uint16x4_t vreinterpret_u16_f16(float16x4_t v) noexcept { return trt_neon::bit_cast<uint16x4_t>(v); }
+inline float16x4_t vreinterpret_f16_u16(uint16x4_t v) noexcept { return trt_neon::bit_cast<float16x4_t>(v); }
+
+inline float32x4_t vcvtq_f32_s32(int32x4_t v) noexcept
+{
+    return trt_neon::map<float32x4_t>([&](int i) { return static_cast<float>(v.lanes[i]); });
+}
+
+inline float16x4_t vcvt_f16_f32(float32x4_t v) noexcept
+{
+    return trt_neon::map<float16x4_t>([&](int i) { return trt_neon::to_half(v.lanes[i]); });
+}
+
+inline float32x4_t vcvt_f32_f16(float16x4_t v) noexcept
+{
+    return trt_neon::map<float32x4_t>([&](int i) { return trt_neon::from_half(v.lanes[i]); });
+}
@@ -0,0 +1,131 @@
+#include "TensorRT_CPP/TRT_cpu_backend.hpp"
+#include "tests/test_util.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+    /// @brief One set of I/O buffers of a backend; the input is filled with a constant byte.
+    struct Buffers
+    {
+        std::vector<std::vector<uint8_t>> storage_in, storage_out;
+        std::vector<void*> in, out;
+
+        Buffers(const InferenceBackend& backend, uint8_t fill)
+        {
+            for (size_t bytes : backend.get_input_size_bytes())
+            {
+                this->storage_in.emplace_back(bytes, fill);
+                this->in.push_back(this->storage_in.back().data());
+            }
+            for (size_t bytes : backend.get_output_size_bytes())
+            {
+                this->storage_out.emplace_back(bytes);
+                this->out.push_back(this->storage_out.back().data());
+            }
+        }
+
+        void fill_input(uint8_t fill)
+        {
+            for (auto& input : this->storage_in) std::memset(input.data(), fill, input.size());
+        }
+    };
+
+    CpuBackendConfig async_config(int contexts)
+    {
+        CpuBackendConfig config = CpuInferenceBackend::yolo_nms_config();
+        config.contexts = contexts;
+        config.service_time = std::chrono::milliseconds(30);
+        return config;
+    }
+}
+
+int main()
+{
+    CpuInferenceBackend backend(async_config(3));
+    const auto& in_sizes = backend.get_input_size_bytes();
+    const auto& out_sizes = backend.get_output_size_bytes();
+    TEST_CHECK(backend.get_num_async_slots() == 3);
+
+    // Reference outputs of three different inputs.
+    std::vector<Buffers> reference, buffers;
+    for (uint8_t fill : {1, 2, 3})
+    {
+        reference.emplace_back(backend, fill);
+        buffers.emplace_back(backend, fill);
+        TEST_CHECK(backend.infer_b(reference.back().in, in_sizes, reference.back().out, out_sizes));
+    }
+
+    // Tickets are unique and increasing; a context is held per in-flight inference.
+    InferTicket tickets[3] = {};
+    for (int i = 0; i < 3; i++)
+    {
+        TEST_CHECK(backend.infer_async(buffers[i].in, in_sizes, tickets[i]));
+        TEST_CHECK(tickets[i] != INVALID_INFER_TICKET);
+        TEST_CHECK(i == 0 || tickets[i] > tickets[i - 1]);
+    }
+    TEST_CHECK(backend.get_num_free_contexts() == 0);
+
+    // Context exhaustion: a fourth submission fails without a ticket.
+    InferTicket extra = 42;
+    TEST_CHECK(!backend.infer_async(buffers[0].in, in_sizes, extra));
+    TEST_CHECK(extra == INVALID_INFER_TICKET);
+
+    // Still running: polling reports pending; results come back in any order and match the synchronous ones.
+    TEST_CHECK(backend.retrieve_infer_result_async(tickets[1], buffers[1].out, out_sizes, false) == AsyncInferStatus::kPending);
+    for (int i : {2, 0, 1})
+    {
+        TEST_CHECK(backend.retrieve_infer_result_async(tickets[i], buffers[i].out, out_sizes) == AsyncInferStatus::kReady);
+        TEST_CHECK(buffers[i].storage_out == reference[i].storage_out);
+    }
+
+    // A ticket is spent once retrieved; the invalid ticket never refers to anything.
+    TEST_CHECK(backend.retrieve_infer_result_async(tickets[0], buffers[0].out, out_sizes) == AsyncInferStatus::kInvalidTicket);
+    TEST_CHECK(backend.retrieve_infer_result_async(INVALID_INFER_TICKET, buffers[0].out, out_sizes)
+        == AsyncInferStatus::kInvalidTicket);
+    TEST_CHECK(backend.get_num_free_contexts() == 3);
+
+    // Rejected output buffers leave the ticket valid.
+    InferTicket ticket = INVALID_INFER_TICKET;
+    TEST_CHECK(backend.infer_async(buffers[0].in, in_sizes, ticket));
+    TEST_CHECK(ticket > tickets[2]);
+    std::vector<size_t> short_sizes = out_sizes;
+    short_sizes[1] /= 2;
+    TEST_CHECK(backend.retrieve_infer_result_async(ticket, buffers[0].out, short_sizes) == AsyncInferStatus::kFailed);
+    TEST_CHECK(backend.retrieve_infer_result_async(ticket, buffers[0].out, out_sizes) == AsyncInferStatus::kReady);
+
+    // The inputs of an in-flight inference are read until it is retrieved (as the GPU may read pinned inputs
+    // after infer_async() returns): refilling them early changes the result, so callers must not.
+    TEST_CHECK(backend.infer_async(buffers[0].in, in_sizes, ticket));
+    buffers[0].fill_input(2);
+    TEST_CHECK(backend.retrieve_infer_result_async(ticket, buffers[0].out, out_sizes) == AsyncInferStatus::kReady);
+    TEST_CHECK(buffers[0].storage_out == reference[1].storage_out);
+    TEST_CHECK(buffers[0].storage_out != reference[0].storage_out);
+
+    // Two threads retrieving one ticket: only one collects it, the other finds it claimed (or already spent).
+    TEST_CHECK(backend.infer_async(buffers[0].in, in_sizes, ticket));
+    AsyncInferStatus statuses[2] = {};
+    std::thread other([&] { statuses[1] = backend.retrieve_infer_result_async(ticket, buffers[1].out, out_sizes); });
+    statuses[0] = backend.retrieve_infer_result_async(ticket, buffers[2].out, out_sizes);
+    other.join();
+    TEST_CHECK((statuses[0] == AsyncInferStatus::kReady) != (statuses[1] == AsyncInferStatus::kReady));
+    TEST_CHECK(statuses[0] == AsyncInferStatus::kInvalidTicket || statuses[1] == AsyncInferStatus::kInvalidTicket);
+    TEST_CHECK(backend.get_num_free_contexts() == 3);
+
+    // A polled ticket that is still pending stays retrievable.
+    TEST_CHECK(backend.infer_async(buffers[0].in, in_sizes, ticket));
+    TEST_CHECK(backend.retrieve_infer_result_async(ticket, buffers[0].out, out_sizes, false) == AsyncInferStatus::kPending);
+    TEST_CHECK(backend.retrieve_infer_result_async(ticket, buffers[0].out, out_sizes) == AsyncInferStatus::kReady);
+
+    // Synchronous calls share the contexts: an in-flight inference holds its context until retrieved.
+    CpuInferenceBackend single(async_config(1));
+    Buffers one(single, 1);
+    TEST_CHECK(single.infer_async(one.in, single.get_input_size_bytes(), ticket));
+    TEST_CHECK(single.get_num_free_contexts() == 0);
+    TEST_CHECK(single.retrieve_infer_result_async(ticket, one.out, single.get_output_size_bytes()) == AsyncInferStatus::kReady);
+    TEST_CHECK(single.infer_b(one.in, single.get_input_size_bytes(), one.out, single.get_output_size_bytes()));
+
+    return TRT::YOLO::Test::test_exit_code("test_async_inference");
+}
@@ -0,0 +1,128 @@
+#include "TensorRT_CPP/TRT_context_pool.hpp"
+#include "TensorRT_CPP/TRT_cpu_backend.hpp"
+#include "tests/test_util.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    /// @brief Long enough for a started thread to be queued in lease() before the next one starts.
+    constexpr std::chrono::milliseconds QUEUE_DELAY(50);
+
+    void check_round_robin()
+    {
+        ContextPool pool(3);
+        TEST_CHECK(pool.size() == 3);
+        TEST_CHECK(ContextPool(0).size() == 1);
+
+        // Free contexts are handed out in the order they were returned.
+        for (int round = 0; round < 3; round++)
+        {
+            for (int expected = 0; expected < 3; expected++)
+            {
+                ContextLease lease = pool.lease();
+                TEST_CHECK(lease.index() == expected);
+            }
+        }
+        const ContextPoolStats stats = pool.get_stats();
+        TEST_CHECK(stats.leases == 9);
+        TEST_CHECK(stats.contended_leases == 0);
+        TEST_CHECK(stats.leases_per_context == std::vector<uint64_t>({3, 3, 3}));
+
+        // Leases are exclusive, move-only and can be returned early.
+        ContextLease a = pool.lease();
+        ContextLease b = std::move(a);
+        TEST_CHECK(!a && b);
+        TEST_CHECK(pool.available() == 2);
+        b.release();
+        b.release();
+        TEST_CHECK(!b && pool.available() == 3);
+    }
+
+    void check_arrival_order()
+    {
+        // Threads queued on a full pool are served strictly in the order they started waiting.
+        ContextPool pool(1);
+        ContextLease held = pool.lease();
+        std::mutex order_mutex;
+        std::vector<int> order;
+        std::vector<std::thread> waiters;
+        for (int i = 0; i < 5; i++)
+        {
+            waiters.emplace_back([&, i]
+            {
+                ContextLease lease = pool.lease();
+                std::lock_guard<std::mutex> lock(order_mutex);
+                order.push_back(i);
+            });
+            std::this_thread::sleep_for(QUEUE_DELAY);
+        }
+        held.release();
+        for (auto& waiter : waiters) waiter.join();
+        TEST_CHECK(order == std::vector<int>({0, 1, 2, 3, 4}));
+
+        const ContextPoolStats stats = pool.get_stats();
+        TEST_CHECK(stats.contended_leases == 5);
+        TEST_CHECK(stats.max_wait_ms > 0.0);
+    }
+
+    void check_try_lease_does_not_jump_queue()
+    {
+        ContextPool pool(2);
+        ContextLease first = pool.lease();
+        ContextLease second = pool.lease();
+        TEST_CHECK(!pool.try_lease());
+
+        std::thread waiter([&] { ContextLease lease = pool.lease(); });
+        std::this_thread::sleep_for(QUEUE_DELAY);
+        first.release();
+
+        // The freed context belongs to the waiter, whether or not it has woken up yet.
+        TEST_CHECK(!pool.try_lease());
+        waiter.join();
+        ContextLease after = pool.try_lease();
+        TEST_CHECK(after);
+        TEST_CHECK(pool.get_stats().failed_try_leases == 2);
+    }
+
+    void check_foreign_leases()
+    {
+        ContextPool pool(2), other(2);
+        ContextLease mine = pool.lease();
+        ContextLease foreign = other.lease(); // Same index as mine
+        TEST_CHECK(mine.index() == foreign.index());
+        TEST_CHECK(pool.owns(mine) && !pool.owns(foreign) && other.owns(foreign));
+        TEST_CHECK(!pool.owns(ContextLease()));
+        ContextLease moved = std::move(mine);
+        TEST_CHECK(pool.owns(moved) && !pool.owns(mine));
+
+        // A backend runs only on its own contexts: a lease of another backend's context is refused, since its
+        // real holder may be running on that context at the same time.
+        CpuInferenceBackend backend(CpuInferenceBackend::yolo_nms_config());
+        CpuInferenceBackend other_backend(CpuInferenceBackend::yolo_nms_config());
+        std::vector<std::vector<uint8_t>> inputs, outputs;
+        std::vector<void*> in, out;
+        for (size_t bytes : backend.get_input_size_bytes()) in.push_back(inputs.emplace_back(bytes).data());
+        for (size_t bytes : backend.get_output_size_bytes()) out.push_back(outputs.emplace_back(bytes).data());
+        const ContextLease own_lease = backend.lease_context();
+        const ContextLease other_lease = other_backend.lease_context();
+        TEST_CHECK(own_lease.index() == other_lease.index());
+        TEST_CHECK(backend.owns_context(own_lease) && !backend.owns_context(other_lease));
+        TEST_CHECK(backend.infer_b(own_lease, in, backend.get_input_size_bytes(), out, backend.get_output_size_bytes()));
+        TEST_CHECK(!backend.infer_b(other_lease, in, backend.get_input_size_bytes(), out,
+            backend.get_output_size_bytes()));
+        TEST_CHECK(!backend.infer_b(ContextLease(), in, backend.get_input_size_bytes(), out,
+            backend.get_output_size_bytes()));
+    }
+}
+
+int main()
+{
+    check_round_robin();
+    check_arrival_order();
+    check_try_lease_does_not_jump_queue();
+    check_foreign_leases();
+    return TRT::YOLO::Test::test_exit_code("test_context_pool");
+}
@@ -0,0 +1,51 @@
+#include "include/TRT_YOLO_detections.hpp"
+#include "tests/test_util.hpp"
+
+#include <utility>
+
+namespace
+{
+    using namespace TRT::YOLO;
+
+    void check_moves()
+    {
+        DetectionBatch source(5);
+        source.push_back(1.0f, 2.0f, 3.0f, 4.0f, 0.5f, 7);
+        source.push_back(5.0f, 6.0f, 7.0f, 8.0f, 0.25f, 2);
+        const float* x = source.x();
+
+        // Construction takes the storage; the source is left empty and owns nothing.
+        DetectionBatch moved(std::move(source));
+        TEST_CHECK(moved.size() == 2 && moved.capacity() == 5 && moved.x() == x);
+        TEST_CHECK(source.size() == 0 && source.capacity() == 0 && source.padded_capacity() == 0);
+        TEST_CHECK(source.x() == nullptr && source.class_id() == nullptr);
+
+        // Reusing the moved-from batch cannot write into the new owner's arrays.
+        TEST_CHECK(!source.push_back(9.0f, 9.0f, 9.0f, 9.0f, 0.9f, 9));
+        TEST_CHECK(source.dropped() == 1);
+        source.clear();
+        TEST_CHECK(moved.size() == 2 && moved.x()[0] == 1.0f && moved.class_id()[1] == 2);
+
+        // Assignment too, and the target's previous storage is freed rather than left behind.
+        DetectionBatch target(100);
+        target.push_back(0.0f, 0.0f, 1.0f, 1.0f, 0.1f, 0);
+        target = std::move(moved);
+        TEST_CHECK(target.size() == 2 && target.capacity() == 5 && target.x() == x);
+        TEST_CHECK(moved.size() == 0 && moved.capacity() == 0 && moved.x() == nullptr);
+        TEST_CHECK(target[1].confidence() == 0.25f && target.dropped() == 0);
+
+        // A moved-from batch is usable again after reset().
+        moved.reset(3);
+        TEST_CHECK(moved.push_back(1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1) && moved.size() == 1 && target.size() == 2);
+
+        DetectionBatch& self = target;
+        target = std::move(self);
+        TEST_CHECK(target.size() == 2 && target.x() == x);
+    }
+}
+
+int main()
+{
+    check_moves();
+    return TRT::YOLO::Test::test_exit_code("test_detection_batch");
+}
@@ -0,0 +1,151 @@
+#include "include/TRT_YOLO.hpp"
+#include "tests/test_util.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+// Every heap allocation of the process is counted, so the steady-state frame loop can be checked for none.
+static std::atomic<long> allocations{0};
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size != 0 ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    const size_t align = static_cast<size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (std::max<size_t>(size, 1) + align - 1) / align * align))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace
+{
+    using namespace TRT::YOLO;
+
+    const char* const NMS_OUTPUTS =
+        "output num_dets {b}x1 i32\n"
+        "output bboxes {b}x100x4\n"
+        "output scores {b}x100\n"
+        "output labels {b}x100 i32\n"
+        "detections 20\n"
+        "contexts 2\n";
+
+    std::string nms_model(const std::string& input, const std::string& batch, const std::string& extra = "")
+    {
+        std::string outputs = NMS_OUTPUTS;
+        for (size_t at = outputs.find("{b}"); at != std::string::npos; at = outputs.find("{b}"))
+        {
+            outputs.replace(at, 3, batch);
+        }
+        return "input images " + input + "\n" + outputs + extra;
+    }
+
+    struct Model
+    {
+        const char* name;
+        std::string descriptor;
+        float confidence_threshold;
+    };
+
+    /// @brief Runs every entry point of the per-frame loop once to warm up, then again and again, counting allocations.
+    void check_model(const Model& model, const std::vector<ImageView>& images, std::vector<uint8_t>& nv12_frame)
+    {
+        DetectorConfig config;
+        config.confidence_threshold = model.confidence_threshold;
+        Detector detector(Test::write_temp_file(std::string("alloc_") + model.name + ".cpudesc", model.descriptor), config);
+
+        std::vector<DetectionBatch> results;
+        for (size_t i = 0; i < images.size(); i++)
+        {
+            results.emplace_back(detector.get_max_detections());
+        }
+        DetectionBatch single(detector.get_max_detections());
+        std::vector<float> tensor(detector.get_frame_elements());
+        PreprocessWorkspace workspace;
+        const LetterboxInfo letterbox = preprocess_image(images[0], detector.get_preprocess_config(), tensor.data(), workspace);
+
+        ImageView nv12;
+        nv12.data = nv12_frame.data();
+        nv12.width = 640;
+        nv12.height = 480;
+        nv12.format = PixelFormat::kNV12;
+
+        auto frame_loop = [&]()
+        {
+            TEST_CHECK(detector.identify_objects(images.data(), images.size(), results.data()) >= 0);
+            TEST_CHECK(detector.identify_objects(images[1], single) >= 0);
+            TEST_CHECK(detector.identify_objects(nv12, single) >= 0);
+            TEST_CHECK(detector.identify_objects(tensor.data(), tensor.size(), single, &letterbox) >= 0);
+        };
+        frame_loop();
+        frame_loop();
+
+        const long before = allocations.load();
+        for (int i = 0; i < 5; i++)
+        {
+            frame_loop();
+        }
+        const long steady_state = allocations.load() - before;
+        std::cout << model.name << " (batch " << detector.get_max_batch() << "): " << steady_state
+                  << " allocations in 5 steady-state iterations" << std::endl;
+        TEST_CHECK(steady_state == 0);
+    }
+}
+
+int main()
+{
+    using namespace TRT::YOLO;
+
+    // Frames of several sizes and formats, so letterboxing and every staging path are exercised.
+    std::mt19937 rng(5);
+    const int sizes[][2] = {{1280, 720}, {1920, 1080}, {640, 480}, {300, 900}, {3840, 2160}};
+    std::vector<std::vector<uint8_t>> pixels;
+    std::vector<ImageView> images;
+    for (const auto& size : sizes)
+    {
+        pixels.emplace_back(static_cast<size_t>(size[0]) * size[1] * 3);
+        for (uint8_t& value : pixels.back()) value = static_cast<uint8_t>(rng());
+    }
+    for (size_t i = 0; i < pixels.size(); i++)
+    {
+        ImageView image;
+        image.data = pixels[i].data();
+        image.width = sizes[i][0];
+        image.height = sizes[i][1];
+        image.format = i % 2 != 0 ? PixelFormat::kBGR8 : PixelFormat::kRGB8;
+        images.push_back(image);
+    }
+    std::vector<uint8_t> nv12(640 * 480 * 3 / 2);
+    for (uint8_t& value : nv12) value = static_cast<uint8_t>(rng());
+
+    const Model models[] = {
+        {"batch1", nms_model("1x3x640x640", "1"), 0.1f},
+        {"batch4", nms_model("4x3x640x640", "4"), 0.1f},
+        {"batch4_f16", nms_model("4x3x640x640 f16", "4"), 0.1f},
+        {"dynamic", nms_model("-1x3x640x640", "-1", "profile 0 images 1x3x640x640 4x3x640x640 8x3x640x640\n"), 0.1f},
+        {"raw_head", "input images 1x3x640x640\noutput output0 1x84x8400 f16\n", 0.5f},
+        {"raw_head_batch4", "input images 4x3x640x640 f16\noutput output0 4x84x8400 f16\n", 0.5f},
+    };
+    for (const Model& model : models)
+    {
+        check_model(model, images, nv12);
+    }
+    return Test::test_exit_code("test_detector_allocations");
+}
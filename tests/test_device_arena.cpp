@@ -0,0 +1,81 @@
+#include "TensorRT_CPP/TRT_device_arena.hpp"
+#include "tests/test_util.hpp"
+
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+    void check_layout()
+    {
+        // Blocks go back to back, each starting on the next boundary; the tail is rounded up too.
+        const ArenaPlan plan = plan_arena({1000, 256, 1, 0, 4800001}, 256);
+        TEST_CHECK(plan.alignment == 256 && plan.sizes == std::vector<size_t>({1000, 256, 1, 0, 4800001}));
+        TEST_CHECK(plan.offsets == std::vector<size_t>({0, 1024, 1280, 1536, 1536}));
+        TEST_CHECK(plan.payload_bytes == 1000 + 256 + 1 + 4800001);
+        TEST_CHECK(plan.total_bytes == 4801792); // 1536 + 4800001, rounded up to 256
+        TEST_CHECK(plan.padding_bytes() == plan.total_bytes - plan.payload_bytes);
+
+        // block() offsets from any base.
+        char base[4];
+        TEST_CHECK(plan.block(base, 1) == base + 1024);
+
+        // Degenerate arenas.
+        TEST_CHECK(plan_arena({}).total_bytes == 0 && plan_arena({}).offsets.empty());
+        const ArenaPlan empty_blocks = plan_arena({0, 0, 0});
+        TEST_CHECK(empty_blocks.offsets == std::vector<size_t>({0, 0, 0}) && empty_blocks.total_bytes == 0);
+        TEST_CHECK(plan_arena({512, 512}).padding_bytes() == 0 && plan_arena({512, 512}).offsets[1] == 512);
+        TEST_CHECK(plan_arena({7}, 1).total_bytes == 7 && plan_arena({7}).alignment == DEVICE_ARENA_ALIGNMENT);
+    }
+
+    void check_random_layouts()
+    {
+        std::mt19937 rng(5);
+        bool aligned = true, disjoint = true, fits = true, tight = true;
+        for (int trial = 0; trial < 2000; trial++)
+        {
+            const size_t alignment = size_t(1) << (rng() % 13);
+            std::vector<size_t> sizes(rng() % 12);
+            for (size_t& size : sizes) size = rng() % 5 == 0 ? 0 : rng() % 100000;
+            const ArenaPlan plan = plan_arena(sizes, alignment);
+
+            size_t end = 0, payload = 0;
+            for (size_t i = 0; i < sizes.size(); i++)
+            {
+                aligned &= plan.offsets[i] % alignment == 0;
+                disjoint &= plan.offsets[i] >= end;
+                tight &= plan.offsets[i] < end + alignment; // No more padding than needed
+                end = plan.offsets[i] + sizes[i];
+                payload += sizes[i];
+            }
+            fits &= plan.total_bytes >= end && plan.total_bytes < end + alignment && plan.total_bytes % alignment == 0;
+            fits &= plan.payload_bytes == payload && plan.padding_bytes() < (sizes.size() + 1) * alignment;
+        }
+        TEST_CHECK(aligned && disjoint && fits && tight);
+    }
+
+    void check_invalid_alignment()
+    {
+        for (size_t alignment : {size_t(0), size_t(3), size_t(100), size_t(257)})
+        {
+            bool threw = false;
+            try
+            {
+                plan_arena({16}, alignment);
+            }
+            catch (const std::invalid_argument&)
+            {
+                threw = true;
+            }
+            TEST_CHECK(threw);
+        }
+    }
+}
+
+int main()
+{
+    check_layout();
+    check_random_layouts();
+    check_invalid_alignment();
+    return TRT::YOLO::Test::test_exit_code("test_device_arena");
+}
@@ -0,0 +1,126 @@
+#include "TensorRT_CPP/TRT_host_allocator.hpp"
+#include "tests/test_util.hpp"
+
+#include <cstdint>
+
+namespace
+{
+    /// @brief MallocHostAllocator that counts what it hands out and gets back.
+    class CountingAllocator : public MallocHostAllocator
+    {
+    public:
+        CountingAllocator(size_t& allocations, size_t& deallocations)
+            : allocations_(allocations), deallocations_(deallocations)
+        {
+        }
+
+        void* allocate(size_t bytes) override
+        {
+            this->allocations_++;
+            return MallocHostAllocator::allocate(bytes);
+        }
+
+        void deallocate(void* ptr, size_t bytes) override
+        {
+            this->deallocations_++;
+            MallocHostAllocator::deallocate(ptr, bytes);
+        }
+
+    private:
+        size_t& allocations_;
+        size_t& deallocations_;
+    };
+
+    void check_size_classes()
+    {
+        HostBufferPool pool(std::make_unique<MallocHostAllocator>(), 4096);
+        TEST_CHECK(pool.size_class(0) == 4096 && pool.size_class(1) == 4096 && pool.size_class(4096) == 4096);
+        TEST_CHECK(pool.size_class(4097) == 5120);
+        TEST_CHECK(pool.size_class(8192) == 8192 && pool.size_class(8193) == 10240);
+        TEST_CHECK(pool.size_class(640 * 640 * 3 * 4) == 5242880);
+
+        // Never smaller than the request, at most 25% larger, and monotonic.
+        size_t previous = 0;
+        bool covers = true, slack = true, monotonic = true;
+        for (size_t bytes = 1; bytes < (size_t(1) << 26); bytes = bytes * 9 / 8 + 1)
+        {
+            const size_t size = pool.size_class(bytes);
+            covers &= size >= bytes;
+            slack &= bytes <= 4096 || size * 4 <= bytes * 5;
+            monotonic &= size >= previous;
+            previous = size;
+        }
+        TEST_CHECK(covers && slack && monotonic);
+
+        // The smallest class is at least 64 bytes, so buffers keep their alignment.
+        HostBufferPool tiny(std::make_unique<MallocHostAllocator>(), 1);
+        TEST_CHECK(tiny.size_class(1) == 64);
+    }
+
+    void check_reuse_and_stats()
+    {
+        size_t allocations = 0, deallocations = 0;
+        {
+            HostBufferPool pool(std::make_unique<CountingAllocator>(allocations, deallocations));
+            TEST_CHECK(std::string(pool.get_allocator_name()) == "malloc");
+
+            // A "load": three staging buffers.
+            void* a = pool.acquire(100000);
+            void* b = pool.acquire(100000);
+            void* c = pool.acquire(5000);
+            TEST_CHECK(a && b && c && a != b);
+            TEST_CHECK(reinterpret_cast<uintptr_t>(a) % 64 == 0 && reinterpret_cast<uintptr_t>(c) % 64 == 0);
+            const size_t big = pool.size_class(100000), small = pool.size_class(5000);
+            HostBufferPoolStats stats = pool.get_stats();
+            TEST_CHECK(stats.upstream_allocations == 3 && allocations == 3 && stats.reuses == 0);
+            TEST_CHECK(stats.acquisitions == 3 && stats.bytes_in_use == 2 * big + small);
+            TEST_CHECK(stats.upstream_bytes == 2 * big + small && stats.peak_bytes_in_use == 2 * big + small);
+
+            // Unloading caches them; reloading the same geometry (or a close size) reuses them.
+            pool.release(a);
+            pool.release(b);
+            pool.release(c);
+            pool.release(nullptr);
+            stats = pool.get_stats();
+            TEST_CHECK(stats.releases == 3 && stats.bytes_in_use == 0 && stats.bytes_cached == 2 * big + small);
+            void* a2 = pool.acquire(100000);
+            void* b2 = pool.acquire(big - 1);
+            void* c2 = pool.acquire(4500);
+            TEST_CHECK((a2 == a || a2 == b) && (b2 == a || b2 == b) && a2 != b2 && c2 == c);
+            stats = pool.get_stats();
+            TEST_CHECK(stats.upstream_allocations == 3 && allocations == 3 && stats.reuses == 3);
+            TEST_CHECK(stats.bytes_cached == 0 && stats.peak_bytes_in_use == 2 * big + small);
+
+            // A larger request is a new class; the peak follows.
+            void* d = pool.acquire(big + 1);
+            stats = pool.get_stats();
+            TEST_CHECK(stats.upstream_allocations == 4 && stats.peak_bytes_in_use == 2 * big + small + pool.size_class(big + 1));
+
+            // A buffer the pool did not hand out (or one released twice) is ignored.
+            int foreign = 0;
+            pool.release(&foreign);
+            pool.release(d);
+            pool.release(d);
+            stats = pool.get_stats();
+            TEST_CHECK(stats.releases == 4 && stats.bytes_cached == pool.size_class(big + 1));
+
+            // trim() frees the cached buffers only.
+            pool.trim();
+            stats = pool.get_stats();
+            TEST_CHECK(deallocations == 1 && stats.bytes_cached == 0);
+            TEST_CHECK(stats.upstream_bytes == 2 * big + small && stats.bytes_in_use == 2 * big + small);
+            pool.release(a2);
+            pool.release(b2);
+            pool.release(c2);
+        }
+        // Destruction frees the rest.
+        TEST_CHECK(allocations == 4 && deallocations == 4);
+    }
+}
+
+int main()
+{
+    check_size_classes();
+    check_reuse_and_stats();
+    return TRT::YOLO::Test::test_exit_code("test_host_buffer_pool");
+}
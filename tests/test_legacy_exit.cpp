@@ -0,0 +1,22 @@
+#include "TensorRT_CPP/TRT_cpu_backend.hpp"
+#include "include/TRT_YOLO.hpp"
+#include "tests/test_util.hpp"
+
+// Callers of the single-model interface may exit without unload_model() (the original API had none): the model
+// is then destroyed at exit, possibly after other statics. Its buffers must still go back to a live pool, which
+// CTest checks by failing on any "[HOST_POOL]" complaint in the output.
+int main()
+{
+    using namespace TRT::YOLO;
+    TEST_CHECK(load_model(std::make_unique<CpuInferenceBackend>(CpuInferenceBackend::yolo_nms_config())) == 0);
+
+    ImageView image;
+    image.width = 320;
+    image.height = 240;
+    image.format = PixelFormat::kBGR8;
+    std::vector<uint8_t> pixels(image.num_bytes(), 90);
+    image.data = pixels.data();
+    DetectionBatch results(get_max_detections());
+    TEST_CHECK(identify_objects(image, results) >= 0);
+    return Test::test_exit_code("test_legacy_exit");
+}
@@ -0,0 +1,247 @@
+#include "include/TRT_YOLO.hpp"
+#include "include/TRT_YOLO_model_descriptor.hpp"
+#include "tests/test_util.hpp"
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    using namespace TRT::YOLO;
+
+    const char* const NMS_MODEL =
+        "input images 1x3x640x640\n"
+        "output num_dets 1x1 i32\n"
+        "output bboxes 1x100x4 f16\n"
+        "output scores 1x100 f16\n"
+        "output labels 1x100 i32\n";
+
+    const char* const RAW_MODEL =
+        "input images 1x3x320x320 f16\n"
+        "output output0 1x84x2100 f16\n";
+
+    ModelDescriptor parse(const std::string& text, const ModelDescriptor& defaults = ModelDescriptor())
+    {
+        std::stringstream in(text);
+        return ModelDescriptor::parse(in, defaults);
+    }
+
+    /// @brief TRUE if fn throws a std::runtime_error whose message contains expected
+    template <typename Fn>
+    bool throws(Fn fn, const std::string& expected)
+    {
+        try
+        {
+            fn();
+        }
+        catch (const std::runtime_error& e)
+        {
+            if (std::string(e.what()).find(expected) != std::string::npos)
+            {
+                return true;
+            }
+            std::cerr << "Unexpected error: " << e.what() << std::endl;
+            return false;
+        }
+        return false;
+    }
+
+    void check_parse()
+    {
+        const ModelDescriptor descriptor = parse(
+            "name = yolov8n-coco   # comment\n"
+            "\n"
+            "[input]\n"
+            "tensor = images\n"
+            "width = 640\n"
+            "height = 480\n"
+            "channels = 3\n"
+            "dtype = f16\n"
+            "format = bgr\n"
+            "scale = 1/255\n"
+            "mean = 0.485, 0.456 0.406\n"
+            "std = 0.5\n"
+            "[ output ]\n"
+            "layout = raw_v11\n"
+            "classes = 80\n"
+            "rows = 8400\n"
+            "dtype = f16\n"
+            "bboxes = boxes\n"
+            "[postprocess]\n"
+            "confidence = 0.3\n"
+            "class_thresholds = coco.thresholds\n"
+            "cpu_nms = yes\n"
+            "iou = 0.6\n"
+            "top_k = 50\n"
+            "max_candidates = 1000\n"
+            "class_agnostic = true\n");
+        TEST_CHECK(descriptor.name == "yolov8n-coco" && descriptor.path.empty());
+        TEST_CHECK(descriptor.input_tensor == "images" && descriptor.input_width == 640 && descriptor.input_height == 480);
+        TEST_CHECK(descriptor.input_channels == 3 && descriptor.has_input_type && descriptor.input_type == TensorDataType::kHALF);
+        TEST_CHECK(descriptor.input_format == InputFormat::kBGR && descriptor.input_scale == 1.0f / 255.0f);
+        TEST_CHECK(descriptor.input_mean[0] == 0.485f && descriptor.input_mean[1] == 0.456f && descriptor.input_mean[2] == 0.406f);
+        TEST_CHECK(descriptor.input_std[0] == 0.5f && descriptor.input_std[2] == 0.5f);
+        TEST_CHECK(descriptor.has_layout && descriptor.layout == OutputLayout::kRawHead);
+        TEST_CHECK(descriptor.num_classes == 80 && descriptor.rows == 8400 && descriptor.has_output_type);
+        TEST_CHECK(descriptor.bboxes_tensor == "boxes" && descriptor.scores_tensor == OUTPUT_NAME_SCORES);
+        TEST_CHECK(descriptor.confidence_threshold == 0.3f && descriptor.class_thresholds_path == "coco.thresholds");
+        TEST_CHECK(descriptor.cpu_nms && descriptor.nms.iou_threshold == 0.6f && descriptor.nms.top_k == 50);
+        TEST_CHECK(descriptor.nms.max_candidates == 1000 && descriptor.nms.class_agnostic);
+
+        // Keys left out keep the defaults the descriptor is parsed over.
+        ModelDescriptor defaults;
+        defaults.confidence_threshold = 0.7f;
+        defaults.nms.iou_threshold = 0.3f;
+        const ModelDescriptor partial = parse("[postprocess]\niou = 1\n", defaults);
+        TEST_CHECK(partial.confidence_threshold == 0.7f && partial.nms.iou_threshold == 1.0f);
+        TEST_CHECK(!partial.has_layout && !partial.has_input_type && partial.input_width == 0);
+    }
+
+    void check_parse_errors()
+    {
+        const std::pair<const char*, const char*> cases[] = {
+            {"[model]\n", "unknown section '[model]'"},
+            {"[input\n", "unknown section"},
+            {"width = 640\n", "unknown key 'width' outside a section"},
+            {"[input]\nsize = 640\n", "unknown key 'size' in [input]"},
+            {"[output]\nanchors = 8400\n", "unknown key 'anchors' in [output]"},
+            {"[postprocess]\nnms = true\n", "unknown key 'nms' in [postprocess]"},
+            {"[input]\nwidth\n", "expected '<key> = <value>'"},
+            {"[input]\nwidth = \n", "expected '<key> = <value>'"},
+            {"[input]\nwidth = 0\n", "width must be positive"},
+            {"[input]\nwidth = -640\n", "expected a non-negative integer"},
+            {"[input]\nscale = 1/0\n", "division by zero"},
+            {"[input]\nscale = 1/x\n", "expected a number, got 'x'"},
+            {"[input]\nscale = 0.5.5\n", "expected a number"},
+            {"[input]\nscale = -1\n", "scale must be positive"},
+            {"[input]\nmean = 0.4, 0.5\n", "expected 1 or 3 values"},
+            {"[input]\nmean = 1 2 3 4\n", "expected 3 values"},
+            {"[input]\nstd = 1, 0, 1\n", "std must not be zero"},
+            {"[input]\nformat = yuv\n", "unknown input format 'yuv'"},
+            {"[input]\ndtype = f64\n", "unknown data type 'f64'"},
+            {"[output]\nlayout = raw_v5\n", "unknown layout 'raw_v5'"},
+            {"[postprocess]\ncpu_nms = maybe\n", "expected true or false"},
+            {"[postprocess]\niou = 0\n", "iou must be in (0, 1]"},
+            {"[postprocess]\niou = -0.5\n", "iou must be in (0, 1]"},
+            {"[postprocess]\niou = 1.5\n", "iou must be in (0, 1]"},
+            {"[postprocess]\nconfidence = nan\n", "expected a number"},
+            {"[postprocess]\nconfidence = 1e30/1e-30\n", "confidence must be finite"},
+        };
+        for (const auto& [text, message] : cases)
+        {
+            const bool ok = throws([&] { parse(text); }, message);
+            if (!ok) std::cerr << "Descriptor: " << text;
+            TEST_CHECK(ok);
+        }
+
+        // Errors name their line.
+        TEST_CHECK(throws([] { parse("name = a\n\n# comment\n[input]\nwidth = x\n"); }, "line 5: "));
+    }
+
+    void check_files()
+    {
+        const std::filesystem::path dir = std::filesystem::temp_directory_path() / "trt_yolo_test_descriptor";
+        std::filesystem::create_directories(dir);
+        const std::string path = (dir / "model.ini").string();
+
+        // A relative class_thresholds path set by the file is resolved against its directory; an absolute one,
+        // or one inherited from the defaults, is kept as is.
+        std::ofstream(path) << "[postprocess]\nclass_thresholds = model.thresholds\n";
+        TEST_CHECK(ModelDescriptor::load(path).class_thresholds_path == (dir / "model.thresholds").string());
+        TEST_CHECK(ModelDescriptor::load(path).path == path);
+        std::ofstream(path) << "[postprocess]\nclass_thresholds = /etc/model.thresholds\n";
+        TEST_CHECK(ModelDescriptor::load(path).class_thresholds_path == "/etc/model.thresholds");
+        std::ofstream(path) << "name = model\n";
+        ModelDescriptor defaults;
+        defaults.class_thresholds_path = "configured.thresholds";
+        TEST_CHECK(ModelDescriptor::load(path, defaults).class_thresholds_path == "configured.thresholds");
+        TEST_CHECK(throws([&] { ModelDescriptor::load((dir / "missing.ini").string()); }, "Cannot open"));
+
+        // find_for_model() replaces the extension, and only finds files that exist.
+        TEST_CHECK(ModelDescriptor::find_for_model((dir / "model.engine").string()) == path);
+        TEST_CHECK(ModelDescriptor::find_for_model((dir / "model").string()) == path);
+        TEST_CHECK(ModelDescriptor::find_for_model((dir / "other.engine").string()).empty());
+        std::filesystem::create_directories(dir / "v1.2");
+        TEST_CHECK(ModelDescriptor::find_for_model((dir / "v1.2" / "model").string()).empty());
+        std::filesystem::remove(path);
+        TEST_CHECK(ModelDescriptor::find_for_model((dir / "model.engine").string()).empty());
+    }
+
+    void check_detector()
+    {
+        const std::filesystem::path dir = std::filesystem::temp_directory_path() / "trt_yolo_test_descriptor";
+        std::filesystem::create_directories(dir);
+        const std::string nms_model = (dir / "nms.cpudesc").string();
+        const std::string raw_model = (dir / "raw.cpudesc").string();
+        std::ofstream(nms_model) << NMS_MODEL;
+        std::ofstream(raw_model) << RAW_MODEL;
+        std::ofstream(dir / "nms.thresholds") << "3 0.9\n";
+
+        // The descriptor next to the model is found, checked against the bindings, and its post-processing
+        // settings (with the threshold file next to it) replace the configured ones.
+        std::ofstream(dir / "nms.ini") << "name = nms-test\n"
+            "[input]\ntensor = images\nwidth = 640\nheight = 640\nchannels = 3\ndtype = f32\n"
+            "[output]\nlayout = nms_embedded\nrows = 100\ndtype = f16\n"
+            "[postprocess]\nconfidence = 0.4\nclass_thresholds = nms.thresholds\ncpu_nms = true\niou = 0.55\n";
+        DetectorConfig config;
+        config.confidence_threshold = 0.1f;
+        {
+            Detector detector(nms_model, config);
+            TEST_CHECK(detector.get_descriptor().name == "nms-test");
+            TEST_CHECK(detector.get_config().confidence_threshold == 0.4f && detector.get_config().cpu_nms);
+            TEST_CHECK(detector.get_config().nms.iou_threshold == 0.55f);
+            TEST_CHECK(detector.get_class_thresholds()->get(3) == 0.9f);
+            TEST_CHECK(detector.get_class_thresholds()->get(0) == 0.4f);
+        }
+
+        // Every declared value that differs from the engine is refused.
+        const std::pair<const char*, const char*> mismatches[] = {
+            {"[input]\ntensor = input\n", "the input tensor is images, the descriptor declares input"},
+            {"[input]\nwidth = 320\n", "the input shape (input width)"},
+            {"[input]\nheight = 480\n", "the input shape (input height)"},
+            {"[input]\nchannels = 1\n", "the input shape (input channels)"},
+            {"[input]\ndtype = f16\n", "the input data type"},
+            {"[output]\nlayout = raw_v8\n", "the output layout"},
+            {"[output]\nrows = 300\n", "the number of detections"},
+            {"[output]\ndtype = f32\n", "the data type of output bboxes"},
+            {"[output]\nscores = confidences\n", "confidences"},
+        };
+        for (const auto& [text, message] : mismatches)
+        {
+            std::ofstream(dir / "nms.ini") << text;
+            const bool ok = throws([&] { Detector detector(nms_model, config); }, message);
+            if (!ok) std::cerr << "Descriptor: " << text;
+            TEST_CHECK(ok);
+        }
+        std::filesystem::remove(dir / "nms.ini");
+
+        // A raw head reveals its anchors and classes too.
+        std::ofstream(dir / "raw.ini") << "[input]\nwidth = 320\ndtype = f16\n[output]\nlayout = raw_v8\nclasses = 80\n"
+            "rows = 2100\ndtype = f16\n";
+        {
+            Detector detector(raw_model, config);
+            TEST_CHECK(detector.get_descriptor().layout == OutputLayout::kRawHead);
+        }
+        std::ofstream(dir / "raw.ini") << "[output]\nclasses = 20\n";
+        TEST_CHECK(throws([&] { Detector detector(raw_model, config); }, "the number of classes"));
+        std::ofstream(dir / "raw.ini") << "[output]\nrows = 8400\n";
+        TEST_CHECK(throws([&] { Detector detector(raw_model, config); }, "the number of anchors"));
+        std::ofstream(dir / "raw.ini") << "[output]\nlayout = nms_embedded\n";
+        TEST_CHECK(throws([&] { Detector detector(raw_model, config); }, "the output layout"));
+
+        // An explicit descriptor path takes precedence; a syntax error fails the load.
+        config.model_descriptor_path = Test::write_temp_file("descriptor_explicit.ini", "[postprocess]\niou = 0\n");
+        TEST_CHECK(throws([&] { Detector detector(raw_model, config); }, "iou must be in (0, 1]"));
+        std::filesystem::remove_all(dir);
+    }
+}
+
+int main()
+{
+    check_parse();
+    check_parse_errors();
+    check_files();
+    check_detector();
+    return TRT::YOLO::Test::test_exit_code("test_model_descriptor");
+}
@@ -0,0 +1,520 @@
+#include "TensorRT_CPP/TRT_half.hpp"
+#include "include/TRT_YOLO_preprocess.hpp"
+#include "tests/test_util.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+// preprocess_image() must give bit-identical values at every SIMD level, within 1/8 of a grey level of an exact
+// (double precision) letterbox, and the pad value (up to float rounding) outside the scaled area. YUV frames must
+// stay within 3/4 of a grey level of an exact conversion and letterbox. Half outputs (FP16-input engines) must be
+// float_to_half() of the float32 ones, bit for bit.
+
+namespace
+{
+    using namespace TRT::YOLO;
+
+    /// @brief Get the bilinear source position of output index i of n, sampling a source of size pixels with
+    /// half-pixel centers: the two pixels to blend and the weight of the second, clamped at the edges.
+    void sample(int i, int n, int size, int& first, int& second, double& weight)
+    {
+        const double position = (i + 0.5) * size / n - 0.5;
+        first = static_cast<int>(std::floor(position));
+        weight = position - first;
+        if (first < 0)
+        {
+            first = 0;
+            weight = 0.0;
+        }
+        if (first >= size - 1)
+        {
+            first = size - 1;
+            weight = 0.0;
+        }
+        second = std::min(first + 1, size - 1);
+    }
+
+    /// @brief Naive letterbox in double precision: every output value is computed on its own from the four source
+    /// pixels around it, pixel(x, y, c) giving channel c (0: R, 1: G, 2: B) of a width x height frame. Also reports
+    /// whether each value is padding.
+    template <class Pixel>
+    void reference_letterbox(int width, int height, const Pixel& pixel, const PreprocessConfig& config,
+        std::vector<double>& out, std::vector<bool>& padding)
+    {
+        const LetterboxInfo letterbox = LetterboxInfo::fit(width, height, config.model_width, config.model_height);
+        const int scaled_width = std::max(1, std::min(config.model_width, static_cast<int>(std::lround(width * letterbox.scale))));
+        const int scaled_height = std::max(1, std::min(config.model_height, static_cast<int>(std::lround(height * letterbox.scale))));
+        const int pad_x = static_cast<int>(letterbox.pad_x), pad_y = static_cast<int>(letterbox.pad_y);
+        const size_t plane = static_cast<size_t>(config.model_width) * config.model_height;
+        out.assign(plane * 3, 0.0);
+        padding.assign(plane * 3, false);
+        for (int p = 0; p < 3; p++)
+        {
+            const int channel = config.channel_order == InputFormat::kRGB ? p : 2 - p;
+            for (int y = 0; y < config.model_height; y++)
+            {
+                for (int x = 0; x < config.model_width; x++)
+                {
+                    const size_t i = p * plane + static_cast<size_t>(y) * config.model_width + x;
+                    double value = config.pad_value;
+                    if (x < pad_x || x >= pad_x + scaled_width || y < pad_y || y >= pad_y + scaled_height)
+                    {
+                        padding[i] = true;
+                    }
+                    else
+                    {
+                        int x0, x1, y0, y1;
+                        double fx, fy;
+                        sample(x - pad_x, scaled_width, width, x0, x1, fx);
+                        sample(y - pad_y, scaled_height, height, y0, y1, fy);
+                        value = (pixel(x0, y0, channel) * (1 - fx) + pixel(x1, y0, channel) * fx) * (1 - fy)
+                            + (pixel(x0, y1, channel) * (1 - fx) + pixel(x1, y1, channel) * fx) * fy;
+                    }
+                    out[i] = (value * config.scale - config.mean[p]) / config.std[p];
+                }
+            }
+        }
+    }
+
+    /// @brief Get the largest difference between the output and the reference, in grey levels, over the padding
+    /// values (padding TRUE) or the scaled area
+    double max_error(const std::vector<float>& output, const std::vector<double>& expected,
+        const std::vector<bool>& is_padding, bool padding, const PreprocessConfig& config)
+    {
+        const size_t plane = output.size() / 3;
+        double error = 0.0;
+        for (size_t i = 0; i < output.size(); i++)
+        {
+            if (is_padding[i] == padding)
+            {
+                error = std::max(error, std::fabs(output[i] - expected[i]) * config.std[i / plane] / config.scale);
+            }
+        }
+        return error;
+    }
+
+    void check_packed_rgb(std::mt19937& rng)
+    {
+        PreprocessConfig config;
+        const float mean[3] = {0.485f, 0.456f, 0.406f}, std[3] = {0.229f, 0.224f, 0.225f};
+        std::copy(mean, mean + 3, config.mean);
+        std::copy(std, std + 3, config.std);
+
+        // Up- and downscaling, 1-pixel and very narrow frames, odd sizes, padded rows, both channel orders.
+        const int sizes[][2] = {{1280, 720}, {1920, 1080}, {640, 640}, {320, 200}, {33, 17}, {1, 1}, {2, 3},
+            {3000, 40}, {17, 999}, {641, 639}, {3840, 2160}};
+        for (const auto& size : sizes)
+        {
+            for (PixelFormat format : {PixelFormat::kRGB8, PixelFormat::kBGR8})
+            {
+                ImageView image;
+                image.width = size[0];
+                image.height = size[1];
+                image.format = format;
+                image.stride = static_cast<size_t>(size[0]) * 3 + (format == PixelFormat::kBGR8 ? 5 : 0);
+                std::vector<uint8_t> pixels(image.stride * size[1]);
+                for (uint8_t& value : pixels) value = static_cast<uint8_t>(rng());
+                image.data = pixels.data();
+
+                for (InputFormat order : {InputFormat::kRGB, InputFormat::kBGR})
+                {
+                    config.channel_order = order;
+                    std::vector<double> expected;
+                    std::vector<bool> padding;
+                    const bool bgr = format == PixelFormat::kBGR8;
+                    reference_letterbox(image.width, image.height, [&](int x, int y, int c)
+                    {
+                        return static_cast<double>(image.data[y * image.row_stride() + x * 3 + (bgr ? 2 - c : c)]);
+                    }, config, expected, padding);
+
+                    std::vector<float> scalar;
+                    PreprocessWorkspace workspace;
+                    for (SimdLevel level : Test::supported_simd_levels())
+                    {
+                        config.simd_level = level;
+                        std::vector<float> output(expected.size(), -99.0f);
+                        const LetterboxInfo letterbox = preprocess_image(image, config, output.data(), workspace);
+                        TEST_CHECK(letterbox.source_width == image.width && letterbox.source_height == image.height);
+                        if (level == SimdLevel::kScalar)
+                        {
+                            scalar = output;
+                            TEST_CHECK(max_error(output, expected, padding, false, config) < 0.125);
+                            TEST_CHECK(max_error(output, expected, padding, true, config) < 1e-3);
+                        }
+                        TEST_CHECK(output == scalar);
+                    }
+                }
+            }
+        }
+    }
+
+    /// @brief Luma weights of a YUV matrix, and its range.
+    struct YuvCoefficients
+    {
+        double kr, kb;
+        bool full_range;
+
+        YuvCoefficients(YuvMatrix matrix, bool full) : kr(matrix == YuvMatrix::kBT709 ? 0.2126 : 0.299),
+            kb(matrix == YuvMatrix::kBT709 ? 0.0722 : 0.114), full_range(full) {}
+
+        void to_yuv(double r, double g, double b, double& y, double& u, double& v) const
+        {
+            const double luma = this->kr * r + (1 - this->kr - this->kb) * g + this->kb * b;
+            const double cb = (b - luma) / (2 * (1 - this->kb)), cr = (r - luma) / (2 * (1 - this->kr));
+            y = this->full_range ? luma : 16 + luma * 219 / 255;
+            u = 128 + (this->full_range ? cb : cb * 224 / 255);
+            v = 128 + (this->full_range ? cr : cr * 224 / 255);
+        }
+
+        /// @brief Exact conversion back to RGB, clamped to [0, 255]
+        void to_rgb(double y, double u, double v, double* rgb) const
+        {
+            const double chroma_scale = this->full_range ? 1.0 : 255.0 / 224;
+            const double luma = this->full_range ? y : (y - 16) * 255 / 219;
+            const double cb = (u - 128) * chroma_scale, cr = (v - 128) * chroma_scale;
+            const double r = luma + 2 * (1 - this->kr) * cr, b = luma + 2 * (1 - this->kb) * cb;
+            const double g = (luma - this->kr * r - this->kb * b) / (1 - this->kr - this->kb);
+            rgb[0] = std::clamp(r, 0.0, 255.0);
+            rgb[1] = std::clamp(g, 0.0, 255.0);
+            rgb[2] = std::clamp(b, 0.0, 255.0);
+        }
+    };
+
+    uint8_t to_u8(double value)
+    {
+        return static_cast<uint8_t>(std::clamp(std::round(value), 0.0, 255.0));
+    }
+
+    /// @brief A YUV frame built from an RGB image (chroma averaged over its 2x1 or 2x2 block), with its memory.
+    struct YuvFrame
+    {
+        std::vector<uint8_t> bytes;
+        ImageView view;
+
+        /// @param padding Bytes added to every row (the planes are then passed explicitly, with their strides)
+        YuvFrame(PixelFormat format, const std::vector<uint8_t>& rgb, int width, int height,
+            const YuvCoefficients& coefficients, YuvMatrix matrix, size_t padding)
+        {
+            const size_t pixels = static_cast<size_t>(width) * height;
+            std::vector<double> y(pixels), u(pixels), v(pixels);
+            for (size_t i = 0; i < pixels; i++)
+            {
+                coefficients.to_yuv(rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2], y[i], u[i], v[i]);
+            }
+            const int chroma_width = (width + 1) / 2, chroma_height = (height + 1) / 2;
+            auto average = [&](const std::vector<double>& plane, int cx, int cy, int rows)
+            {
+                double sum = 0.0;
+                for (int dy = 0; dy < rows; dy++)
+                {
+                    for (int dx = 0; dx < 2; dx++)
+                    {
+                        sum += plane[std::min(height - 1, cy * rows + dy) * width + std::min(width - 1, cx * 2 + dx)];
+                    }
+                }
+                return to_u8(sum / (rows * 2));
+            };
+
+            this->view.width = width;
+            this->view.height = height;
+            this->view.format = format;
+            this->view.matrix = matrix;
+            this->view.full_range = coefficients.full_range;
+            if (format == PixelFormat::kYUYV)
+            {
+                const size_t stride = 4 * chroma_width + padding;
+                this->bytes.assign(stride * height, 0);
+                for (int row = 0; row < height; row++)
+                {
+                    for (int cx = 0; cx < chroma_width; cx++)
+                    {
+                        uint8_t* pair = &this->bytes[row * stride + cx * 4];
+                        pair[0] = to_u8(y[row * width + cx * 2]);
+                        pair[1] = average(u, cx, row, 1);
+                        pair[2] = to_u8(y[row * width + std::min(width - 1, cx * 2 + 1)]);
+                        pair[3] = average(v, cx, row, 1);
+                    }
+                }
+                this->view.data = this->bytes.data();
+                this->view.stride = padding != 0 ? stride : 0;
+                return;
+            }
+
+            const bool nv12 = format == PixelFormat::kNV12;
+            const size_t stride = width + padding, chroma_stride = (nv12 ? 2 * chroma_width : chroma_width) + padding;
+            const size_t luma_bytes = stride * height, chroma_bytes = chroma_stride * chroma_height;
+            this->bytes.assign(luma_bytes + chroma_bytes * (nv12 ? 1 : 2), 0);
+            for (int row = 0; row < height; row++)
+            {
+                for (int x = 0; x < width; x++) this->bytes[row * stride + x] = to_u8(y[row * width + x]);
+            }
+            for (int cy = 0; cy < chroma_height; cy++)
+            {
+                for (int cx = 0; cx < chroma_width; cx++)
+                {
+                    uint8_t* chroma = &this->bytes[luma_bytes + cy * chroma_stride];
+                    if (nv12)
+                    {
+                        chroma[cx * 2] = average(u, cx, cy, 2);
+                        chroma[cx * 2 + 1] = average(v, cx, cy, 2);
+                    }
+                    else
+                    {
+                        chroma[cx] = average(u, cx, cy, 2);
+                        chroma[chroma_bytes + cx] = average(v, cx, cy, 2);
+                    }
+                }
+            }
+            this->view.data = this->bytes.data();
+            if (padding != 0)
+            {
+                this->view.stride = stride;
+                this->view.chroma_stride = chroma_stride;
+                this->view.chroma = this->bytes.data() + luma_bytes;
+                this->view.chroma_v = nv12 ? nullptr : this->bytes.data() + luma_bytes + chroma_bytes;
+            }
+        }
+
+        /// @brief Get the Y, U, V samples of pixel (x, y), reading the chroma of its block
+        void yuv_at(int x, int y, double& luma, double& u, double& v) const
+        {
+            const ImageView& image = this->view;
+            if (image.format == PixelFormat::kYUYV)
+            {
+                const uint8_t* pair = image.data + y * image.row_stride() + (x / 2) * 4;
+                luma = pair[(x & 1) * 2];
+                u = pair[1];
+                v = pair[3];
+                return;
+            }
+            luma = image.data[y * image.row_stride() + x];
+            const size_t step = image.format == PixelFormat::kNV12 ? 2 : 1;
+            const size_t offset = (y / 2) * image.chroma_row_stride() + (x / 2) * step;
+            u = image.u_plane()[offset];
+            v = image.v_plane()[offset];
+        }
+    };
+
+    void check_yuv(std::mt19937& rng)
+    {
+        struct Size
+        {
+            int width, height;
+            size_t padding;
+        };
+        // Odd sizes (a half chroma block on the last column / row), padded rows with explicit planes, tiny frames.
+        const Size sizes[] = {{1280, 720, 0}, {641, 361, 13}, {333, 777, 5}, {5, 3, 0}, {2, 1, 0}};
+        for (const Size& size : sizes)
+        {
+            const int width = size.width, height = size.height;
+            std::vector<uint8_t> rgb(static_cast<size_t>(width) * height * 3);
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    for (int c = 0; c < 3; c++)
+                    {
+                        rgb[(y * width + x) * 3 + c] = to_u8(127.5 + 127.5 * std::sin(x * 0.013 * (c + 1) + y * 0.021 * (3 - c))
+                            + static_cast<int>(rng() % 21) - 10);
+                    }
+                }
+            }
+            for (PixelFormat format : {PixelFormat::kNV12, PixelFormat::kYUYV, PixelFormat::kI420})
+            {
+                for (YuvMatrix matrix : {YuvMatrix::kBT601, YuvMatrix::kBT709})
+                {
+                    for (bool full_range : {false, true})
+                    {
+                        const YuvCoefficients coefficients(matrix, full_range);
+                        const YuvFrame frame(format, rgb, width, height, coefficients, matrix, size.padding);
+
+                        // The frame converted exactly, and rounded to 8-bit RGB.
+                        std::vector<double> exact(rgb.size());
+                        std::vector<uint8_t> converted(rgb.size());
+                        for (int y = 0; y < height; y++)
+                        {
+                            for (int x = 0; x < width; x++)
+                            {
+                                double luma, u, v;
+                                frame.yuv_at(x, y, luma, u, v);
+                                double* pixel = &exact[(static_cast<size_t>(y) * width + x) * 3];
+                                coefficients.to_rgb(luma, u, v, pixel);
+                                for (int c = 0; c < 3; c++) converted[(static_cast<size_t>(y) * width + x) * 3 + c] = to_u8(pixel[c]);
+                            }
+                        }
+                        ImageView converted_view;
+                        converted_view.data = converted.data();
+                        converted_view.width = width;
+                        converted_view.height = height;
+
+                        for (InputFormat order : {InputFormat::kRGB, InputFormat::kBGR})
+                        {
+                            PreprocessConfig config;
+                            config.channel_order = order;
+                            std::vector<double> expected;
+                            std::vector<bool> padding;
+                            reference_letterbox(width, height, [&](int x, int y, int c)
+                            {
+                                return exact[(static_cast<size_t>(y) * width + x) * 3 + c];
+                            }, config, expected, padding);
+
+                            // Converting then resizing the 8-bit frame rounds once more than the fused conversion.
+                            std::vector<float> two_pass(expected.size());
+                            PreprocessWorkspace workspace;
+                            config.simd_level = SimdLevel::kScalar;
+                            preprocess_image(converted_view, config, two_pass.data(), workspace);
+
+                            std::vector<float> scalar;
+                            for (SimdLevel level : Test::supported_simd_levels())
+                            {
+                                config.simd_level = level;
+                                std::vector<float> output(expected.size(), -99.0f);
+                                preprocess_image(frame.view, config, output.data(), workspace);
+                                if (level == SimdLevel::kScalar)
+                                {
+                                    scalar = output;
+                                    TEST_CHECK(max_error(output, expected, padding, false, config) < 0.75);
+                                    double difference = 0.0;
+                                    for (size_t i = 0; i < output.size(); i++)
+                                    {
+                                        difference = std::max(difference, std::fabs(static_cast<double>(output[i]) - two_pass[i]) / config.scale);
+                                    }
+                                    TEST_CHECK(difference <= 1.01);
+                                }
+                                TEST_CHECK(output == scalar);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // Plane sizes and strides of the YUV formats.
+        ImageView image;
+        image.data = reinterpret_cast<const uint8_t*>("0123456789abcdef");
+        image.format = PixelFormat::kNV12;
+        image.width = 4;
+        image.height = 2;
+        image.stride = 3;
+        TEST_CHECK(!image.is_valid());
+        image.stride = 4;
+        TEST_CHECK(image.is_valid() && image.num_bytes() == 8 + 4);
+        image.format = PixelFormat::kYUYV;
+        image.width = 3;
+        image.stride = 0;
+        TEST_CHECK(image.row_stride() == 8 && image.num_bytes() == 16);
+    }
+
+    void check_half_output(std::mt19937& rng)
+    {
+        // Conversions of planar frames: every half, and 2^20 random float32 bit patterns with the special values.
+        std::vector<uint16_t> halves(65536 + 3);
+        for (size_t i = 0; i < halves.size(); i++) halves[i] = static_cast<uint16_t>(i);
+        std::vector<uint32_t> floats(1 << 20);
+        for (uint32_t& bits : floats) bits = static_cast<uint32_t>(rng());
+        const uint32_t special[] = {0x00000000u, 0x80000000u, 0x7F800000u, 0xFF800000u, 0x7FC00000u, 0x7F800001u,
+            0x477FEFFFu, 0x477FF000u, 0x38800000u, 0x387FFFFFu, 0x33000000u, 0x33000001u, 0x00000001u};
+        std::copy(std::begin(special), std::end(special), floats.begin());
+
+        for (SimdLevel level : Test::supported_simd_levels())
+        {
+            PreprocessConfig config;
+            config.simd_level = level;
+            std::vector<float> widened(halves.size());
+            convert_planar_frame(InputFrame::planar(FrameFormat::kF16Planar, halves.data()), halves.size(), config,
+                widened.data(), TensorDataType::kFLOAT);
+            bool same = true;
+            for (size_t i = 0; i < halves.size(); i++)
+            {
+                const float expected = half_to_float(halves[i]);
+                same &= std::memcmp(&expected, &widened[i], sizeof(float)) == 0;
+            }
+            TEST_CHECK(same);
+
+            std::vector<uint16_t> narrowed(floats.size());
+            convert_planar_frame(InputFrame::planar(FrameFormat::kF32Planar, floats.data()), floats.size(), config,
+                narrowed.data(), TensorDataType::kHALF);
+            same = true;
+            for (size_t i = 0; i < floats.size(); i++)
+            {
+                float value;
+                std::memcpy(&value, &floats[i], sizeof(float));
+                same &= narrowed[i] == float_to_half(value);
+            }
+            TEST_CHECK(same);
+        }
+
+        // preprocess_image() writing half: float_to_half() of its float32 output, bit for bit, for every format.
+        struct Case
+        {
+            int width, height;
+            PixelFormat format;
+        };
+        const Case cases[] = {{1920, 1080, PixelFormat::kBGR8}, {641, 359, PixelFormat::kRGB8},
+            {1280, 720, PixelFormat::kNV12}, {333, 777, PixelFormat::kYUYV}, {3, 2, PixelFormat::kI420}};
+        for (const Case& frame : cases)
+        {
+            std::vector<uint8_t> pixels(static_cast<size_t>(frame.width) * frame.height * 3);
+            for (uint8_t& value : pixels) value = static_cast<uint8_t>(rng());
+            ImageView image;
+            image.data = pixels.data();
+            image.width = frame.width;
+            image.height = frame.height;
+            image.format = frame.format;
+            for (bool imagenet : {false, true})
+            {
+                PreprocessConfig config;
+                if (imagenet)
+                {
+                    const float mean[3] = {0.485f, 0.456f, 0.406f}, std[3] = {0.229f, 0.224f, 0.225f};
+                    std::copy(mean, mean + 3, config.mean);
+                    std::copy(std, std + 3, config.std);
+                }
+                for (SimdLevel level : Test::supported_simd_levels())
+                {
+                    config.simd_level = level;
+                    PreprocessWorkspace workspace;
+                    const size_t count = static_cast<size_t>(config.model_width) * config.model_height * 3;
+                    std::vector<float> output(count);
+                    std::vector<uint16_t> half_output(count, 0xDEAD);
+                    const LetterboxInfo a = preprocess_image(image, config, output.data(), workspace);
+                    const LetterboxInfo b = preprocess_image(image, config, half_output.data(), TensorDataType::kHALF, workspace);
+                    TEST_CHECK(a.scale == b.scale && a.pad_x == b.pad_x && a.pad_y == b.pad_y);
+                    bool same = true;
+                    for (size_t i = 0; i < count; i++) same &= half_output[i] == float_to_half(output[i]);
+                    TEST_CHECK(same);
+                }
+            }
+        }
+
+        // Other input types are rejected.
+        bool threw = false;
+        try
+        {
+            ImageView image;
+            image.data = reinterpret_cast<const uint8_t*>("abc");
+            image.width = 1;
+            image.height = 1;
+            PreprocessConfig config;
+            PreprocessWorkspace workspace;
+            std::vector<int8_t> output(static_cast<size_t>(config.model_width) * config.model_height * 3);
+            preprocess_image(image, config, output.data(), TensorDataType::kINT8, workspace);
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        TEST_CHECK(threw);
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(1);
+    check_packed_rgb(rng);
+    check_yuv(rng);
+    check_half_output(rng);
+    return TRT::YOLO::Test::test_exit_code("test_preprocess");
+}
@@ -0,0 +1,398 @@
+#include "include/TRT_YOLO_nms.hpp"
+#include "include/TRT_YOLO_postprocess.hpp"
+#include "tests/test_util.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+// Every SIMD level must produce bit-identical results to the scalar kernels, and those to a naive reference.
+// Levels this CPU lacks are skipped (see Test::supported_simd_levels()).
+
+namespace
+{
+    using namespace TRT::YOLO;
+
+    bool same_batches(const DetectionBatch& a, const DetectionBatch& b)
+    {
+        return Test::same_detections(a, b) && a.dropped() == b.dropped();
+    }
+
+    /// @brief Naive filter_detections(): rows in order, score >= the threshold of the class (never NaN).
+    void reference_filter(const std::vector<float>& boxes, const std::vector<float>& scores,
+        const std::vector<int32_t>& class_ids, const ClassThresholds& thresholds, const LetterboxInfo* letterbox,
+        DetectionBatch& out)
+    {
+        out.clear();
+        for (size_t i = 0; i < scores.size(); i++)
+        {
+            if (!(scores[i] >= thresholds.get(class_ids[i])))
+            {
+                continue;
+            }
+            float x1 = boxes[i * 4], y1 = boxes[i * 4 + 1], x2 = boxes[i * 4 + 2], y2 = boxes[i * 4 + 3];
+            if (letterbox != nullptr)
+            {
+                const float inverse = 1.0f / letterbox->scale;
+                const float width = static_cast<float>(letterbox->source_width);
+                const float height = static_cast<float>(letterbox->source_height);
+                x1 = letterbox_project(x1, letterbox->pad_x, inverse, width);
+                y1 = letterbox_project(y1, letterbox->pad_y, inverse, height);
+                x2 = letterbox_project(x2, letterbox->pad_x, inverse, width);
+                y2 = letterbox_project(y2, letterbox->pad_y, inverse, height);
+            }
+            out.push_back(x1, y1, x2 - x1, y2 - y1, scores[i], class_ids[i]);
+        }
+    }
+
+    /// @brief Naive greedy suppression, O(n^2): candidate indices by rank (stable, NaN scores left out, cut to
+    /// max_candidates), and for each rank the rank of the box that suppressed it first (-1: none). Stops after top_k.
+    /// Boxes of the same view (if views is set) never suppress each other.
+    void reference_clusters(const DetectionBatch& candidates, const NmsConfig& config, const int32_t* views,
+        std::vector<size_t>& ranked, std::vector<long>& owner, std::vector<size_t>& kept)
+    {
+        ranked.clear();
+        kept.clear();
+        for (size_t i = 0; i < candidates.size(); i++)
+        {
+            if (!std::isnan(candidates.confidence()[i])) ranked.push_back(i);
+        }
+        const float* confidence = candidates.confidence();
+        std::stable_sort(ranked.begin(), ranked.end(), [&](size_t a, size_t b) { return confidence[a] > confidence[b]; });
+        if (config.max_candidates != 0 && ranked.size() > config.max_candidates)
+        {
+            ranked.resize(config.max_candidates);
+        }
+
+        owner.assign(ranked.size(), -1);
+        for (size_t r = 0; r < ranked.size(); r++)
+        {
+            if (owner[r] >= 0) continue;
+            if (config.top_k != 0 && kept.size() == config.top_k) break;
+            kept.push_back(r);
+            const bounding_box_t a = candidates[ranked[r]].rect();
+            const float area_a = std::max(a.width, 0.0f) * std::max(a.height, 0.0f);
+            for (size_t s = r + 1; s < ranked.size(); s++)
+            {
+                const size_t b_index = ranked[s];
+                if (owner[s] >= 0 || (!config.class_agnostic && candidates.class_id()[b_index] != candidates.class_id()[ranked[r]])
+                    || (views != nullptr && views[b_index] == views[ranked[r]]))
+                {
+                    continue;
+                }
+                const bounding_box_t b = candidates[b_index].rect();
+                const float area_b = std::max(b.width, 0.0f) * std::max(b.height, 0.0f);
+                const float overlap_width = std::max(std::min(a.x + a.width, b.x + b.width) - std::max(a.x, b.x), 0.0f);
+                const float overlap_height = std::max(std::min(a.y + a.height, b.y + b.height) - std::max(a.y, b.y), 0.0f);
+                const float intersection = overlap_width * overlap_height;
+                const float base = config.metric == OverlapMetric::kIoS ? std::min(area_a, area_b) : area_a + area_b - intersection;
+                if (intersection > config.iou_threshold * base) owner[s] = static_cast<long>(r);
+            }
+        }
+    }
+
+    /// @brief Appends a box given by its model-space corners, projected like the kernels if letterbox is set.
+    void push_corners(DetectionBatch& out, const LetterboxInfo* letterbox, float x1, float y1, float x2, float y2,
+        float confidence, int32_t class_id)
+    {
+        if (letterbox != nullptr)
+        {
+            const float inverse = 1.0f / letterbox->scale;
+            const float width = static_cast<float>(letterbox->source_width);
+            const float height = static_cast<float>(letterbox->source_height);
+            x1 = letterbox_project(x1, letterbox->pad_x, inverse, width);
+            y1 = letterbox_project(y1, letterbox->pad_y, inverse, height);
+            x2 = letterbox_project(x2, letterbox->pad_x, inverse, width);
+            y2 = letterbox_project(y2, letterbox->pad_y, inverse, height);
+        }
+        out.push_back(x1, y1, x2 - x1, y2 - y1, confidence, class_id);
+    }
+
+    /// @brief Naive non_max_suppression(): the kept boxes of reference_clusters(), unchanged or projected.
+    void reference_nms(const DetectionBatch& candidates, const NmsConfig& config, const LetterboxInfo* letterbox,
+        const int32_t* views, DetectionBatch& out)
+    {
+        std::vector<size_t> ranked, kept;
+        std::vector<long> owner;
+        reference_clusters(candidates, config, views, ranked, owner, kept);
+        out.clear();
+        for (size_t r : kept)
+        {
+            const detected_object_info_t box = candidates[ranked[r]];
+            if (letterbox != nullptr)
+            {
+                push_corners(out, letterbox, box.rect.x, box.rect.y, box.rect.x + box.rect.width,
+                    box.rect.y + box.rect.height, box.confidence, box.class_id);
+            }
+            else
+            {
+                out.push_back(box);
+            }
+        }
+    }
+
+    /// @brief Naive weighted_box_fusion(): each kept box of reference_clusters() becomes the confidence-weighted
+    /// (clamped at 0) mean corners of itself and the boxes it suppressed first, summed in rank order.
+    void reference_wbf(const DetectionBatch& candidates, const NmsConfig& config, const LetterboxInfo* letterbox,
+        const int32_t* views, DetectionBatch& out)
+    {
+        std::vector<size_t> ranked, kept;
+        std::vector<long> owner;
+        reference_clusters(candidates, config, views, ranked, owner, kept);
+        out.clear();
+        for (size_t r : kept)
+        {
+            float weight = 0.0f, x1 = 0.0f, y1 = 0.0f, x2 = 0.0f, y2 = 0.0f;
+            for (size_t s = 0; s < ranked.size(); s++)
+            {
+                if (s != r && owner[s] != static_cast<long>(r))
+                {
+                    continue;
+                }
+                const bounding_box_t box = candidates[ranked[s]].rect();
+                const float confidence = candidates.confidence()[ranked[s]];
+                const float w = confidence > 0.0f ? confidence : 0.0f;
+                weight += w;
+                x1 += w * box.x;
+                y1 += w * box.y;
+                x2 += w * (box.x + box.width);
+                y2 += w * (box.y + box.height);
+            }
+            const detected_object_info_t best = candidates[ranked[r]];
+            if (weight > 0.0f)
+            {
+                const float inverse = 1.0f / weight;
+                x1 *= inverse;
+                y1 *= inverse;
+                x2 *= inverse;
+                y2 *= inverse;
+            }
+            else
+            {
+                x1 = best.rect.x;
+                y1 = best.rect.y;
+                x2 = best.rect.x + best.rect.width;
+                y2 = best.rect.y + best.rect.height;
+            }
+            push_corners(out, letterbox, x1, y1, x2, y2, best.confidence, best.class_id);
+        }
+    }
+
+    /// @brief Random boxes over a 640x640 model input: scores on a 0.01 grid (many ties, a few negative) and a NaN
+    /// every 50th box.
+    void random_candidates(DetectionBatch& candidates, size_t count, int classes, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        candidates.reset(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const float cx = unit(rng) * 640.0f, cy = unit(rng) * 640.0f;
+            const float width = 20.0f + unit(rng) * 80.0f, height = 20.0f + unit(rng) * 80.0f;
+            const float score = i % 50 == 0 ? std::numeric_limits<float>::quiet_NaN()
+                : static_cast<float>(static_cast<int>(rng() % 110) - 9) / 100.0f;
+            candidates.push_back(cx - width / 2, cy - height / 2, width, height, score == 0.0f ? 0.5f : score,
+                static_cast<int>(rng() % classes));
+        }
+    }
+
+    void check_nms(std::mt19937& rng)
+    {
+        NmsWorkspace workspace;
+        const LetterboxInfo letterbox = LetterboxInfo::fit(1920, 1080);
+
+        // Tails of the 8- and 16-wide IoU kernels, both metrics, class-aware and agnostic, top_k and
+        // max_candidates limits, capacities that drop surviving boxes (which must still suppress), and views
+        // whose boxes never suppress each other; non_max_suppression() and weighted_box_fusion() alike.
+        for (size_t count : {0, 1, 5, 17, 100, 255, 256, 1000, 3000})
+        {
+            DetectionBatch candidates;
+            random_candidates(candidates, count, 5, rng);
+            std::vector<int32_t> tile_views(count);
+            for (int32_t& view : tile_views)
+            {
+                view = static_cast<int32_t>(rng() % 3);
+            }
+            for (OverlapMetric metric : {OverlapMetric::kIoU, OverlapMetric::kIoS})
+            {
+                for (bool agnostic : {false, true})
+                {
+                    for (size_t limit : {static_cast<size_t>(0), static_cast<size_t>(10), static_cast<size_t>(300)})
+                    {
+                        NmsConfig config;
+                        config.metric = metric;
+                        config.class_agnostic = agnostic;
+                        config.top_k = limit;
+                        config.max_candidates = count == 1000 ? 50 : 0;
+                        for (size_t capacity : {count + 1, static_cast<size_t>(4)})
+                        {
+                            for (const LetterboxInfo* projection : {static_cast<const LetterboxInfo*>(nullptr), &letterbox})
+                            {
+                                for (bool with_views : {false, true})
+                                {
+                                    const int32_t* views = with_views ? tile_views.data() : nullptr;
+                                    DetectionBatch expected(capacity), actual(capacity);
+                                    reference_nms(candidates, config, projection, views, expected);
+                                    for (SimdLevel level : Test::supported_simd_levels())
+                                    {
+                                        non_max_suppression(candidates, actual, config, workspace, level, projection, views);
+                                        TEST_CHECK(same_batches(actual, expected));
+                                    }
+                                    reference_wbf(candidates, config, projection, views, expected);
+                                    for (SimdLevel level : Test::supported_simd_levels())
+                                    {
+                                        weighted_box_fusion(candidates, actual, config, workspace, level, projection, views);
+                                        TEST_CHECK(same_batches(actual, expected));
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /// @brief Naive decode_raw_head(): transposes the head, then scans each anchor's row for the best class
+    /// (the first one on ties; a NaN class 0 score never passes).
+    void reference_decode(const std::vector<float>& head, size_t num_classes, size_t num_anchors,
+        const ClassThresholds& thresholds, const LetterboxInfo* letterbox, DetectionBatch& out)
+    {
+        const size_t rows = 4 + num_classes;
+        std::vector<float> transposed(head.size());
+        for (size_t r = 0; r < rows; r++)
+        {
+            for (size_t a = 0; a < num_anchors; a++) transposed[a * rows + r] = head[r * num_anchors + a];
+        }
+        out.clear();
+        for (size_t a = 0; a < num_anchors; a++)
+        {
+            const float* row = &transposed[a * rows];
+            float best = row[4];
+            int32_t best_class = 0;
+            for (size_t c = 1; c < num_classes; c++)
+            {
+                if (row[4 + c] > best)
+                {
+                    best = row[4 + c];
+                    best_class = static_cast<int32_t>(c);
+                }
+            }
+            if (!(best >= thresholds.get(best_class)))
+            {
+                continue;
+            }
+            const float cx = row[0], cy = row[1], w = row[2], h = row[3];
+            if (letterbox != nullptr)
+            {
+                push_corners(out, letterbox, cx - w * 0.5f, cy - h * 0.5f, cx + w * 0.5f, cy + h * 0.5f, best, best_class);
+            }
+            else
+            {
+                out.push_back(cx - w * 0.5f, cy - h * 0.5f, w, h, best, best_class);
+            }
+        }
+    }
+
+    void check_decode(std::mt19937& rng)
+    {
+        ClassThresholds thresholds(0.6f);
+        thresholds.set(1, 0.3f);
+        thresholds.set(2, 0.9f);
+        const LetterboxInfo letterbox = LetterboxInfo::fit(1920, 1080);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        // Anchor tails of each block size, class counts below and above a vector, capacities that drop anchors;
+        // heads of random scores, of many tied scores, and with NaNs scattered over them.
+        for (size_t num_classes : {1, 2, 3, 17, 80})
+        {
+            for (size_t num_anchors : {0, 1, 7, 15, 16, 17, 63, 64, 65, 100, 1000, 8400})
+            {
+                for (int pattern = 0; pattern < 3; pattern++)
+                {
+                    std::vector<float> head((4 + num_classes) * num_anchors);
+                    for (float& value : head) value = unit(rng);
+                    for (size_t i = 0; i < 4 * num_anchors; i++) head[i] *= 640.0f;
+                    if (pattern == 1)
+                    {
+                        for (float& value : head) value = std::round(value * 4.0f) / 4.0f;
+                    }
+                    if (pattern == 2)
+                    {
+                        for (size_t k = 0; k < head.size() / 10; k++)
+                        {
+                            head[rng() % head.size()] = std::numeric_limits<float>::quiet_NaN();
+                        }
+                    }
+                    for (size_t capacity : {static_cast<size_t>(0), static_cast<size_t>(5), num_anchors})
+                    {
+                        for (const LetterboxInfo* projection : {static_cast<const LetterboxInfo*>(nullptr), &letterbox})
+                        {
+                            DetectionBatch expected(capacity), actual(capacity);
+                            reference_decode(head, num_classes, num_anchors, thresholds, projection, expected);
+                            for (SimdLevel level : Test::supported_simd_levels())
+                            {
+                                decode_raw_head(head.data(), num_classes, num_anchors, thresholds, actual, level,
+                                    projection);
+                                TEST_CHECK(same_batches(actual, expected));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void check_filter(std::mt19937& rng)
+    {
+        ClassThresholds thresholds(0.3f);
+        thresholds.set(0, 0.5f);
+        thresholds.set(2, 0.1f);
+        thresholds.set(79, 0.9f);
+        const LetterboxInfo letterbox = LetterboxInfo::fit(1920, 1080);
+
+        // Every tail length of the 8- and 16-wide kernels, capacities that drop rows, NaN scores, and class ids
+        // outside the table (negative, or past the last entry).
+        for (size_t count : {0, 1, 7, 8, 9, 15, 16, 17, 33, 100, 1000, 8400})
+        {
+            std::vector<float> boxes(count * 4), scores(count);
+            std::vector<int32_t> class_ids(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                for (int k = 0; k < 4; k++) boxes[i * 4 + k] = static_cast<float>(rng() % 700) - 30.0f;
+                scores[i] = i % 37 == 0 ? std::numeric_limits<float>::quiet_NaN() : static_cast<float>(rng() % 1000) / 1000.0f;
+                class_ids[i] = static_cast<int32_t>(rng() % 90) - 5;
+            }
+            for (size_t capacity : {count, count / 2, static_cast<size_t>(3)})
+            {
+                for (const LetterboxInfo* projection : {static_cast<const LetterboxInfo*>(nullptr), &letterbox})
+                {
+                    DetectionBatch expected(capacity), actual(capacity);
+                    reference_filter(boxes, scores, class_ids, thresholds, projection, expected);
+                    for (SimdLevel level : Test::supported_simd_levels())
+                    {
+                        filter_detections(boxes.data(), scores.data(), class_ids.data(), count, thresholds, actual,
+                            level, projection);
+                        TEST_CHECK(same_batches(actual, expected));
+                    }
+                }
+            }
+        }
+    }
+}
+
+int main()
+{
+    std::cout << "SIMD levels:";
+    for (TRT::YOLO::SimdLevel level : TRT::YOLO::Test::supported_simd_levels())
+    {
+        std::cout << " " << TRT::YOLO::simd_level_name(level);
+    }
+    std::cout << std::endl;
+
+    std::mt19937 rng(1);
+    check_filter(rng);
+    check_nms(rng);
+    check_decode(rng);
+    return TRT::YOLO::Test::test_exit_code("test_simd_equivalence");
+}
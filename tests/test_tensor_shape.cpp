@@ -0,0 +1,166 @@
+#include "TensorRT_CPP/TRT_cpu_backend.hpp"
+#include "TensorRT_CPP/TRT_tensor_shape.hpp"
+#include "tests/test_util.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    OptimizationProfile batch_profile(int index, int min, int opt, int max, int size = 640)
+    {
+        OptimizationProfile profile;
+        profile.index = index;
+        profile.inputs.push_back({{min, 3, size, size}, {opt, 3, size, size}, {max, 3, size, size}});
+        return profile;
+    }
+
+    void check_shape_helpers()
+    {
+        TEST_CHECK(!has_dynamic_dims({1, 3, 640, 640}));
+        TEST_CHECK(has_dynamic_dims({-1, 3, 640, 640}));
+        TEST_CHECK(shape_volume({2, 3, 4}) == 24);
+        TEST_CHECK(shape_volume({}) == 0);
+        TEST_CHECK(shape_volume({-1, 3}) == 0);
+        TEST_CHECK(shape_volume({4, 0}) == 0);
+        TEST_CHECK(shape_to_string({-1, 3, 640, 640}) == "-1x3x640x640");
+
+        // Bounds are inclusive, and the rank must match.
+        TEST_CHECK(shape_within({1, 3, 640, 640}, {1, 3, 640, 640}, {8, 3, 640, 640}));
+        TEST_CHECK(shape_within({8, 3, 640, 640}, {1, 3, 640, 640}, {8, 3, 640, 640}));
+        TEST_CHECK(!shape_within({9, 3, 640, 640}, {1, 3, 640, 640}, {8, 3, 640, 640}));
+        TEST_CHECK(!shape_within({0, 3, 640, 640}, {1, 3, 640, 640}, {8, 3, 640, 640}));
+        TEST_CHECK(!shape_within({4, 3, 640}, {1, 3, 640, 640}, {8, 3, 640, 640}));
+        TEST_CHECK(!shape_within({4, 3, 320, 640}, {1, 3, 640, 640}, {8, 3, 640, 640}));
+
+        // Only dynamic dimensions are replaced; ones the reference lacks stay dynamic.
+        TEST_CHECK(resolve_dynamic_dims({-1, 100, 4}, {8, 3, 640, 640}) == TensorShape({8, 100, 4}));
+        TEST_CHECK(resolve_dynamic_dims({-1, 3, -1, -1}, {2, 3, 320, 480}) == TensorShape({2, 3, 320, 480}));
+        TEST_CHECK(resolve_dynamic_dims({1, -1, -1}, {5, 6}) == TensorShape({1, 6, -1}));
+        TensorShape resolved = {9, 9, 9, 9, 9};
+        resolve_dynamic_dims({-1, 100}, {4, 3, 640, 640}, resolved);
+        TEST_CHECK(resolved == TensorShape({4, 100}));
+    }
+
+    void check_select_profile()
+    {
+        TEST_CHECK(select_profile({}, 1) == -1);
+
+        const std::vector<OptimizationProfile> profiles = {
+            batch_profile(0, 1, 1, 1),
+            batch_profile(1, 1, 4, 8),
+            batch_profile(2, 1, 16, 32),
+            batch_profile(3, 2, 8, 8),  // Same max volume as profile 1
+        };
+        TEST_CHECK(select_profile(profiles, 0) == 0);    // <= 0: profile 0
+        TEST_CHECK(select_profile(profiles, -3) == 0);
+        TEST_CHECK(select_profile(profiles, 1) == 0);    // The smallest max volume among those accepting 1
+        TEST_CHECK(select_profile(profiles, 4) == 1);
+        TEST_CHECK(select_profile(profiles, 7) == 3);    // Same volume as profile 1, opt batch closer
+        TEST_CHECK(select_profile(profiles, 16) == 2);
+        TEST_CHECK(select_profile(profiles, 33) == -1);  // No profile accepts it
+
+        // Full ties go to the first profile.
+        const std::vector<OptimizationProfile> tied = {batch_profile(0, 1, 4, 8), batch_profile(1, 1, 4, 8)};
+        TEST_CHECK(select_profile(tied, 6) == 0);
+
+        // A smaller spatial max wins over a larger one at the same batch range.
+        const std::vector<OptimizationProfile> spatial = {batch_profile(0, 1, 4, 8, 1280), batch_profile(1, 1, 4, 8, 640)};
+        TEST_CHECK(select_profile(spatial, 4) == 1);
+
+        // Every input's batch range must accept the batch.
+        OptimizationProfile two_inputs = batch_profile(0, 1, 4, 8);
+        two_inputs.inputs.push_back({{1, 4}, {2, 4}, {2, 4}});
+        TEST_CHECK(select_profile({two_inputs}, 2) == 0);
+        TEST_CHECK(select_profile({two_inputs}, 4) == -1);
+    }
+
+    CpuBackendConfig parse(const std::string& text)
+    {
+        std::istringstream in(text);
+        return CpuInferenceBackend::parse_descriptor(in);
+    }
+
+    void check_descriptor_profiles()
+    {
+        const std::string dynamic_model =
+            "input images -1x3x640x640\n"
+            "output num_dets -1x1 i32\n"
+            "output bboxes -1x100x4\n"
+            "output scores -1x100\n"
+            "output labels -1x100 i32\n"
+            "profile 0 images 1x3x640x640 1x3x640x640 1x3x640x640\n"
+            "profile 1 images 1x3x640x640 4x3x640x640 8x3x640x640\n"
+            "profile 2 images 1x3x640x640 16x3x640x640 32x3x640x640\n";
+
+        // Profile lines land in input order under their index; the batch line picks among them.
+        const CpuBackendConfig config = parse(dynamic_model + "batch 4\n");
+        TEST_CHECK(config.batch_size == 4);
+        TEST_CHECK(config.profiles.size() == 3);
+        TEST_CHECK(config.profiles[1].index == 1);
+        TEST_CHECK(config.profiles[1].inputs.size() == 1);
+        TEST_CHECK(config.profiles[1].inputs[0].opt == TensorShape({4, 3, 640, 640}));
+
+        CpuInferenceBackend backend(config);
+        TEST_CHECK(backend.is_dynamic());
+        TEST_CHECK(backend.get_profile_index() == 1);
+        TEST_CHECK(backend.get_input_shapes()[0] == TensorShape({8, 3, 640, 640}));  // Buffers sized for the max
+        TEST_CHECK(backend.get_output_shapes()[1] == TensorShape({8, 100, 4}));
+        TEST_CHECK(backend.get_input_profile()[0].min == TensorShape({1, 3, 640, 640}));
+
+        // Without a batch line, profile 0; a batch no profile takes is an error.
+        TEST_CHECK(CpuInferenceBackend(parse(dynamic_model)).get_profile_index() == 0);
+        TEST_CHECK(CpuInferenceBackend(parse(dynamic_model + "batch 20\n")).get_profile_index() == 2);
+        bool threw = false;
+        try { CpuInferenceBackend rejected(parse(dynamic_model + "batch 64\n")); }
+        catch (const std::runtime_error&) { threw = true; }
+        TEST_CHECK(threw);
+
+        // Per-call shapes: outputs follow the batch of the call; shapes outside the profile are rejected.
+        std::vector<std::vector<uint8_t>> inputs, outputs;
+        std::vector<void*> input_ptrs, output_ptrs;
+        for (size_t bytes : backend.get_input_size_bytes())
+        {
+            inputs.emplace_back(bytes, 1);
+            input_ptrs.push_back(inputs.back().data());
+        }
+        for (size_t bytes : backend.get_output_size_bytes())
+        {
+            outputs.emplace_back(bytes);
+            output_ptrs.push_back(outputs.back().data());
+        }
+        std::vector<TensorShape> output_shapes;
+        TEST_CHECK(backend.infer_b(input_ptrs, backend.get_input_size_bytes(), output_ptrs, backend.get_output_size_bytes(),
+            {{3, 3, 640, 640}}, output_shapes));
+        TEST_CHECK(output_shapes.size() == 4 && output_shapes[1] == TensorShape({3, 100, 4}));
+        TEST_CHECK(output_shapes.size() == 4 && output_shapes[0] == TensorShape({3, 1}));
+        TEST_CHECK(!backend.infer_b(input_ptrs, backend.get_input_size_bytes(), output_ptrs, backend.get_output_size_bytes(),
+            {{9, 3, 640, 640}}, output_shapes));
+        TEST_CHECK(!backend.infer_b(input_ptrs, backend.get_input_size_bytes(), output_ptrs, backend.get_output_size_bytes(),
+            {{2, 3, 320, 640}}, output_shapes));
+
+        // Malformed profile lines.
+        auto rejects = [](const std::string& text)
+        {
+            try { CpuInferenceBackend backend(parse(text)); }
+            catch (const std::runtime_error&) { return true; }
+            return false;
+        };
+        TEST_CHECK(rejects("input images -1x3x640x640\noutput scores -1x100\n"));  // Dynamic without a profile
+        TEST_CHECK(rejects("input images -1x3x640x640\noutput scores -1x100\n"
+            "profile 0 boxes 1x3x640x640 1x3x640x640 1x3x640x640\n"));               // Undeclared input
+        TEST_CHECK(rejects("input images -1x3x640x640\noutput scores -1x100\n"
+            "profile 0 images 1x3x320x320 1x3x640x640 1x3x640x640\n"));              // Varies a static dimension
+        TEST_CHECK(rejects("input images -1x3x640x640\noutput scores -1x100\n"
+            "profile 0 images 2x3x640x640 1x3x640x640 4x3x640x640\n"));              // opt below min
+        TEST_CHECK(rejects("input images -1x3x640x640\noutput scores -1x100\nprofile 0 images 1x3x640x640\n"));
+    }
+}
+
+int main()
+{
+    check_shape_helpers();
+    check_select_profile();
+    check_descriptor_profiles();
+    return TRT::YOLO::Test::test_exit_code("test_tensor_shape");
+}
@@ -0,0 +1,273 @@
+#include "TensorRT_CPP/TRT_cpu_backend.hpp"
+#include "include/TRT_YOLO_tiling.hpp"
+#include "tests/test_util.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    using namespace TRT::YOLO;
+
+    /// @brief A CPU backend that really looks at its input: each frame reports one box around the model-input
+    /// pixels whose first channel is above 0.5 (the frame's single bright object, or the part of it the frame
+    /// shows), of class 0, scoring more the more of it is visible. Outputs are the NMS-embedded YOLO ones.
+    /// Like the GPU, async inferences read their inputs at retrieval.
+    class BrightObjectBackend : public CpuInferenceBackend
+    {
+    public:
+        /// @brief Pixels of a whole object: a visible part of that area or more scores 0.95.
+        static constexpr float WHOLE_AREA = 10000.0f;
+
+        explicit BrightObjectBackend(int batch, int contexts)
+            : CpuInferenceBackend(make_config(batch, contexts)), async_inputs_(contexts)
+        {
+        }
+
+    protected:
+        bool execute_on_context(int context, const std::vector<void*> &input_buf,
+            const std::vector<size_t> &size_in_param, const std::vector<void*> &output_buf,
+            const std::vector<size_t> &size_out_param, const std::vector<TensorShape> *input_shapes,
+            std::vector<TensorShape> *output_shapes) override
+        {
+            if (!CpuInferenceBackend::execute_on_context(context, input_buf, size_in_param, output_buf,
+                size_out_param, input_shapes, output_shapes))
+            {
+                return false;
+            }
+            this->detect(input_buf[0], output_buf);
+            return true;
+        }
+
+        bool enqueue_on_context(int context, const std::vector<void*> &input_buf,
+            const std::vector<size_t> &size_in_param) override
+        {
+            this->async_inputs_[context] = input_buf[0];
+            return CpuInferenceBackend::enqueue_on_context(context, input_buf, size_in_param);
+        }
+
+        AsyncInferStatus collect_from_context(int context, const std::vector<void*> &output_buf,
+            const std::vector<size_t> &size_out_param, bool wait) override
+        {
+            const AsyncInferStatus status = CpuInferenceBackend::collect_from_context(context, output_buf,
+                size_out_param, wait);
+            if (status == AsyncInferStatus::kReady)
+            {
+                this->detect(this->async_inputs_[context], output_buf);
+            }
+            return status;
+        }
+
+    private:
+        std::vector<void*> async_inputs_; // Input of the inference in flight on each context
+
+        static CpuBackendConfig make_config(int batch, int contexts)
+        {
+            CpuBackendConfig config = CpuInferenceBackend::yolo_nms_config();
+            for (CpuBindingDesc& binding : config.bindings) binding.shape[0] = batch;
+            config.contexts = contexts;
+            config.service_time = std::chrono::microseconds(2000);
+            return config;
+        }
+
+        void detect(const void* input, const std::vector<void*>& output_buf) const
+        {
+            const TensorShape& image = this->get_input_shapes()[0];
+            const int batch = image[0], height = image[2], width = image[3];
+            for (int frame = 0; frame < batch; frame++)
+            {
+                const float* plane = static_cast<const float*>(input) + static_cast<size_t>(frame) * 3 * height * width;
+                int x1 = width, y1 = height, x2 = 0, y2 = 0;
+                float area = 0.0f;
+                for (int y = 0; y < height; y++)
+                {
+                    for (int x = 0; x < width; x++)
+                    {
+                        if (plane[static_cast<size_t>(y) * width + x] > 0.5f)
+                        {
+                            x1 = std::min(x1, x);
+                            y1 = std::min(y1, y);
+                            x2 = std::max(x2, x + 1);
+                            y2 = std::max(y2, y + 1);
+                            area += 1.0f;
+                        }
+                    }
+                }
+                int32_t* num_dets = static_cast<int32_t*>(output_buf[0]) + frame;
+                float* box = static_cast<float*>(output_buf[1]) + static_cast<size_t>(frame) * 100 * 4;
+                float* score = static_cast<float*>(output_buf[2]) + static_cast<size_t>(frame) * 100;
+                int32_t* label = static_cast<int32_t*>(output_buf[3]) + static_cast<size_t>(frame) * 100;
+                *num_dets = area > 0.0f ? 1 : 0;
+                const float corners[4] = {static_cast<float>(x1), static_cast<float>(y1), static_cast<float>(x2),
+                    static_cast<float>(y2)};
+                std::memcpy(box, corners, sizeof(corners));
+                *score = 0.3f + 0.65f * std::min(area / WHOLE_AREA, 1.0f);
+                *label = 0;
+            }
+        }
+    };
+
+    void check_plan_tiles()
+    {
+        std::vector<TileRect> tiles;
+        plan_tiles(3840, 2160, 640, 640, 0.2f, false, tiles);
+        TEST_CHECK(tiles.size() == 32);
+
+        // Tiles stay inside the frame, reach every edge, overlap by at least the requested fraction (a pixel less
+        // with even origins) and start on even pixels when asked.
+        for (int width : {640, 700, 1281, 1920, 3840, 4001})
+        {
+            for (int height : {360, 640, 1080, 2161})
+            {
+                for (float overlap : {0.0f, 0.1f, 0.2f, 0.5f})
+                {
+                    for (bool even : {false, true})
+                    {
+                        plan_tiles(width, height, 640, 640, overlap, even, tiles);
+                        size_t columns = 0;
+                        while (columns < tiles.size() && tiles[columns].y == tiles[0].y) columns++;
+                        bool inside = true, sized = true, aligned = true, overlapping = true;
+                        for (const TileRect& tile : tiles)
+                        {
+                            inside &= tile.x >= 0 && tile.y >= 0 && tile.x + tile.width <= width && tile.y + tile.height <= height;
+                            sized &= tile.width <= 641 && tile.height <= 641;
+                            aligned &= !even || (tile.x % 2 == 0 && tile.y % 2 == 0);
+                        }
+                        for (size_t i = 1; i < columns; i++)
+                        {
+                            const int shared = tiles[i - 1].x + tiles[i - 1].width - tiles[i].x;
+                            overlapping &= shared >= static_cast<int>(std::ceil(overlap * 640)) - (even ? 1 : 0);
+                        }
+                        TEST_CHECK(inside && sized && aligned && overlapping);
+                        TEST_CHECK(tiles[0].x == 0 && tiles[0].y == 0);
+                        TEST_CHECK(tiles.back().x + tiles.back().width == width && tiles.back().y + tiles.back().height == height);
+                    }
+                }
+            }
+        }
+
+        bool threw = false;
+        try
+        {
+            plan_tiles(1920, 1080, 640, 640, 0.95f, false, tiles);
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        TEST_CHECK(threw);
+    }
+
+    void check_seam_merge()
+    {
+        // Two tiles sharing the columns [500, 640): an object at x [560, 660) is cut at 640 in the left tile and
+        // whole in the right one. Both sightings merge into the right tile's box, in frame pixels.
+        const std::vector<TileRect> tiles = {{0, 0, 640, 640}, {500, 0, 640, 640}};
+        std::vector<DetectionBatch> results;
+        results.emplace_back(10);
+        results.emplace_back(10);
+        results[0].push_back(560.0f, 100.0f, 80.0f, 50.0f, 0.6f, 3);
+        results[0].push_back(20.0f, 20.0f, 30.0f, 30.0f, 0.8f, 1); // Only the left tile sees it
+        results[1].push_back(60.0f, 101.0f, 100.0f, 49.0f, 0.9f, 3);
+
+        TilingConfig config;
+        TileMergeWorkspace workspace;
+        DetectionBatch merged(10);
+        for (SimdLevel level : Test::supported_simd_levels())
+        {
+            TEST_CHECK(merge_tile_detections(tiles, results.data(), nullptr, merged, config, workspace, level) == 2);
+            DetectionBatch expected(10);
+            expected.push_back(560.0f, 101.0f, 100.0f, 49.0f, 0.9f, 3);
+            expected.push_back(20.0f, 20.0f, 30.0f, 30.0f, 0.8f, 1);
+            TEST_CHECK(Test::same_detections(merged, expected));
+        }
+
+        // Fusion averages the two sightings instead.
+        config.merge = TileMerge::kWeightedBoxFusion;
+        TEST_CHECK(merge_tile_detections(tiles, results.data(), nullptr, merged, config, workspace) == 2);
+        TEST_CHECK(merged.confidence()[0] == 0.9f && merged.x()[0] == 560.0f);
+        TEST_CHECK(merged.width()[0] > 80.0f && merged.width()[0] < 100.0f);
+
+        // Boxes of different classes never merge.
+        results[1].class_id()[0] = 4;
+        config.merge = TileMerge::kNms;
+        TEST_CHECK(merge_tile_detections(tiles, results.data(), nullptr, merged, config, workspace) == 3);
+
+        // Boxes of one tile never merge with each other, in the seam band as in the interior: its own NMS kept
+        // both. The left tile's two nested boxes in the band both merge with the right tile's sighting instead.
+        results[0].clear();
+        results[1].clear();
+        results[0].push_back(520.0f, 300.0f, 60.0f, 60.0f, 0.8f, 2);
+        results[0].push_back(530.0f, 310.0f, 20.0f, 20.0f, 0.7f, 2);
+        results[0].push_back(100.0f, 300.0f, 60.0f, 60.0f, 0.8f, 2); // The same pair in the left tile's interior
+        results[0].push_back(110.0f, 310.0f, 20.0f, 20.0f, 0.7f, 2);
+        for (SimdLevel level : Test::supported_simd_levels())
+        {
+            for (size_t top_k : {static_cast<size_t>(0), static_cast<size_t>(100)})
+            {
+                config.nms.top_k = top_k; // 100: the interior boxes enter the merge too
+                TEST_CHECK(merge_tile_detections(tiles, results.data(), nullptr, merged, config, workspace, level) == 4);
+            }
+        }
+        config.nms.top_k = 0;
+        results[1].push_back(20.0f, 300.0f, 60.0f, 60.0f, 0.9f, 2);
+        TEST_CHECK(merge_tile_detections(tiles, results.data(), nullptr, merged, config, workspace) == 3);
+        TEST_CHECK(merged.x()[0] == 520.0f && merged.confidence()[0] == 0.9f);
+    }
+
+    void check_tiled_detector()
+    {
+        // A 1280 x 640 frame of 640 x 640 tiles. The object at x [600, 700) crosses the first seam: it is cut in
+        // the first and last tiles and whole in the middle one.
+        ImageView frame;
+        frame.width = 1280;
+        frame.height = 640;
+        frame.format = PixelFormat::kBGR8;
+        std::vector<uint8_t> pixels(frame.num_bytes(), 0);
+        for (int y = 200; y < 300; y++)
+        {
+            std::memset(&pixels[(static_cast<size_t>(y) * frame.width + 600) * 3], 255, 100 * 3);
+        }
+        frame.data = pixels.data();
+
+        // Single frames and batches of tiles, one context or chunks in flight on several (whose staging buffers
+        // must not be refilled before their results are retrieved).
+        for (int batch : {1, 2})
+        {
+            for (int contexts : {1, 3})
+            {
+                Detector detector(std::make_unique<BrightObjectBackend>(batch, contexts));
+                for (size_t tiles_per_call : {static_cast<size_t>(0), static_cast<size_t>(1)})
+                {
+                    TilingConfig config;
+                    config.batch_size = tiles_per_call;
+                    TiledDetector tiled(detector, config);
+                    DetectionBatch results(tiled.get_max_detections(frame.width, frame.height));
+                    TEST_CHECK(tiled.identify_objects(frame, results) == 1);
+                    TEST_CHECK(tiled.get_tiles().size() == 3 && tiled.get_num_candidates() == 3);
+                    if (results.size() == 1)
+                    {
+                        const detected_object_info_t box = results[0];
+                        TEST_CHECK(box.rect.x == 600.0f && box.rect.y == 200.0f);
+                        TEST_CHECK(box.rect.width == 100.0f && box.rect.height == 100.0f);
+                        TEST_CHECK(box.confidence == 0.95f && box.class_id == 0);
+                    }
+
+                    config.merge = TileMerge::kWeightedBoxFusion;
+                    TiledDetector fused(detector, config);
+                    TEST_CHECK(fused.identify_objects(frame, results) == 1);
+                    TEST_CHECK(results.x()[0] >= 600.0f && results.x()[0] + results.width()[0] <= 700.0f);
+                }
+            }
+        }
+    }
+}
+
+int main()
+{
+    check_plan_tiles();
+    check_seam_merge();
+    check_tiled_detector();
+    return TRT::YOLO::Test::test_exit_code("test_tiling");
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "include/TRT_YOLO_detections.hpp"
+#include "include/TRT_YOLO_simd.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// @brief Minimal support for the GPU-less tests and benchmarks in this directory.
+/// Each test is a plain executable: checks report their failures, and main() returns test_exit_code().
+namespace TRT::YOLO::Test
+{
+
+    /// @brief Number of checks that failed so far
+    inline int& failures() noexcept
+    {
+        static int count = 0;
+        return count;
+    }
+
+    /// @brief Prints the verdict of the test; the process exit code.
+    inline int test_exit_code(const char* name)
+    {
+        if (failures() == 0)
+        {
+            std::cout << name << ": ok" << std::endl;
+            return 0;
+        }
+        std::cout << name << ": " << failures() << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    /// @brief Writes a CPU backend descriptor (or any text file) under the temporary directory.
+    /// @return Its path
+    inline std::string write_temp_file(const std::string& name, const std::string& contents)
+    {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / ("trt_yolo_test_" + name);
+        std::ofstream(path) << contents;
+        return path.string();
+    }
+
+    /// @brief TRUE if a and b hold bit-identical detections in the same order
+    inline bool same_detections(const DetectionBatch& a, const DetectionBatch& b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        const size_t bytes = a.size() * sizeof(float);
+        return std::memcmp(a.x(), b.x(), bytes) == 0 && std::memcmp(a.y(), b.y(), bytes) == 0
+            && std::memcmp(a.width(), b.width(), bytes) == 0 && std::memcmp(a.height(), b.height(), bytes) == 0
+            && std::memcmp(a.confidence(), b.confidence(), bytes) == 0
+            && std::memcmp(a.class_id(), b.class_id(), a.size() * sizeof(a.class_id()[0])) == 0;
+    }
+
+    /// @brief Get the scalar level and every SIMD level this CPU runs (the levels that must agree)
+    inline std::vector<SimdLevel> supported_simd_levels()
+    {
+        std::vector<SimdLevel> levels;
+        for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kNEON, SimdLevel::kAVX2, SimdLevel::kAVX512})
+        {
+            if (simd_level_supported(level))
+            {
+                levels.push_back(level);
+            }
+        }
+        return levels;
+    }
+
+    /// @brief TRUE if the benchmark was started with --quick (a short run, as under CTest)
+    inline bool quick_run(int argc, char** argv)
+    {
+        return argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    }
+
+    /// @brief Get the median time of one call of fn over repeats runs, in milliseconds (after one warm-up call)
+    template <typename Function>
+    double median_ms(int repeats, Function&& fn)
+    {
+        fn();
+        std::vector<double> times(static_cast<size_t>(std::max(repeats, 1)));
+        for (double& time : times)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+        return times[times.size() / 2];
+    }
+
+}
+
+/// @brief Records a failure (with its location) unless condition holds; the test carries on.
+#define TEST_CHECK(condition)                                                                              \
+    do                                                                                                     \
+    {                                                                                                      \
+        if (!(condition))                                                                                  \
+        {                                                                                                  \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " << #condition << std::endl;     \
+            TRT::YOLO::Test::failures()++;                                                                 \
+        }                                                                                                  \
+    } while (0)
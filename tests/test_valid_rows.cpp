@@ -0,0 +1,143 @@
+#include "TensorRT_CPP/TRT_cpu_backend.hpp"
+#include "TensorRT_CPP/TRT_valid_rows.hpp"
+#include "tests/test_util.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    const std::vector<CountedOutputs> NMS_MAPPING = {{"num_dets", {"bboxes", "scores", "labels"}}};
+
+    /// @brief One set of I/O buffers of a backend
+    struct Buffers
+    {
+        std::vector<std::vector<uint8_t>> storage_in, storage_out;
+        std::vector<void*> in, out;
+
+        explicit Buffers(const InferenceBackend& backend)
+        {
+            for (size_t bytes : backend.get_input_size_bytes())
+            {
+                this->in.push_back(this->storage_in.emplace_back(bytes, 7).data());
+            }
+            for (size_t bytes : backend.get_output_size_bytes())
+            {
+                this->out.push_back(this->storage_out.emplace_back(bytes, 0xAB).data());
+            }
+        }
+    };
+
+    CpuBackendConfig nms_config(int detections)
+    {
+        CpuBackendConfig config = CpuInferenceBackend::yolo_nms_config();
+        config.synthetic_detections = detections;
+        return config;
+    }
+
+    void check_saved_bytes()
+    {
+        // num_dets i32 [1, 1], then per detection 16 bytes of bboxes, 4 of scores and 4 of labels (of 100).
+        const size_t full_bytes = 4 + 100 * 24;
+        for (int detections : {7, 0, 100, 150})
+        {
+            CpuInferenceBackend backend(nms_config(detections));
+            CpuInferenceBackend reference(nms_config(detections));
+            TEST_CHECK(!backend.has_counted_outputs());
+            TEST_CHECK(backend.set_counted_outputs(NMS_MAPPING) && backend.has_counted_outputs());
+
+            Buffers buffers(backend), expected(reference);
+            const int calls = 3;
+            for (int call = 0; call < calls; call++)
+            {
+                TEST_CHECK(backend.infer_b(buffers.in, backend.get_input_size_bytes(), buffers.out,
+                    backend.get_output_size_bytes()));
+            }
+            TEST_CHECK(reference.infer_b(expected.in, reference.get_input_size_bytes(), expected.out,
+                reference.get_output_size_bytes()));
+
+            // The valid rows match a full copy; the rest of each counted output is left untouched.
+            const size_t valid = static_cast<size_t>(std::min(detections, 100));
+            const size_t row_bytes[4] = {4, 16, 4, 4};
+            for (size_t o = 0; o < 4; o++)
+            {
+                const size_t copied = o == 0 ? 4 : valid * row_bytes[o];
+                TEST_CHECK(std::memcmp(buffers.out[o], expected.out[o], copied) == 0);
+                const auto& storage = buffers.storage_out[o];
+                TEST_CHECK(std::all_of(storage.begin() + copied, storage.end(), [](uint8_t b) { return b == 0xAB; }));
+            }
+
+            const ValidRowStats stats = backend.get_valid_row_stats();
+            const size_t copied = 4 + valid * 24;
+            TEST_CHECK(stats.inferences == calls);
+            TEST_CHECK(stats.bytes_copied == calls * copied);
+            TEST_CHECK(stats.bytes_skipped == calls * (full_bytes - copied));
+            TEST_CHECK(stats.skipped_bytes_per_inference() == static_cast<double>(full_bytes - copied));
+            TEST_CHECK(reference.get_valid_row_stats().inferences == 0);
+        }
+    }
+
+    void check_rejected_mappings()
+    {
+        std::vector<TensorDesc> outputs = {
+            make_tensor_desc("num_dets", false, TensorDataType::kINT32, {1, 1}),
+            make_tensor_desc("bboxes", false, TensorDataType::kFLOAT, {1, 100, 4}),
+            make_tensor_desc("scores", false, TensorDataType::kHALF, {1, 100}),
+            make_tensor_desc("labels", false, TensorDataType::kINT32, {1, 100}),
+            make_tensor_desc("count_f", false, TensorDataType::kFLOAT, {1, 1}),
+            make_tensor_desc("count2", false, TensorDataType::kINT64, {1}),
+            make_tensor_desc("packed", false, TensorDataType::kHALF, {1, 100, 8}, 2, 8),
+        };
+
+        ValidRowPlan plan;
+        std::string error;
+        TEST_CHECK(plan.build(NMS_MAPPING, outputs, error) && !plan.empty());
+        TEST_CHECK(plan.count_output(1) == 0 && plan.count_output(3) == 0 && plan.count_output(0) == -1);
+        TEST_CHECK(plan.count_output(4) == -1);
+
+        // valid_bytes() follows the count, never past the buffer, and never below zero.
+        const int32_t counts[] = {3, 0, -5, 1000};
+        const size_t expected[] = {3 * 16, 0, 0, 1600};
+        for (int i = 0; i < 4; i++)
+        {
+            TEST_CHECK(plan.valid_bytes(1, &counts[i], 1600) == expected[i]);
+        }
+        TEST_CHECK(plan.valid_bytes(2, &counts[0], 200) == 3 * 2);
+
+        const std::pair<std::vector<CountedOutputs>, const char*> rejected[] = {
+            {{{"num_dets", {"boxes"}}}, "no output named 'boxes'"},
+            {{{"detections", {"bboxes"}}}, "no output named 'detections'"},
+            {{{"count_f", {"bboxes"}}}, "count tensor 'count_f' must hold a single integer"},
+            {{{"scores", {"bboxes"}}}, "count tensor 'scores' must hold a single integer"},
+            {{{"num_dets", {"num_dets"}}}, "cannot be counted"},
+            {{{"num_dets", {"bboxes", "bboxes"}}}, "output 'bboxes' cannot be counted by 'num_dets'"},
+            {{{"num_dets", {"bboxes"}}, {"count2", {"bboxes"}}}, "output 'bboxes' cannot be counted by 'count2'"},
+            {{{"num_dets", {"scores"}}, {"count2", {"num_dets"}}}, "'num_dets' is both a count and a dependent"},
+            {{{"count2", {"num_dets"}}, {"num_dets", {"scores"}}}, "cannot be counted"},
+            {{{"num_dets", {"packed"}}}, "output 'packed' is not a linear"},
+        };
+        for (const auto& [mapping, message] : rejected)
+        {
+            error.clear();
+            const bool refused = !plan.build(mapping, outputs, error) && plan.empty();
+            const bool explained = error.find(message) != std::string::npos;
+            if (!explained) std::cerr << "Unexpected error: '" << error << "', expected '" << message << "'\n";
+            TEST_CHECK(refused && explained);
+        }
+
+        // A backend keeps copying in full after a rejected mapping.
+        CpuInferenceBackend backend(nms_config(5));
+        TEST_CHECK(!backend.set_counted_outputs({{"scores", {"bboxes"}}}) && !backend.has_counted_outputs());
+        Buffers buffers(backend);
+        TEST_CHECK(backend.infer_b(buffers.in, backend.get_input_size_bytes(), buffers.out,
+            backend.get_output_size_bytes()));
+        TEST_CHECK(backend.get_valid_row_stats().inferences == 0);
+    }
+}
+
+int main()
+{
+    check_saved_bytes();
+    check_rejected_mappings();
+    return TRT::YOLO::Test::test_exit_code("test_valid_rows");
+}